@@ -96,8 +96,12 @@ IncidentLight directLight;
 
 		#if defined( USE_SHADOWMAP ) && ( UNROLLED_LOOP_INDEX < NUM_DIR_LIGHT_SHADOWS )
 		directionalLightShadow = directionalLightShadows[ i ];
+		#ifdef DIR_LIGHT_SHADOW_CASCADES
+		directLight.color *= all( bvec2( directLight.visible, receiveShadow ) ) ? getShadow( directionalShadowMap[ i ], directionalLightShadow.shadowMapSize, directionalLightShadow.shadowBias, directionalLightShadow.shadowRadius, getCascadeShadowCoord( directionalShadowCascades[ i ], directionalLightShadow.shadowCascadeSplits, directionalLightShadow.shadowCascadeFar, vDirectionalShadowCoord[ i ] ) ) : 1.0;
+		#else
 		directLight.color *= all( bvec2( directLight.visible, receiveShadow ) ) ? getShadow( directionalShadowMap[ i ], directionalLightShadow.shadowMapSize, directionalLightShadow.shadowBias, directionalLightShadow.shadowRadius, vDirectionalShadowCoord[ i ] ) : 1.0;
 		#endif
+		#endif
 
 		RE_Direct( directLight, geometry, material, reflectedLight );
 
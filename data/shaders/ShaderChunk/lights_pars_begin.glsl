@@ -1,7 +1,12 @@
 
 uniform bool receiveShadow;
-uniform vec3 ambientLightColor;
-uniform vec3 lightProbe[ 9 ];
+
+#ifndef USE_UBO
+
+	uniform vec3 ambientLightColor;
+	uniform vec3 lightProbe[ 9 ];
+
+#endif
 
 // get the irradiance (radiance convolved with cosine lobe) at the point 'normal' on the unit sphere
 // source: https://graphics.stanford.edu/papers/envmap/envmap.pdf
@@ -61,7 +66,11 @@ vec3 getAmbientLightIrradiance( const in vec3 ambientLightColor ) {
 		vec3 color;
 	};
 
-	uniform DirectionalLight directionalLights[ NUM_DIR_LIGHTS ];
+	#ifndef USE_UBO
+
+		uniform DirectionalLight directionalLights[ NUM_DIR_LIGHTS ];
+
+	#endif
 
 	void getDirectionalDirectLightIrradiance( const in DirectionalLight directionalLight, const in GeometricContext geometry, out IncidentLight directLight ) {
 
@@ -83,7 +92,11 @@ vec3 getAmbientLightIrradiance( const in vec3 ambientLightColor ) {
 		float decay;
 	};
 
-	uniform PointLight pointLights[ NUM_POINT_LIGHTS ];
+	#ifndef USE_UBO
+
+		uniform PointLight pointLights[ NUM_POINT_LIGHTS ];
+
+	#endif
 
 	// directLight is an out parameter as having it as a return value caused compiler errors on some devices
 	void getPointDirectLightIrradiance( const in PointLight pointLight, const in GeometricContext geometry, out IncidentLight directLight ) {
@@ -114,7 +127,11 @@ vec3 getAmbientLightIrradiance( const in vec3 ambientLightColor ) {
 		float penumbraCos;
 	};
 
-	uniform SpotLight spotLights[ NUM_SPOT_LIGHTS ];
+	#ifndef USE_UBO
+
+		uniform SpotLight spotLights[ NUM_SPOT_LIGHTS ];
+
+	#endif
 
 	// directLight is an out parameter as having it as a return value caused compiler errors on some devices
 	void getSpotDirectLightIrradiance( const in SpotLight spotLight, const in GeometricContext geometry, out IncidentLight directLight ) {
@@ -171,7 +188,11 @@ vec3 getAmbientLightIrradiance( const in vec3 ambientLightColor ) {
 		vec3 groundColor;
 	};
 
-	uniform HemisphereLight hemisphereLights[ NUM_HEMI_LIGHTS ];
+	#ifndef USE_UBO
+
+		uniform HemisphereLight hemisphereLights[ NUM_HEMI_LIGHTS ];
+
+	#endif
 
 	vec3 getHemisphereLightIrradiance( const in HemisphereLight hemiLight, const in GeometricContext geometry ) {
 
@@ -192,3 +213,29 @@ vec3 getAmbientLightIrradiance( const in vec3 ambientLightColor ) {
 
 #endif
 
+
+#ifdef USE_UBO
+
+	// filled once per frame by the renderer, see GLUniformBuffers
+	layout( std140 ) uniform LightsBlock {
+		vec3 ambientLightColor;
+		vec3 lightProbe[ 9 ];
+
+		#if NUM_DIR_LIGHTS > 0
+			DirectionalLight directionalLights[ NUM_DIR_LIGHTS ];
+		#endif
+
+		#if NUM_POINT_LIGHTS > 0
+			PointLight pointLights[ NUM_POINT_LIGHTS ];
+		#endif
+
+		#if NUM_SPOT_LIGHTS > 0
+			SpotLight spotLights[ NUM_SPOT_LIGHTS ];
+		#endif
+
+		#if NUM_HEMI_LIGHTS > 0
+			HemisphereLight hemisphereLights[ NUM_HEMI_LIGHTS ];
+		#endif
+	};
+
+#endif
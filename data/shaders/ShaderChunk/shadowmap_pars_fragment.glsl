@@ -11,10 +11,36 @@
 			float shadowNormalBias;
 			float shadowRadius;
 			vec2 shadowMapSize;
+			#ifdef DIR_LIGHT_SHADOW_CASCADES
+			vec3 shadowCascadeSplits;
+			float shadowCascadeFar;
+			#endif
 		};
 
 		uniform DirectionalLightShadow directionalLightShadows[ NUM_DIR_LIGHT_SHADOWS ];
 
+		#ifdef DIR_LIGHT_SHADOW_CASCADES
+
+			uniform mat4 directionalShadowCascades[ NUM_DIR_LIGHT_SHADOWS ];
+			varying float vDirectionalShadowDepth;
+
+			// maps coordinates of the first cascade to the cascade covering the fragment
+			vec4 getCascadeShadowCoord( const in mat4 cascades, const in vec3 splits, const in float far, vec4 shadowCoord ) {
+
+				vec3 passed = step( splits, vec3( vDirectionalShadowDepth ) );
+				float cascade = passed.x + passed.y + passed.z;
+
+				vec4 transform = cascade < 0.5 ? cascades[ 0 ] : cascade < 1.5 ? cascades[ 1 ] : cascade < 2.5 ? cascades[ 2 ] : cascades[ 3 ];
+
+				// fragments beyond the last cascade fall outside the map, and are not shadowed
+				shadowCoord.xy = vDirectionalShadowDepth > far ? vec2( - 1.0 ) : shadowCoord.xy * transform.xy + transform.zw * shadowCoord.w;
+
+				return shadowCoord;
+
+			}
+
+		#endif
+
 	#endif
 
 	#if NUM_SPOT_LIGHT_SHADOWS > 0
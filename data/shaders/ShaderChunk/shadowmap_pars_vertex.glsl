@@ -11,10 +11,18 @@
 			float shadowNormalBias;
 			float shadowRadius;
 			vec2 shadowMapSize;
+			#ifdef DIR_LIGHT_SHADOW_CASCADES
+			vec3 shadowCascadeSplits;
+			float shadowCascadeFar;
+			#endif
 		};
 
 		uniform DirectionalLightShadow directionalLightShadows[ NUM_DIR_LIGHT_SHADOWS ];
 
+		#ifdef DIR_LIGHT_SHADOW_CASCADES
+			varying float vDirectionalShadowDepth;
+		#endif
+
 	#endif
 
 	#if NUM_SPOT_LIGHT_SHADOWS > 0
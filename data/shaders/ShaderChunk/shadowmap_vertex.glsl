@@ -20,6 +20,12 @@
 	}
 	#pragma unroll_loop_end
 
+	#ifdef DIR_LIGHT_SHADOW_CASCADES
+
+		vDirectionalShadowDepth = - mvPosition.z;
+
+	#endif
+
 	#endif
 
 	#if NUM_SPOT_LIGHT_SHADOWS > 0
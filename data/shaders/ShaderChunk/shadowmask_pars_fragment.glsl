@@ -13,7 +13,11 @@ float getShadowMask() {
 	for ( int i = 0; i < NUM_DIR_LIGHT_SHADOWS; i ++ ) {
 
 		directionalLight = directionalLightShadows[ i ];
+		#ifdef DIR_LIGHT_SHADOW_CASCADES
+		shadow *= receiveShadow ? getShadow( directionalShadowMap[ i ], directionalLight.shadowMapSize, directionalLight.shadowBias, directionalLight.shadowRadius, getCascadeShadowCoord( directionalShadowCascades[ i ], directionalLight.shadowCascadeSplits, directionalLight.shadowCascadeFar, vDirectionalShadowCoord[ i ] ) ) : 1.0;
+		#else
 		shadow *= receiveShadow ? getShadow( directionalShadowMap[ i ], directionalLight.shadowMapSize, directionalLight.shadowBias, directionalLight.shadowRadius, vDirectionalShadowCoord[ i ] ) : 1.0;
+		#endif
 
 	}
 	#pragma unroll_loop_end
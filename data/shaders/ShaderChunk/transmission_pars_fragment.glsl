@@ -20,7 +20,12 @@
 	uniform sampler2D transmissionSamplerMap;
 
 	uniform mat4 modelMatrix;
-	uniform mat4 projectionMatrix;
+
+	#ifndef USE_UBO
+
+		uniform mat4 projectionMatrix;
+
+	#endif
 
 	varying vec4 vWorldPosition;
 
@@ -151,7 +151,17 @@ namespace threepp {
         RG,
         RGInteger,
         RGBInteger,
-        RGBAInteger
+        RGBAInteger,
+
+        // compressed formats
+        RGB_S3TC_DXT1,
+        RGBA_S3TC_DXT1,
+        RGBA_S3TC_DXT3,
+        RGBA_S3TC_DXT5,
+        RED_GREEN_RGTC2,
+        RGBA_BPTC,
+        RGB_ETC2,
+        RGBA_ETC2_EAC
     };
 
     enum class Loop {
@@ -0,0 +1,71 @@
+
+#ifndef THREEPP_BVH_HPP
+#define THREEPP_BVH_HPP
+
+#include "threepp/math/Ray.hpp"
+#include "threepp/math/Vector3.hpp"
+
+#include <vector>
+
+namespace threepp {
+
+    class BufferGeometry;
+
+    // Bounding volume hierarchy over the triangles of a BufferGeometry.
+    // Built top-down using binned SAH and stored as a flat, depth-first node array.
+    // Triangles are identified by their index in the geometry (faceIndex semantics).
+    class BVH {
+
+    public:
+        struct Node {
+
+            Vector3 min;
+            Vector3 max;
+            // leaf: index of the first triangle in triangles(), interior: index of the second child
+            unsigned int offset;
+            // number of triangles in a leaf, 0 for interior nodes (whose first child follows immediately)
+            unsigned int count;
+
+            [[nodiscard]] bool isLeaf() const {
+
+                return count > 0;
+            }
+        };
+
+        static constexpr unsigned int defaultMaxLeafSize = 4;
+
+        // Builds the tree with at most maxLeafSize triangles in a leaf.
+        explicit BVH(const BufferGeometry& geometry, unsigned int maxLeafSize = defaultMaxLeafSize);
+
+        [[nodiscard]] unsigned int maxLeafSize() const;
+
+        [[nodiscard]] const std::vector<Node>& nodes() const;
+
+        [[nodiscard]] const std::vector<unsigned int>& triangles() const;
+
+        [[nodiscard]] bool isValidFor(const BufferGeometry& geometry) const;
+
+        [[nodiscard]] bool needsRefit(const BufferGeometry& geometry) const;
+
+        // Recomputes node bounds after vertex positions have changed, keeping the tree topology.
+        void refit(const BufferGeometry& geometry);
+
+        // Collects the triangles contained in leaves whose bounds are hit by the ray.
+        void intersectRay(const Ray& ray, std::vector<unsigned int>& candidates) const;
+
+    private:
+        std::vector<Node> nodes_;
+        std::vector<unsigned int> triangles_;
+
+        unsigned int maxLeafSize_;
+        unsigned int attributesVersion_;
+        unsigned int positionVersion_;
+        unsigned int indexVersion_;
+        unsigned int triangleCount_;
+
+        void build(const BufferGeometry& geometry);
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_BVH_HPP
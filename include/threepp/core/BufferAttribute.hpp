@@ -25,6 +25,9 @@ namespace threepp {
     public:
         UpdateRange updateRange{0, -1};
 
+        // ranges, in elements, uploaded by the next update instead of the whole array
+        std::vector<UpdateRange> updateRanges;
+
         unsigned int version = 0;
 
         [[nodiscard]] virtual int count() const = 0;
@@ -54,6 +57,16 @@ namespace threepp {
             this->usage_ = value;
         }
 
+        void addUpdateRange(int offset, int count) {
+
+            updateRanges.push_back({offset, count});
+        }
+
+        void clearUpdateRanges() {
+
+            updateRanges.clear();
+        }
+
         template<class T>
         TypedBufferAttribute<T>* typed() {
 
@@ -82,8 +95,8 @@ namespace threepp {
             this->usage_ = source.usage_;
         }
 
-        inline static Vector3 _vector{};
-        inline static Vector2 _vector2{};
+        inline static thread_local Vector3 _vector{};
+        inline static thread_local Vector2 _vector2{};
     };
 
     template<class T>
@@ -102,7 +115,7 @@ namespace threepp {
 
         const std::vector<T>& array() const {
 
-            return array();
+            return const_cast<TypedBufferAttribute<T>*>(this)->array();
         }
 
         TypedBufferAttribute<T>& copyAt(unsigned int index1, const TypedBufferAttribute<T>& attribute, unsigned int index2) {
@@ -404,6 +417,12 @@ namespace threepp {
             return create(array.begin(), array.end(), itemSize, normalized);
         }
 
+        // Takes ownership of the array without copying it.
+        static std::unique_ptr<TypedBufferAttribute<T>> create(std::vector<T>&& array, int itemSize, bool normalized = false) {
+
+            return std::unique_ptr<TypedBufferAttribute<T>>(new TypedBufferAttribute<T>(std::move(array), itemSize, normalized));
+        }
+
         template<class ArrayLike>
         static std::unique_ptr<TypedBufferAttribute<T>> create(const ArrayLike& array, int itemSize, bool normalized = false) {
 
@@ -421,8 +440,8 @@ namespace threepp {
 
         TypedBufferAttribute(const std::vector<T>& array, int count): array_(array), count_(count) {}
 
-        TypedBufferAttribute(const std::vector<T>& array, int itemSize, bool normalized)
-            : BufferAttribute(itemSize, normalized), array_(array), count_(array_.size() / itemSize) {}
+        TypedBufferAttribute(std::vector<T> array, int itemSize, bool normalized)
+            : BufferAttribute(itemSize, normalized), array_(std::move(array)), count_(array_.size() / itemSize) {}
 
     private:
         std::vector<T> array_;
@@ -8,6 +8,7 @@
 
 #include "threepp/core/EventDispatcher.hpp"
 
+#include "threepp/core/BVH.hpp"
 #include "threepp/core/BufferAttribute.hpp"
 
 #include <optional>
@@ -50,6 +51,7 @@ namespace threepp {
         BufferGeometry& setIndex(const ArrayLike& index) {
 
             this->index_ = IntBufferAttribute::create(index, 1);
+            ++attributesVersion_;
 
             return *this;
         }
@@ -84,6 +86,9 @@ namespace threepp {
 
         [[nodiscard]] bool hasAttribute(const std::string& name) const;
 
+        // Incremented whenever the index or an attribute is set or deleted, rather than changed in place.
+        [[nodiscard]] unsigned int attributesVersion() const;
+
         [[nodiscard]] const std::unordered_map<std::string, std::vector<std::shared_ptr<BufferAttribute>>>& getMorphAttributes() const;
 
         void addGroup(int start, int count, unsigned int materialIndex = 0);
@@ -116,11 +121,27 @@ namespace threepp {
 
         void computeBoundingSphere();
 
+        // Builds a bounding volume hierarchy used to accelerate raycasting against this geometry,
+        // with at most maxLeafSize triangles in a leaf.
+        void computeBoundsTree(unsigned int maxLeafSize = BVH::defaultMaxLeafSize);
+
+        // Returns the bounding volume hierarchy, or nullptr if computeBoundsTree has not been called.
+        // The tree is refitted or rebuilt on access if the position or index attribute has changed since.
+        const BVH* boundsTree();
+
+        void disposeBoundsTree();
+
         void normalizeNormals();
 
         [[nodiscard]] std::shared_ptr<BufferGeometry> toNonIndexed() const;
 
-        void computeVertexNormals();
+        // Computes smooth normals of indexed geometries, and flat normals otherwise.
+        // Uses threadCount threads, or as many as the hardware runs concurrently for large geometries if 0.
+        void computeVertexNormals(unsigned int threadCount = 0);
+
+        // Computes the tangent attribute of an indexed geometry with normal and uv attributes,
+        // with w the handedness of the tangent space. Uses threads as computeVertexNormals.
+        void computeTangents(unsigned int threadCount = 0);
 
         void dispose();
 
@@ -135,6 +156,8 @@ namespace threepp {
     private:
         bool disposed_ = false;
         std::unique_ptr<IntBufferAttribute> index_;
+        std::unique_ptr<BVH> boundsTree_;
+        unsigned int attributesVersion_{0};
         std::unordered_map<std::string, std::shared_ptr<BufferAttribute>> attributes_;
         std::unordered_map<std::string, std::vector<std::shared_ptr<BufferAttribute>>> morphAttributes_;
 
@@ -14,6 +14,7 @@
 
 #include "misc.hpp"
 
+#include <array>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -162,6 +163,7 @@ namespace threepp {
         // Adds object as child of this object. An arbitrary number of objects may be added.
         // Any current parent on an object passed in here will be removed, since an object can have at most one parent.
         // This version of add does NOT take ownership of the passed in object
+        // Dispatches "added" on object, and "childadded" with object as the target on this object.
         virtual void add(Object3D& object);
 
         // Removes object as child of this object.
@@ -209,10 +211,23 @@ namespace threepp {
         // Updates the local transform.
         void updateMatrix();
 
+        // Updates the global transform of the object and its descendants.
+        // The local transform is only recomposed when position, quaternion or scale changed since it was last composed,
+        // and world transforms are only recomputed for objects whose local transform or ancestors changed.
         virtual void updateMatrixWorld(bool force = false);
 
+        // Total number of world transforms recomputed by updateMatrixWorld on the calling thread.
+        static size_t matrixWorldUpdateCount();
+
+        // Incremented each time updateMatrixWorld or updateWorldMatrix recomputes matrixWorld.
+        [[nodiscard]] unsigned int matrixWorldVersion() const;
+
         virtual void updateWorldMatrix(std::optional<bool> updateParents = std::nullopt, std::optional<bool> updateChildren = std::nullopt);
 
+        // Uses the world transform of source as the local transform, which updateMatrixWorld follows as source moves.
+        // The source must outlive this object.
+        void followMatrixWorld(const Object3D& source);
+
         static std::shared_ptr<Object3D> create() {
 
             return std::make_shared<Object3D>();
@@ -259,7 +274,18 @@ namespace threepp {
     private:
         inline static unsigned int _object3Did{0};
 
+        // position, quaternion and scale the local transform was last composed from
+        std::array<float, 10> composedFrom_;
+
+        unsigned int matrixWorldVersion_{0};
+
+        // object whose world transform is the local transform, and its version when last followed
+        const Object3D* matrixSource_{nullptr};
+        unsigned int matrixSourceVersion_{0};
+
         std::vector<std::shared_ptr<Object3D>> children_;
+
+        friend class TransformHierarchy;
     };
 
 }// namespace threepp
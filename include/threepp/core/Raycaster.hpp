@@ -17,6 +17,10 @@ namespace threepp {
     class Camera;
     class Object3D;
 
+    namespace utils {
+        class ThreadPool;
+    }
+
     struct Intersection {
 
         float distance;
@@ -48,6 +52,9 @@ namespace threepp {
         };
         Params params;
 
+        // Number of rays handed to a worker at a time by the batched intersectObjects.
+        size_t batchSize = 64;
+
         explicit Raycaster(const Vector3& origin = Vector3(), const Vector3& direction = Vector3(), float near = 0, float far = std::numeric_limits<float>::infinity())
             : near(near), far(far), ray(origin, direction), camera(nullptr) {}
 
@@ -58,6 +65,11 @@ namespace threepp {
         std::vector<Intersection> intersectObject(Object3D& object, bool recursive = false);
 
         std::vector<Intersection> intersectObjects(const std::vector<Object3D*>& objects, bool recursive = false);
+
+        // Intersects each of the rays with the objects and returns the sorted intersections per ray.
+        // The rays are distributed over the pool, or over a temporary pool using all cores if none is given.
+        // The objects must not be modified while this call is in progress.
+        std::vector<std::vector<Intersection>> intersectObjects(const std::vector<Ray>& rays, const std::vector<Object3D*>& objects, bool recursive = false, utils::ThreadPool* pool = nullptr);
     };
 
 }// namespace threepp
@@ -0,0 +1,101 @@
+
+#ifndef THREEPP_TRANSFORMHIERARCHY_HPP
+#define THREEPP_TRANSFORMHIERARCHY_HPP
+
+#include "threepp/core/EventDispatcher.hpp"
+#include "threepp/math/Matrix4.hpp"
+
+#include <array>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+namespace threepp {
+
+    class Object3D;
+
+    // Flattened transform hierarchy for large scene graphs whose structure rarely changes.
+    // The local and world matrices of the objects below root are stored contiguously in topological order,
+    // and the objects' matrix and matrixWorld point into this storage.
+    // update() then replaces root.updateMatrixWorld() with a single linear sweep over the arrays,
+    // which still reads the position, quaternion and scale of each object, as Object3D owns them.
+    // This makes it a modest gain over updateMatrixWorld on 100k objects, not an order of magnitude:
+    // about 1.4x when few objects move, and on par when all of them do.
+    //
+    // Adding or removing objects below root is picked up on the next update, which then re-flattens the hierarchy,
+    // so frequent structural changes eat the gain. Call rebuild after sharing the matrices of an object with another one.
+    // Disable Scene::autoUpdate when updating a scene through a hierarchy, as the renderer would otherwise update it a second time.
+    // Objects that customize updateMatrixWorld (other than cameras), or whose matrices are shared with other objects
+    // (e.g. a light and its helper), keep their own matrices and are updated through updateMatrixWorld, together with their descendants.
+    // The hierarchy must not outlive root.
+    class TransformHierarchy {
+
+    public:
+        explicit TransformHierarchy(Object3D& root);
+
+        TransformHierarchy(const TransformHierarchy&) = delete;
+        TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+
+        // Re-flattens the hierarchy below root.
+        void rebuild();
+
+        // Equivalent to root.updateMatrixWorld(force).
+        void update(bool force = false);
+
+        // Number of objects stored in the flattened arrays, as of the last update or rebuild.
+        [[nodiscard]] size_t size() const;
+
+        ~TransformHierarchy();
+
+    private:
+        struct Storage {
+
+            std::vector<Matrix4> matrices;
+            std::vector<Matrix4> matricesWorld;
+        };
+
+        struct StructureListener: EventListener {
+
+            explicit StructureListener(TransformHierarchy* scope): scope_(scope) {}
+
+            void onEvent(Event& event) override;
+
+        private:
+            TransformHierarchy* scope_;
+        };
+
+        Object3D& root_;
+
+        // the flattened objects are watched for being removed or given children, which requires a rebuild
+        StructureListener onStructureChanged_{this};
+        std::unordered_set<Object3D*> watched_;
+        bool dirty_ = false;
+
+        std::vector<Object3D*> objects_;
+        std::vector<int> parents_;
+
+        enum class Kind: unsigned char {
+            Plain,
+            Camera,
+            // updated through its own updateMatrixWorld, along with its descendants
+            Custom
+        };
+
+        std::vector<Kind> kinds_;
+        // position, quaternion and scale each local matrix was last composed from
+        std::vector<std::array<float, 10>> composedFrom_;
+        std::vector<unsigned char> changed_;
+
+        std::shared_ptr<Storage> storage_;
+
+        void flatten(Object3D& object, int parent);
+
+        void watch(Object3D& object);
+
+        // stops watching object and its descendants, which may be destroyed once removed
+        void unwatch(Object3D& object);
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_TRANSFORMHIERARCHY_HPP
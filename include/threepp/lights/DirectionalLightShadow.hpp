@@ -12,14 +12,53 @@ namespace threepp {
     class DirectionalLightShadow: public LightShadow {
 
     public:
-        static std::shared_ptr<DirectionalLightShadow> create() {
+        static constexpr unsigned int maxCascades = 4;
 
-            return std::shared_ptr<DirectionalLightShadow>(new DirectionalLightShadow());
-        }
+        // The number of cascades the view frustum is split into, at most maxCascades.
+        // With more than one cascade the left, right, top and bottom of camera are fitted to
+        // each split of the view frustum, and the cascades are laid out side by side in the map.
+        unsigned int cascades = 1;
+
+        // Blends the split distances between uniform (0) and logarithmic (1).
+        float cascadeSplitLambda = 0.5f;
+
+        // The view distance covered by the cascades, or the far plane of the view camera if 0.
+        float cascadeDistance = 0;
+
+        [[nodiscard]] unsigned int getCascadeCount() const;
+
+        // View depths at which the cascades after the first start, and where the last one ends.
+        [[nodiscard]] const Vector3& getCascadeSplits() const;
+
+        [[nodiscard]] float getCascadeFar() const;
+
+        // Column i maps shadow coordinates of cascade 0, as given by matrix, to the coordinates of cascade i
+        // in the map, as (scale.x, scale.y, offset.x, offset.y).
+        Matrix4& getCascadeTransforms();
+
+        // Splits the frustum of camera and fits a cascade to each split. The bounds are snapped to
+        // whole texels, so that the cascades do not shimmer as the view camera moves.
+        void updateCascades(Light* light, const Camera& camera);
+
+        using LightShadow::updateMatrices;
+
+        void updateMatrices(Light* light, size_t cascade);
+
+        static std::shared_ptr<DirectionalLightShadow> create();
 
     protected:
-        DirectionalLightShadow()
-            : LightShadow(OrthographicCamera::create(-5, 5, 5, -5, 0.5f, 500)) {}
+        struct Bounds {
+
+            float left, right, top, bottom;
+        };
+
+        std::vector<Bounds> _cascadeBounds;
+        Vector3 _cascadeSplits;
+        float _cascadeFar = 0;
+        Matrix4 _cascadeTransforms;
+        Matrix4 _cascadeMatrix;
+
+        DirectionalLightShadow();
     };
 
 }// namespace threepp
@@ -23,8 +23,8 @@ namespace threepp {
             std::vector<Image> images;
             for (const auto& path : paths) {
                 isJPEG = checkIsJPEG(path.string());
-                const auto load = loader.load(path, isJPEG ? 3 : 4, false);
-                images.emplace_back(*load);
+                auto load = loader.load(path, isJPEG ? 3 : 4, false);
+                images.emplace_back(std::move(*load));
             }
 
             auto texture = CubeTexture::create(images);
@@ -0,0 +1,26 @@
+// https://github.com/mrdoob/three.js/blob/r129/examples/jsm/loaders/DDSLoader.js
+
+#ifndef THREEPP_DDSLOADER_HPP
+#define THREEPP_DDSLOADER_HPP
+
+#include "threepp/textures/CompressedTexture.hpp"
+
+#include <filesystem>
+#include <vector>
+
+namespace threepp {
+
+    // Loads 2D textures compressed as BC1 (DXT1), BC2 (DXT3), BC3 (DXT5), BC5 or BC7 from DDS files, along with their mipmaps.
+    // Blocks are uploaded as stored, top row first, so the images are not flipped like those of TextureLoader.
+    class DDSLoader {
+
+    public:
+        // Returns nullptr if the file can not be read, or holds a format or texture type that is not supported.
+        [[nodiscard]] std::shared_ptr<CompressedTexture> load(const std::filesystem::path& path) const;
+
+        [[nodiscard]] std::shared_ptr<CompressedTexture> parse(const std::vector<unsigned char>& data) const;
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_DDSLOADER_HPP
@@ -14,6 +14,12 @@ namespace threepp {
     public:
         std::optional<Image> load(const std::filesystem::path& imagePath, int channels = 4, bool flipY = true);
         std::optional<Image> load(const std::vector<unsigned char>& data, int channels = 4, bool flipY = true);
+
+        // Memory-maps a file of uncompressed pixels, unsigned char or float, without copying them.
+        // The rows are used as stored, so flipped tells whether they are stored bottom to top, as OpenGL expects.
+        // The mapping is read-only, so the pixels are copied the first time they are written to.
+        template<class T = unsigned char>
+        std::optional<Image> loadRaw(const std::filesystem::path& path, unsigned int width, unsigned int height, unsigned int channels = 4, bool flipped = true);
     };
 
 }// namespace threepp
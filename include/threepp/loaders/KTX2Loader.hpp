@@ -0,0 +1,25 @@
+#ifndef THREEPP_KTX2LOADER_HPP
+#define THREEPP_KTX2LOADER_HPP
+
+#include "threepp/textures/CompressedTexture.hpp"
+
+#include <filesystem>
+#include <vector>
+
+namespace threepp {
+
+    // Loads 2D textures compressed as BC1, BC2, BC3, BC5, BC7 or ETC2 from KTX2 files, along with their mipmaps.
+    // Supercompressed files, e.g. Basis Universal, are not supported, as they need transcoding. sRGB formats set
+    // the encoding of the texture. Blocks are uploaded as stored, so the images are not flipped like those of TextureLoader.
+    class KTX2Loader {
+
+    public:
+        // Returns nullptr if the file can not be read, or holds a format or texture type that is not supported.
+        [[nodiscard]] std::shared_ptr<CompressedTexture> load(const std::filesystem::path& path) const;
+
+        [[nodiscard]] std::shared_ptr<CompressedTexture> parse(const std::vector<unsigned char>& data) const;
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_KTX2LOADER_HPP
@@ -15,6 +15,8 @@ namespace threepp {
 
     public:
         bool useCache = true;
+        // number of threads used to parse files larger than 1MB, 0 uses the hardware concurrency
+        unsigned int threadCount = 0;
 
         OBJLoader();
 
@@ -1,4 +1,3 @@
-
 #ifndef THREEPP_STLLOADER_HPP
 #define THREEPP_STLLOADER_HPP
 
@@ -8,9 +7,17 @@
 
 namespace threepp {
 
+    // Loads binary and ASCII STL files.
     class STLLoader {
 
     public:
+        // Merge vertices sharing the same position into an indexed geometry.
+        // Merged geometries get smooth vertex normals, rather than the face normals stored in the file.
+        bool mergeVertices = false;
+
+        // Number of threads used for parsing. 0 uses all hardware threads.
+        unsigned int threadCount = 0;
+
         [[nodiscard]] std::shared_ptr<BufferGeometry> load(const std::filesystem::path& path) const;
     };
 
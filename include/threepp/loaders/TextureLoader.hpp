@@ -5,6 +5,7 @@
 #include "threepp/textures/Texture.hpp"
 
 #include <filesystem>
+#include <functional>
 #include <memory>
 
 namespace threepp {
@@ -12,12 +13,30 @@ namespace threepp {
     class TextureLoader {
 
     public:
+        // Build the mipmaps of loaded textures on the CPU, on the worker threads for loadAsync,
+        // rather than generating them with GL on upload.
+        bool generateMipmaps = false;
+
         explicit TextureLoader(bool useCache = true);
 
         std::shared_ptr<Texture> load(const std::filesystem::path& path, bool flipY = true);
 
         std::shared_ptr<Texture> loadFromMemory(const std::string& name, const std::vector<unsigned char>& data, bool flipY = true);
 
+        // Returns a texture holding a single white texel right away, and decodes the image on a worker thread.
+        // The decoded image is moved into the texture by update, which calls onLoad once it has.
+        std::shared_ptr<Texture> loadAsync(const std::filesystem::path& path, bool flipY = true, const std::function<void(Texture&)>& onLoad = nullptr);
+
+        // Moves the images decoded since the last call into their textures, and returns how many were loaded.
+        // Call from the rendering thread, e.g. once per frame.
+        size_t update();
+
+        // Waits for every image being decoded, and moves them into their textures.
+        size_t wait();
+
+        // The number of textures whose image has not been moved into them yet.
+        [[nodiscard]] size_t pending() const;
+
         void clearCache();
 
         ~TextureLoader();
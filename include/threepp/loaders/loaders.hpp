@@ -2,7 +2,9 @@
 #ifndef THREEPP_LOADERS_HPP
 #define THREEPP_LOADERS_HPP
 
+#include "DDSLoader.hpp"
 #include "FontLoader.hpp"
+#include "KTX2Loader.hpp"
 #include "OBJLoader.hpp"
 #include "STLLoader.hpp"
 #include "TextureLoader.hpp"
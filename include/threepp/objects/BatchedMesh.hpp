@@ -0,0 +1,51 @@
+
+#ifndef THREEPP_BATCHEDMESH_HPP
+#define THREEPP_BATCHEDMESH_HPP
+
+#include "threepp/math/Frustum.hpp"
+#include "threepp/math/Sphere.hpp"
+#include "threepp/objects/Mesh.hpp"
+
+#include <functional>
+
+namespace threepp {
+
+    // A mesh whose geometry is the concatenation of several meshes sharing a material, see StaticBatch.
+    // Every source mesh keeps its own range of the merged geometry,
+    // so that sources can still be hidden and frustum culled individually.
+    class BatchedMesh: public Mesh {
+
+    public:
+        struct Range {
+
+            Object3D* object;
+            // in index units for indexed geometries, vertex units otherwise
+            int start;
+            int count;
+            // bounding sphere of the source in the space of the batch
+            Sphere boundingSphere;
+        };
+
+        BatchedMesh(std::shared_ptr<BufferGeometry> geometry, std::shared_ptr<Material> material, std::vector<Range> ranges, const Object3D* root);
+
+        [[nodiscard]] std::string type() const override;
+
+        [[nodiscard]] const std::vector<Range>& ranges() const;
+
+        // Stops drawing the ranges for which predicate returns true, e.g. of sources that are about to be destroyed.
+        void removeRanges(const std::function<bool(const Range&)>& predicate);
+
+        // Collects the ranges of the sources that are visible, on one of the layers and inside the frustum.
+        // Sources that are no longer below the root are skipped. Adjacent ranges are merged.
+        void computeDrawRanges(const Frustum& frustum, const Layers& layers, std::vector<int>& starts, std::vector<int>& counts) const;
+
+        static std::shared_ptr<BatchedMesh> create(std::shared_ptr<BufferGeometry> geometry, std::shared_ptr<Material> material, std::vector<Range> ranges, const Object3D* root);
+
+    private:
+        std::vector<Range> ranges_;
+        const Object3D* root_;
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_BATCHEDMESH_HPP
@@ -12,7 +12,8 @@ namespace threepp {
     class InstancedMesh: public Mesh {
 
     public:
-        const size_t count;
+        // number of instances drawn, may be lowered below the count the mesh was created with
+        size_t count;
         std::unique_ptr<FloatBufferAttribute> instanceMatrix;
         std::unique_ptr<FloatBufferAttribute> instanceColor = nullptr;
 
@@ -43,7 +44,6 @@ namespace threepp {
         ~InstancedMesh() override;
 
     private:
-        Mesh _mesh;
         bool disposed{false};
 
     };
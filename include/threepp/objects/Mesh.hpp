@@ -36,6 +36,11 @@ namespace threepp {
 
         Material* material() override;
 
+        std::shared_ptr<Material> shared_material() {
+
+            return materials_.empty() ? nullptr : materials_.front();
+        }
+
         [[nodiscard]] std::vector<Material*> materials() override;
 
         void setMaterial(const std::shared_ptr<Material>& material);
@@ -61,6 +66,9 @@ namespace threepp {
     protected:
         std::shared_ptr<BufferGeometry> geometry_;
         std::vector<std::shared_ptr<Material>> materials_;
+
+        // Raycasts the geometry as if it was placed at the given world transform.
+        void raycast(Raycaster& raycaster, const Matrix4& matrixWorld, std::vector<Intersection>& intersects);
     };
 
 }// namespace threepp
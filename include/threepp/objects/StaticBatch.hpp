@@ -0,0 +1,131 @@
+
+#ifndef THREEPP_STATICBATCH_HPP
+#define THREEPP_STATICBATCH_HPP
+
+#include "threepp/objects/BatchedMesh.hpp"
+
+#include <map>
+#include <unordered_set>
+
+namespace threepp {
+
+    // Opt-in static batching of the meshes below this object.
+    // Meshes sharing a material, shadow settings and render order are merged into a single BatchedMesh,
+    // which is drawn instead of the individual meshes. The meshes remain part of the scene graph,
+    // so raycasting, per-object visibility and per-object frustum culling keep working.
+    //
+    // Batches are only rebuilt when objects are added below this object, or when a batched mesh moves relative to it,
+    // or is given another geometry, material, shadow settings or render order. Moving this object moves the batches along.
+    // Exclude meshes that move often with setDynamic. Call invalidate after modifying the contents of a geometry,
+    // or making an unbatched mesh batchable, which are not tracked.
+    // Meshes removed from below this object stop being drawn right away, and their batches are rebuilt on the next update.
+    // Transparent, instanced, skinned, morphed and multi-material meshes are never batched.
+    class StaticBatch: public Object3D {
+
+    public:
+        StaticBatch();
+
+        [[nodiscard]] std::string type() const override;
+
+        // Dynamic meshes are drawn individually.
+        void setDynamic(Object3D& object, bool dynamic = true);
+
+        [[nodiscard]] bool isDynamic(const Object3D& object) const;
+
+        // Whether the object is drawn as part of one of the batches.
+        [[nodiscard]] bool isBatched(const Object3D& object) const;
+
+        [[nodiscard]] const std::vector<std::shared_ptr<BatchedMesh>>& batches() const;
+
+        // Rebuilds the batches whose meshes have changed since the last update.
+        // Called by updateMatrixWorld.
+        void update();
+
+        // Rebuilds all batches on the next update.
+        void invalidate();
+
+        void updateMatrixWorld(bool force = false) override;
+
+        static std::shared_ptr<StaticBatch> create();
+
+        ~StaticBatch() override;
+
+    private:
+        struct Source {
+
+            unsigned int id;
+            Mesh* mesh;
+            BufferGeometry* geometry;
+            Material* material;
+            bool castShadow;
+            bool receiveShadow;
+            unsigned int renderOrder;
+            // the transform relative to the batch, and the world transform version it was last checked against
+            Matrix4 relative;
+            unsigned int matrixWorldVersion;
+
+            bool operator==(const Source& other) const;
+        };
+
+        struct Batch {
+
+            std::vector<Source> sources;
+            std::shared_ptr<BatchedMesh> mesh;
+        };
+
+        struct RemovedListener: EventListener {
+
+            explicit RemovedListener(StaticBatch* scope): scope_(scope) {}
+
+            void onEvent(Event& event) override;
+
+        private:
+            StaticBatch* scope_;
+        };
+
+        struct AddedListener: EventListener {
+
+            explicit AddedListener(StaticBatch* scope): scope_(scope) {}
+
+            void onEvent(Event&) override;
+
+        private:
+            StaticBatch* scope_;
+        };
+
+        bool invalidated_ = true;
+        // objects have been added below this object, or marked dynamic
+        bool changed_ = false;
+
+        std::vector<Source> sources_;
+        std::vector<Source> collected_;
+
+        std::map<std::string, Batch> batchMap_;
+        std::vector<std::shared_ptr<BatchedMesh>> batches_;
+
+        // by id, as objects may be destroyed while they are listed
+        std::unordered_set<unsigned int> batched_;
+        std::unordered_set<unsigned int> dynamic_;
+
+        // objects below this one, which the batches refer to, are watched for being removed or given children
+        RemovedListener onRemoved_{this};
+        AddedListener onAdded_{this};
+        std::vector<Object3D*> visited_;
+        std::vector<Object3D*> watched_;
+
+        void collect(Object3D& object);
+
+        // whether a batched mesh has moved or changed since the batches were built
+        [[nodiscard]] bool sourcesChanged();
+
+        void watch();
+
+        // drops everything that is no longer below this object
+        void purge();
+
+        [[nodiscard]] std::shared_ptr<BatchedMesh> build(const std::vector<Source>& sources);
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_STATICBATCH_HPP
@@ -36,6 +36,8 @@ namespace threepp {
             std::shared_ptr<DepthTexture> depthTexture;
         };
 
+        const unsigned int id = renderTargetId++;
+
         const std::string uuid;
 
         unsigned int width;
@@ -72,6 +74,8 @@ namespace threepp {
     protected:
         bool disposed = false;
 
+    private:
+        inline static unsigned int renderTargetId = 0;
     };
 
 }// namespace threepp
@@ -17,6 +17,7 @@
 #include "threepp/renderers/gl/GLShadowMap.hpp"
 #include "threepp/renderers/gl/GLState.hpp"
 
+#include <filesystem>
 #include <memory>
 #include <vector>
 
@@ -51,6 +52,39 @@ namespace threepp {
 
         bool sortObjects = true;
 
+        // Cull the scene graph on worker threads. GL calls are still issued from the rendering thread,
+        // and objects are rendered in the same order as with serial culling.
+        bool parallelProjection = false;
+
+        // Draw consecutive opaque or transparent meshes sharing geometry and material with a single instanced draw call.
+        // Meshes using a ShaderMaterial, callbacks, morph targets or multiple materials are drawn individually.
+        // Opaque meshes are then sorted by geometry before depth, so that they can be grouped. Off by default.
+        bool autoInstancing = false;
+
+        // Share the camera and light uniforms between programs through uniform buffer objects,
+        // uploaded once per camera and frame instead of once per program. Set before the first render.
+        bool useUniformBuffers = true;
+
+        // Generate shader source on worker threads and compile programs without waiting for them to link.
+        // Objects are not drawn until their program is ready, which can take a few frames.
+        bool asyncShaderCompilation = false;
+
+        // Directory where linked program binaries are kept, and loaded from instead of compiling the programs again
+        // on later runs. Disabled when empty, or where the driver does not support program binaries.
+        std::filesystem::path programCacheDirectory;
+
+        // The texture data uploaded per call to render at most, in bytes and milliseconds, or no limit if 0,
+        // so that textures streamed in with TextureLoader::loadAsync are spread over several frames.
+        // Textures over the budget keep their previous image, or sample as black, until a later frame.
+        size_t textureUploadBudgetBytes = 0;
+        float textureUploadBudgetMilliseconds = 0;
+
+        // The estimated memory textures loaded from images may take up, in bytes, or no limit if 0.
+        // Over the budget, the textures least recently rendered with are deleted after the frame,
+        // and uploaded again when next used. Textures used in the current frame (see beginFrame),
+        // or written to with copyFramebufferToTexture, are kept.
+        size_t textureMemoryBudgetBytes = 0;
+
         // user-defined clipping
 
         std::vector<Plane> clippingPlanes;
@@ -134,8 +168,17 @@ namespace threepp {
 
         void dispose();
 
+        // Compiles the programs of all materials in the scene ahead of rendering it.
+        // Shader source is generated in parallel, and with asyncShaderCompilation this returns without waiting for any program.
+        void compile(Object3D& scene, Camera& camera);
+
         void render(Object3D& scene, Camera& camera);
 
+        // Starts a frame made of one or more calls to render, e.g. a scene and a HUD drawn over it,
+        // so that textures used in any of them are kept within textureMemoryBudgetBytes.
+        // Until this is first called, each call to render is a frame of its own.
+        void beginFrame();
+
         void renderBufferDirect(Camera* camera, Scene* scene, BufferGeometry* geometry, Material* material, Object3D* object, std::optional<GeometryGroup> group);
 
         [[nodiscard]] int getActiveCubeFace() const;
@@ -13,9 +13,11 @@ namespace threepp::gl {
 
         size_t geometries{0};
         size_t textures{0};
+        // estimated memory taken by the textures uploaded from images
+        size_t textureBytes{0};
 
         friend std::ostream& operator<<(std::ostream& os, const MemoryInfo& m) {
-            os << "MemoryInfo: geomestries=" << m.geometries << ", textures=" << m.textures;
+            os << "MemoryInfo: geomestries=" << m.geometries << ", textures=" << m.textures << ", textureBytes=" << m.textureBytes;
             return os;
         }
     };
@@ -27,9 +29,72 @@ namespace threepp::gl {
         size_t triangles{0};
         size_t points{0};
         size_t lines{0};
+        // world matrices recomputed when updating the scene graph
+        size_t matrices{0};
 
         friend std::ostream& operator<<(std::ostream& os, const RenderInfo& m) {
-            os << "RenderInfo: frame=" << m.frame << ", calls=" << m.calls << ", triangles=" << m.triangles << ", points=" << m.points << ", lines=" << m.lines;
+            os << "RenderInfo: frame=" << m.frame << ", calls=" << m.calls << ", triangles=" << m.triangles << ", points=" << m.points << ", lines=" << m.lines << ", matrices=" << m.matrices;
+            return os;
+        }
+    };
+
+    // textures uploaded by GLTextures, the ones put off to a later frame by the upload budget,
+    // and the ones deleted to stay within the memory budget
+    struct TextureInfo {
+
+        size_t uploads{0};
+        size_t bytes{0};
+        size_t deferred{0};
+        size_t evictions{0};
+        size_t evicted{0};
+
+        friend std::ostream& operator<<(std::ostream& os, const TextureInfo& m) {
+            os << "TextureInfo: uploads=" << m.uploads << ", bytes=" << m.bytes << ", deferred=" << m.deferred << ", evictions=" << m.evictions << ", evicted=" << m.evicted;
+            return os;
+        }
+    };
+
+    // binds issued through GLState, and the redundant ones it dropped
+    struct StateInfo {
+
+        size_t programs{0};
+        size_t textures{0};
+        size_t buffers{0};
+        size_t vertexArrays{0};
+        size_t framebuffers{0};
+        size_t skipped{0};
+
+        friend std::ostream& operator<<(std::ostream& os, const StateInfo& m) {
+            os << "StateInfo: programs=" << m.programs << ", textures=" << m.textures << ", buffers=" << m.buffers << ", vertexArrays=" << m.vertexArrays << ", framebuffers=" << m.framebuffers << ", skipped=" << m.skipped;
+            return os;
+        }
+    };
+
+    // shadow maps of the last frame, drawn in full, restored from the cached static casters with only the
+    // moving ones drawn, or left as they were, and the draw calls issued for them
+    struct ShadowInfo {
+
+        size_t rendered{0};
+        size_t composited{0};
+        size_t skipped{0};
+        size_t calls{0};
+
+        friend std::ostream& operator<<(std::ostream& os, const ShadowInfo& m) {
+            os << "ShadowInfo: rendered=" << m.rendered << ", composited=" << m.composited << ", skipped=" << m.skipped << ", calls=" << m.calls;
+            return os;
+        }
+    };
+
+    // programs loaded from, compiled for or rejected by the program binary cache, since the renderer was created
+    struct ProgramBinaryInfo {
+
+        size_t hits{0};
+        size_t misses{0};
+        size_t rejected{0};
+        size_t stored{0};
+
+        friend std::ostream& operator<<(std::ostream& os, const ProgramBinaryInfo& m) {
+            os << "ProgramBinaryInfo: hits=" << m.hits << ", misses=" << m.misses << ", rejected=" << m.rejected << ", stored=" << m.stored;
             return os;
         }
     };
@@ -38,6 +103,10 @@ namespace threepp::gl {
 
         MemoryInfo memory{};
         RenderInfo render{};
+        StateInfo state{};
+        TextureInfo textures{};
+        ShadowInfo shadows{};
+        ProgramBinaryInfo programBinaries{};
 
         bool autoReset = true;
 
@@ -47,7 +116,11 @@ namespace threepp::gl {
 
         friend std::ostream& operator<<(std::ostream& os, const GLInfo& m) {
             os << m.memory << "\n"
-               << m.render;
+               << m.render << "\n"
+               << m.state << "\n"
+               << m.textures << "\n"
+               << m.shadows << "\n"
+               << m.programBinaries;
             return os;
         }
     };
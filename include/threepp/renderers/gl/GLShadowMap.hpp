@@ -18,6 +18,8 @@ namespace threepp {
     namespace gl {
 
         class GLObjects;
+        struct GLInfo;
+        struct GLProperties;
 
         struct GLShadowMap {
 
@@ -26,9 +28,17 @@ namespace threepp {
             bool autoUpdate = true;
             bool needsUpdate = false;
 
+            // Keeps the depth of shadow casters that have not changed for a while in a map of its own per light,
+            // so that only the casters that change are drawn each frame, and lights whose casters, position and
+            // views are unchanged are not drawn at all. Off by default.
+            // Casters are told apart by the versions of their world matrix, instance matrices, geometry attributes
+            // and materials. Set needsUpdate on a light's shadow to redraw it in full after changes these miss,
+            // e.g. to material properties that do not call Material::needsUpdate.
+            bool cacheStaticCasters = false;
+
             ShadowMap type;
 
-            explicit GLShadowMap(GLObjects& objects);
+            GLShadowMap(GLObjects& objects, GLProperties& properties, GLInfo& info);
 
             void render(GLRenderer& renderer, const std::vector<Light*>& lights, Object3D* scene, Camera* camera);
 
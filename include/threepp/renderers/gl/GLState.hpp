@@ -5,6 +5,7 @@
 
 #include "threepp/constants.hpp"
 #include "threepp/math/Vector4.hpp"
+#include "threepp/renderers/gl/GLInfo.hpp"
 
 #include <functional>
 #include <optional>
@@ -99,6 +100,8 @@ namespace threepp {
             void reset();
         };
 
+        // Caches the bound GL state, so that redundant calls are never issued.
+        // Binds are counted per frame in GLInfo::state.
         struct GLState {
 
             ColorBuffer colorBuffer;
@@ -111,6 +114,9 @@ namespace threepp {
 
             std::optional<int> currentProgram;
 
+            std::unordered_map<int, unsigned int> currentBoundBuffers;
+            std::optional<unsigned int> currentVertexArray;
+
             bool currentBlendingEnabled = false;
             std::optional<Blending> currentBlending;
             std::optional<BlendEquation> currentBlendEquation;
@@ -142,7 +148,7 @@ namespace threepp {
             Vector4 currentScissor;
             Vector4 currentViewport;
 
-            GLState();
+            explicit GLState(GLInfo& info);
 
             void enable(int id);
 
@@ -152,6 +158,21 @@ namespace threepp {
 
             bool useProgram(unsigned int program);
 
+            // the element array binding belongs to the bound vertex array, so it is never skipped
+            bool bindBuffer(int target, unsigned int buffer);
+
+            bool bindVertexArray(unsigned int vertexArray);
+
+            // deleting an object unbinds it, and frees its name for reuse
+
+            void deleteBuffer(unsigned int buffer);
+
+            void deleteVertexArray(unsigned int vertexArray);
+
+            void deleteTexture(unsigned int texture);
+
+            void deleteFramebuffer(unsigned int framebuffer);
+
             void setBlending(
                     Blending blending,
                     std::optional<BlendEquation> blendEquation = std::nullopt,
@@ -187,6 +208,8 @@ namespace threepp {
 
             void texImage3D(unsigned int target, int level, int internalFormat, int width, int height, int depth, unsigned int format, unsigned int type, const void* pixels);
 
+            void compressedTexImage2D(unsigned int target, int level, unsigned int internalFormat, int width, int height, int imageSize, const void* data);
+
             //
 
             void scissor(const Vector4& scissor);
@@ -196,6 +219,9 @@ namespace threepp {
             //
 
             void reset(int width, int height);
+
+        private:
+            GLInfo& info;
         };
 
     }// namespace gl
@@ -3,6 +3,7 @@
 #ifndef THREEPP_SHADERCHUNK_HPP
 #define THREEPP_SHADERCHUNK_HPP
 
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -542,6 +543,10 @@ namespace threepp::shaders {
             return data_.at(key);
         }
 
+        // The chunk with its #include directives expanded, recursively.
+        // Expanded chunks are cached, and this may be called from any thread.
+        const std::string& resolved(const std::string& key);
+
         static ShaderChunk& instance() {
             static ShaderChunk instance;
             return instance;
@@ -550,6 +555,9 @@ namespace threepp::shaders {
     private:
         std::unordered_map<std::string, std::string> data_;
 
+        std::mutex resolvedMutex_;
+        std::unordered_map<std::string, std::string> resolved_;
+
         ShaderChunk();
 
         ~ShaderChunk() = default;
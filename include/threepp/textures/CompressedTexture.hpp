@@ -0,0 +1,40 @@
+// https://github.com/mrdoob/three.js/blob/r129/src/textures/CompressedTexture.js
+
+#ifndef THREEPP_COMPRESSEDTEXTURE_HPP
+#define THREEPP_COMPRESSEDTEXTURE_HPP
+
+#include "threepp/textures/Texture.hpp"
+
+namespace threepp {
+
+    // A texture in a compressed format, uploaded as is with the mipmaps it is given, since GL can not
+    // generate mipmaps for compressed formats. The image holds the size of the texture, but no data.
+    class CompressedTexture: public Texture {
+
+    public:
+        static std::shared_ptr<CompressedTexture> create(
+                std::vector<Image> mipmaps,
+                unsigned int width, unsigned int height,
+                Format format) {
+            return std::shared_ptr<CompressedTexture>(new CompressedTexture(std::move(mipmaps), width, height, format));
+        }
+
+    private:
+        CompressedTexture(std::vector<Image> mipmaps, unsigned int width, unsigned int height, Format format)
+            : Texture({}) {
+
+            this->image.emplace_back(std::vector<unsigned char>{}, width, height, false);
+            this->mipmaps = std::move(mipmaps);
+            this->format = format;
+
+            this->generateMipmaps = false;
+
+            if (this->mipmaps.size() <= 1) this->minFilter = Filter::Linear;
+
+            this->needsUpdate();
+        }
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_COMPRESSEDTEXTURE_HPP
@@ -9,22 +9,27 @@ namespace threepp {
     class DataTexture: public Texture {
 
     public:
-        void setData(const ImageData& data) {
+        void setData(ImageData data) {
 
-            image.front().setData(data);
+            image.front().setData(std::move(data));
         }
 
         static std::shared_ptr<DataTexture> create(
-                const ImageData& data,
+                ImageData data,
                 unsigned int width = 1, unsigned int height = 1) {
-            return std::shared_ptr<DataTexture>(new DataTexture(data, width, height));
+            return create(Image{std::move(data), width, height});
+        }
+
+        // Uses the storage of image, which may be shared with, or borrowed from, the caller.
+        static std::shared_ptr<DataTexture> create(Image image) {
+            return std::shared_ptr<DataTexture>(new DataTexture(std::move(image)));
         }
 
     private:
-        explicit DataTexture(const ImageData& data, unsigned int width, unsigned int height)
+        explicit DataTexture(Image image)
             : Texture({}) {
 
-            this->image.emplace_back(data, width, height);
+            this->image.emplace_back(std::move(image));
 
             this->magFilter = Filter::Nearest;
             this->minFilter = Filter::Nearest;
@@ -2,7 +2,9 @@
 #ifndef THREEPP_IMAGE_HPP
 #define THREEPP_IMAGE_HPP
 
+#include <algorithm>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -11,6 +13,76 @@ namespace threepp {
 
     typedef std::variant<std::vector<unsigned char>, std::vector<float>> ImageData;
 
+    // A view of the pixels of an Image.
+    template<class T>
+    class PixelView {
+
+    public:
+        PixelView(T* data, size_t size)
+            : data_(data), size_(size) {}
+
+        [[nodiscard]] T* data() const {
+
+            return data_;
+        }
+
+        [[nodiscard]] size_t size() const {
+
+            return size_;
+        }
+
+        [[nodiscard]] bool empty() const {
+
+            return size_ == 0;
+        }
+
+        [[nodiscard]] T* begin() const {
+
+            return data_;
+        }
+
+        [[nodiscard]] T* end() const {
+
+            return data_ + size_;
+        }
+
+        [[nodiscard]] T& front() const {
+
+            return data_[0];
+        }
+
+        [[nodiscard]] T& back() const {
+
+            return data_[size_ - 1];
+        }
+
+        T& operator[](size_t index) const {
+
+            return data_[index];
+        }
+
+        friend bool operator==(const PixelView& lhs, const PixelView& rhs) {
+
+            return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+        friend bool operator==(const PixelView& lhs, const std::vector<std::remove_const_t<T>>& rhs) {
+
+            return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+    private:
+        T* data_;
+        size_t size_;
+    };
+
+    // Pixels of 8 bit or float channels, which are shared between copies of the image rather than copied.
+    // The storage is either owned by the image, shared with a caller through a shared_ptr
+    // (which may alias any owner, e.g. a decoder buffer or a memory-mapped file), or borrowed from the caller.
+    //
+    // Pixels are copied on write: the non-const data() first copies pixels that are shared with another image,
+    // or read-only, so that writes never show through other images. Borrowed pixels are written in place.
+    // data() returns a PixelView rather than the std::vector<T>& of earlier versions; use the const overload to read.
     class Image {
 
     public:
@@ -19,10 +91,39 @@ namespace threepp {
         unsigned int depth;
 
         Image(ImageData data, unsigned int width, unsigned int height, bool flipped = true)
-            : data_(std::move(data)), width(width), height(height), depth(0), flipped_(flipped){};
+            : width(width), height(height), depth(0), flipped_(flipped) {
+
+            setData(std::move(data));
+        }
 
         Image(ImageData data, unsigned int width, unsigned int height, unsigned int depth, bool flipped = true)
-            : data_(std::move(data)), width(width), height(height), depth(depth), flipped_(flipped){};
+            : width(width), height(height), depth(depth), flipped_(flipped) {
+
+            setData(std::move(data));
+        }
+
+        // Shares size elements at pixels, kept alive by pixels.
+        template<class T>
+        Image(std::shared_ptr<T> pixels, size_t size, unsigned int width, unsigned int height, bool flipped = true)
+            : width(width), height(height), depth(0), flipped_(flipped) {
+
+            setData(std::move(pixels), size);
+        }
+
+        // Shares size read-only elements at pixels, which are copied before they are written to.
+        template<class T>
+        Image(std::shared_ptr<const T> pixels, size_t size, unsigned int width, unsigned int height, bool flipped = true)
+            : width(width), height(height), depth(0), flipped_(flipped) {
+
+            setData(std::move(pixels), size);
+        }
+
+        // Views size elements at pixels, owned by the caller, which must outlive the image and its copies.
+        template<class T>
+        static Image borrow(T* pixels, size_t size, unsigned int width, unsigned int height, bool flipped = true) {
+
+            return {std::shared_ptr<T>(std::shared_ptr<void>(), pixels), size, width, height, flipped};
+        }
 
         [[nodiscard]] bool flipped() const {
 
@@ -31,18 +132,84 @@ namespace threepp {
 
         void setData(ImageData data) {
 
-            data_ = std::move(data);
+            std::visit([this](auto& data) { own(std::move(data)); }, data);
+        }
+
+        template<class T>
+        void setData(std::shared_ptr<T> pixels, size_t size) {
+
+            static_assert(std::is_same_v<T, unsigned char> || std::is_same_v<T, float>, "Pixels are either unsigned char or float");
+
+            pixels_ = std::move(pixels);
+            size_ = size;
+            float_ = std::is_same_v<T, float>;
+            readOnly_ = false;
+        }
+
+        template<class T>
+        void setData(std::shared_ptr<const T> pixels, size_t size) {
+
+            setData(std::const_pointer_cast<T>(std::move(pixels)), size);
+            readOnly_ = true;
         }
 
+        // Copies the pixels first if they are shared with another image or read-only.
         template<class T = unsigned char>
-        [[nodiscard]] std::vector<T>& data() {
+        [[nodiscard]] PixelView<T> data() {
+
+            const auto first = static_cast<const T*>(pixels(std::is_same_v<T, float>));
+
+            if (readOnly_ || shared()) {
 
-            return std::get<std::vector<T>>(data_);
+                own(std::vector<T>(first, first + size_));
+            }
+
+            return {static_cast<T*>(pixels_.get()), size_};
+        }
+
+        template<class T = unsigned char>
+        [[nodiscard]] PixelView<const T> data() const {
+
+            return {static_cast<const T*>(pixels(std::is_same_v<T, float>)), size_};
+        }
+
+        template<class T>
+        [[nodiscard]] bool holds() const {
+
+            return float_ == std::is_same_v<T, float>;
+        }
+
+        [[nodiscard]] size_t byteLength() const {
+
+            return size_ * (float_ ? sizeof(float) : sizeof(unsigned char));
+        }
+
+        // Whether other images share the pixels of this one. Borrowed pixels are not counted as shared.
+        [[nodiscard]] bool shared() const {
+
+            return pixels_.use_count() > 1;
         }
 
     private:
         bool flipped_;
-        ImageData data_;
+        std::shared_ptr<void> pixels_;
+        size_t size_{};
+        bool float_{};
+        bool readOnly_{};
+
+        [[nodiscard]] void* pixels(bool floating) const {
+
+            if (floating != float_) throw std::bad_variant_access();
+
+            return pixels_.get();
+        }
+
+        template<class T>
+        void own(std::vector<T> data) {
+
+            auto owner = std::make_shared<std::vector<T>>(std::move(data));
+            setData(std::shared_ptr<T>(owner, owner->data()), owner->size());
+        }
     };
 
 }// namespace threepp
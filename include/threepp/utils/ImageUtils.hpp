@@ -0,0 +1,21 @@
+
+#ifndef THREEPP_IMAGEUTILS_HPP
+#define THREEPP_IMAGEUTILS_HPP
+
+#include "threepp/textures/Texture.hpp"
+
+#include <vector>
+
+namespace threepp {
+
+    // The mip chain of an image with the given number of channels, from the image itself down to 1x1,
+    // each level averaging 2x2 texels of the one above. Odd sizes repeat the last row or column.
+    std::vector<Image> generateMipmaps(Image& image, unsigned int channels);
+
+    // Fills the mipmaps of an uncompressed 8 bit or float texture on the CPU, so that they are uploaded
+    // as they are rather than generated by GL. Does nothing for other textures.
+    void generateMipmaps(Texture& texture);
+
+}// namespace threepp
+
+#endif//THREEPP_IMAGEUTILS_HPP
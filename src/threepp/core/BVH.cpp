@@ -0,0 +1,355 @@
+
+#include "threepp/core/BVH.hpp"
+
+#include "threepp/core/BufferGeometry.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+using namespace threepp;
+
+namespace {
+
+    constexpr int numBins = 16;
+    constexpr int maxDepth = 64;
+    constexpr int stackSize = 128;
+
+    struct Bounds {
+
+        Vector3 min{std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity()};
+        Vector3 max{-std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()};
+
+        void expand(const Vector3& point) {
+            min.min(point);
+            max.max(point);
+        }
+
+        void expand(const Bounds& other) {
+            min.min(other.min);
+            max.max(other.max);
+        }
+
+        [[nodiscard]] float halfArea() const {
+            if (min.x > max.x) return 0;
+
+            const auto dx = max.x - min.x, dy = max.y - min.y, dz = max.z - min.z;
+            return dx * dy + dy * dz + dz * dx;
+        }
+    };
+
+    struct Bin {
+        Bounds bounds;
+        unsigned int count = 0;
+    };
+
+    unsigned int triangleCount(const BufferGeometry& geometry) {
+
+        const auto index = geometry.getIndex();
+        const auto position = geometry.getAttribute<float>("position");
+
+        if (index) return index->count() / 3;
+        if (position) return position->count() / 3;
+
+        return 0;
+    }
+
+    struct TriangleAccessor {
+
+        const IntBufferAttribute* index;
+        const FloatBufferAttribute* position;
+
+        void vertex(unsigned int i, Vector3& target) const {
+
+            const auto v = index ? index->getX(i) : i;
+            target.set(position->getX(v), position->getY(v), position->getZ(v));
+        }
+
+        Bounds bounds(unsigned int triangle) const {
+
+            Bounds b;
+            Vector3 v;
+            for (unsigned int i = 0; i < 3; ++i) {
+                vertex(triangle * 3 + i, v);
+                b.expand(v);
+            }
+
+            return b;
+        }
+    };
+
+    float component(const Vector3& v, int axis) {
+
+        return axis == 0 ? v.x : axis == 1 ? v.y : v.z;
+    }
+
+}// namespace
+
+
+BVH::BVH(const BufferGeometry& geometry, unsigned int maxLeafSize)
+    : maxLeafSize_(std::max(1u, maxLeafSize)) {
+
+    build(geometry);
+}
+
+unsigned int BVH::maxLeafSize() const {
+
+    return maxLeafSize_;
+}
+
+const std::vector<BVH::Node>& BVH::nodes() const {
+
+    return nodes_;
+}
+
+const std::vector<unsigned int>& BVH::triangles() const {
+
+    return triangles_;
+}
+
+bool BVH::isValidFor(const BufferGeometry& geometry) const {
+
+    const auto index = geometry.getIndex();
+
+    // a replaced attribute may reuse the address of the old one, and starts over at version 0
+    return attributesVersion_ == geometry.attributesVersion() &&
+           indexVersion_ == (index ? index->version : 0) &&
+           triangleCount_ == triangleCount(geometry);
+}
+
+bool BVH::needsRefit(const BufferGeometry& geometry) const {
+
+    const auto position = geometry.getAttribute<float>("position");
+
+    return position && position->version != positionVersion_;
+}
+
+void BVH::build(const BufferGeometry& geometry) {
+
+    const auto index = geometry.getIndex();
+    const auto position = geometry.getAttribute<float>("position");
+
+    attributesVersion_ = geometry.attributesVersion();
+    positionVersion_ = position ? position->version : 0;
+    indexVersion_ = index ? index->version : 0;
+    triangleCount_ = triangleCount(geometry);
+
+    nodes_.clear();
+    triangles_.resize(triangleCount_);
+
+    if (triangleCount_ == 0) return;
+
+    TriangleAccessor accessor{index, position};
+
+    std::vector<Bounds> bounds(triangleCount_);
+    std::vector<Vector3> centroids(triangleCount_);
+
+    for (unsigned int i = 0; i < triangleCount_; ++i) {
+
+        triangles_[i] = i;
+        bounds[i] = accessor.bounds(i);
+        centroids[i].copy(bounds[i].min).add(bounds[i].max).multiplyScalar(0.5f);
+    }
+
+    nodes_.reserve(2 * triangleCount_ / maxLeafSize_ + 1);
+
+    struct Builder {
+
+        BVH& bvh;
+        const std::vector<Bounds>& bounds;
+        const std::vector<Vector3>& centroids;
+
+        void makeLeaf(unsigned int nodeIndex, unsigned int begin, unsigned int end) const {
+
+            auto& node = bvh.nodes_[nodeIndex];
+            node.offset = begin;
+            node.count = end - begin;
+        }
+
+        void build(unsigned int begin, unsigned int end, int depth) {
+
+            const auto nodeIndex = static_cast<unsigned int>(bvh.nodes_.size());
+            bvh.nodes_.emplace_back();
+
+            Bounds nodeBounds, centroidBounds;
+            for (auto i = begin; i < end; ++i) {
+                const auto t = bvh.triangles_[i];
+                nodeBounds.expand(bounds[t]);
+                centroidBounds.expand(centroids[t]);
+            }
+
+            bvh.nodes_[nodeIndex].min = nodeBounds.min;
+            bvh.nodes_[nodeIndex].max = nodeBounds.max;
+
+            const auto count = end - begin;
+            if (count <= bvh.maxLeafSize_) {
+                makeLeaf(nodeIndex, begin, end);
+                return;
+            }
+
+            // binned SAH over the centroid bounds
+
+            int bestAxis = -1;
+            int bestBin = 0;
+            float bestCost = std::numeric_limits<float>::infinity();
+
+            for (int axis = 0; axis < 3 && depth < maxDepth; ++axis) {
+
+                const auto cmin = component(centroidBounds.min, axis);
+                const auto extent = component(centroidBounds.max, axis) - cmin;
+                if (extent <= 0) continue;
+
+                std::array<Bin, numBins> bins{};
+                const auto scale = numBins / extent;
+
+                for (auto i = begin; i < end; ++i) {
+                    const auto t = bvh.triangles_[i];
+                    const auto b = std::min(numBins - 1, static_cast<int>((component(centroids[t], axis) - cmin) * scale));
+                    bins[b].bounds.expand(bounds[t]);
+                    ++bins[b].count;
+                }
+
+                std::array<float, numBins - 1> leftCost{};
+                Bounds left;
+                unsigned int leftCount = 0;
+                for (int b = 0; b < numBins - 1; ++b) {
+                    left.expand(bins[b].bounds);
+                    leftCount += bins[b].count;
+                    leftCost[b] = left.halfArea() * static_cast<float>(leftCount);
+                }
+
+                Bounds right;
+                unsigned int rightCount = 0;
+                for (int b = numBins - 1; b > 0; --b) {
+                    right.expand(bins[b].bounds);
+                    rightCount += bins[b].count;
+
+                    const auto cost = leftCost[b - 1] + right.halfArea() * static_cast<float>(rightCount);
+                    if (rightCount > 0 && rightCount < count && cost < bestCost) {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestBin = b;
+                    }
+                }
+            }
+
+            unsigned int mid;
+
+            if (bestAxis != -1) {
+
+                const auto cmin = component(centroidBounds.min, bestAxis);
+                const auto scale = numBins / (component(centroidBounds.max, bestAxis) - cmin);
+
+                auto it = std::partition(bvh.triangles_.begin() + begin, bvh.triangles_.begin() + end, [&](unsigned int t) {
+                    const auto b = std::min(numBins - 1, static_cast<int>((component(centroids[t], bestAxis) - cmin) * scale));
+                    return b < bestBin;
+                });
+                mid = static_cast<unsigned int>(it - bvh.triangles_.begin());
+
+            } else {
+
+                // coincident centroids or a very deep tree, split by count
+                mid = begin + count / 2;
+            }
+
+            if (mid == begin || mid == end) {
+                mid = begin + count / 2;
+            }
+
+            build(begin, mid, depth + 1);
+            bvh.nodes_[nodeIndex].offset = static_cast<unsigned int>(bvh.nodes_.size());
+            bvh.nodes_[nodeIndex].count = 0;
+            build(mid, end, depth + 1);
+        }
+    };
+
+    Builder{*this, bounds, centroids}.build(0, triangleCount_, 0);
+}
+
+void BVH::refit(const BufferGeometry& geometry) {
+
+    const auto index = geometry.getIndex();
+    const auto position = geometry.getAttribute<float>("position");
+
+    positionVersion_ = position ? position->version : 0;
+
+    if (nodes_.empty()) return;
+
+    TriangleAccessor accessor{index, position};
+
+    // children are always stored after their parent
+    for (auto i = static_cast<int>(nodes_.size()) - 1; i >= 0; --i) {
+
+        auto& node = nodes_[i];
+        Bounds b;
+
+        if (node.isLeaf()) {
+
+            for (auto j = node.offset; j < node.offset + node.count; ++j) {
+                b.expand(accessor.bounds(triangles_[j]));
+            }
+
+        } else {
+
+            const auto& left = nodes_[i + 1];
+            const auto& right = nodes_[node.offset];
+            b.min.copy(left.min).min(right.min);
+            b.max.copy(left.max).max(right.max);
+        }
+
+        node.min = b.min;
+        node.max = b.max;
+    }
+}
+
+void BVH::intersectRay(const Ray& ray, std::vector<unsigned int>& candidates) const {
+
+    if (nodes_.empty()) return;
+
+    const auto& origin = ray.origin;
+    const auto& dir = ray.direction;
+    const Vector3 invDir(1.f / dir.x, 1.f / dir.y, 1.f / dir.z);
+
+    // a ray parallel to a slab only hits it from within, as 0 * inf would give NaN on its planes
+    const auto slab = [](float min, float max, float origin, float dir, float invDir, float& tmin, float& tmax) {
+        if (dir == 0) return origin >= min && origin <= max;
+
+        const auto t1 = (min - origin) * invDir;
+        const auto t2 = (max - origin) * invDir;
+        tmin = std::max(tmin, std::min(t1, t2));
+        tmax = std::min(tmax, std::max(t1, t2));
+
+        return true;
+    };
+
+    const auto hit = [&](const Node& node) {
+        float tmin = 0;
+        float tmax = std::numeric_limits<float>::infinity();
+
+        return slab(node.min.x, node.max.x, origin.x, dir.x, invDir.x, tmin, tmax) &&
+               slab(node.min.y, node.max.y, origin.y, dir.y, invDir.y, tmin, tmax) &&
+               slab(node.min.z, node.max.z, origin.z, dir.z, invDir.z, tmin, tmax) &&
+               tmax >= tmin;
+    };
+
+    std::array<unsigned int, stackSize> stack{};
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+
+        const auto& node = nodes_[stack[--top]];
+
+        if (!hit(node)) continue;
+
+        if (node.isLeaf()) {
+
+            candidates.insert(candidates.end(), triangles_.begin() + node.offset, triangles_.begin() + node.offset + node.count);
+
+        } else {
+
+            stack[top++] = node.offset;
+            stack[top++] = static_cast<unsigned int>(&node - nodes_.data()) + 1;
+        }
+    }
+}
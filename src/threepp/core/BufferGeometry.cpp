@@ -4,15 +4,241 @@
 #include "threepp/math/MathUtils.hpp"
 #include "threepp/math/Matrix3.hpp"
 #include "threepp/math/Matrix4.hpp"
+#include "threepp/utils/ThreadPool.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 using namespace threepp;
 
 namespace {
 
+    // geometries with fewer triangles are processed on the calling thread, unless a thread count is given
+    constexpr size_t minParallelTriangles = 1 << 16;
+
+    unsigned int resolveThreadCount(unsigned int threadCount, size_t triangles) {
+
+        if (threadCount == 0) {
+
+            if (triangles < minParallelTriangles) return 1;
+            threadCount = std::thread::hardware_concurrency();
+        }
+
+        return static_cast<unsigned int>(std::clamp<size_t>(threadCount, 1, std::max<size_t>(1, triangles)));
+    }
+
+    // started on first use and shared by all geometries, so that threads are not started for every call
+    utils::ThreadPool& sharedPool() {
+
+        static utils::ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()));
+
+        return pool;
+    }
+
+    // splits ranges of work between threads, or runs them on the calling thread when there is one
+    class Workers {
+
+    public:
+        explicit Workers(unsigned int count): count_(count) {}
+
+        [[nodiscard]] unsigned int count() const {
+
+            return count_;
+        }
+
+        // calls f(worker, first, last) for one range of [0, size) per worker, in order.
+        // The first range is done on the calling thread, which then waits for the others only,
+        // as the shared pool may be running the work of other calls as well
+        template<class F>
+        void forEach(size_t size, const F& f) {
+
+            if (count_ <= 1) {
+
+                f(0u, size_t{0}, size);
+                return;
+            }
+
+            const auto perWorker = (size + count_ - 1) / count_;
+
+            std::mutex mutex;
+            std::condition_variable finished;
+            auto pending = count_ - 1;
+
+            auto& pool = sharedPool();
+            for (unsigned int worker = 1; worker < count_; ++worker) {
+
+                const auto first = std::min(size, worker * perWorker);
+                const auto last = std::min(size, first + perWorker);
+                pool.submit([&, worker, first, last] {
+                    f(worker, first, last);
+
+                    // notified under the lock, so that the waiting thread can not return and destroy it first
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (--pending == 0) finished.notify_one();
+                });
+            }
+
+            f(0u, size_t{0}, std::min(size, perWorker));
+
+            std::unique_lock<std::mutex> lock(mutex);
+            finished.wait(lock, [&] { return pending == 0; });
+        }
+
+    private:
+        unsigned int count_;
+    };
+
+    // Calls compute(triangle, value) for every triangle, and add(vertex, value) for each of its three vertices.
+    // With more than one worker, each owns a range of the vertices and a range of the triangles. Values are added
+    // to the vertices a worker owns as it goes, and to the others once all triangles are computed, so that no two
+    // threads add to the same vertex. For indices with some locality, as most meshes have, few are put off.
+    template<size_t N, class Compute, class Add>
+    void scatter(Workers& workers, const unsigned int* indices, size_t triangles, size_t vertices, const Compute& compute, const Add& add) {
+
+        const auto count = workers.count();
+
+        if (count <= 1) {
+
+            float value[N];
+            for (size_t triangle = 0; triangle < triangles; ++triangle) {
+
+                compute(triangle, value);
+
+                add(indices[triangle * 3], value);
+                add(indices[triangle * 3 + 1], value);
+                add(indices[triangle * 3 + 2], value);
+            }
+
+            return;
+        }
+
+        const auto verticesPerWorker = std::max<size_t>(1, (vertices + count - 1) / count);
+
+        // the corners put off by each worker, by the worker owning their vertex
+        std::vector<std::vector<std::vector<unsigned int>>> deferred(count, std::vector<std::vector<unsigned int>>(count));
+
+        workers.forEach(triangles, [&](unsigned int worker, size_t first, size_t last) {
+            float value[N];
+            auto& bucket = deferred[worker];
+
+            const auto firstOwned = worker * verticesPerWorker;
+            const auto ownedCount = worker + 1 == count ? vertices - std::min(vertices, firstOwned) : verticesPerWorker;
+
+            for (auto triangle = first; triangle < last; ++triangle) {
+
+                compute(triangle, value);
+
+                for (auto corner = triangle * 3; corner < triangle * 3 + 3; ++corner) {
+
+                    const auto vertex = indices[corner];
+
+                    if (vertex - firstOwned < ownedCount) {
+
+                        add(vertex, value);
+
+                    } else {
+
+                        const auto owner = std::min<size_t>(vertex / verticesPerWorker, count - 1);
+                        bucket[owner].push_back(static_cast<unsigned int>(corner));
+                    }
+                }
+            }
+        });
+
+        workers.forEach(count, [&](unsigned int, size_t first, size_t last) {
+            float value[N];
+
+            for (auto owner = first; owner < last; ++owner) {
+
+                for (const auto& bucket : deferred) {
+
+                    for (auto corner : bucket[owner]) {
+
+                        compute(corner / 3, value);
+                        add(indices[corner], value);
+                    }
+                }
+            }
+        });
+    }
+
+    // (c - b) x (a - b), for the vertices a, b and c of a triangle
+    void faceNormal(const float* positions, const unsigned int* triangle, float* normal) {
+
+        const auto a = positions + triangle[0] * 3;
+        const auto b = positions + triangle[1] * 3;
+        const auto c = positions + triangle[2] * 3;
+
+        const float cbx = c[0] - b[0], cby = c[1] - b[1], cbz = c[2] - b[2];
+        const float abx = a[0] - b[0], aby = a[1] - b[1], abz = a[2] - b[2];
+
+        normal[0] = cby * abz - cbz * aby;
+        normal[1] = cbz * abx - cbx * abz;
+        normal[2] = cbx * aby - cby * abx;
+    }
+
+    // the directions of increasing u and v over a triangle, or zero for degenerate uvs
+    void faceTangents(const float* positions, const float* uvs, const unsigned int* triangle, float* sdir, float* tdir) {
+
+        const auto a = positions + triangle[0] * 3;
+        const auto b = positions + triangle[1] * 3;
+        const auto c = positions + triangle[2] * 3;
+
+        const auto uvA = uvs + triangle[0] * 2;
+        const auto uvB = uvs + triangle[1] * 2;
+        const auto uvC = uvs + triangle[2] * 2;
+
+        const float bx = b[0] - a[0], by = b[1] - a[1], bz = b[2] - a[2];
+        const float cx = c[0] - a[0], cy = c[1] - a[1], cz = c[2] - a[2];
+
+        const float ub = uvB[0] - uvA[0], vb = uvB[1] - uvA[1];
+        const float uc = uvC[0] - uvA[0], vc = uvC[1] - uvA[1];
+
+        const float r = 1.f / (ub * vc - uc * vb);
+
+        // coincident or colinear uvs are ignored
+        if (!std::isfinite(r)) {
+
+            std::fill(sdir, sdir + 3, 0.f);
+            std::fill(tdir, tdir + 3, 0.f);
+            return;
+        }
+
+        sdir[0] = (bx * vc - cx * vb) * r;
+        sdir[1] = (by * vc - cy * vb) * r;
+        sdir[2] = (bz * vc - cz * vb) * r;
+
+        tdir[0] = (cx * ub - bx * uc) * r;
+        tdir[1] = (cy * ub - by * uc) * r;
+        tdir[2] = (cz * ub - bz * uc) * r;
+    }
+
+    void add3(float* target, const float* value) {
+
+        target[0] += value[0];
+        target[1] += value[1];
+        target[2] += value[2];
+    }
+
+    // normalizes the vectors [first, last) of xyz, leaving zero vectors as they are
+    void normalize3(float* vectors, size_t first, size_t last) {
+
+        for (auto i = first * 3; i < last * 3; i += 3) {
+
+            const auto length = std::sqrt(vectors[i] * vectors[i] + vectors[i + 1] * vectors[i + 1] + vectors[i + 2] * vectors[i + 2]);
+            const auto divisor = length > 0 ? length : 1.f;
+
+            vectors[i] /= divisor;
+            vectors[i + 1] /= divisor;
+            vectors[i + 2] /= divisor;
+        }
+    }
+
     std::unique_ptr<BufferAttribute> convertBufferAttribute(BufferAttribute& _attribute, const std::vector<unsigned int>& indices) {
 
         if (_attribute.typed<float>()) {
@@ -101,6 +327,7 @@ const std::unordered_map<std::string, std::vector<std::shared_ptr<BufferAttribut
 void BufferGeometry::setAttribute(const std::string& name, std::shared_ptr<BufferAttribute> attribute) {
 
     attributes_[name] = std::move(attribute);
+    ++attributesVersion_;
 }
 
 void BufferGeometry::deleteAttribute(const std::string& name) {
@@ -108,9 +335,15 @@ void BufferGeometry::deleteAttribute(const std::string& name) {
     if (attributes_.count(name)) {
 
         attributes_.erase(name);
+        ++attributesVersion_;
     }
 }
 
+unsigned int BufferGeometry::attributesVersion() const {
+
+    return attributesVersion_;
+}
+
 bool BufferGeometry::hasAttribute(const std::string& name) const {
 
     return attributes_.count(name);
@@ -436,19 +669,37 @@ void BufferGeometry::computeBoundingSphere() {
     }
 }
 
-void BufferGeometry::normalizeNormals() {
+void BufferGeometry::computeBoundsTree(unsigned int maxLeafSize) {
 
-    auto normals = getAttribute<float>("normal");
+    boundsTree_ = std::make_unique<BVH>(*this, maxLeafSize);
+}
+
+const BVH* BufferGeometry::boundsTree() {
 
-    Vector3 _vector{};
-    for (int i = 0, il = normals->count(); i < il; i++) {
+    if (!boundsTree_) return nullptr;
 
-        normals->setFromBufferAttribute(_vector, i);
+    if (!boundsTree_->isValidFor(*this)) {
 
-        _vector.normalize();
+        computeBoundsTree(boundsTree_->maxLeafSize());
 
-        normals->setXYZ(i, _vector.x, _vector.y, _vector.z);
+    } else if (boundsTree_->needsRefit(*this)) {
+
+        boundsTree_->refit(*this);
     }
+
+    return boundsTree_.get();
+}
+
+void BufferGeometry::disposeBoundsTree() {
+
+    boundsTree_ = nullptr;
+}
+
+void BufferGeometry::normalizeNormals() {
+
+    auto normals = getAttribute<float>("normal");
+
+    normalize3(normals->array().data(), 0, normals->count());
 }
 
 void BufferGeometry::copy(const BufferGeometry& source) {
@@ -456,9 +707,11 @@ void BufferGeometry::copy(const BufferGeometry& source) {
 
     this->index_ = nullptr;
     this->attributes_.clear();
+    ++this->attributesVersion_;
     this->groups.clear();
     this->boundingBox = std::nullopt;
     this->boundingSphere = std::nullopt;
+    this->boundsTree_ = nullptr;
 
     // name
 
@@ -575,90 +828,146 @@ std::shared_ptr<BufferGeometry> BufferGeometry::toNonIndexed() const {
 }
 
 
-void BufferGeometry::computeVertexNormals() {
+void BufferGeometry::computeVertexNormals(unsigned int threadCount) {
 
     auto index = getIndex();
 
     const auto positionAttribute = this->getAttribute<float>("position");
 
-    if (positionAttribute) {
-
-        auto normalAttribute = this->getAttribute<float>("normal");
+    if (!positionAttribute) return;
 
-        if (!normalAttribute) {
+    auto normalAttribute = this->getAttribute<float>("normal");
 
-            this->setAttribute("normal", FloatBufferAttribute::create(std::vector<float>(positionAttribute->count() * 3), 3));
-            normalAttribute = this->getAttribute<float>("normal");
+    if (!normalAttribute) {
 
-        } else {
+        this->setAttribute("normal", FloatBufferAttribute::create(std::vector<float>(positionAttribute->count() * 3), 3));
+        normalAttribute = this->getAttribute<float>("normal");
+    }
 
-            // reset existing normals to zero
+    const auto positions = positionAttribute->array().data();
+    const auto vertexCount = positionAttribute->count();
+    auto normals = normalAttribute->array().data();
 
-            for (unsigned i = 0, il = normalAttribute->count(); i < il; i++) {
+    const auto triangles = (index ? index->count() : vertexCount) / 3;
+    Workers workers(resolveThreadCount(threadCount, triangles));
 
-                normalAttribute->setXYZ(i, 0, 0, 0);
-            }
-        }
+    if (index) {
 
-        Vector3 pA, pB, pC;
-        Vector3 nA, nB, nC;
-        Vector3 cb, ab;
+        const auto indices = index->array().data();
 
-        // indexed elements
+        // reset existing normals to zero
+        std::fill(normals, normals + vertexCount * 3, 0.f);
 
-        if (index) {
+        scatter<3>(
+                workers, indices, triangles, vertexCount,
+                [&](size_t triangle, float* normal) { faceNormal(positions, indices + triangle * 3, normal); },
+                [&](unsigned int vertex, const float* normal) { add3(normals + vertex * 3, normal); });
 
-            for (unsigned i = 0, il = index->count(); i < il; i += 3) {
+        workers.forEach(vertexCount, [&](unsigned int, size_t first, size_t last) {
+            normalize3(normals, first, last);
+        });
 
-                auto vA = index->getX(i + 0);
-                auto vB = index->getX(i + 1);
-                auto vC = index->getX(i + 2);
+    } else {
 
-                positionAttribute->setFromBufferAttribute(pA, vA);
-                positionAttribute->setFromBufferAttribute(pB, vB);
-                positionAttribute->setFromBufferAttribute(pC, vC);
+        // non-indexed elements (unconnected triangle soup)
 
-                cb.subVectors(pC, pB);
-                ab.subVectors(pA, pB);
-                cb.cross(ab);
+        workers.forEach(triangles, [&](unsigned int, size_t first, size_t last) {
+            const unsigned int corners[3] = {0, 1, 2};
 
-                normalAttribute->setFromBufferAttribute(nA, vA);
-                normalAttribute->setFromBufferAttribute(nB, vB);
-                normalAttribute->setFromBufferAttribute(nC, vC);
+            for (auto i = first * 9; i < last * 9; i += 9) {
 
-                nA.add(cb);
-                nB.add(cb);
-                nC.add(cb);
+                auto normal = normals + i;
+                faceNormal(positions + i, corners, normal);
+                normalize3(normal, 0, 1);
 
-                normalAttribute->setXYZ(vA, nA.x, nA.y, nA.z);
-                normalAttribute->setXYZ(vB, nB.x, nB.y, nB.z);
-                normalAttribute->setXYZ(vC, nC.x, nC.y, nC.z);
+                std::copy(normal, normal + 3, normal + 3);
+                std::copy(normal, normal + 3, normal + 6);
             }
+        });
+    }
 
-        } else {
+    normalAttribute->needsUpdate();
+}
 
-            // non-indexed elements (unconnected triangle soup)
+void BufferGeometry::computeTangents(unsigned int threadCount) {
 
-            for (unsigned i = 0, il = positionAttribute->count(); i < il; i += 3) {
+    const auto index = getIndex();
+    const auto positionAttribute = getAttribute<float>("position");
+    const auto normalAttribute = getAttribute<float>("normal");
+    const auto uvAttribute = getAttribute<float>("uv");
 
-                positionAttribute->setFromBufferAttribute(pA, i + 0);
-                positionAttribute->setFromBufferAttribute(pB, i + 1);
-                positionAttribute->setFromBufferAttribute(pC, i + 2);
+    if (!index || !positionAttribute || !normalAttribute || !uvAttribute) {
 
-                cb.subVectors(pC, pB);
-                ab.subVectors(pA, pB);
-                cb.cross(ab);
+        std::cerr << "THREE.BufferGeometry: .computeTangents() failed. Missing required attributes (index, position, normal or uv)" << std::endl;
+        return;
+    }
 
-                normalAttribute->setXYZ(i + 0, cb.x, cb.y, cb.z);
-                normalAttribute->setXYZ(i + 1, cb.x, cb.y, cb.z);
-                normalAttribute->setXYZ(i + 2, cb.x, cb.y, cb.z);
-            }
-        }
+    const auto vertexCount = positionAttribute->count();
 
-        this->normalizeNormals();
+    if (!hasAttribute("tangent")) {
 
-        normalAttribute->needsUpdate();
+        setAttribute("tangent", FloatBufferAttribute::create(std::vector<float>(vertexCount * 4), 4));
     }
+
+    auto tangentAttribute = getAttribute<float>("tangent");
+
+    const auto positions = positionAttribute->array().data();
+    const auto normals = normalAttribute->array().data();
+    const auto uvs = uvAttribute->array().data();
+    auto tangents = tangentAttribute->array().data();
+
+    // the triangles of the groups, or of the whole index
+    const auto& array = index->array();
+    std::vector<unsigned int> grouped;
+    for (const auto& group : groups) {
+
+        const auto start = std::min<size_t>(group.start, array.size());
+        const auto end = std::min<size_t>(start + group.count, array.size());
+        grouped.insert(grouped.end(), array.begin() + start, array.begin() + end);
+    }
+    const auto indices = groups.empty() ? array.data() : grouped.data();
+    const auto triangles = (groups.empty() ? array.size() : grouped.size()) / 3;
+
+    Workers workers(resolveThreadCount(threadCount, triangles));
+
+    std::vector<float> tan1(vertexCount * 3), tan2(vertexCount * 3);
+    std::vector<unsigned char> used(vertexCount);
+
+    scatter<6>(
+            workers, indices, triangles, vertexCount,
+            [&](size_t triangle, float* directions) { faceTangents(positions, uvs, indices + triangle * 3, directions, directions + 3); },
+            [&](unsigned int vertex, const float* directions) {
+                add3(tan1.data() + vertex * 3, directions);
+                add3(tan2.data() + vertex * 3, directions + 3);
+                used[vertex] = 1;
+            });
+
+    workers.forEach(vertexCount, [&](unsigned int, size_t first, size_t last) {
+        for (auto v = first; v < last; ++v) {
+
+            if (!used[v]) continue;
+
+            const auto n = normals + v * 3;
+            const auto t = tan1.data() + v * 3;
+            const auto t2 = tan2.data() + v * 3;
+
+            // Gram-Schmidt orthogonalize
+            const auto d = n[0] * t[0] + n[1] * t[1] + n[2] * t[2];
+            auto tangent = tangents + v * 4;
+            tangent[0] = t[0] - n[0] * d;
+            tangent[1] = t[1] - n[1] * d;
+            tangent[2] = t[2] - n[2] * d;
+            normalize3(tangent, 0, 1);
+
+            // handedness
+            const auto cx = n[1] * t[2] - n[2] * t[1];
+            const auto cy = n[2] * t[0] - n[0] * t[2];
+            const auto cz = n[0] * t[1] - n[1] * t[0];
+            tangent[3] = (cx * t2[0] + cy * t2[1] + cz * t2[2]) < 0 ? -1.f : 1.f;
+        }
+    });
+
+    tangentAttribute->needsUpdate();
 }
 
 std::shared_ptr<BufferGeometry> BufferGeometry::clone() const {
@@ -10,12 +10,36 @@
 
 #include "threepp/lights/Light.hpp"
 
+#include <limits>
+
 using namespace threepp;
 
+namespace {
+
+    thread_local size_t matrixWorldUpdates = 0;
+
+    // NaN never compares equal, so the first update always composes the local transform
+    constexpr std::array<float, 10> notComposed{
+            std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::quiet_NaN(),
+            std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::quiet_NaN(),
+            std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::quiet_NaN(),
+            std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::quiet_NaN(),
+            std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::quiet_NaN()};
+
+    std::array<float, 10> transformOf(const Vector3& position, const Quaternion& quaternion, const Vector3& scale) {
+
+        return {position.x, position.y, position.z,
+                quaternion.x, quaternion.y, quaternion.z, quaternion.w,
+                scale.x, scale.y, scale.z};
+    }
+
+}// namespace
+
 Object3D::Object3D()
     : uuid(math::generateUUID()),
       matrix(std::make_shared<Matrix4>()),
-      matrixWorld(std::make_shared<Matrix4>()) {
+      matrixWorld(std::make_shared<Matrix4>()),
+      composedFrom_(notComposed) {
 
     rotation._onChange([this] {
         quaternion.setFromEuler(rotation, false);
@@ -215,9 +239,11 @@ void Object3D::add(Object3D& object) {
     }
 
     object.parent = this;
+    object.matrixWorldNeedsUpdate = true;
     this->children.emplace_back(&object);
 
     object.dispatchEvent("added");
+    this->dispatchEvent("childadded", &object);
 }
 
 void Object3D::remove(Object3D& object) {
@@ -231,6 +257,7 @@ void Object3D::remove(Object3D& object) {
             children.erase(find);
 
             child->parent = nullptr;
+            child->matrixWorldNeedsUpdate = true;
             child->dispatchEvent("remove", child);
         }
     }
@@ -258,8 +285,9 @@ void Object3D::clear() {
     for (auto& object : this->children) {
 
         object->parent = nullptr;
+        object->matrixWorldNeedsUpdate = true;
 
-        object->dispatchEvent("remove");
+        object->dispatchEvent("remove", object);
     }
 
     this->children.clear();
@@ -354,13 +382,25 @@ void Object3D::traverseAncestors(const std::function<void(Object3D&)>& callback)
 void Object3D::updateMatrix() {
 
     this->matrix->compose(this->position, this->quaternion, this->scale);
+    this->composedFrom_ = transformOf(this->position, this->quaternion, this->scale);
 
     this->matrixWorldNeedsUpdate = true;
 }
 
 void Object3D::updateMatrixWorld(bool force) {
 
-    if (this->matrixAutoUpdate) this->updateMatrix();
+    if (this->matrixAutoUpdate && composedFrom_ != transformOf(this->position, this->quaternion, this->scale)) {
+
+        this->updateMatrix();
+    }
+
+    if (this->matrixSource_ && matrixSourceVersion_ != matrixSource_->matrixWorldVersion_) {
+
+        // the source's world matrix may have been moved, e.g. into a TransformHierarchy
+        this->matrix = matrixSource_->matrixWorld;
+        matrixSourceVersion_ = matrixSource_->matrixWorldVersion_;
+        this->matrixWorldNeedsUpdate = true;
+    }
 
     if (this->matrixWorldNeedsUpdate || force) {
 
@@ -373,6 +413,9 @@ void Object3D::updateMatrixWorld(bool force) {
             this->matrixWorld->multiplyMatrices(*this->parent->matrixWorld, *this->matrix);
         }
 
+        ++matrixWorldUpdates;
+        ++matrixWorldVersion_;
+
         this->matrixWorldNeedsUpdate = false;
 
         force = true;
@@ -386,6 +429,16 @@ void Object3D::updateMatrixWorld(bool force) {
     }
 }
 
+size_t Object3D::matrixWorldUpdateCount() {
+
+    return matrixWorldUpdates;
+}
+
+unsigned int Object3D::matrixWorldVersion() const {
+
+    return matrixWorldVersion_;
+}
+
 void Object3D::updateWorldMatrix(std::optional<bool> updateParents, std::optional<bool> updateChildren) {
 
     if (updateParents && updateParents.value() && parent) {
@@ -404,6 +457,8 @@ void Object3D::updateWorldMatrix(std::optional<bool> updateParents, std::optiona
         this->matrixWorld->multiplyMatrices(*this->parent->matrixWorld, *this->matrix);
     }
 
+    ++matrixWorldVersion_;
+
     // update children
 
     if (updateChildren && updateChildren.value()) {
@@ -415,6 +470,16 @@ void Object3D::updateWorldMatrix(std::optional<bool> updateParents, std::optiona
     }
 }
 
+void Object3D::followMatrixWorld(const Object3D& source) {
+
+    this->matrix = source.matrixWorld;
+    this->matrixAutoUpdate = false;
+    this->matrixWorldNeedsUpdate = true;
+
+    this->matrixSource_ = &source;
+    this->matrixSourceVersion_ = source.matrixWorldVersion_;
+}
+
 void Object3D::copy(const Object3D& source, bool recursive) {
 
     this->name = source.name;
@@ -428,6 +493,7 @@ void Object3D::copy(const Object3D& source, bool recursive) {
 
     this->matrix->copy(*source.matrix);
     this->matrixWorld->copy(*source.matrixWorld);
+    ++this->matrixWorldVersion_;
 
     this->matrixAutoUpdate = source.matrixAutoUpdate;
     this->matrixWorldNeedsUpdate = source.matrixWorldNeedsUpdate;
@@ -477,6 +543,8 @@ Object3D::Object3D(Object3D&& source) noexcept: Object3D() {
 
     this->matrix = std::move(source.matrix);
     this->matrixWorld = std::move(source.matrixWorld);
+    this->matrixSource_ = source.matrixSource_;
+    this->matrixSourceVersion_ = source.matrixSourceVersion_;
 
     this->matrixAutoUpdate = source.matrixAutoUpdate;
     this->matrixWorldNeedsUpdate = source.matrixWorldNeedsUpdate;
@@ -3,9 +3,13 @@
 
 #include "threepp/cameras/OrthographicCamera.hpp"
 #include "threepp/cameras/PerspectiveCamera.hpp"
+#include "threepp/core/BufferGeometry.hpp"
+#include "threepp/utils/ThreadPool.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <thread>
 
 using namespace threepp;
 
@@ -34,6 +38,25 @@ namespace {
         }
     }
 
+    // computes the lazily created geometry data used by raycast up front,
+    // so that the objects are only read once the rays are processed concurrently
+    void prepareObject(Object3D& object, bool recursive) {
+
+        if (auto geometry = object.geometry()) {
+
+            if (!geometry->boundingSphere) geometry->computeBoundingSphere();
+            geometry->boundsTree();
+        }
+
+        if (recursive) {
+
+            for (const auto& child : object.children) {
+
+                prepareObject(*child, true);
+            }
+        }
+    }
+
 }// namespace
 
 
@@ -69,6 +92,56 @@ std::vector<Intersection> Raycaster::intersectObjects(const std::vector<Object3D
     return intersects;
 }
 
+std::vector<std::vector<Intersection>> Raycaster::intersectObjects(const std::vector<Ray>& rays, const std::vector<Object3D*>& objects, bool recursive, utils::ThreadPool* pool) {
+
+    std::vector<std::vector<Intersection>> intersects(rays.size());
+
+    for (auto& object : objects) {
+
+        prepareObject(*object, recursive);
+    }
+
+    const auto numBatches = (rays.size() + batchSize - 1) / batchSize;
+    std::atomic<size_t> nextBatch{0};
+
+    auto work = [&] {
+        Raycaster raycaster(*this);
+
+        for (auto batch = nextBatch++; batch < numBatches; batch = nextBatch++) {
+
+            const auto end = std::min(rays.size(), (batch + 1) * batchSize);
+            for (auto i = batch * batchSize; i < end; ++i) {
+
+                raycaster.ray.copy(rays[i]);
+                intersects[i] = raycaster.intersectObjects(objects, recursive);
+            }
+        }
+    };
+
+    const auto numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    if (numBatches <= 1 || numThreads == 1) {
+
+        work();
+        return intersects;
+    }
+
+    std::unique_ptr<utils::ThreadPool> ownPool;
+    if (!pool) {
+        ownPool = std::make_unique<utils::ThreadPool>(numThreads);
+        pool = ownPool.get();
+    }
+
+    const auto numWorkers = std::min<size_t>(numThreads, numBatches);
+    for (size_t i = 0; i < numWorkers; ++i) {
+
+        pool->submit(work);
+    }
+    pool->wait();
+
+    return intersects;
+}
+
 void Raycaster::setFromCamera(const Vector2& coords, Camera& camera) {
 
     if (camera.is<PerspectiveCamera>()) {
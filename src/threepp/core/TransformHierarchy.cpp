@@ -0,0 +1,245 @@
+
+#include "threepp/core/TransformHierarchy.hpp"
+
+#include "threepp/cameras/Camera.hpp"
+#include "threepp/core/Object3D.hpp"
+
+#include <limits>
+#include <unordered_set>
+
+using namespace threepp;
+
+namespace {
+
+    // types known to rely on the default updateMatrixWorld, cameras are handled by the sweep
+    bool isFlattenable(const Object3D& object) {
+
+        static const std::unordered_set<std::string> types{
+                "Object3D", "Scene", "Group", "Bone",
+                "Mesh", "InstancedMesh", "BatchedMesh",
+                "Line", "LineSegments", "LineLoop", "Points", "Sprite",
+                "Camera", "PerspectiveCamera", "OrthographicCamera"};
+
+        return types.count(object.type());
+    }
+
+    std::array<float, 10> transformOf(const Object3D& object) {
+
+        const auto& p = object.position;
+        const auto& q = object.quaternion;
+        const auto& s = object.scale;
+
+        return {p.x, p.y, p.z, q.x, q.y, q.z, q.w, s.x, s.y, s.z};
+    }
+
+    // whether matrix is shared with anything besides the hierarchy, e.g. a helper using it as its local matrix
+    bool isShared(const std::shared_ptr<Matrix4>& matrix, const std::shared_ptr<void>& storage) {
+
+        const bool inStorage = storage && !matrix.owner_before(storage) && !storage.owner_before(matrix);
+
+        return !inStorage && matrix.use_count() > 1;
+    }
+
+    // column by column, so that each column of the result is a linear combination of the columns of a
+    void multiply(const std::array<float, 16>& a, const std::array<float, 16>& b, std::array<float, 16>& out) {
+
+        for (int j = 0; j < 16; j += 4) {
+
+            const float b0 = b[j], b1 = b[j + 1], b2 = b[j + 2], b3 = b[j + 3];
+
+            for (int i = 0; i < 4; ++i) {
+
+                out[j + i] = a[i] * b0 + a[4 + i] * b1 + a[8 + i] * b2 + a[12 + i] * b3;
+            }
+        }
+    }
+
+}// namespace
+
+TransformHierarchy::TransformHierarchy(Object3D& root): root_(root) {
+
+    rebuild();
+}
+
+void TransformHierarchy::rebuild() {
+
+    objects_.clear();
+    parents_.clear();
+    kinds_.clear();
+
+    flatten(root_, -1);
+
+    for (auto object : objects_) watch(*object);
+    dirty_ = false;
+
+    const auto size = objects_.size();
+
+    composedFrom_.assign(size, {});
+    changed_.assign(size, 0);
+
+    // the previous storage lives on for as long as objects that are no longer part of the hierarchy refer to it
+    storage_ = std::make_shared<Storage>();
+    storage_->matrices.resize(size);
+    storage_->matricesWorld.resize(size);
+
+    for (size_t i = 0; i < size; ++i) {
+
+        // keeps its own matrices, which may be shared
+        if (kinds_[i] == Kind::Custom) continue;
+
+        auto object = objects_[i];
+
+        storage_->matrices[i].copy(*object->matrix);
+        storage_->matricesWorld[i].copy(*object->matrixWorld);
+
+        object->matrix = std::shared_ptr<Matrix4>(storage_, &storage_->matrices[i]);
+        object->matrixWorld = std::shared_ptr<Matrix4>(storage_, &storage_->matricesWorld[i]);
+        ++object->matrixWorldVersion_;
+
+        // forces the local matrix to be composed on the first update
+        composedFrom_[i].fill(std::numeric_limits<float>::quiet_NaN());
+    }
+}
+
+void TransformHierarchy::update(bool force) {
+
+    if (dirty_) rebuild();
+
+    auto& matrices = storage_->matrices;
+    auto& matricesWorld = storage_->matricesWorld;
+
+    const auto size = objects_.size();
+
+    // a single sweep in topological order, parents are done before their children and each object is visited once
+
+    for (size_t i = 0; i < size; ++i) {
+
+        auto object = objects_[i];
+        const auto parent = parents_[i];
+
+        // the parent of root is outside of the hierarchy, and may have moved
+        const bool parentChanged = parent < 0 ? force || object->parent : changed_[parent] != 0;
+
+        if (kinds_[i] == Kind::Custom) {
+
+            object->updateMatrixWorld(parentChanged);
+            changed_[i] = 0;
+
+            continue;
+        }
+
+        bool changed = object->matrixWorldNeedsUpdate;
+
+        if (object->matrixAutoUpdate) {
+
+            const auto transform = transformOf(*object);
+
+            if (transform != composedFrom_[i]) {
+
+                matrices[i].compose(object->position, object->quaternion, object->scale);
+                composedFrom_[i] = transform;
+
+                changed = true;
+            }
+        }
+
+        if (!changed && !parentChanged) {
+
+            changed_[i] = 0;
+            continue;
+        }
+
+        if (parent >= 0) {
+
+            multiply(matricesWorld[parent].elements, matrices[i].elements, matricesWorld[i].elements);
+
+        } else if (object->parent) {
+
+            matricesWorld[i].multiplyMatrices(*object->parent->matrixWorld, matrices[i]);
+
+        } else {
+
+            matricesWorld[i].copy(matrices[i]);
+        }
+
+        if (kinds_[i] == Kind::Camera) {
+
+            static_cast<Camera*>(object)->matrixWorldInverse.copy(matricesWorld[i]).invert();
+        }
+
+        object->matrixWorldNeedsUpdate = false;
+        ++object->matrixWorldVersion_;
+        changed_[i] = 1;
+    }
+}
+
+size_t TransformHierarchy::size() const {
+
+    return objects_.size();
+}
+
+void TransformHierarchy::flatten(Object3D& object, int parent) {
+
+    const auto index = static_cast<int>(objects_.size());
+
+    objects_.emplace_back(&object);
+    parents_.emplace_back(parent);
+
+    // objects sharing matrices can not be moved into the flat storage
+    if (!isFlattenable(object) || object.matrixSource_ ||
+        isShared(object.matrix, storage_) || isShared(object.matrixWorld, storage_)) {
+
+        kinds_.emplace_back(Kind::Custom);
+        return;
+    }
+
+    kinds_.emplace_back(object.is<Camera>() ? Kind::Camera : Kind::Plain);
+
+    for (auto child : object.children) {
+
+        flatten(*child, index);
+    }
+}
+
+void TransformHierarchy::watch(Object3D& object) {
+
+    if (!watched_.insert(&object).second) return;
+
+    object.addEventListener("remove", &onStructureChanged_);
+    object.addEventListener("childadded", &onStructureChanged_);
+}
+
+void TransformHierarchy::unwatch(Object3D& object) {
+
+    if (watched_.erase(&object)) {
+
+        object.removeEventListener("remove", &onStructureChanged_);
+        object.removeEventListener("childadded", &onStructureChanged_);
+    }
+
+    for (auto child : object.children) {
+
+        unwatch(*child);
+    }
+}
+
+void TransformHierarchy::StructureListener::onEvent(Event& event) {
+
+    // the removed object is still alive while the event is dispatched
+    if (event.type == "remove" && event.target) {
+
+        scope_->unwatch(*static_cast<Object3D*>(event.target));
+    }
+
+    scope_->dirty_ = true;
+}
+
+TransformHierarchy::~TransformHierarchy() {
+
+    // the watched objects are below root, so they are still alive here
+    for (auto object : watched_) {
+
+        object->removeEventListener("remove", &onStructureChanged_);
+        object->removeEventListener("childadded", &onStructureChanged_);
+    }
+}
@@ -99,8 +99,7 @@ struct CameraHelper::Impl {
 
         camera.updateProjectionMatrix();
 
-        scope.matrix = camera.matrixWorld;
-        scope.matrixAutoUpdate = false;
+        scope.followMatrixWorld(camera);
 
         update();
     }
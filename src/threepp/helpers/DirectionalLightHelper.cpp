@@ -12,8 +12,7 @@ DirectionalLightHelper::DirectionalLightHelper(DirectionalLight& light, float si
 
     this->light.updateMatrixWorld();
 
-    this->matrix = this->light.matrixWorld;
-    this->matrixAutoUpdate = false;
+    this->followMatrixWorld(this->light);
 
     auto geometry = BufferGeometry::create();
     geometry->setAttribute("position", FloatBufferAttribute::create(
@@ -28,8 +28,7 @@ struct HemisphereLightHelper::Impl {
         : scope(scope), light(light) {
 
         this->light.updateMatrixWorld();
-        this->scope.matrix = light.matrixWorld;
-        this->scope.matrixAutoUpdate = false;
+        this->scope.followMatrixWorld(light);
 
         auto geometry = OctahedronGeometry::create(size);
         geometry->rotateY(math::PI * 0.5f);
@@ -20,8 +20,7 @@ PointLightHelper::PointLightHelper(PointLight& light, float sphereSize, std::opt
 
     this->light.updateMatrixWorld();
 
-    this->matrix = this->light.matrixWorld;
-    this->matrixAutoUpdate = false;
+    this->followMatrixWorld(this->light);
 
     update();
 }
@@ -62,8 +62,7 @@ SkeletonHelper::SkeletonHelper(Object3D& object)
     m->toneMapped = false;
     m->transparent = true;
 
-    this->matrix = object.matrixWorld;
-    this->matrixAutoUpdate = false;
+    this->followMatrixWorld(object);
 }
 
 const std::vector<Bone*>& SkeletonHelper::getBones() const {
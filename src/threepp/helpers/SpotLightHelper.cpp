@@ -15,8 +15,7 @@ SpotLightHelper::SpotLightHelper(SpotLight& light, std::optional<Color> color)
 
     this->light.updateMatrixWorld();
 
-    this->matrix = this->light.matrixWorld;
-    this->matrixAutoUpdate = false;
+    this->followMatrixWorld(this->light);
 
     auto geometry = BufferGeometry::create();
 
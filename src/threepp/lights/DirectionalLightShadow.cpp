@@ -0,0 +1,209 @@
+
+#include "threepp/lights/DirectionalLightShadow.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace threepp;
+
+namespace {
+
+    constexpr float noSplit = std::numeric_limits<float>::max();
+
+    // the corners of the view frustum of camera in view space, as four rays from the near to the far plane
+    void getFrustumCorners(const Camera& camera, Vector3 (&nearCorners)[4], Vector3 (&farCorners)[4]) {
+
+        const float ndc[4][2] = {{-1, -1}, {1, -1}, {1, 1}, {-1, 1}};
+
+        for (unsigned i = 0; i < 4; ++i) {
+
+            nearCorners[i].set(ndc[i][0], ndc[i][1], -1).applyMatrix4(camera.projectionMatrixInverse);
+            farCorners[i].set(ndc[i][0], ndc[i][1], 1).applyMatrix4(camera.projectionMatrixInverse);
+        }
+    }
+
+    void setCascadeTransform(Matrix4& transforms, unsigned int cascade, float scaleX, float scaleY, float offsetX, float offsetY) {
+
+        auto column = transforms.elements.data() + cascade * 4;
+        column[0] = scaleX;
+        column[1] = scaleY;
+        column[2] = offsetX;
+        column[3] = offsetY;
+    }
+
+}// namespace
+
+DirectionalLightShadow::DirectionalLightShadow()
+    : LightShadow(OrthographicCamera::create(-5, 5, 5, -5, 0.5f, 500)),
+      _cascadeSplits(noSplit, noSplit, noSplit),
+      _cascadeFar(noSplit) {
+
+    for (unsigned i = 0; i < maxCascades; ++i) {
+
+        setCascadeTransform(_cascadeTransforms, i, 1, 1, 0, 0);
+    }
+}
+
+unsigned int DirectionalLightShadow::getCascadeCount() const {
+
+    return std::clamp(cascades, 1u, maxCascades);
+}
+
+const Vector3& DirectionalLightShadow::getCascadeSplits() const {
+
+    return _cascadeSplits;
+}
+
+float DirectionalLightShadow::getCascadeFar() const {
+
+    return _cascadeFar;
+}
+
+Matrix4& DirectionalLightShadow::getCascadeTransforms() {
+
+    return _cascadeTransforms;
+}
+
+void DirectionalLightShadow::updateCascades(Light* light, const Camera& camera) {
+
+    const auto count = getCascadeCount();
+
+    if (count == 1) {
+
+        if (!_cascadeBounds.empty()) {
+
+            _cascadeBounds.clear();
+            _cascadeSplits.set(noSplit, noSplit, noSplit);
+            _cascadeFar = noSplit;
+            setCascadeTransform(_cascadeTransforms, 0, 1, 1, 0, 0);
+
+            _frameExtents.set(1, 1);
+            _viewports = {Vector4(0, 0, 1, 1)};
+        }
+
+        return;
+    }
+
+    // cascades are laid out in a 2x1 or 2x2 grid
+
+    _frameExtents.set(2, count > 2 ? 2.f : 1.f);
+    _viewports.resize(count);
+    for (unsigned i = 0; i < count; ++i) {
+
+        _viewports[i].set(static_cast<float>(i % 2), static_cast<float>(i / 2), 1, 1);
+    }
+
+    // positions the shadow camera at the light, all cascades share its orientation and depth range
+
+    LightShadow::updateMatrices(light);
+
+    const auto near = camera.near;
+    const auto far = cascadeDistance > 0 ? std::min(cascadeDistance, camera.far) : camera.far;
+
+    Vector3 nearCorners[4], farCorners[4];
+    getFrustumCorners(camera, nearCorners, farCorners);
+    const auto nearZ = nearCorners[0].z;
+    const auto farZ = farCorners[0].z;
+
+    _cascadeBounds.resize(count);
+    _cascadeSplits.set(noSplit, noSplit, noSplit);
+    _cascadeFar = far;
+
+    auto splitStart = near;
+
+    for (unsigned i = 0; i < count; ++i) {
+
+        // the practical split scheme
+        const auto t = static_cast<float>(i + 1) / static_cast<float>(count);
+        const auto logSplit = near * std::pow(far / near, t);
+        const auto uniformSplit = near + (far - near) * t;
+        const auto splitEnd = (i + 1 == count) ? far : cascadeSplitLambda * logSplit + (1 - cascadeSplitLambda) * uniformSplit;
+
+        if (i + 1 < count) _cascadeSplits[i] = splitEnd;
+
+        // the bounding sphere of the split depends on the camera projection only,
+        // so its radius does not change as the camera moves
+
+        Vector3 corners[8];
+        Vector3 center;
+        for (unsigned j = 0; j < 4; ++j) {
+
+            corners[j].lerpVectors(nearCorners[j], farCorners[j], (-splitStart - nearZ) / (farZ - nearZ));
+            corners[j + 4].lerpVectors(nearCorners[j], farCorners[j], (-splitEnd - nearZ) / (farZ - nearZ));
+            center.add(corners[j]).add(corners[j + 4]);
+        }
+        center.divideScalar(8);
+
+        float radius = 0;
+        for (const auto& corner : corners) {
+
+            radius = std::max(radius, center.distanceTo(corner));
+        }
+
+        center.applyMatrix4(*camera.matrixWorld).applyMatrix4(this->camera->matrixWorldInverse);
+
+        // snapping the center to whole texels keeps the rasterization of static casters stable
+
+        const auto texelX = 2 * radius / mapSize.x;
+        const auto texelY = 2 * radius / mapSize.y;
+        const auto x = std::floor(center.x / texelX) * texelX;
+        const auto y = std::floor(center.y / texelY) * texelY;
+
+        _cascadeBounds[i] = {x - radius, x + radius, y + radius, y - radius};
+
+        splitStart = splitEnd;
+    }
+
+    // shadow coordinates are computed for the first cascade, and mapped to the others by a scale and offset
+
+    updateMatrices(light, 0);
+    _cascadeMatrix.copy(matrix);
+
+    const auto& reference = _cascadeBounds.front();
+
+    for (unsigned i = 0; i < count; ++i) {
+
+        const auto& bounds = _cascadeBounds[i];
+        const auto& viewport = _viewports[i];
+
+        const auto scaleX = (reference.right - reference.left) / (bounds.right - bounds.left);
+        const auto scaleY = (reference.top - reference.bottom) / (bounds.top - bounds.bottom);
+        const auto offsetX = ((reference.right + reference.left) - (bounds.right + bounds.left)) / (bounds.right - bounds.left);
+        const auto offsetY = ((reference.top + reference.bottom) - (bounds.top + bounds.bottom)) / (bounds.top - bounds.bottom);
+
+        setCascadeTransform(_cascadeTransforms, i,
+                            scaleX / _frameExtents.x,
+                            scaleY / _frameExtents.y,
+                            (0.5f * (offsetX - scaleX + 1) + viewport.x) / _frameExtents.x,
+                            (0.5f * (offsetY - scaleY + 1) + viewport.y) / _frameExtents.y);
+    }
+}
+
+void DirectionalLightShadow::updateMatrices(Light* light, size_t cascade) {
+
+    if (cascade >= _cascadeBounds.size()) {
+
+        LightShadow::updateMatrices(light);
+        return;
+    }
+
+    auto shadowCamera = camera->as<OrthographicCamera>();
+
+    const auto& bounds = _cascadeBounds[cascade];
+    shadowCamera->left = bounds.left;
+    shadowCamera->right = bounds.right;
+    shadowCamera->top = bounds.top;
+    shadowCamera->bottom = bounds.bottom;
+    shadowCamera->updateProjectionMatrix();
+
+    LightShadow::updateMatrices(light);
+
+    // the shaders expect the coordinates of the first cascade
+    if (cascade > 0) matrix.copy(_cascadeMatrix);
+}
+
+std::shared_ptr<DirectionalLightShadow> DirectionalLightShadow::create() {
+
+    return std::shared_ptr<DirectionalLightShadow>(new DirectionalLightShadow());
+}
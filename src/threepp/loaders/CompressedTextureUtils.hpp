@@ -0,0 +1,73 @@
+
+#ifndef THREEPP_COMPRESSEDTEXTUREUTILS_HPP
+#define THREEPP_COMPRESSEDTEXTUREUTILS_HPP
+
+#include "threepp/textures/CompressedTexture.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+namespace threepp::utils {
+
+    // Reads a little endian value, as stored by DDS and KTX2 files.
+    template<class T>
+    T readLE(const unsigned char* data) {
+
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+
+        return value;
+    }
+
+    // The size in bytes of a mip level of a compressed format, stored in blocks of 4x4 texels.
+    // Saturates rather than wrapping around, so that the sizes of absurd headers are larger than any file.
+    inline size_t compressedLevelSize(Format format, unsigned int width, unsigned int height) {
+
+        const size_t blockBytes = format == Format::RGB_S3TC_DXT1 || format == Format::RGBA_S3TC_DXT1 || format == Format::RGB_ETC2 ? 8 : 16;
+        const auto blocksWide = std::max<size_t>(1, (static_cast<size_t>(width) + 3) / 4);
+        const auto blocksHigh = std::max<size_t>(1, (static_cast<size_t>(height) + 3) / 4);
+
+        if (blocksWide > std::numeric_limits<size_t>::max() / blockBytes / blocksHigh) {
+
+            return std::numeric_limits<size_t>::max();
+        }
+
+        return blocksWide * blocksHigh * blockBytes;
+    }
+
+    // The number of mip levels down to 1x1, floor(log2(max(width, height))) + 1.
+    inline unsigned int maxLevelCount(unsigned int width, unsigned int height) {
+
+        unsigned int count = 1;
+        for (auto size = std::max(width, height); size > 1; size >>= 1) ++count;
+
+        return count;
+    }
+
+    // Copies levelCount mip levels stored one after another from offset.
+    // Returns false if they go past size, or if there are more levels than maxLevelCount.
+    inline bool readCompressedLevels(std::vector<Image>& mipmaps, Format format, unsigned int width, unsigned int height, unsigned int levelCount,
+                                     const unsigned char* data, size_t size, size_t offset) {
+
+        if (levelCount > maxLevelCount(width, height)) return false;
+
+        for (unsigned i = 0; i < levelCount; ++i) {
+
+            const auto levelWidth = std::max(1u, width >> i);
+            const auto levelHeight = std::max(1u, height >> i);
+            const auto levelSize = compressedLevelSize(format, levelWidth, levelHeight);
+
+            if (offset > size || levelSize > size - offset) return false;
+
+            mipmaps.emplace_back(std::vector<unsigned char>(data + offset, data + offset + levelSize), levelWidth, levelHeight, false);
+            offset += levelSize;
+        }
+
+        return true;
+    }
+
+}// namespace threepp::utils
+
+#endif//THREEPP_COMPRESSEDTEXTUREUTILS_HPP
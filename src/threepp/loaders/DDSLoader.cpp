@@ -0,0 +1,194 @@
+
+#include "threepp/loaders/DDSLoader.hpp"
+
+#include "threepp/loaders/CompressedTextureUtils.hpp"
+#include "threepp/utils/MemoryMappedFile.hpp"
+
+#include <cstdint>
+#include <optional>
+
+using namespace threepp;
+
+namespace {
+
+    constexpr uint32_t fourCC(const char (&code)[5]) {
+
+        return static_cast<uint32_t>(code[0]) | static_cast<uint32_t>(code[1]) << 8 | static_cast<uint32_t>(code[2]) << 16 | static_cast<uint32_t>(code[3]) << 24;
+    }
+
+    constexpr uint32_t DDS_MAGIC = fourCC("DDS ");
+
+    constexpr uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+    constexpr uint32_t DDSCAPS2_CUBEMAP = 0x200;
+    constexpr uint32_t DDSCAPS2_VOLUME = 0x200000;
+    constexpr uint32_t DDPF_FOURCC = 0x4;
+
+    // offsets from the start of the file, which begins with the magic and a 124 byte header
+    constexpr size_t headerLength = 128;
+    constexpr size_t off_flags = 8;
+    constexpr size_t off_height = 12;
+    constexpr size_t off_width = 16;
+    constexpr size_t off_mipmapCount = 28;
+    constexpr size_t off_pfFlags = 80;
+    constexpr size_t off_pfFourCC = 84;
+    constexpr size_t off_caps2 = 112;
+
+    // the DX10 header, which follows the header for the DX10 four-character code
+    constexpr size_t dx10HeaderLength = 20;
+    constexpr size_t off_dxgiFormat = 128;
+    constexpr size_t off_arraySize = 140;
+
+    std::optional<Format> formatOfFourCC(uint32_t code) {
+
+        switch (code) {
+            case fourCC("DXT1"):
+                return Format::RGB_S3TC_DXT1;
+            case fourCC("DXT3"):
+                return Format::RGBA_S3TC_DXT3;
+            case fourCC("DXT5"):
+                return Format::RGBA_S3TC_DXT5;
+            case fourCC("ATI2"):
+            case fourCC("BC5U"):
+                return Format::RED_GREEN_RGTC2;
+            default:
+                return std::nullopt;
+        }
+    }
+
+    // Returns the format of a DXGI_FORMAT, and whether its values are sRGB encoded.
+    std::optional<std::pair<Format, bool>> formatOfDXGI(uint32_t dxgiFormat) {
+
+        switch (dxgiFormat) {
+            case 71:// DXGI_FORMAT_BC1_UNORM
+                return std::make_pair(Format::RGBA_S3TC_DXT1, false);
+            case 72:// DXGI_FORMAT_BC1_UNORM_SRGB
+                return std::make_pair(Format::RGBA_S3TC_DXT1, true);
+            case 74:// DXGI_FORMAT_BC2_UNORM
+                return std::make_pair(Format::RGBA_S3TC_DXT3, false);
+            case 75:// DXGI_FORMAT_BC2_UNORM_SRGB
+                return std::make_pair(Format::RGBA_S3TC_DXT3, true);
+            case 77:// DXGI_FORMAT_BC3_UNORM
+                return std::make_pair(Format::RGBA_S3TC_DXT5, false);
+            case 78:// DXGI_FORMAT_BC3_UNORM_SRGB
+                return std::make_pair(Format::RGBA_S3TC_DXT5, true);
+            case 83:// DXGI_FORMAT_BC5_UNORM
+                return std::make_pair(Format::RED_GREEN_RGTC2, false);
+            case 98:// DXGI_FORMAT_BC7_UNORM
+                return std::make_pair(Format::RGBA_BPTC, false);
+            case 99:// DXGI_FORMAT_BC7_UNORM_SRGB
+                return std::make_pair(Format::RGBA_BPTC, true);
+            default:
+                return std::nullopt;
+        }
+    }
+
+    std::shared_ptr<CompressedTexture> parse(const unsigned char* data, size_t size) {
+
+        using utils::readLE;
+
+        if (size < headerLength || readLE<uint32_t>(data) != DDS_MAGIC) {
+
+            std::cerr << "[DDSLoader] Invalid magic number in DDS header" << std::endl;
+            return nullptr;
+        }
+
+        if (!(readLE<uint32_t>(data + off_pfFlags) & DDPF_FOURCC)) {
+
+            std::cerr << "[DDSLoader] Unsupported format, must contain a FourCC code" << std::endl;
+            return nullptr;
+        }
+
+        if (readLE<uint32_t>(data + off_caps2) & (DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME)) {
+
+            std::cerr << "[DDSLoader] Cubemaps and volume textures are not supported" << std::endl;
+            return nullptr;
+        }
+
+        const auto code = readLE<uint32_t>(data + off_pfFourCC);
+
+        std::optional<Format> format;
+        bool sRGB = false;
+        size_t dataOffset = headerLength;
+
+        if (code == fourCC("DX10")) {
+
+            if (size < headerLength + dx10HeaderLength) {
+
+                std::cerr << "[DDSLoader] Truncated DX10 header" << std::endl;
+                return nullptr;
+            }
+
+            if (readLE<uint32_t>(data + off_arraySize) > 1) {
+
+                std::cerr << "[DDSLoader] Texture arrays are not supported" << std::endl;
+                return nullptr;
+            }
+
+            if (auto dxgi = formatOfDXGI(readLE<uint32_t>(data + off_dxgiFormat))) {
+
+                format = dxgi->first;
+                sRGB = dxgi->second;
+            }
+
+            dataOffset += dx10HeaderLength;
+
+        } else {
+
+            format = formatOfFourCC(code);
+        }
+
+        if (!format) {
+
+            std::cerr << "[DDSLoader] Unsupported FourCC code or DXGI format" << std::endl;
+            return nullptr;
+        }
+
+        const auto width = readLE<uint32_t>(data + off_width);
+        const auto height = readLE<uint32_t>(data + off_height);
+
+        unsigned int mipmapCount = 1;
+        if (readLE<uint32_t>(data + off_flags) & DDSD_MIPMAPCOUNT) {
+
+            mipmapCount = std::max(1u, readLE<uint32_t>(data + off_mipmapCount));
+        }
+
+        if (mipmapCount > utils::maxLevelCount(width, height)) {
+
+            std::cerr << "[DDSLoader] Invalid mipmap count " << mipmapCount << " for " << width << "x" << height << std::endl;
+            return nullptr;
+        }
+
+        std::vector<Image> mipmaps;
+        if (!utils::readCompressedLevels(mipmaps, *format, width, height, mipmapCount, data, size, dataOffset)) {
+
+            std::cerr << "[DDSLoader] Truncated mipmap data" << std::endl;
+            return nullptr;
+        }
+
+        auto texture = CompressedTexture::create(std::move(mipmaps), width, height, *format);
+        if (sRGB) texture->encoding = Encoding::sRGB;
+
+        return texture;
+    }
+
+}// namespace
+
+std::shared_ptr<CompressedTexture> DDSLoader::load(const std::filesystem::path& path) const {
+
+    utils::MemoryMappedFile file(path);
+
+    if (!file.valid()) {
+        std::cerr << "[DDSLoader] No such file: '" << absolute(path).string() << "'!" << std::endl;
+        return nullptr;
+    }
+
+    auto texture = ::parse(reinterpret_cast<const unsigned char*>(file.data()), file.size());
+    if (texture) texture->name = path.stem().string();
+
+    return texture;
+}
+
+std::shared_ptr<CompressedTexture> DDSLoader::parse(const std::vector<unsigned char>& data) const {
+
+    return ::parse(data.data(), data.size());
+}
@@ -1,6 +1,8 @@
 
 #include "threepp/loaders/ImageLoader.hpp"
 
+#include "threepp/utils/MemoryMappedFile.hpp"
+
 #ifndef STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_IMPLEMENTATION
 #endif
@@ -10,31 +12,18 @@ using namespace threepp;
 
 namespace {
 
-    struct ImageStruct {
-
-        int width{};
-        int height{};
-        int channels;
-        unsigned char* pixels;
-
-        ImageStruct(const std::vector<unsigned char>& data, int channels, bool flipY): channels(channels) {
-            stbi_set_flip_vertically_on_load(flipY);
-            pixels = stbi_load_from_memory(data.data(), static_cast<int>(data.size()), &width, &height, nullptr, channels);
-        }
-
-        ImageStruct(const std::filesystem::path& imagePath, int channels, bool flipY): channels(channels) {
-            stbi_set_flip_vertically_on_load(flipY);
-            pixels = stbi_load(imagePath.string().c_str(), &width, &height, nullptr, channels);
-        }
+    // the pixels decoded by stb are handed to the image, rather than copied
+    std::optional<Image> makeImage(unsigned char* pixels, int width, int height, int channels, bool flipY) {
 
-        [[nodiscard]] std::vector<unsigned char> get() const {
-            return {pixels, pixels + (channels * width * height)};
-        }
+        if (!pixels) return std::nullopt;
 
-        ~ImageStruct() {
-            stbi_image_free(pixels);
-        }
-    };
+        return Image{
+                std::shared_ptr<unsigned char>(pixels, stbi_image_free),
+                static_cast<size_t>(width) * height * channels,
+                static_cast<unsigned int>(width),
+                static_cast<unsigned int>(height),
+                flipY};
+    }
 
 }// namespace
 
@@ -44,22 +33,37 @@ std::optional<Image> ImageLoader::load(const std::filesystem::path& imagePath, i
         return std::nullopt;
     }
 
-    ImageStruct image{imagePath, channels, flipY};
+    int width, height;
+    stbi_set_flip_vertically_on_load_thread(flipY);
+    const auto pixels = stbi_load(imagePath.string().c_str(), &width, &height, nullptr, channels);
 
-    return Image{
-            image.get(),
-            static_cast<unsigned int>(image.width),
-            static_cast<unsigned int>(image.height),
-            flipY};
+    return makeImage(pixels, width, height, channels, flipY);
 }
 
 std::optional<Image> ImageLoader::load(const std::vector<unsigned char>& data, int channels, bool flipY) {
 
-    ImageStruct image{data, channels, flipY};
+    int width, height;
+    stbi_set_flip_vertically_on_load_thread(flipY);
+    const auto pixels = stbi_load_from_memory(data.data(), static_cast<int>(data.size()), &width, &height, nullptr, channels);
+
+    return makeImage(pixels, width, height, channels, flipY);
+}
+
+template<class T>
+std::optional<Image> ImageLoader::loadRaw(const std::filesystem::path& path, unsigned int width, unsigned int height, unsigned int channels, bool flipped) {
+
+    auto file = std::make_shared<utils::MemoryMappedFile>(path);
 
-    return Image{
-            image.get(),
-            static_cast<unsigned int>(image.width),
-            static_cast<unsigned int>(image.height),
-            flipY};
+    const auto size = static_cast<size_t>(width) * height * channels;
+    if (!file->valid() || size == 0 || file->size() < size * sizeof(T)) {
+        return std::nullopt;
+    }
+
+    // the mapping is read-only, and stays open for as long as the image, or a copy of it, refers to it
+    auto pixels = reinterpret_cast<const T*>(file->data());
+
+    return Image{std::shared_ptr<const T>(std::move(file), pixels), size, width, height, flipped};
 }
+
+template std::optional<Image> ImageLoader::loadRaw<unsigned char>(const std::filesystem::path&, unsigned int, unsigned int, unsigned int, bool);
+template std::optional<Image> ImageLoader::loadRaw<float>(const std::filesystem::path&, unsigned int, unsigned int, unsigned int, bool);
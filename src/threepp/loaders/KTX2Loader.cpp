@@ -0,0 +1,165 @@
+
+#include "threepp/loaders/KTX2Loader.hpp"
+
+#include "threepp/loaders/CompressedTextureUtils.hpp"
+#include "threepp/utils/MemoryMappedFile.hpp"
+
+#include <cstdint>
+#include <optional>
+
+using namespace threepp;
+
+namespace {
+
+    constexpr unsigned char KTX2_IDENTIFIER[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+    // offsets from the start of the file
+    constexpr size_t off_vkFormat = 12;
+    constexpr size_t off_pixelWidth = 20;
+    constexpr size_t off_pixelHeight = 24;
+    constexpr size_t off_pixelDepth = 28;
+    constexpr size_t off_layerCount = 32;
+    constexpr size_t off_faceCount = 36;
+    constexpr size_t off_levelCount = 40;
+    constexpr size_t off_supercompressionScheme = 44;
+    constexpr size_t off_levelIndex = 80;
+
+    // byteOffset, byteLength and uncompressedByteLength of each level
+    constexpr size_t levelIndexEntryLength = 24;
+
+    // Returns the format of a VkFormat, and whether its values are sRGB encoded.
+    std::optional<std::pair<Format, bool>> formatOfVkFormat(uint32_t vkFormat) {
+
+        switch (vkFormat) {
+            case 131:// VK_FORMAT_BC1_RGB_UNORM_BLOCK
+                return std::make_pair(Format::RGB_S3TC_DXT1, false);
+            case 132:// VK_FORMAT_BC1_RGB_SRGB_BLOCK
+                return std::make_pair(Format::RGB_S3TC_DXT1, true);
+            case 133:// VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+                return std::make_pair(Format::RGBA_S3TC_DXT1, false);
+            case 134:// VK_FORMAT_BC1_RGBA_SRGB_BLOCK
+                return std::make_pair(Format::RGBA_S3TC_DXT1, true);
+            case 135:// VK_FORMAT_BC2_UNORM_BLOCK
+                return std::make_pair(Format::RGBA_S3TC_DXT3, false);
+            case 136:// VK_FORMAT_BC2_SRGB_BLOCK
+                return std::make_pair(Format::RGBA_S3TC_DXT3, true);
+            case 137:// VK_FORMAT_BC3_UNORM_BLOCK
+                return std::make_pair(Format::RGBA_S3TC_DXT5, false);
+            case 138:// VK_FORMAT_BC3_SRGB_BLOCK
+                return std::make_pair(Format::RGBA_S3TC_DXT5, true);
+            case 141:// VK_FORMAT_BC5_UNORM_BLOCK
+                return std::make_pair(Format::RED_GREEN_RGTC2, false);
+            case 145:// VK_FORMAT_BC7_UNORM_BLOCK
+                return std::make_pair(Format::RGBA_BPTC, false);
+            case 146:// VK_FORMAT_BC7_SRGB_BLOCK
+                return std::make_pair(Format::RGBA_BPTC, true);
+            case 147:// VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+                return std::make_pair(Format::RGB_ETC2, false);
+            case 148:// VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK
+                return std::make_pair(Format::RGB_ETC2, true);
+            case 151:// VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+                return std::make_pair(Format::RGBA_ETC2_EAC, false);
+            case 152:// VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK
+                return std::make_pair(Format::RGBA_ETC2_EAC, true);
+            default:
+                return std::nullopt;
+        }
+    }
+
+    std::shared_ptr<CompressedTexture> parse(const unsigned char* data, size_t size) {
+
+        using utils::readLE;
+
+        if (size < off_levelIndex || std::memcmp(data, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0) {
+
+            std::cerr << "[KTX2Loader] Missing KTX2 identifier" << std::endl;
+            return nullptr;
+        }
+
+        if (readLE<uint32_t>(data + off_supercompressionScheme) != 0) {
+
+            std::cerr << "[KTX2Loader] Supercompressed files are not supported" << std::endl;
+            return nullptr;
+        }
+
+        if (readLE<uint32_t>(data + off_pixelDepth) > 0 || readLE<uint32_t>(data + off_layerCount) > 1 || readLE<uint32_t>(data + off_faceCount) != 1) {
+
+            std::cerr << "[KTX2Loader] Only 2D textures are supported" << std::endl;
+            return nullptr;
+        }
+
+        const auto vkFormat = formatOfVkFormat(readLE<uint32_t>(data + off_vkFormat));
+
+        if (!vkFormat) {
+
+            std::cerr << "[KTX2Loader] Unsupported vkFormat " << readLE<uint32_t>(data + off_vkFormat) << std::endl;
+            return nullptr;
+        }
+
+        const auto [format, sRGB] = *vkFormat;
+
+        const auto width = readLE<uint32_t>(data + off_pixelWidth);
+        const auto height = readLE<uint32_t>(data + off_pixelHeight);
+        // 0 asks for the mipmaps to be generated, which compressed formats do not allow
+        const auto levelCount = std::max(1u, readLE<uint32_t>(data + off_levelCount));
+
+        if (levelCount > utils::maxLevelCount(width, height)) {
+
+            std::cerr << "[KTX2Loader] Invalid level count " << levelCount << " for " << width << "x" << height << std::endl;
+            return nullptr;
+        }
+
+        if (size < off_levelIndex + levelCount * levelIndexEntryLength) {
+
+            std::cerr << "[KTX2Loader] Truncated level index" << std::endl;
+            return nullptr;
+        }
+
+        std::vector<Image> mipmaps;
+        mipmaps.reserve(levelCount);
+
+        for (unsigned i = 0; i < levelCount; ++i) {
+
+            const auto entry = data + off_levelIndex + i * levelIndexEntryLength;
+            const auto byteOffset = readLE<uint64_t>(entry);
+            const auto byteLength = readLE<uint64_t>(entry + 8);
+
+            const auto levelWidth = std::max(1u, width >> i);
+            const auto levelHeight = std::max(1u, height >> i);
+
+            // the levels are stored smallest first, and located through the index
+            if (byteLength != utils::compressedLevelSize(format, levelWidth, levelHeight) ||
+                !utils::readCompressedLevels(mipmaps, format, levelWidth, levelHeight, 1, data, size, byteOffset)) {
+
+                std::cerr << "[KTX2Loader] Invalid data for level " << i << std::endl;
+                return nullptr;
+            }
+        }
+
+        auto texture = CompressedTexture::create(std::move(mipmaps), width, height, format);
+        if (sRGB) texture->encoding = Encoding::sRGB;
+
+        return texture;
+    }
+
+}// namespace
+
+std::shared_ptr<CompressedTexture> KTX2Loader::load(const std::filesystem::path& path) const {
+
+    utils::MemoryMappedFile file(path);
+
+    if (!file.valid()) {
+        std::cerr << "[KTX2Loader] No such file: '" << absolute(path).string() << "'!" << std::endl;
+        return nullptr;
+    }
+
+    auto texture = ::parse(reinterpret_cast<const unsigned char*>(file.data()), file.size());
+    if (texture) texture->name = path.stem().string();
+
+    return texture;
+}
+
+std::shared_ptr<CompressedTexture> KTX2Loader::parse(const std::vector<unsigned char>& data) const {
+
+    return ::parse(data.data(), data.size());
+}
@@ -7,13 +7,18 @@
 #include "threepp/objects/LineSegments.hpp"
 #include "threepp/objects/Mesh.hpp"
 #include "threepp/objects/Points.hpp"
+#include "threepp/utils/CharConv.hpp"
+#include "threepp/utils/MemoryMappedFile.hpp"
 #include "threepp/utils/StringUtils.hpp"
+#include "threepp/utils/ThreadPool.hpp"
 
-#include <fstream>
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <optional>
-#include <regex>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -21,24 +26,295 @@ using namespace threepp;
 
 namespace {
 
-    size_t parseVertexOrNormalIndex(const std::string& value, size_t len) {
-        int index = utils::parseInt(value);
-        return (index > 0 ? (index - 1) : index + len / 3) * 3;
+    // files smaller than this are parsed on the calling thread
+    constexpr size_t minParallelSize = 1 << 20;
+
+    bool isSpace(char c) {
+
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';
+    }
+
+    std::string_view trim(std::string_view text) {
+
+        while (!text.empty() && isSpace(text.front())) text.remove_prefix(1);
+        while (!text.empty() && isSpace(text.back())) text.remove_suffix(1);
+
+        return text;
+    }
+
+    // splits off the next whitespace separated token
+    std::string_view nextToken(std::string_view& text) {
+
+        size_t start = 0;
+        while (start < text.size() && isSpace(text[start])) ++start;
+        size_t end = start;
+        while (end < text.size() && !isSpace(text[end])) ++end;
+
+        auto token = text.substr(start, end - start);
+        text.remove_prefix(end);
+
+        return token;
+    }
+
+    template<class F>
+    void forEachLine(const char* begin, const char* end, const F& f) {
+
+        while (begin < end) {
+
+            auto newline = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+            if (!newline) newline = end;
+
+            f(trim(std::string_view(begin, newline - begin)));
+
+            begin = newline + 1;
+        }
     }
 
-    size_t parseUvIndex(const std::string& value, size_t len) {
-        int index = utils::parseInt(value);
-        return (index > 0 ? (index - 1) : index + len / 2) * 2;
+    enum class Statement {
+        Vertex,
+        Normal,
+        Uv,
+        Other
+    };
+
+    Statement statementOf(std::string_view line) {
+
+        if (line.size() < 2 || line.front() != 'v') return Statement::Other;
+
+        if (isSpace(line[1])) return Statement::Vertex;
+        if (line.size() > 2 && isSpace(line[2])) {
+            if (line[1] == 'n') return Statement::Normal;
+            if (line[1] == 't') return Statement::Uv;
+        }
+
+        return Statement::Other;
     }
 
+    struct FaceVertex {
+
+        // indices into the v, vt and vn arrays, -1 when not given
+        int v;
+        int vt;
+        int vn;
+    };
+
+    struct Command {
+
+        enum class Type {
+            Object,
+            Material,
+            Library,
+            Smooth,
+            Points,
+            Unexpected
+        };
+
+        Type type;
+        std::string_view value;
+        // triangles of the chunk that precede this command
+        size_t triangles;
+        // range of Points commands within the points of the chunk
+        size_t pointsBegin = 0;
+        size_t pointsEnd = 0;
+    };
+
+    // a line aligned part of the file, parsed independently
+    struct Chunk {
+
+        const char* begin;
+        const char* end;
+
+        Chunk(const char* begin, const char* end): begin(begin), end(end) {}
+
+        size_t vertices = 0;
+        size_t normals = 0;
+        size_t uvs = 0;
+
+        size_t vertexOffset = 0;
+        size_t normalOffset = 0;
+        size_t uvOffset = 0;
+
+        std::vector<FaceVertex> triangles;
+        // number of triangles with uvs/normals preceding each triangle
+        std::vector<uint32_t> uvTriangles{0};
+        std::vector<uint32_t> normalTriangles{0};
+
+        std::vector<int> points;
+        std::vector<float> colors;
+
+        std::vector<Command> commands;
+
+        void count() {
+
+            forEachLine(begin, end, [this](std::string_view line) {
+                switch (statementOf(line)) {
+                    case Statement::Vertex: ++vertices; break;
+                    case Statement::Normal: ++normals; break;
+                    case Statement::Uv: ++uvs; break;
+                    default: break;
+                }
+            });
+        }
+
+        void parse(std::vector<float>& allVertices, std::vector<float>& allNormals, std::vector<float>& allUvs) {
+
+            size_t v = 0, vn = 0, vt = 0;
+            std::vector<FaceVertex> face;
+
+            // resolves 1-based and negative (relative) indices
+            const auto resolve = [](std::string_view token, size_t count) {
+                int index;
+                if (token.empty() || !utils::fromChars(token, index) || index == 0) return -1;
+                return index > 0 ? index - 1 : static_cast<int>(count) + index;
+            };
+
+            forEachLine(begin, end, [&](std::string_view line) {
+                if (line.empty() || line.front() == '#') return;
+
+                auto rest = line;
+                const auto keyword = nextToken(rest);
+
+                switch (statementOf(line)) {
+
+                    case Statement::Vertex: {
+
+                        float values[6]{};
+                        int n = 0;
+                        while (n < 6 && utils::fromChars(nextToken(rest), values[n])) ++n;
+
+                        std::copy(values, values + 3, &allVertices[(vertexOffset + v) * 3]);
+
+                        if (n == 6) {
+                            // vertices without a color of their own are white, as when there are no colors
+                            colors.resize(vertices * 3, 1.f);
+                            std::copy(values + 3, values + 6, &colors[v * 3]);
+                        }
+
+                        ++v;
+                        return;
+                    }
+                    case Statement::Normal: {
+
+                        float* normal = &allNormals[(normalOffset + vn++) * 3];
+                        for (int i = 0; i < 3; ++i) utils::fromChars(nextToken(rest), normal[i]);
+                        return;
+                    }
+                    case Statement::Uv: {
+
+                        float* uv = &allUvs[(uvOffset + vt++) * 2];
+                        for (int i = 0; i < 2; ++i) utils::fromChars(nextToken(rest), uv[i]);
+                        return;
+                    }
+                    default: break;
+                }
+
+                if (keyword == "f") {
+
+                    face.clear();
+
+                    for (auto token = nextToken(rest); !token.empty(); token = nextToken(rest)) {
+
+                        const auto slash1 = token.find('/');
+                        const auto slash2 = slash1 == std::string_view::npos ? slash1 : token.find('/', slash1 + 1);
+
+                        FaceVertex vertex{resolve(token.substr(0, slash1), vertexOffset + v), -1, -1};
+
+                        if (slash1 != std::string_view::npos) {
+                            vertex.vt = resolve(token.substr(slash1 + 1, slash2 - slash1 - 1), uvOffset + vt);
+                        }
+                        if (slash2 != std::string_view::npos) {
+                            vertex.vn = resolve(token.substr(slash2 + 1), normalOffset + vn);
+                        }
+
+                        face.emplace_back(vertex);
+                    }
+
+                    // uvs and normals are taken into account when given for the first vertex of the face
+                    for (size_t j = 1; j + 1 < face.size(); ++j) {
+
+                        triangles.insert(triangles.end(), {face[0], face[j], face[j + 1]});
+
+                        uvTriangles.emplace_back(uvTriangles.back() + (face[0].vt != -1));
+                        normalTriangles.emplace_back(normalTriangles.back() + (face[0].vn != -1));
+                    }
+
+                } else if (line.front() == 'v') {
+
+                    // other vertex data, such as parameter space vertices, is ignored
+
+                } else if (keyword == "l") {
+
+                    // lines are not supported
+
+                } else if (keyword == "p") {
+
+                    const auto pointsBegin = points.size();
+                    for (auto token = nextToken(rest); !token.empty(); token = nextToken(rest)) {
+                        points.emplace_back(resolve(token, vertexOffset + v));
+                    }
+
+                    commands.push_back({Command::Type::Points, {}, triangleCount(), pointsBegin, points.size()});
+
+                } else if (keyword == "s") {
+
+                    commands.push_back({Command::Type::Smooth, nextToken(rest), triangleCount()});
+
+                } else if ((keyword == "o" || keyword == "g") && !trim(rest).empty()) {
+
+                    commands.push_back({Command::Type::Object, trim(rest), triangleCount()});
+
+                } else if (keyword == "usemtl") {
+
+                    commands.push_back({Command::Type::Material, trim(rest), triangleCount()});
+
+                } else if (keyword == "mtllib") {
+
+                    commands.push_back({Command::Type::Library, trim(rest), triangleCount()});
+
+                } else if (line != "\\0") {
+
+                    commands.push_back({Command::Type::Unexpected, line, triangleCount()});
+                }
+            });
+        }
+
+        [[nodiscard]] size_t triangleCount() const {
+
+            return triangles.size() / 3;
+        }
+    };
+
     struct OBJGeometry {
         std::string type;
+
+        // number of vertices, normals, uvs and colors written by the segments of this geometry
+        size_t vertexCount = 0;
+        size_t normalCount = 0;
+        size_t uvCount = 0;
+        size_t colorCount = 0;
+
         std::vector<float> vertices;
         std::vector<float> normals;
         std::vector<float> colors;
         std::vector<float> uvs;
     };
 
+    // a run of triangles or points of a chunk, written to a geometry once all chunks have been parsed
+    struct Segment {
+
+        const Chunk* chunk;
+        OBJGeometry* geometry;
+
+        bool points;
+        size_t begin;
+        size_t end;
+
+        size_t vertexOffset;
+        size_t normalOffset;
+        size_t uvOffset;
+        size_t colorOffset;
+    };
+
     struct OBJMaterial {
         std::optional<size_t> index;
         std::string name;
@@ -98,7 +374,7 @@ namespace {
             auto lastMultiMaterial = currentMaterial();
             if (lastMultiMaterial && lastMultiMaterial->groupEnd == -1) {
 
-                lastMultiMaterial->groupEnd = static_cast<int>(geometry.vertices.size()) / 3;
+                lastMultiMaterial->groupEnd = static_cast<int>(geometry.vertexCount);
                 lastMultiMaterial->groupCount = lastMultiMaterial->groupEnd - lastMultiMaterial->groupStart;
                 lastMultiMaterial->inherited = false;
             }
@@ -122,21 +398,19 @@ namespace {
         }
     };
 
-
+    // Replays the commands of the chunks in file order.
+    // Faces are only counted here, their data is copied by the segments afterwards.
     class ParserState {
 
     public:
         std::shared_ptr<OBJObject> object;
         std::vector<std::shared_ptr<OBJObject>> objects;
 
-        std::vector<float> vertices;
-        std::vector<float> normals;
-        std::vector<float> colors;
-        std::vector<float> uvs;
+        std::vector<Segment> segments;
 
         std::vector<std::string> materialLibraries;
 
-        ParserState() {
+        explicit ParserState(bool hasColors): hasColors_(hasColors) {
             startObject("", false);
         }
 
@@ -172,112 +446,200 @@ namespace {
             object->finalize(true);
         }
 
-        void addVertex(size_t a, size_t b, size_t c) {
+        void addFaces(const Chunk& chunk, size_t begin, size_t end) {
 
-            auto& src = vertices;
-            auto& dst = object->geometry.vertices;
+            if (begin == end) return;
 
-            dst.insert(dst.end(), {src[a + 0], src[a + 1], src[a + 2],
-                                   src[b + 0], src[b + 1], src[b + 2],
-                                   src[c + 0], src[c + 1], src[c + 2]});
-        }
+            auto& geometry = object->geometry;
 
-        void addVertexPointOrLine(size_t a) {
+            segments.push_back({&chunk, &geometry, false, begin, end,
+                                geometry.vertexCount, geometry.normalCount, geometry.uvCount, geometry.colorCount});
 
-            auto& src = vertices;
-            auto& dst = object->geometry.vertices;
+            const auto vertices = (end - begin) * 3;
 
-            dst.insert(dst.end(), {src[a + 0], src[a + 1], src[a + 2]});
+            geometry.vertexCount += vertices;
+            geometry.uvCount += (chunk.uvTriangles[end] - chunk.uvTriangles[begin]) * 3;
+            geometry.normalCount += (chunk.normalTriangles[end] - chunk.normalTriangles[begin]) * 3;
+            if (hasColors_) geometry.colorCount += vertices;
         }
 
-        void addNormal(size_t a, size_t b, size_t c) {
+        void addPointGeometry(const Chunk& chunk, size_t begin, size_t end) {
 
-            auto& src = normals;
-            auto& dst = object->geometry.normals;
+            auto& geometry = object->geometry;
+            geometry.type = "Points";
+
+            segments.push_back({&chunk, &geometry, true, begin, end,
+                                geometry.vertexCount, geometry.normalCount, geometry.uvCount, geometry.colorCount});
 
-            dst.insert(dst.end(), {src[a + 0], src[a + 1], src[a + 2],
-                                   src[b + 0], src[b + 1], src[b + 2],
-                                   src[c + 0], src[c + 1], src[c + 2]});
+            geometry.vertexCount += end - begin;
         }
 
-        void addColor(size_t a, size_t b, size_t c) {
+        void replay(const Chunk& chunk) {
 
-            auto& src = colors;
-            auto& dst = object->geometry.colors;
+            size_t triangles = 0;
 
-            dst.insert(dst.end(), {src[a + 0], src[a + 1], src[a + 2],
-                                   src[b + 0], src[b + 1], src[b + 2],
-                                   src[c + 0], src[c + 1], src[c + 2]});
-        }
+            for (const auto& command : chunk.commands) {
 
-        void addUv(size_t a, size_t b, size_t c) {
+                addFaces(chunk, triangles, command.triangles);
+                triangles = command.triangles;
 
-            auto& src = uvs;
-            auto& dst = object->geometry.uvs;
+                switch (command.type) {
 
-            dst.insert(dst.end(), {src[a + 0], src[a + 1],
-                                   src[b + 0], src[b + 1],
-                                   src[c + 0], src[c + 1]});
-        }
+                    case Command::Type::Object:
+                        startObject(std::string(command.value));
+                        break;
+
+                    case Command::Type::Material:
+                        object->startMaterial(std::string(command.value), materialLibraries);
+                        break;
+
+                    case Command::Type::Library:
+                        materialLibraries.emplace_back(command.value);
+                        break;
 
-        void addUvLine(size_t a) {
+                    case Command::Type::Smooth: {
 
-            auto& src = uvs;
-            auto& dst = object->geometry.uvs;
+                        auto value = std::string(command.value);
+                        utils::toLowerInplace(value);
+                        object->smooth = value.empty() || (value != "0" && value != "off");
 
-            dst.insert(dst.end(), {src[a + 0], src[a + 1]});
+                        auto material = object->currentMaterial();
+                        if (material) {
+                            material->smooth = object->smooth;
+                        }
+                        break;
+                    }
+
+                    case Command::Type::Points:
+                        addPointGeometry(chunk, command.pointsBegin, command.pointsEnd);
+                        break;
+
+                    case Command::Type::Unexpected:
+                        std::cerr << "[OBJLoader] Unexpected line: " << command.value << ":" << command.value.size() << std::endl;
+                        break;
+                }
+            }
+
+            addFaces(chunk, triangles, chunk.triangleCount());
         }
 
-        void addFace(const std::string& a, const std::string& b, const std::string& c,
-                     const std::string& ua, const std::string& ub, const std::string& uc,
-                     const std::string& na, const std::string& nb, const std::string& nc) {
+    private:
+        bool hasColors_;
+    };
 
-            auto vLen = vertices.size();
+    struct Source {
 
-            auto ia = parseVertexOrNormalIndex(a, vLen);
-            auto ib = parseVertexOrNormalIndex(b, vLen);
-            auto ic = parseVertexOrNormalIndex(c, vLen);
+        std::vector<float> vertices;
+        std::vector<float> normals;
+        std::vector<float> uvs;
+        std::vector<float> colors;
+    };
 
-            addVertex(ia, ib, ic);
+    template<size_t N>
+    void copyItem(const std::vector<float>& src, int index, float* dst) {
 
-            if (!ua.empty()) {
+        if (index >= 0 && static_cast<size_t>(index) < src.size() / N) {
 
-                auto uvlen = uvs.size();
-                ia = parseUvIndex(ua, uvlen);
-                ib = parseUvIndex(ub, uvlen);
-                ic = parseUvIndex(uc, uvlen);
+            std::copy_n(&src[static_cast<size_t>(index) * N], N, dst);
 
-                addUv(ia, ib, ic);
-            }
+        } else {
 
-            if (!na.empty()) {
+            std::fill_n(dst, N, 0.f);
+        }
+    }
+
+    void writeSegment(const Source& source, const Segment& segment) {
+
+        const auto& chunk = *segment.chunk;
+        auto& geometry = *segment.geometry;
 
-                auto nLen = normals.size();
-                ia = parseVertexOrNormalIndex(na, nLen);
+        float* vertices = geometry.vertices.data() + segment.vertexOffset * 3;
 
-                ib = (na == nb) ? ia : parseVertexOrNormalIndex(nb, nLen);
-                ic = (na == nc) ? ia : parseVertexOrNormalIndex(nc, nLen);
+        if (segment.points) {
 
-                addNormal(ia, ib, ic);
+            for (size_t i = segment.begin; i < segment.end; ++i) {
+                copyItem<3>(source.vertices, chunk.points[i], vertices);
+                vertices += 3;
             }
 
-            if (!colors.empty()) {
+            return;
+        }
+
+        float* normals = geometry.normals.data() + segment.normalOffset * 3;
+        float* uvs = geometry.uvs.data() + segment.uvOffset * 2;
+        float* colors = geometry.colors.data() + segment.colorOffset * 3;
+
+        for (size_t t = segment.begin; t < segment.end; ++t) {
+
+            const FaceVertex* triangle = &chunk.triangles[t * 3];
+            const bool hasUvs = triangle[0].vt != -1;
+            const bool hasNormals = triangle[0].vn != -1;
+
+            for (int i = 0; i < 3; ++i) {
+
+                const auto& vertex = triangle[i];
+
+                copyItem<3>(source.vertices, vertex.v, vertices);
+                vertices += 3;
+
+                if (hasUvs) {
+                    copyItem<2>(source.uvs, vertex.vt, uvs);
+                    uvs += 2;
+                }
 
-                addColor(ia, ib, ic);
+                if (hasNormals) {
+                    copyItem<3>(source.normals, vertex.vn, normals);
+                    normals += 3;
+                }
+
+                if (!source.colors.empty()) {
+                    copyItem<3>(source.colors, vertex.v, colors);
+                    colors += 3;
+                }
             }
         }
+    }
+
+    // runs f(i) for i in [0, count), on a pool when more than one thread is requested
+    template<class F>
+    void parallelFor(size_t count, unsigned int threadCount, const F& f) {
+
+        if (threadCount <= 1 || count <= 1) {
+
+            for (size_t i = 0; i < count; ++i) f(i);
+            return;
+        }
+
+        utils::ThreadPool pool(threadCount);
+        for (size_t i = 0; i < count; ++i) {
+            pool.submit([&f, i] { f(i); });
+        }
+        pool.wait();
+    }
+
+    std::vector<Chunk> splitChunks(const char* data, size_t size, size_t count) {
 
-        void addPointGeometry(const std::vector<std::string>& verts) {
+        std::vector<Chunk> chunks;
 
-            object->geometry.type = "Points";
+        const char* begin = data;
+        const char* end = data + size;
 
-            auto vLen = verts.size();
+        for (size_t i = 1; i <= count && begin < end; ++i) {
 
-            for (const auto& v : verts) {
-                addVertexPointOrLine(parseVertexOrNormalIndex(v, vLen));
+            const char* chunkEnd = i == count ? end : std::max(begin, data + size * i / count);
+
+            // extend to the end of the line
+            if (chunkEnd < end) {
+                auto newline = static_cast<const char*>(std::memchr(chunkEnd, '\n', end - chunkEnd));
+                chunkEnd = newline ? newline + 1 : end;
             }
+
+            chunks.emplace_back(begin, chunkEnd);
+            begin = chunkEnd;
         }
-    };
+
+        return chunks;
+    }
 
 }// namespace
 
@@ -306,7 +668,12 @@ struct OBJLoader::Impl {
             return nullptr;
         }
 
-        std::ifstream in(path);
+        utils::MemoryMappedFile file(path);
+
+        if (!file.valid()) {
+            std::cerr << "[OBJLoader] Unable to read file: '" << absolute(path).string() << "'!" << std::endl;
+            return nullptr;
+        }
 
         if (tryLoadMtl) {
             std::filesystem::path mtlFile{path.parent_path() / (path.stem().string() + ".mtl")};
@@ -316,126 +683,64 @@ struct OBJLoader::Impl {
             }
         }
 
-        ParserState state;
-
-        std::string line;
-        while (std::getline(in, line)) {
-            utils::trimInplace(line);
-
-            auto lineLength = line.size();
-
-            if (lineLength == 0) continue;
-
-            auto lineFirstChar = line.front();
-
-            if (lineFirstChar == '#') continue;
-
-            if (lineFirstChar == 'v') {
-
-                auto data = utils::split(line, ' ');
-
-                if (data[0] == "v") {
-                    state.vertices.insert(state.vertices.end(), {utils::parseFloat(data[1]),
-                                                                 utils::parseFloat(data[2]),
-                                                                 utils::parseFloat(data[3])});
-
-                    if (data.size() == 8) {
-                        state.colors.insert(state.colors.end(), {utils::parseFloat(data[4]),
-                                                                 utils::parseFloat(data[5]),
-                                                                 utils::parseFloat(data[6])});
-                    }
-                } else if (data[0] == "vn") {
-                    state.normals.insert(state.normals.end(), {utils::parseFloat(data[1]),
-                                                               utils::parseFloat(data[2]),
-                                                               utils::parseFloat(data[3])});
-                } else if (data[0] == "vt") {
-                    state.uvs.insert(state.uvs.end(), {utils::parseFloat(data[1]),
-                                                       utils::parseFloat(data[2])});
-                }
-            } else if (lineFirstChar == 'f') {
-
-                std::string lineData{line.begin() + 1, line.end()};
-                utils::trimInplace(lineData);
-                auto vertexData = utils::split(lineData, ' ');
-                std::vector<std::vector<std::string>> faceVertices;
-
-                for (const auto& vertex : vertexData) {
-
-                    if (!vertexData.empty()) {
-                        auto vertexParts = utils::split(vertex, '/');
-                        faceVertices.insert(faceVertices.end(), vertexParts);
-                    }
-                }
-
-                auto& v1 = faceVertices[0];
+        unsigned int threadCount = scope.threadCount;
+        if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+        if (file.size() < minParallelSize) threadCount = 1;
 
-                for (unsigned j = 1; j < faceVertices.size() - 1; ++j) {
+        auto chunks = splitChunks(file.data(), file.size(), threadCount);
 
-                    auto& v2 = faceVertices[j];
-                    auto& v3 = faceVertices[j + 1];
+        // count the vertex data of each chunk, so that it can be parsed directly into place
 
-                    state.addFace(v1[0], v2[0], v3[0],
-                                  v1[1], v2[1], v3[1],
-                                  v1[2], v2[2], v3[2]);
-                }
-
-
-            } else if (lineFirstChar == 'l') {
-
-                // TODO
-
-            } else if (lineFirstChar == 'p') {
-
-                auto lineData = utils::trim(line.substr(1));
-                auto pointData = utils::split(lineData, ' ');
-
-                state.addPointGeometry(pointData);
+        parallelFor(chunks.size(), threadCount, [&](size_t i) { chunks[i].count(); });
 
-            } else if (lineFirstChar == 's') {
+        size_t vertexCount = 0, normalCount = 0, uvCount = 0;
+        for (auto& chunk : chunks) {
+            chunk.vertexOffset = vertexCount;
+            chunk.normalOffset = normalCount;
+            chunk.uvOffset = uvCount;
 
-                auto result = utils::split(line, ' ');
-
-                if (!result.empty()) {
-
-                    auto value = utils::trim(result[1]);
-                    utils::toLowerInplace(value);
-                    state.object->smooth = (value != "0" && value != "off");
+            vertexCount += chunk.vertices;
+            normalCount += chunk.normals;
+            uvCount += chunk.uvs;
+        }
 
-                } else {
+        Source source;
+        source.vertices.resize(vertexCount * 3);
+        source.normals.resize(normalCount * 3);
+        source.uvs.resize(uvCount * 2);
 
-                    state.object->smooth = true;
-                }
+        parallelFor(chunks.size(), threadCount, [&](size_t i) {
+            chunks[i].parse(source.vertices, source.normals, source.uvs);
+        });
 
-                auto material = state.object->currentMaterial();
-                if (material) {
-                    material->smooth = state.object->smooth;
-                }
+        const bool hasColors = std::any_of(chunks.begin(), chunks.end(), [](const Chunk& chunk) { return !chunk.colors.empty(); });
+        if (hasColors) {
+            source.colors.resize(vertexCount * 3, 1.f);
+            for (const auto& chunk : chunks) {
+                std::copy(chunk.colors.begin(), chunk.colors.end(), source.colors.begin() + static_cast<std::ptrdiff_t>(chunk.vertexOffset * 3));
+            }
+        }
 
-            } else {
-                static std::regex r("^[og]\\s+(.*)");
-                std::smatch match;
-                if (std::regex_match(line, match, r)) {
-                    std::string name = utils::trim(match[1]);
-                    state.startObject(name);
-                    continue;
-                }
-                if (line.find("usemtl ") != std::string::npos) {
-                    state.object->startMaterial(utils::trim(line.substr(7)), state.materialLibraries);
-                    continue;
-                }
-                if (line.find("mtllib ") != std::string::npos) {
-                    state.materialLibraries.emplace_back(utils::trim(line.substr(7)));
-                    continue;
-                }
+        // objects, groups and materials depend on everything that precedes them, so these are resolved in order
 
+        ParserState state(hasColors);
+        for (const auto& chunk : chunks) {
+            state.replay(chunk);
+        }
 
-                if (line == "\\0") continue;
+        state.finalize();
 
-                std::cerr << "[OBJLoader] Unexpected line: " << line << ":" << line.size() << std::endl;
-            }
+        for (const auto& object : state.objects) {
+            auto& geometry = object->geometry;
+            geometry.vertices.resize(geometry.vertexCount * 3);
+            geometry.normals.resize(geometry.normalCount * 3);
+            geometry.uvs.resize(geometry.uvCount * 2);
+            geometry.colors.resize(geometry.colorCount * 3);
         }
 
-        state.finalize();
+        parallelFor(state.segments.size(), threadCount, [&](size_t i) {
+            writeSegment(source, state.segments[i]);
+        });
 
         auto container = Group::create();
 
@@ -445,17 +750,17 @@ struct OBJLoader::Impl {
             auto& materials = object->materials;
             bool isLine = geometry.type == "Line";
             bool isPoints = geometry.type == "Points";
-            bool hasVertexColors = false;
+            bool hasVertexColors = !geometry.colors.empty();
 
             if (geometry.vertices.empty()) continue;
 
             auto bufferGeometry = BufferGeometry::create();
 
-            bufferGeometry->setAttribute("position", FloatBufferAttribute::create(geometry.vertices, 3));
+            bufferGeometry->setAttribute("position", FloatBufferAttribute::create(std::move(geometry.vertices), 3));
 
             if (!geometry.normals.empty()) {
 
-                bufferGeometry->setAttribute("normal", FloatBufferAttribute::create(geometry.normals, 3));
+                bufferGeometry->setAttribute("normal", FloatBufferAttribute::create(std::move(geometry.normals), 3));
 
             } else {
 
@@ -464,12 +769,12 @@ struct OBJLoader::Impl {
 
             if (!geometry.colors.empty()) {
 
-                bufferGeometry->setAttribute("color", FloatBufferAttribute::create(geometry.colors, 3));
+                bufferGeometry->setAttribute("color", FloatBufferAttribute::create(std::move(geometry.colors), 3));
             }
 
             if (!geometry.uvs.empty()) {
 
-                bufferGeometry->setAttribute("uv", FloatBufferAttribute::create(geometry.uvs, 2));
+                bufferGeometry->setAttribute("uv", FloatBufferAttribute::create(std::move(geometry.uvs), 2));
             }
 
             std::vector<std::shared_ptr<Material>> createdMaterials;
@@ -1,12 +1,238 @@
 
 #include "threepp/loaders/STLLoader.hpp"
 
-#include <fstream>
+#include "threepp/utils/CharConv.hpp"
+#include "threepp/utils/MemoryMappedFile.hpp"
+#include "threepp/utils/ThreadPool.hpp"
+
+#include <array>
+#include <cstring>
 #include <iostream>
-#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
 
 using namespace threepp;
 
+namespace {
+
+    constexpr size_t headerLength = 84;
+    constexpr size_t faceLength = 12 * 4 + 2;
+
+    // files smaller than this are parsed on the calling thread
+    constexpr size_t minParallelSize = 1 << 20;
+
+    bool isBinary(const char* data, size_t size) {
+
+        if (size >= headerLength) {
+
+            uint32_t faces;
+            std::memcpy(&faces, data + 80, sizeof(uint32_t));
+
+            if (headerLength + static_cast<size_t>(faces) * faceLength == size) return true;
+        }
+
+        // ASCII files start with 'solid', although some binary files do as well
+        std::string_view text(data, size);
+        const auto start = text.find_first_not_of(" \t\r\n");
+
+        return start == std::string_view::npos || text.compare(start, 5, "solid") != 0;
+    }
+
+    unsigned int resolveThreadCount(unsigned int threadCount, size_t size) {
+
+        if (size < minParallelSize) return 1;
+        if (threadCount == 0) threadCount = std::thread::hardware_concurrency();
+
+        return std::max(1u, threadCount);
+    }
+
+    // runs f(chunk) for chunks [0, chunks), on a pool when more than one thread is requested
+    template<class F>
+    void forEachChunk(unsigned int chunks, unsigned int threadCount, const F& f) {
+
+        if (threadCount <= 1) {
+
+            for (unsigned int chunk = 0; chunk < chunks; ++chunk) f(chunk);
+            return;
+        }
+
+        utils::ThreadPool pool(threadCount);
+        for (unsigned int chunk = 0; chunk < chunks; ++chunk) {
+            pool.submit([&f, chunk] { f(chunk); });
+        }
+        pool.wait();
+    }
+
+    void parseBinary(const char* data, size_t size, unsigned int threadCount, std::vector<float>& vertices, std::vector<float>& normals) {
+
+        if (size < headerLength) return;
+
+        uint32_t faces;
+        std::memcpy(&faces, data + 80, sizeof(uint32_t));
+
+        // truncated files are read as far as they go
+        faces = static_cast<uint32_t>(std::min<size_t>(faces, (size - headerLength) / faceLength));
+
+        vertices.resize(static_cast<size_t>(faces) * 9);
+        normals.resize(static_cast<size_t>(faces) * 9);
+
+        threadCount = resolveThreadCount(threadCount, size);
+        const auto facesPerChunk = (faces + threadCount - 1) / threadCount;
+
+        forEachChunk(threadCount, threadCount, [&](unsigned int chunk) {
+            const size_t first = static_cast<size_t>(chunk) * facesPerChunk;
+            const size_t last = std::min<size_t>(first + facesPerChunk, faces);
+
+            for (size_t face = first; face < last; ++face) {
+
+                const char* start = data + headerLength + face * faceLength;
+
+                float normal[3];
+                std::memcpy(normal, start, sizeof(normal));
+                std::memcpy(&vertices[face * 9], start + 12, 9 * sizeof(float));
+
+                for (size_t i = 0; i < 9; i += 3) {
+                    std::memcpy(&normals[face * 9 + i], normal, sizeof(normal));
+                }
+            }
+        });
+    }
+
+    class AsciiParser {
+
+    public:
+        AsciiParser(const char* begin, const char* end): pos_(begin), end_(end) {}
+
+        void parse(std::vector<float>& vertices, std::vector<float>& normals) {
+
+            float normal[3]{};
+            std::string_view token;
+
+            while (next(token)) {
+
+                if (token == "vertex") {
+
+                    float vertex[3]{};
+                    for (float& value : vertex) number(value);
+
+                    vertices.insert(vertices.end(), vertex, vertex + 3);
+                    normals.insert(normals.end(), normal, normal + 3);
+
+                } else if (token == "facet") {
+
+                    next(token);// normal
+                    for (float& value : normal) number(value);
+                }
+            }
+        }
+
+    private:
+        const char* pos_;
+        const char* end_;
+
+        static bool isSpace(char c) {
+
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        bool next(std::string_view& token) {
+
+            while (pos_ < end_ && isSpace(*pos_)) ++pos_;
+            const char* start = pos_;
+            while (pos_ < end_ && !isSpace(*pos_)) ++pos_;
+
+            token = std::string_view(start, pos_ - start);
+
+            return !token.empty();
+        }
+
+        void number(float& value) {
+
+            std::string_view token;
+            if (next(token)) utils::fromChars(token, value);
+        }
+    };
+
+    void parseAscii(const char* data, size_t size, unsigned int threadCount, std::vector<float>& vertices, std::vector<float>& normals) {
+
+        const std::string_view text(data, size);
+
+        // chunks end right after a facet, so that no facet is split between chunks
+        threadCount = resolveThreadCount(threadCount, size);
+
+        std::vector<size_t> bounds{0};
+        for (unsigned int i = 1; i < threadCount; ++i) {
+
+            const auto pos = text.find("endfacet", std::max(bounds.back(), size * i / threadCount));
+            if (pos == std::string_view::npos) break;
+
+            bounds.emplace_back(pos + 8);
+        }
+        bounds.emplace_back(size);
+
+        const auto chunks = static_cast<unsigned int>(bounds.size() - 1);
+
+        std::vector<std::vector<float>> chunkVertices(chunks);
+        std::vector<std::vector<float>> chunkNormals(chunks);
+
+        forEachChunk(chunks, threadCount, [&](unsigned int chunk) {
+            AsciiParser parser(data + bounds[chunk], data + bounds[chunk + 1]);
+            parser.parse(chunkVertices[chunk], chunkNormals[chunk]);
+        });
+
+        if (chunks == 1) {
+
+            vertices = std::move(chunkVertices.front());
+            normals = std::move(chunkNormals.front());
+            return;
+        }
+
+        for (unsigned int chunk = 0; chunk < chunks; ++chunk) {
+
+            vertices.insert(vertices.end(), chunkVertices[chunk].begin(), chunkVertices[chunk].end());
+            normals.insert(normals.end(), chunkNormals[chunk].begin(), chunkNormals[chunk].end());
+        }
+    }
+
+    struct PositionHash {
+
+        size_t operator()(const std::array<uint32_t, 3>& p) const {
+
+            return (p[0] * 73856093u) ^ (p[1] * 19349663u) ^ (p[2] * 83492791u);
+        }
+    };
+
+    void merge(std::vector<float>& vertices, std::vector<unsigned int>& index) {
+
+        const auto count = vertices.size() / 3;
+
+        std::unordered_map<std::array<uint32_t, 3>, unsigned int, PositionHash> map;
+        map.reserve(count / 4);
+
+        index.resize(count);
+
+        size_t unique = 0;
+        for (size_t i = 0; i < count; ++i) {
+
+            std::array<uint32_t, 3> key{};
+            std::memcpy(key.data(), &vertices[i * 3], sizeof(key));
+
+            const auto [it, inserted] = map.try_emplace(key, static_cast<unsigned int>(unique));
+
+            if (inserted) {
+
+                std::memmove(&vertices[unique * 3], &vertices[i * 3], 3 * sizeof(float));
+                ++unique;
+            }
+
+            index[i] = it->second;
+        }
+
+        vertices.resize(unique * 3);
+    }
+
+}// namespace
 
 std::shared_ptr<BufferGeometry> STLLoader::load(const std::filesystem::path& path) const {
 
@@ -15,54 +241,41 @@ std::shared_ptr<BufferGeometry> STLLoader::load(const std::filesystem::path& pat
         return nullptr;
     }
 
-    std::ifstream reader(path, std::ios::binary);
-    reader.seekg(80, std::ios::beg);
+    utils::MemoryMappedFile file(path);
 
-    uint32_t faces;
-    reader.read(reinterpret_cast<char*>(&faces), sizeof(uint32_t));
+    if (!file.valid()) {
+        std::cerr << "[STLLoader] Unable to read file: '" << absolute(path).string() << "'!" << std::endl;
+        return nullptr;
+    }
 
-    const int dataOffset = 84;
-    const int faceLength = 12 * 4 + 2;
+    std::vector<float> vertices;
+    std::vector<float> normals;
 
-    auto geometry = std::make_shared<BufferGeometry>();
+    if (isBinary(file.data(), file.size())) {
 
-    std::vector<float> vertices(faces * 3 * 3);
-    std::vector<float> normals(faces * 3 * 3);
+        parseBinary(file.data(), file.size(), threadCount, vertices, normals);
 
-    float normalX;
-    float normalY;
-    float normalZ;
+    } else {
 
-    for (int face = 0; face < faces; face++) {
-        int start = dataOffset + face * faceLength;
-        reader.seekg(start, std::ios::beg);
+        parseAscii(file.data(), file.size(), threadCount, vertices, normals);
+    }
 
-        reader.read(reinterpret_cast<char*>(&normalX), sizeof(float));
-        reader.read(reinterpret_cast<char*>(&normalY), sizeof(float));
-        reader.read(reinterpret_cast<char*>(&normalZ), sizeof(float));
+    auto geometry = BufferGeometry::create();
 
+    if (mergeVertices) {
 
-        for (int i = 1; i <= 3; i++) {
-            int vertexStart = start + i * 12;
-            int componentIdx = face * 3 * 3 + (i - 1) * 3;
-            reader.seekg(vertexStart, std::ios::beg);
+        std::vector<unsigned int> index;
+        merge(vertices, index);
 
-            float& x = vertices.emplace_back();
-            float& y = vertices.emplace_back();
-            float& z = vertices.emplace_back();
+        geometry->setIndex(index);
+        geometry->setAttribute("position", FloatBufferAttribute::create(std::move(vertices), 3));
+        geometry->computeVertexNormals();
 
-            reader.read(reinterpret_cast<char*>(&vertices[componentIdx]), 4);
-            reader.read(reinterpret_cast<char*>(&vertices[componentIdx + 1]), 4);
-            reader.read(reinterpret_cast<char*>(&vertices[componentIdx + 2]), 4);
+    } else {
 
-            normals[componentIdx] = normalX;
-            normals[componentIdx + 1] = normalY;
-            normals[componentIdx + 2] = normalZ;
-        }
+        geometry->setAttribute("position", FloatBufferAttribute::create(std::move(vertices), 3));
+        geometry->setAttribute("normal", FloatBufferAttribute::create(std::move(normals), 3));
     }
 
-    geometry->setAttribute("position", FloatBufferAttribute::create(vertices, 3));
-    geometry->setAttribute("normal", FloatBufferAttribute::create(normals, 3));
-
     return geometry;
 }
@@ -2,9 +2,13 @@
 #include "threepp/loaders/TextureLoader.hpp"
 
 #include "threepp/loaders/ImageLoader.hpp"
+#include "threepp/utils/ImageUtils.hpp"
+#include "threepp/utils/ThreadPool.hpp"
 
+#include <atomic>
 #include <iostream>
 #include <regex>
+#include <thread>
 #include <vector>
 
 using namespace threepp;
@@ -18,6 +22,28 @@ namespace {
         return std::regex_match(path, reg);
     }
 
+    std::shared_ptr<Texture> createTexture(Image image) {
+
+        // moved rather than copied into the texture
+        std::vector<Image> images;
+        images.emplace_back(std::move(image));
+
+        return Texture::create(std::move(images));
+    }
+
+    // An image being decoded on a worker thread.
+    struct PendingImage {
+
+        std::filesystem::path path;
+        std::weak_ptr<Texture> texture;
+        bool isJPEG;
+        std::function<void(Texture&)> onLoad;
+
+        std::optional<Image> image;
+        std::vector<Image> mipmaps;
+        std::atomic<bool> decoded{false};
+    };
+
 }// namespace
 
 struct TextureLoader::Impl {
@@ -26,6 +52,10 @@ struct TextureLoader::Impl {
     ImageLoader imageLoader_;
     std::unordered_map<std::string, std::weak_ptr<Texture>> cache_;
 
+    std::vector<std::shared_ptr<PendingImage>> pending_;
+    // declared last, so that the workers are done before the rest is destroyed
+    std::unique_ptr<utils::ThreadPool> pool_;
+
     explicit Impl(bool useCache): useCache_(useCache) {}
 
     std::shared_ptr<Texture> checkCache(const std::string& name) {
@@ -44,7 +74,7 @@ struct TextureLoader::Impl {
         return tex;
     }
 
-    std::shared_ptr<Texture> load(const std::filesystem::path& path, bool flipY) {
+    std::shared_ptr<Texture> load(const std::filesystem::path& path, bool flipY, bool generateMipmaps) {
 
         if (auto cachedTexture = checkCache(path.string())) {
 
@@ -60,10 +90,11 @@ struct TextureLoader::Impl {
 
         auto image = imageLoader_.load(path, isJPEG ? 3 : 4, flipY);
 
-        auto texture = Texture::create(*image);
+        auto texture = createTexture(std::move(*image));
         texture->name = path.stem().string();
 
         texture->format = isJPEG ? Format::RGB : Format::RGBA;
+        if (generateMipmaps) threepp::generateMipmaps(*texture);
         texture->needsUpdate();
 
         if (useCache_) cache_[path.string()] = texture;
@@ -71,7 +102,7 @@ struct TextureLoader::Impl {
         return texture;
     }
 
-    std::shared_ptr<Texture> loadFromMemory(const std::string& name, const std::vector<unsigned char>& data, bool flipY) {
+    std::shared_ptr<Texture> loadFromMemory(const std::string& name, const std::vector<unsigned char>& data, bool flipY, bool generateMipmaps) {
 
         if (auto cachedTexture = checkCache(name)) {
 
@@ -82,16 +113,114 @@ struct TextureLoader::Impl {
 
         auto image = imageLoader_.load(data, isJPEG ? 3 : 4, flipY);
 
-        auto texture = Texture::create(*image);
+        auto texture = createTexture(std::move(*image));
         texture->name = name;
 
         texture->format = isJPEG ? Format::RGB : Format::RGBA;
+        if (generateMipmaps) threepp::generateMipmaps(*texture);
         texture->needsUpdate();
 
         if (useCache_) cache_[name] = texture;
 
         return texture;
     }
+
+    std::shared_ptr<Texture> loadAsync(const std::filesystem::path& path, bool flipY, bool generateMipmaps, const std::function<void(Texture&)>& onLoad) {
+
+        if (auto cachedTexture = checkCache(path.string())) {
+
+            return cachedTexture;
+        }
+
+        if (!std::filesystem::exists(path)) {
+            std::cerr << "[TextureLoader] No such file: '" << absolute(path).string() << "'!" << std::endl;
+            return nullptr;
+        }
+
+        auto texture = createTexture(Image{std::vector<unsigned char>{255, 255, 255, 255}, 1, 1, flipY});
+        texture->name = path.stem().string();
+        texture->needsUpdate();
+
+        if (useCache_) cache_[path.string()] = texture;
+
+        auto pending = std::make_shared<PendingImage>();
+        pending->path = path;
+        pending->texture = texture;
+        pending->isJPEG = checkIsJPEG(path.string());
+        pending->onLoad = onLoad;
+        pending_.emplace_back(pending);
+
+        if (!pool_) {
+
+            pool_ = std::make_unique<utils::ThreadPool>(std::max(1u, std::thread::hardware_concurrency()));
+        }
+
+        pool_->submit([this, pending, flipY, generateMipmaps] {
+            const auto channels = pending->isJPEG ? 3 : 4;
+            pending->image = imageLoader_.load(pending->path, channels, flipY);
+            if (generateMipmaps && pending->image && pending->image->width > 0) {
+                pending->mipmaps = threepp::generateMipmaps(*pending->image, channels);
+            }
+            pending->decoded.store(true, std::memory_order_release);
+        });
+
+        return texture;
+    }
+
+    size_t update() {
+
+        size_t loaded = 0;
+
+        auto it = pending_.begin();
+        while (it != pending_.end()) {
+
+            auto& pending = **it;
+
+            if (!pending.decoded.load(std::memory_order_acquire)) {
+
+                ++it;
+                continue;
+            }
+
+            auto texture = pending.texture.lock();
+
+            if (texture && pending.image && pending.image->width > 0) {
+
+                texture->image.clear();
+                texture->image.emplace_back(std::move(*pending.image));
+
+                texture->format = pending.isJPEG ? Format::RGB : Format::RGBA;
+
+                if (!pending.mipmaps.empty()) {
+
+                    texture->mipmaps = std::move(pending.mipmaps);
+                    // rows of the smaller levels are not 4 byte aligned
+                    if (pending.isJPEG) texture->unpackAlignment = 1;
+                }
+
+                texture->needsUpdate();
+
+                if (pending.onLoad) pending.onLoad(*texture);
+
+                ++loaded;
+
+            } else if (texture) {
+
+                std::cerr << "[TextureLoader] Failed to decode '" << pending.path.string() << "'!" << std::endl;
+            }
+
+            it = pending_.erase(it);
+        }
+
+        return loaded;
+    }
+
+    size_t wait() {
+
+        if (pool_) pool_->wait();
+
+        return update();
+    }
 };
 
 TextureLoader::TextureLoader(bool useCache)
@@ -99,12 +228,32 @@ TextureLoader::TextureLoader(bool useCache)
 
 std::shared_ptr<Texture> TextureLoader::load(const std::filesystem::path& path, bool flipY) {
 
-    return pimpl_->load(path, flipY);
+    return pimpl_->load(path, flipY, generateMipmaps);
 }
 
 std::shared_ptr<Texture> TextureLoader::loadFromMemory(const std::string& name, const std::vector<unsigned char>& data, bool flipY) {
 
-    return pimpl_->loadFromMemory(name, data, flipY);
+    return pimpl_->loadFromMemory(name, data, flipY, generateMipmaps);
+}
+
+std::shared_ptr<Texture> TextureLoader::loadAsync(const std::filesystem::path& path, bool flipY, const std::function<void(Texture&)>& onLoad) {
+
+    return pimpl_->loadAsync(path, flipY, generateMipmaps, onLoad);
+}
+
+size_t TextureLoader::update() {
+
+    return pimpl_->update();
+}
+
+size_t TextureLoader::wait() {
+
+    return pimpl_->wait();
+}
+
+size_t TextureLoader::pending() const {
+
+    return pimpl_->pending_.size();
 }
 
 void TextureLoader::clearCache() {
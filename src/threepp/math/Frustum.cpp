@@ -6,11 +6,6 @@
 
 using namespace threepp;
 
-namespace {
-    Sphere _sphere{};
-    Vector3 _vector{};
-}// namespace
-
 Frustum::Frustum(Plane p0, Plane p1, Plane p2, Plane p3, Plane p4, Plane p5)
     : planes_{p0, p1, p2, p3, p4, p5} {}
 
@@ -60,12 +55,15 @@ bool Frustum::intersectsObject(Object3D& object) const {
 
     if (!geometry->boundingSphere) geometry->computeBoundingSphere();
 
+    Sphere _sphere;
     _sphere.copy(geometry->boundingSphere.value()).applyMatrix4(*object.matrixWorld);
 
     return this->intersectsSphere(_sphere);
 }
 
 bool Frustum::intersectsSprite(const Sprite& sprite) const {
+
+    Sphere _sphere;
     _sphere.center.set(0, 0, 0);
     _sphere.radius = 0.7071067811865476f;
     _sphere.applyMatrix4(*sprite.matrixWorld);
@@ -93,6 +91,8 @@ bool Frustum::intersectsSphere(const Sphere& sphere) const {
 
 bool Frustum::intersectsBox(const Box3& box) const {
 
+    Vector3 _vector;
+
     for (int i = 0; i < 6; i++) {
 
         const auto& plane = planes_[i];
@@ -7,10 +7,10 @@ using namespace threepp;
 
 namespace {
 
-    Vector3 _v0{};
-    Vector3 _v1{};
-    Vector3 _v2{};
-    Vector3 _v3{};
+    thread_local Vector3 _v0{};
+    thread_local Vector3 _v1{};
+    thread_local Vector3 _v2{};
+    thread_local Vector3 _v3{};
 
 }// namespace
 
@@ -156,12 +156,12 @@ void Triangle::closestPointToPoint(const Vector3& p, Vector3& target) {
     const auto a = this->a_, b = this->b_, c = this->c_;
     float v, w;
 
-    static Vector3 _vab{};
-    static Vector3 _vac{};
-    static Vector3 _vap{};
-    static Vector3 _vbp{};
-    static Vector3 _vcp{};
-    static Vector3 _vbc{};
+    Vector3 _vab;
+    Vector3 _vac;
+    Vector3 _vap;
+    Vector3 _vbp;
+    Vector3 _vcp;
+    Vector3 _vbc;
 
 
     // algorithm thanks to Real-Time Collision Detection by Christer Ericson,
@@ -0,0 +1,82 @@
+
+#include "threepp/objects/BatchedMesh.hpp"
+
+#include <algorithm>
+
+using namespace threepp;
+
+namespace {
+
+    // visibility of the source, including its ancestors below the batch root
+    bool isVisible(const Object3D* object, const Object3D* root) {
+
+        for (; object != root; object = object->parent) {
+
+            // detached from the root
+            if (!object || !object->visible) return false;
+        }
+
+        return true;
+    }
+
+}// namespace
+
+BatchedMesh::BatchedMesh(std::shared_ptr<BufferGeometry> geometry, std::shared_ptr<Material> material, std::vector<Range> ranges, const Object3D* root)
+    : Mesh(std::move(geometry), std::move(material)), ranges_(std::move(ranges)), root_(root) {
+
+    // layers are tested per source
+    layers.enableAll();
+}
+
+std::string BatchedMesh::type() const {
+
+    return "BatchedMesh";
+}
+
+const std::vector<BatchedMesh::Range>& BatchedMesh::ranges() const {
+
+    return ranges_;
+}
+
+void BatchedMesh::removeRanges(const std::function<bool(const Range&)>& predicate) {
+
+    ranges_.erase(std::remove_if(ranges_.begin(), ranges_.end(), predicate), ranges_.end());
+}
+
+void BatchedMesh::computeDrawRanges(const Frustum& frustum, const Layers& layers, std::vector<int>& starts, std::vector<int>& counts) const {
+
+    starts.clear();
+    counts.clear();
+
+    Sphere sphere;
+
+    for (const auto& range : ranges_) {
+
+        auto object = range.object;
+
+        bool visible = isVisible(object, root_) && object->layers.test(layers);
+
+        if (visible && object->frustumCulled) {
+
+            sphere.copy(range.boundingSphere).applyMatrix4(*matrixWorld);
+            visible = frustum.intersectsSphere(sphere);
+        }
+
+        if (!visible) continue;
+
+        if (!starts.empty() && starts.back() + counts.back() == range.start) {
+
+            counts.back() += range.count;
+
+        } else {
+
+            starts.emplace_back(range.start);
+            counts.emplace_back(range.count);
+        }
+    }
+}
+
+std::shared_ptr<BatchedMesh> BatchedMesh::create(std::shared_ptr<BufferGeometry> geometry, std::shared_ptr<Material> material, std::vector<Range> ranges, const Object3D* root) {
+
+    return std::make_shared<BatchedMesh>(std::move(geometry), std::move(material), std::move(ranges), root);
+}
@@ -9,10 +9,10 @@ using namespace threepp;
 
 namespace {
 
-    Matrix4 _instanceLocalMatrix;
-    Matrix4 _instanceWorldMatrix;
+    thread_local Matrix4 _instanceLocalMatrix;
+    thread_local Matrix4 _instanceWorldMatrix;
 
-    std::vector<Intersection> _instanceIntersects;
+    thread_local std::vector<Intersection> _instanceIntersects;
 
 }// namespace
 
@@ -47,7 +47,7 @@ void InstancedMesh::setColorAt(size_t index, const Color& color) {
 
     if (!this->instanceColor) {
 
-        this->instanceColor = FloatBufferAttribute ::create(std::vector<float>(count * 3), 3);
+        this->instanceColor = FloatBufferAttribute ::create(std::vector<float>(instanceMatrix->count() * 3), 3);
     }
 
     color.toArray(this->instanceColor->array(), index * 3);
@@ -71,10 +71,7 @@ void InstancedMesh::raycast(Raycaster& raycaster, std::vector<Intersection>& int
     const auto& matrixWorld = this->matrixWorld;
     const auto raycastTimes = this->count;
 
-    _mesh.setGeometry(geometry_);
-    _mesh.setMaterials(materials_);
-
-    if (!_mesh.material()) return;
+    if (!material()) return;
 
     for (int instanceId = 0; instanceId < raycastTimes; instanceId++) {
 
@@ -84,18 +81,15 @@ void InstancedMesh::raycast(Raycaster& raycaster, std::vector<Intersection>& int
 
         _instanceWorldMatrix.multiplyMatrices(*matrixWorld, _instanceLocalMatrix);
 
-        // the mesh represents this single instance
-
-        _mesh.matrixWorld->copy(_instanceWorldMatrix);
+        // raycast the geometry as this single instance
 
-        _mesh.raycast(raycaster, _instanceIntersects);
+        Mesh::raycast(raycaster, _instanceWorldMatrix, _instanceIntersects);
 
         // process the result of raycast
 
         for (auto& intersect : _instanceIntersects) {
 
             intersect.instanceId = instanceId;
-            intersect.object = this;
             intersects.emplace_back(intersect);
         }
 
@@ -19,10 +19,10 @@ using namespace threepp;
 namespace {
 
     std::optional<Intersection> checkIntersection(
-            Object3D* object, Material* material, Raycaster& raycaster, Ray& ray,
+            Object3D* object, const Matrix4& matrixWorld, Material* material, Raycaster& raycaster, Ray& ray,
             const Vector3& pA, const Vector3& pB, const Vector3& pC, Vector3& point) {
 
-        static Vector3 _intersectionPointWorld{};
+        Vector3 _intersectionPointWorld;
 
         if (material->side == Side::Back) {
 
@@ -36,7 +36,7 @@ namespace {
         if (point.isNan()) return std::nullopt;
 
         _intersectionPointWorld.copy(point);
-        _intersectionPointWorld.applyMatrix4(*object->matrixWorld);
+        _intersectionPointWorld.applyMatrix4(matrixWorld);
 
         const auto distance = raycaster.ray.origin.distanceTo(_intersectionPointWorld);
 
@@ -51,7 +51,7 @@ namespace {
     }
 
     std::optional<Intersection> checkBufferGeometryIntersection(
-            Object3D* object, Material* material,
+            Object3D* object, const Matrix4& matrixWorld, Material* material,
             Raycaster& raycaster, Ray& ray,
             const FloatBufferAttribute& position,
             const std::vector<std::shared_ptr<BufferAttribute>>* morphPosition,
@@ -60,10 +60,10 @@ namespace {
             const FloatBufferAttribute* uv2,
             unsigned int a, unsigned int b, unsigned int c) {
 
-        static Vector3 _vA{};
-        static Vector3 _vB{};
-        static Vector3 _vC{};
-        static Vector3 _intersectionPoint{};
+        Vector3 _vA;
+        Vector3 _vB;
+        Vector3 _vC;
+        Vector3 _intersectionPoint;
 
         position.setFromBufferAttribute(_vA, a);
         position.setFromBufferAttribute(_vB, b);
@@ -129,13 +129,13 @@ namespace {
             skinned->boneTransform(c, _vC);
         }
 
-        auto intersection = checkIntersection(object, material, raycaster, ray, _vA, _vB, _vC, _intersectionPoint);
+        auto intersection = checkIntersection(object, matrixWorld, material, raycaster, ray, _vA, _vB, _vC, _intersectionPoint);
 
         if (intersection) {
 
-            static Vector2 _uvA{};
-            static Vector2 _uvB{};
-            static Vector2 _uvC{};
+            Vector2 _uvA;
+            Vector2 _uvB;
+            Vector2 _uvC;
 
             if (uv) {
 
@@ -196,25 +196,30 @@ std::vector<Material*> Mesh::materials() {
 
 void Mesh::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects) {
 
+    raycast(raycaster, *this->matrixWorld, intersects);
+}
+
+void Mesh::raycast(Raycaster& raycaster, const Matrix4& matrixWorld, std::vector<Intersection>& intersects) {
+
     if (material() == nullptr) return;
 
-    static Sphere _sphere{};
+    Sphere _sphere;
 
     // Checking boundingSphere distance to ray
 
     if (!geometry_->boundingSphere) geometry_->computeBoundingSphere();
 
     _sphere.copy(*geometry_->boundingSphere);
-    _sphere.applyMatrix4(*matrixWorld);
+    _sphere.applyMatrix4(matrixWorld);
 
     if (!raycaster.ray.intersectsSphere(_sphere)) return;
 
     //
 
-    static Ray _ray{};
-    static Matrix4 _inverseMatrix{};
+    Ray _ray;
+    Matrix4 _inverseMatrix;
 
-    _inverseMatrix.copy(*matrixWorld).invert();
+    _inverseMatrix.copy(matrixWorld).invert();
     _ray.copy(raycaster.ray).applyMatrix4(_inverseMatrix);
 
     // Check boundingBox before continuing
@@ -232,10 +237,77 @@ void Mesh::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects)
     const auto morphTargetsRelative = geometry_->morphTargetsRelative;
     const auto uv = geometry_->getAttribute<float>("uv");
     const auto uv2 = geometry_->getAttribute<float>("uv2");
-    const auto groups = geometry_->groups;
+    const auto& groups = geometry_->groups;
     const auto drawRange = geometry_->drawRange;
 
-    if (index != nullptr) {
+    // the bounds tree holds the triangles starting at multiples of 3, ranges starting in between are drawn as other triangles
+    const auto aligned = drawRange.start % 3 == 0 &&
+                         (numMaterials() == 1 || std::all_of(groups.begin(), groups.end(), [](const auto& group) { return group.start % 3 == 0; }));
+
+    // the bounds tree is built from the rest pose, so it can't be used with morph targets or skinning
+    const auto boundsTree = (aligned && !morphPosition && !is<SkinnedMesh>()) ? geometry_->boundsTree() : nullptr;
+
+    if (boundsTree && position != nullptr) {
+
+        std::vector<unsigned int> candidates;
+        boundsTree->intersectRay(_ray, candidates);
+
+        const int count = (index != nullptr) ? index->count() : position->count();
+
+        // whether the loops over [start, end) below visit the triangle
+        const auto inRange = [](int triangle, int start, int end) {
+            return triangle >= start / 3 && triangle < end / 3 + (end % 3 != 0);
+        };
+
+        for (const auto triangle : candidates) {
+
+            const int i = static_cast<int>(triangle) * 3;
+
+            const auto a = (index != nullptr) ? index->getX(i) : i;
+            const auto b = (index != nullptr) ? index->getX(i + 1) : i + 1;
+            const auto c = (index != nullptr) ? index->getX(i + 2) : i + 2;
+
+            if (numMaterials() > 1) {
+
+                for (auto& group : groups) {
+
+                    const auto start = std::max(group.start, drawRange.start);
+                    const auto end = std::min((group.start + group.count), (drawRange.start + drawRange.count));
+
+                    if (!inRange(static_cast<int>(triangle), start, end)) continue;
+
+                    intersection = checkBufferGeometryIntersection(
+                            this, matrixWorld, materials_[group.materialIndex].get(), raycaster, _ray, *position,
+                            morphPosition, morphTargetsRelative, uv, uv2, a, b, c);
+
+                    if (intersection) {
+
+                        intersection->faceIndex = i / 3;
+                        intersection->face->materialIndex = group.materialIndex;
+                        intersects.emplace_back(*intersection);
+                    }
+                }
+
+            } else {
+
+                const int start = std::max(0, drawRange.start);
+                const int end = std::min(count, (drawRange.start + drawRange.count));
+
+                if (!inRange(static_cast<int>(triangle), start, end)) continue;
+
+                intersection = checkBufferGeometryIntersection(
+                        this, matrixWorld, material(), raycaster, _ray, *position,
+                        morphPosition, morphTargetsRelative, uv, uv2, a, b, c);
+
+                if (intersection) {
+
+                    intersection->faceIndex = i / 3;
+                    intersects.emplace_back(*intersection);
+                }
+            }
+        }
+
+    } else if (index != nullptr) {
 
         // indexed buffer geometry
 
@@ -255,7 +327,7 @@ void Mesh::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects)
                     const auto c = index->getX(j + 2);
 
                     intersection = checkBufferGeometryIntersection(
-                            this, groupMaterial, raycaster, _ray, *position,
+                            this, matrixWorld, groupMaterial, raycaster, _ray, *position,
                             morphPosition, morphTargetsRelative, uv, uv2, a, b, c);
 
                     if (intersection) {
@@ -279,7 +351,7 @@ void Mesh::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects)
                 const auto c = index->getX(i + 2);
 
                 intersection = checkBufferGeometryIntersection(
-                        this, material(), raycaster, _ray, *position,
+                        this, matrixWorld, material(), raycaster, _ray, *position,
                         morphPosition, morphTargetsRelative, uv, uv2, a, b, c);
 
                 if (intersection) {
@@ -310,7 +382,7 @@ void Mesh::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects)
                     const auto c = j + 2;
 
                     intersection = checkBufferGeometryIntersection(
-                            this, groupMaterial, raycaster, _ray, *position,
+                            this, matrixWorld, groupMaterial, raycaster, _ray, *position,
                             morphPosition, morphTargetsRelative, uv, uv2, a, b, c);
 
                     if (intersection) {
@@ -334,7 +406,7 @@ void Mesh::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects)
                 const int c = i + 2;
 
                 intersection = checkBufferGeometryIntersection(
-                        this, material(), raycaster, _ray, *position,
+                        this, matrixWorld, material(), raycaster, _ray, *position,
                         morphPosition, morphTargetsRelative, uv, uv2, a, b, c);
 
                 if (intersection) {
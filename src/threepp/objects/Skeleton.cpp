@@ -1,6 +1,7 @@
 
 #include "threepp/objects/Skeleton.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -119,7 +120,9 @@ void Skeleton::update() {
 
     if (boneTexture) {
 
-        boneTexture->setData(boneMatrices);
+        // the texture owns a copy, so that it stays valid when the skeleton or the texture is copied
+        auto pixels = boneTexture->image.front().data<float>();
+        std::copy_n(boneMatrices.begin(), std::min(boneMatrices.size(), pixels.size()), pixels.begin());
         boneTexture->needsUpdate();
     }
 }
@@ -137,17 +140,12 @@ Skeleton& Skeleton::computeBoneTexture() {
     int sizei = math::ceilPowerOfTwo(size);
     sizei = std::max(sizei, 4);
 
-    auto boneMatrices = std::vector<float>(sizei * sizei * 4);// 4 floats per RGBA pixel
-    //                boneMatrices.set(this->boneMatrices);                   // copy current values
-    for (unsigned i = 0; i < this->boneMatrices.size(); ++i) {
-        boneMatrices[i] = this->boneMatrices[i];
-    }
+    this->boneMatrices.resize(sizei * sizei * 4);// 4 floats per RGBA pixel
 
     auto boneTexture = DataTexture::create(boneMatrices, sizei, sizei);
     boneTexture->format = Format::RGBA;
     boneTexture->type = Type::Float;
 
-    this->boneMatrices = boneMatrices;
     this->boneTexture = boneTexture;
     this->boneTextureSize = sizei;
 
@@ -0,0 +1,358 @@
+
+#include "threepp/objects/StaticBatch.hpp"
+
+#include "threepp/core/InstancedBufferGeometry.hpp"
+#include "threepp/objects/InstancedMesh.hpp"
+#include "threepp/objects/SkinnedMesh.hpp"
+#include "threepp/utils/BufferGeometryUtils.hpp"
+
+#include <algorithm>
+
+using namespace threepp;
+
+namespace {
+
+    bool isBatchable(Object3D& object, bool mirrored) {
+
+        if (!object.is<Mesh>() || object.is<InstancedMesh>() || object.is<SkinnedMesh>() || object.is<BatchedMesh>()) return false;
+        if (object.onBeforeRender || object.onAfterRender) return false;
+        if ((object.matrixWorld->determinant() < 0) != mirrored) return false;
+
+        auto& mesh = static_cast<Mesh&>(object);
+        if (mesh.numMaterials() != 1) return false;
+
+        auto material = mesh.material();
+        if (!material || material->transparent) return false;
+
+        auto geometry = mesh.geometry();
+        if (!geometry || dynamic_cast<InstancedBufferGeometry*>(geometry)) return false;
+        if (!geometry->hasAttribute("position") || !geometry->getMorphAttributes().empty()) return false;
+
+        const auto count = geometry->hasIndex() ? geometry->getIndex()->count() : geometry->getAttribute<float>("position")->count();
+
+        return geometry->drawRange.start == 0 && geometry->drawRange.count >= count;
+    }
+
+    // the transform of object relative to root, one of its ancestors, from the local transforms in between,
+    // so that it is left exactly as it was when only root moves
+    Matrix4 relativeTransform(const Object3D& object, const Object3D& root) {
+
+        Matrix4 relative;
+        relative.copy(*object.matrix);
+
+        for (auto parent = object.parent; parent && parent != &root; parent = parent->parent) {
+            relative.premultiply(*parent->matrix);
+        }
+
+        return relative;
+    }
+
+    // meshes can only be merged when their geometries have the same layout
+    std::string layoutOf(const BufferGeometry& geometry) {
+
+        std::vector<std::string> names;
+        for (const auto& [name, attribute] : geometry.getAttributes()) {
+            names.emplace_back(name + ":" + std::to_string(attribute->itemSize()));
+        }
+        std::sort(names.begin(), names.end());
+
+        std::string layout = geometry.hasIndex() ? "indexed" : "non-indexed";
+        for (const auto& name : names) {
+            layout += "," + name;
+        }
+
+        return layout;
+    }
+
+}// namespace
+
+bool StaticBatch::Source::operator==(const StaticBatch::Source& other) const {
+
+    return id == other.id && mesh == other.mesh && geometry == other.geometry && material == other.material &&
+           castShadow == other.castShadow && receiveShadow == other.receiveShadow && renderOrder == other.renderOrder &&
+           relative == other.relative;
+}
+
+StaticBatch::StaticBatch() {
+
+    addEventListener("childadded", &onAdded_);
+}
+
+std::string StaticBatch::type() const {
+
+    return "StaticBatch";
+}
+
+void StaticBatch::setDynamic(Object3D& object, bool dynamic) {
+
+    if (dynamic) {
+        dynamic_.insert(object.id);
+    } else {
+        dynamic_.erase(object.id);
+    }
+
+    changed_ = true;
+}
+
+bool StaticBatch::isDynamic(const Object3D& object) const {
+
+    return dynamic_.count(object.id);
+}
+
+bool StaticBatch::isBatched(const Object3D& object) const {
+
+    return batched_.count(object.id);
+}
+
+const std::vector<std::shared_ptr<BatchedMesh>>& StaticBatch::batches() const {
+
+    return batches_;
+}
+
+void StaticBatch::invalidate() {
+
+    invalidated_ = true;
+}
+
+void StaticBatch::updateMatrixWorld(bool force) {
+
+    Object3D::updateMatrixWorld(force);
+
+    update();
+
+    // the batches are not part of the scene graph, and follow this object
+    for (const auto& mesh : batches_) {
+
+        mesh->updateMatrixWorld();
+    }
+}
+
+void StaticBatch::update() {
+
+    if (!invalidated_ && !changed_ && !sourcesChanged()) return;
+
+    collected_.clear();
+    visited_.clear();
+    collect(*this);
+    watch();
+
+    changed_ = false;
+
+    if (!invalidated_ && collected_ == sources_) return;
+
+    // group the meshes, only batches whose members changed are rebuilt
+
+    std::map<std::string, std::vector<Source>> groups;
+    for (const auto& source : collected_) {
+
+        const auto key = std::to_string(source.material->id) + "/" +
+                         std::to_string(source.castShadow) + std::to_string(source.receiveShadow) + "/" +
+                         std::to_string(source.renderOrder) + "/" + layoutOf(*source.geometry);
+
+        groups[key].emplace_back(source);
+    }
+
+    std::map<std::string, Batch> batchMap;
+
+    for (auto& [key, sources] : groups) {
+
+        auto it = batchMap_.find(key);
+
+        if (!invalidated_ && it != batchMap_.end() && it->second.sources == sources) {
+
+            batchMap[key] = std::move(it->second);
+            batchMap_.erase(it);
+
+        } else {
+
+            auto mesh = build(sources);
+            batchMap[key] = {std::move(sources), std::move(mesh)};
+        }
+    }
+
+    // batches that have been rebuilt or are no longer used release their geometry here
+    batchMap_ = std::move(batchMap);
+
+    batches_.clear();
+    batched_.clear();
+
+    for (const auto& [key, batch] : batchMap_) {
+
+        if (!batch.mesh) continue;
+
+        batches_.emplace_back(batch.mesh);
+
+        for (const auto& source : batch.sources) {
+            batched_.insert(source.id);
+        }
+    }
+
+    sources_.swap(collected_);
+    invalidated_ = false;
+}
+
+bool StaticBatch::sourcesChanged() {
+
+    bool changed = false;
+
+    for (auto& source : sources_) {
+
+        auto& mesh = *source.mesh;
+
+        if (mesh.geometry() != source.geometry || mesh.material() != source.material ||
+            mesh.castShadow != source.castShadow || mesh.receiveShadow != source.receiveShadow || mesh.renderOrder != source.renderOrder) {
+
+            changed = true;
+        }
+
+        // only meshes whose world transform changed can have moved, which includes all of them when this object moves
+        if (mesh.matrixWorldVersion() != source.matrixWorldVersion) {
+
+            source.matrixWorldVersion = mesh.matrixWorldVersion();
+            if (relativeTransform(mesh, *this) != source.relative) changed = true;
+        }
+    }
+
+    return changed;
+}
+
+void StaticBatch::watch() {
+
+    for (auto object : watched_) {
+
+        object->removeEventListener("remove", &onRemoved_);
+        object->removeEventListener("childadded", &onAdded_);
+    }
+
+    watched_ = visited_;
+
+    for (auto object : watched_) {
+
+        object->addEventListener("remove", &onRemoved_);
+        object->addEventListener("childadded", &onAdded_);
+    }
+}
+
+void StaticBatch::purge() {
+
+    const auto attached = [this](const Object3D* object) {
+        for (; object; object = object->parent) {
+            if (object == this) return true;
+        }
+        return false;
+    };
+
+    // the removed objects are still alive while the event is dispatched
+    for (const auto& mesh : batches_) {
+
+        mesh->removeRanges([&](const BatchedMesh::Range& range) {
+            if (attached(range.object)) return false;
+
+            batched_.erase(range.object->id);
+            return true;
+        });
+    }
+
+    watched_.erase(std::remove_if(watched_.begin(), watched_.end(), [&](Object3D* object) {
+                       if (attached(object)) return false;
+
+                       object->removeEventListener("remove", &onRemoved_);
+                       object->removeEventListener("childadded", &onAdded_);
+                       return true;
+                   }),
+                   watched_.end());
+
+    invalidated_ = true;
+}
+
+void StaticBatch::RemovedListener::onEvent(Event&) {
+
+    scope_->purge();
+}
+
+void StaticBatch::AddedListener::onEvent(Event&) {
+
+    scope_->changed_ = true;
+}
+
+void StaticBatch::collect(Object3D& object) {
+
+    const bool mirrored = matrixWorld->determinant() < 0;
+
+    for (auto child : object.children) {
+
+        // nested batches take care of their own descendants
+        if (child->is<StaticBatch>()) continue;
+
+        visited_.emplace_back(child);
+
+        if (!dynamic_.count(child->id) && isBatchable(*child, mirrored)) {
+
+            collected_.push_back({child->id, static_cast<Mesh*>(child), child->geometry(), child->material(),
+                                  child->castShadow, child->receiveShadow, child->renderOrder,
+                                  relativeTransform(*child, *this), child->matrixWorldVersion()});
+        }
+
+        collect(*child);
+    }
+}
+
+std::shared_ptr<BatchedMesh> StaticBatch::build(const std::vector<Source>& sources) {
+
+    // a single mesh gains nothing from being batched
+    if (sources.size() < 2) return nullptr;
+
+    std::vector<std::shared_ptr<BufferGeometry>> geometries;
+    std::vector<BatchedMesh::Range> ranges;
+
+    for (const auto& source : sources) {
+
+        auto geometry = source.geometry->clone();
+        geometry->clearGroups();
+        geometry->applyMatrix4(source.relative);
+
+        if (!geometry->boundingSphere) geometry->computeBoundingSphere();
+
+        ranges.push_back({source.mesh, 0, 0, *geometry->boundingSphere});
+        geometries.emplace_back(geometry);
+    }
+
+    auto merged = mergeBufferGeometries(geometries, true);
+
+    if (!merged) return nullptr;
+
+    for (size_t i = 0; i < ranges.size(); ++i) {
+
+        ranges[i].start = merged->groups[i].start;
+        ranges[i].count = merged->groups[i].count;
+    }
+
+    merged->clearGroups();
+    merged->computeBoundingSphere();
+
+    const auto& front = sources.front();
+
+    auto mesh = BatchedMesh::create(merged, front.mesh->shared_material(), std::move(ranges), this);
+    mesh->followMatrixWorld(*this);
+    mesh->updateMatrixWorld();
+    mesh->castShadow = front.castShadow;
+    mesh->receiveShadow = front.receiveShadow;
+    mesh->renderOrder = front.renderOrder;
+
+    return mesh;
+}
+
+std::shared_ptr<StaticBatch> StaticBatch::create() {
+
+    return std::make_shared<StaticBatch>();
+}
+
+StaticBatch::~StaticBatch() {
+
+    // the watched objects are below this one, so they are still alive here
+    for (auto object : watched_) {
+
+        object->removeEventListener("remove", &onRemoved_);
+        object->removeEventListener("childadded", &onAdded_);
+    }
+}
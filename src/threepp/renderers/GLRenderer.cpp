@@ -13,9 +13,11 @@
 #include "threepp/renderers/gl/GLMorphTargets.hpp"
 #include "threepp/renderers/gl/GLObjects.hpp"
 #include "threepp/renderers/gl/GLPrograms.hpp"
+#include "threepp/renderers/gl/GLProjection.hpp"
 #include "threepp/renderers/gl/GLRenderLists.hpp"
 #include "threepp/renderers/gl/GLRenderStates.hpp"
 #include "threepp/renderers/gl/GLTextures.hpp"
+#include "threepp/renderers/gl/GLUniformBuffers.hpp"
 #include "threepp/renderers/gl/GLUtils.hpp"
 
 #include "threepp/cameras/OrthographicCamera.hpp"
@@ -23,6 +25,7 @@
 #include "threepp/materials/RawShaderMaterial.hpp"
 #include "threepp/math/Frustum.hpp"
 
+#include "threepp/objects/BatchedMesh.hpp"
 #include "threepp/objects/Group.hpp"
 #include "threepp/objects/InstancedMesh.hpp"
 #include "threepp/objects/LOD.hpp"
@@ -33,6 +36,8 @@
 #include "threepp/objects/SkinnedMesh.hpp"
 #include "threepp/objects/Sprite.hpp"
 
+#include "threepp/utils/ThreadPool.hpp"
+
 #ifndef EMSCRIPTEN
 #include "threepp/utils/LoadGlad.hpp"
 #else
@@ -40,6 +45,9 @@
 #endif
 
 #include <cmath>
+#include <thread>
+#include <typeinfo>
+#include <unordered_set>
 
 
 using namespace threepp;
@@ -66,6 +74,7 @@ struct GLRenderer::Impl {
 
     GLRenderer& scope;
 
+    gl::GLInfo _info;
     gl::GLState state;
 
 
@@ -85,6 +94,8 @@ struct GLRenderer::Impl {
     std::optional<unsigned int> _currentMaterialId;
 
     Camera* _currentCamera = nullptr;
+    // layers of the camera the scene is rendered for, which shadow passes draw batched meshes with
+    const Layers* _viewLayers = nullptr;
     Vector4 _currentViewport;
     Vector4 _currentScissor;
     std::optional<bool> _currentScissorTest;
@@ -105,6 +116,12 @@ struct GLRenderer::Impl {
 
     Frustum _frustum;
 
+    gl::GLProjection projection;
+    std::unique_ptr<utils::ThreadPool> projectionPool;
+
+    std::vector<int> multiDrawStarts;
+    std::vector<int> multiDrawCounts;
+
     // clipping
 
     bool _clippingEnabled = false;
@@ -116,8 +133,6 @@ struct GLRenderer::Impl {
 
     Vector3 _vector3;
 
-    gl::GLInfo _info;
-
     gl::GLProperties properties;
     gl::GLGeometries geometries;
     gl::GLBindingStates bindingStates;
@@ -138,24 +153,35 @@ struct GLRenderer::Impl {
 
     gl::GLShadowMap shadowMap;
 
+    gl::GLUniformBuffers uniformBuffers;
+
+    // meshes drawn on behalf of runs of render items sharing geometry and material,
+    // released before the GL objects they depend upon
+    std::vector<std::shared_ptr<InstancedMesh>> autoInstances;
+    size_t autoInstancesIndex = 0;
+
     Impl(GLRenderer& scope, WindowSize size, const GLRenderer::Parameters& parameters)
-        : scope(scope), _size(size),
-          cubemaps(scope),
-          bufferRenderer(std::make_unique<gl::GLBufferRenderer>(_info)),
-          indexedBufferRenderer(std::make_unique<gl::GLIndexedBufferRenderer>(_info)),
-          clipping(properties),
-          bindingStates(attributes),
+        : scope(scope),
+          state(_info),
+          _emptyScene(std::make_unique<Scene>()),
+          onMaterialDispose(this),
+          _size(size),
+          _currentDrawBuffers(GL_BACK),
           geometries(attributes, _info, bindingStates),
+          bindingStates(state, attributes),
+          attributes(state),
+          clipping(properties),
           textures(state, properties, _info),
-          objects(geometries, attributes, _info),
-          renderLists(properties),
-          shadowMap(objects),
           materials(properties),
+          renderLists(properties),
+          objects(geometries, attributes, _info),
+          programCache(bindingStates, clipping, _info),
+          cubemaps(scope),
           background(scope, cubemaps, state, objects, parameters.premultipliedAlpha),
-          programCache(bindingStates, clipping),
-          _currentDrawBuffers(GL_BACK),
-          _emptyScene(std::make_unique<Scene>()),
-          onMaterialDispose(this) {
+          bufferRenderer(std::make_unique<gl::GLBufferRenderer>(_info)),
+          indexedBufferRenderer(std::make_unique<gl::GLIndexedBufferRenderer>(_info)),
+          shadowMap(objects, properties, _info),
+          uniformBuffers(state) {
 
         this->setViewport(0, 0, size.width, size.height);
         this->setScissor(0, 0, _size.width, _size.height);
@@ -170,12 +196,12 @@ struct GLRenderer::Impl {
 
         releaseMaterialProgramReferences(material);
 
-        properties.materialProperties.remove(material->uuid());
+        properties.materialProperties.remove(material->id);
     }
 
     void releaseMaterialProgramReferences(Material* material) {
 
-        auto& programs = properties.materialProperties.get(material->uuid())->programs;
+        auto& programs = properties.materialProperties.get(material->id)->programs;
 
         if (!programs.empty()) {
 
@@ -188,8 +214,21 @@ struct GLRenderer::Impl {
 
     void render(Object3D* scene, Camera* camera) {
 
+        if (renderStateStack.empty()) {
+
+            textures.uploadBudgetBytes = scope.textureUploadBudgetBytes;
+            textures.uploadBudgetMilliseconds = scope.textureUploadBudgetMilliseconds;
+            textures.memoryBudgetBytes = scope.textureMemoryBudgetBytes;
+            textures.beginUploads();
+
+            // instance buffers are not reused within a frame, so that their uploads do not wait on earlier draws
+            autoInstancesIndex = 0;
+        }
+
         // update scene graph
 
+        const auto matrixWorldUpdates = Object3D::matrixWorldUpdateCount();
+
         if (auto _scene = scene->as<Scene>()) {
             if (_scene->autoUpdate) scene->updateMatrixWorld();
         }
@@ -198,6 +237,8 @@ struct GLRenderer::Impl {
 
         if (camera->parent == nullptr) camera->updateMatrixWorld();
 
+        const auto matricesUpdated = Object3D::matrixWorldUpdateCount() - matrixWorldUpdates;
+
         //
         //    if ( scene.isScene === true ) scene.onBeforeRender( _this, scene, camera, _currentRenderTarget );
 
@@ -213,11 +254,11 @@ struct GLRenderer::Impl {
         _clippingEnabled = clipping.init(scope.clippingPlanes, _localClippingEnabled, camera);
 
         currentRenderList = renderLists.get(scene, renderListStack.size());
-        currentRenderList->init();
+        currentRenderList->init(scope.autoInstancing);
 
         renderListStack.emplace_back(currentRenderList);
 
-        projectObject(scene, camera, 0, scope.sortObjects);
+        projectObject(scene, camera, scope.sortObjects);
 
         currentRenderList->finish();
 
@@ -232,17 +273,24 @@ struct GLRenderer::Impl {
 
         auto& shadowsArray = currentRenderState->getShadowsArray();
 
+        const auto outerViewLayers = _viewLayers;
+        _viewLayers = &camera->layers;
+
         shadowMap.render(scope, shadowsArray, scene, camera);
 
         currentRenderState->setupLights();
         currentRenderState->setupLightsView(camera);
 
+        if (scope.useUniformBuffers) uniformBuffers.updateLights(currentRenderState->getLights().state);
+
         if (_clippingEnabled) clipping.endShadows();
 
         //
 
         if (this->_info.autoReset) this->_info.reset();
 
+        this->_info.render.matrices += matricesUpdated;
+
         //
 
         background.render(*currentRenderList, scene);
@@ -280,6 +328,7 @@ struct GLRenderer::Impl {
 
         _currentMaterialId = std::nullopt;
         _currentCamera = nullptr;
+        _viewLayers = outerViewLayers;
 
         renderStateStack.pop_back();
 
@@ -287,9 +336,14 @@ struct GLRenderer::Impl {
 
             currentRenderState = renderStateStack.back();
 
+            // restore the lights of the enclosing render
+            if (scope.useUniformBuffers) uniformBuffers.updateLights(currentRenderState->getLights().state);
+
         } else {
 
             currentRenderState = nullptr;
+
+            textures.evict();
         }
 
         renderListStack.pop_back();
@@ -304,6 +358,55 @@ struct GLRenderer::Impl {
         }
     }
 
+    void compile(Object3D* scene, Camera* camera) {
+
+        currentRenderState = renderStates.get(scene, renderStateStack.size());
+        currentRenderState->init();
+
+        scene->traverseVisible([&](Object3D& object) {
+            auto light = object.as<Light>();
+
+            if (light && light->layers.test(camera->layers)) {
+
+                currentRenderState->pushLight(light);
+
+                if (light->castShadow) {
+
+                    currentRenderState->pushShadow(light);
+                }
+            }
+        });
+
+        currentRenderState->setupLights();
+
+        std::unordered_set<Material*> compiled;
+        std::vector<gl::GLProgram*> programs;
+
+        scene->traverse([&](Object3D& object) {
+            for (auto material : object.materials()) {
+
+                if (material && compiled.insert(material).second) {
+
+                    programs.emplace_back(getProgram(material, scene, &object, true));
+
+                    // light uniforms hold copies, and shadow maps are created by the first render,
+                    // so make that render wire them up again
+                    properties.materialProperties.get(material->id)->lightsStateVersion = std::numeric_limits<unsigned int>::max();
+                }
+            }
+        });
+
+        if (!scope.asyncShaderCompilation) {
+
+            for (auto program : programs) {
+
+                program->finish();
+            }
+        }
+
+        currentRenderState = renderStateStack.empty() ? nullptr : renderStateStack.back();
+    }
+
     void renderBufferDirect(Camera* camera, Object3D* _scene, BufferGeometry* geometry, Material* material, Object3D* object, std::optional<GeometryGroup> group) {
 
         auto scene = _scene;
@@ -317,6 +420,9 @@ struct GLRenderer::Impl {
 
         auto program = setProgram(camera, scene, material, object);
 
+        // still compiling
+        if (!program) return;
+
         state.setMaterial(material, frontFaceCW);
 
         //
@@ -432,6 +538,23 @@ struct GLRenderer::Impl {
 
             renderer->renderInstances(drawStart, drawCount, im->count);
 
+        } else if (auto batched = object->as<BatchedMesh>()) {
+
+            // only the sources that are visible to this camera are drawn,
+            // on the layers of the viewing camera as for unbatched shadow casters
+            Frustum frustum;
+            frustum.setFromProjectionMatrix(Matrix4().multiplyMatrices(camera->projectionMatrix, camera->matrixWorldInverse));
+            batched->computeDrawRanges(frustum, _viewLayers ? *_viewLayers : camera->layers, multiDrawStarts, multiDrawCounts);
+
+            // each triangle is drawn as three lines in wireframe
+            for (size_t i = 0; i < multiDrawStarts.size(); ++i) {
+
+                multiDrawStarts[i] *= rangeFactor;
+                multiDrawCounts[i] *= rangeFactor;
+            }
+
+            renderer->renderMultiDraw(multiDrawStarts, multiDrawCounts);
+
         } else if (auto g = dynamic_cast<InstancedBufferGeometry*>(geometry)) {
 
             const auto instanceCount = std::min(g->instanceCount, g->_maxInstanceCount);
@@ -444,69 +567,73 @@ struct GLRenderer::Impl {
         }
     }
 
-    void projectObject(Object3D* object, Camera* camera, unsigned int groupOrder, bool sortObjects) {
-        if (!object->visible) return;
+    void projectObject(Object3D* object, Camera* camera, bool sortObjects) {
 
-        bool visible = object->layers.test(camera->layers);
+        utils::ThreadPool* pool = nullptr;
 
-        if (visible) {
+        if (scope.parallelProjection) {
 
-            if (object->is<Group>()) {
+            if (!projectionPool) {
 
-                groupOrder = object->renderOrder;
+                projectionPool = std::make_unique<utils::ThreadPool>(std::thread::hardware_concurrency());
+            }
 
-            } else if (auto lod = object->as<LOD>()) {
+            pool = projectionPool.get();
+        }
 
-                if (lod->autoUpdate) lod->update(*camera);
+        projection.project(object, camera, _frustum, _projScreenMatrix, sortObjects, pool);
 
-            } else if (auto light = object->as<Light>()) {
+        // render list, lights and GL resources are only touched from this thread
 
-                currentRenderState->pushLight(light);
+        projection.forEach([this](const gl::ProjectedObject& item) {
+            auto object = item.object;
 
-                if (light->castShadow) {
+            switch (item.kind) {
 
-                    currentRenderState->pushShadow(light);
-                }
+                case gl::ProjectedObject::Kind::Light: {
 
-            } else if (auto sprite = object->as<Sprite>()) {
+                    auto light = static_cast<Light*>(object);
 
-                if (!object->frustumCulled || _frustum.intersectsSprite(*sprite)) {
+                    currentRenderState->pushLight(light);
 
-                    if (sortObjects) {
+                    if (light->castShadow) {
 
-                        _vector3.setFromMatrixPosition(*sprite->matrixWorld)
-                                .applyMatrix4(_projScreenMatrix);
+                        currentRenderState->pushShadow(light);
                     }
 
+                    break;
+                }
+
+                case gl::ProjectedObject::Kind::Sprite: {
+
                     auto geometry = objects.update(object);
-                    auto material = sprite->material;
+                    auto material = static_cast<Sprite*>(object)->material;
 
                     if (material->visible) {
 
-                        currentRenderList->push(object, geometry, material.get(), groupOrder, _vector3.z, std::nullopt);
+                        currentRenderList->push(object, geometry, material.get(), item.groupOrder, item.z, std::nullopt);
                     }
+
+                    break;
                 }
 
-            } else if (object->is<Mesh>() || object->is<Line>() || object->is<Points>()) {
+                case gl::ProjectedObject::Kind::Drawable: {
 
-                if (auto skinned = object->as<SkinnedMesh>()) {
+                    if (auto skinned = object->as<SkinnedMesh>()) {
 
-                    // update skeleton only once in a frame
+                        // update skeleton only once in a frame
 
-                    if (skinned->skeleton->frame != _info.render.frame) {
+                        // the skeleton starts at frame -1, which no frame matches
+                        if (static_cast<size_t>(skinned->skeleton->frame) != _info.render.frame) {
 
-                        skinned->skeleton->update();
-                        skinned->skeleton->frame = _info.render.frame;
+                            skinned->skeleton->update();
+                            skinned->skeleton->frame = static_cast<int>(_info.render.frame);
+                        }
                     }
-                }
 
-                if (!object->frustumCulled || _frustum.intersectsObject(*object)) {
+                    if (item.cull == gl::ProjectedObject::Cull::Culled) break;
 
-                    if (sortObjects) {
-
-                        _vector3.setFromMatrixPosition(*object->matrixWorld)
-                                .applyMatrix4(_projScreenMatrix);
-                    }
+                    if (item.cull == gl::ProjectedObject::Cull::Deferred && !_frustum.intersectsObject(*object)) break;
 
                     auto geometry = objects.update(object);
                     const auto& materials = object->materials();
@@ -521,22 +648,19 @@ struct GLRenderer::Impl {
 
                             if (groupMaterial && groupMaterial->visible) {
 
-                                currentRenderList->push(object, geometry, groupMaterial, groupOrder, _vector3.z, group);
+                                currentRenderList->push(object, geometry, groupMaterial, item.groupOrder, item.z, group);
                             }
                         }
 
                     } else if (materials.front()->visible) {
 
-                        currentRenderList->push(object, geometry, materials.front(), groupOrder, _vector3.z, std::nullopt);
+                        currentRenderList->push(object, geometry, materials.front(), item.groupOrder, item.z, std::nullopt);
                     }
+
+                    break;
                 }
             }
-        }
-
-        for (const auto& child : object->children) {
-
-            projectObject(child, camera, groupOrder, sortObjects);
-        }
+        });
     }
 
     void renderObjects(const std::vector<gl::RenderItem*>& renderList, Object3D* scene, Camera* camera) {
@@ -546,17 +670,112 @@ struct GLRenderer::Impl {
             if (_scene->overrideMaterial) overrideMaterial = _scene->overrideMaterial.get();
         }
 
-        for (const auto& renderItem : renderList) {
+        for (size_t i = 0; i < renderList.size(); ++i) {
 
+            auto renderItem = renderList[i];
             auto object = renderItem->object;
             auto geometry = renderItem->geometry;
             auto material = overrideMaterial == nullptr ? renderItem->material : overrideMaterial;
             auto group = renderItem->group;
 
+            if (scope.autoInstancing) {
+
+                const auto count = autoInstanceRunLength(renderList, i, material, overrideMaterial != nullptr);
+
+                if (count >= minAutoInstanceCount) {
+
+                    renderAutoInstanced(renderList, i, count, scene, camera, material);
+                    i += count - 1;
+
+                    continue;
+                }
+            }
+
             renderObject(object, scene, camera, geometry, material, group);
         }
     }
 
+    // runs shorter than this are not worth the instance buffer upload
+    static constexpr size_t minAutoInstanceCount = 4;
+
+    static bool canAutoInstance(const gl::RenderItem& renderItem, Material* material) {
+
+        const auto object = renderItem.object;
+
+        if (renderItem.group || object->onBeforeRender || object->onAfterRender) return false;
+        // plain meshes only, multi-material, skinned, instanced, batched and other special purpose meshes are drawn as usual
+        // (the dynamic type is compared, as type() would build a string for every render item)
+        if (typeid(*object) != typeid(Mesh)) return false;
+        // the winding order is set once for the whole run
+        if (object->matrixWorld->determinant() < 0) return false;
+        if (!renderItem.geometry->getMorphAttributes().empty()) return false;
+
+        // custom shaders are not guaranteed to apply the instance matrix
+        return !material->is<ShaderMaterial>();
+    }
+
+    // number of consecutive render items from start that can be drawn as instances of the first one
+    static size_t autoInstanceRunLength(const std::vector<gl::RenderItem*>& renderList, size_t start, Material* material, bool overrideMaterial) {
+
+        const auto first = renderList[start];
+
+        if (start + 1 == renderList.size() || !canAutoInstance(*first, material)) return 1;
+
+        size_t end = start + 1;
+        for (; end < renderList.size(); ++end) {
+
+            const auto renderItem = renderList[end];
+
+            if (renderItem->geometry != first->geometry) break;
+            if (!overrideMaterial && renderItem->material != first->material) break;
+            if (renderItem->object->receiveShadow != first->object->receiveShadow) break;
+            if (!canAutoInstance(*renderItem, material)) break;
+        }
+
+        return end - start;
+    }
+
+    void renderAutoInstanced(const std::vector<gl::RenderItem*>& renderList, size_t start, size_t count, Object3D* scene, Camera* camera, Material* material) {
+
+        if (autoInstancesIndex == autoInstances.size()) {
+
+            autoInstances.emplace_back();
+        }
+
+        auto& instances = autoInstances[autoInstancesIndex++];
+
+        if (!instances || static_cast<size_t>(instances->instanceMatrix->count()) < count) {
+
+            size_t capacity = 64;
+            while (capacity < count) capacity *= 2;
+
+            instances = InstancedMesh::create(nullptr, nullptr, capacity);
+        }
+
+        const auto first = renderList[start];
+        const auto mesh = static_cast<Mesh*>(first->object);
+
+        auto& array = instances->instanceMatrix->array();
+        for (size_t i = 0; i < count; ++i) {
+
+            renderList[start + i]->object->matrixWorld->toArray(array, i * 16);
+        }
+
+        instances->count = count;
+        instances->instanceMatrix->updateRange = {0, static_cast<int>(count * 16)};
+        instances->instanceMatrix->needsUpdate();
+
+        instances->setGeometry(mesh->shared_geometry());
+        instances->receiveShadow = mesh->receiveShadow;
+
+        objects.update(instances.get());
+
+        renderObject(instances.get(), scene, camera, first->geometry, material, std::nullopt);
+
+        // do not keep the geometry alive
+        instances->setGeometry(nullptr);
+    }
+
     void renderObject(Object3D* object, Object3D* scene, Camera* camera, BufferGeometry* geometry, Material* material, std::optional<GeometryGroup> group) {
 
         if (object->onBeforeRender) {
@@ -575,12 +794,12 @@ struct GLRenderer::Impl {
         }
     }
 
-    gl::GLProgram* getProgram(Material* material, Object3D* _scene, Object3D* object) {
+    gl::GLProgram* getProgram(Material* material, Object3D* _scene, Object3D* object, bool parallel = false) {
 
         auto* scene = _scene->as<Scene>();
         if (!scene) scene = _emptyScene.get();// scene could be a Mesh, Line, Points, ...
 
-        auto materialProperties = properties.materialProperties.get(material->uuid());
+        auto materialProperties = properties.materialProperties.get(material->id);
 
         auto& lights = currentRenderState->getLights();
         auto& shadowsArray = currentRenderState->getShadowsArray();
@@ -633,7 +852,7 @@ struct GLRenderer::Impl {
 
             // material.onBeforeCompile( parameters, this );
 
-            program = programCache.acquireProgram(scope, parameters, programCacheKey);
+            program = programCache.acquireProgram(scope, parameters, programCacheKey, parallel);
             programs[programCacheKey] = program;
 
             materialProperties->uniforms = parameters.uniforms;
@@ -669,24 +888,23 @@ struct GLRenderer::Impl {
 
             uniforms.at("directionalShadowMap").setValue(lights.state.directionalShadowMap);
             uniforms.at("directionalShadowMatrix").setValue(lights.state.directionalShadowMatrix);
+            uniforms.at("directionalShadowCascades").setValue(lights.state.directionalShadowCascades);
             uniforms.at("spotShadowMap").setValue(lights.state.spotShadowMap);
             uniforms.at("spotShadowMatrix").setValue(lights.state.spotShadowMatrix);
             uniforms.at("pointShadowMap").setValue(lights.state.pointShadowMap);
             uniforms.at("pointShadowMatrix").setValue(lights.state.pointShadowMatrix);
         }
 
-        auto progUniforms = program->getUniforms();
-        auto uniformsList = gl::GLUniforms::seqWithValue(progUniforms->seq, *materialProperties->uniforms);
-
         materialProperties->currentProgram = program;
-        materialProperties->uniformsList = uniformsList;
+        // the uniforms of the program are known once it has linked
+        materialProperties->uniformsProgram = nullptr;
 
         return materialProperties->currentProgram;
     }
 
     void updateCommonMaterialProperties(Material* material, gl::ProgramParameters& parameters) {
 
-        auto materialProperties = properties.materialProperties.get(material->uuid());
+        auto materialProperties = properties.materialProperties.get(material->id);
 
         materialProperties->outputEncoding = parameters.outputEncoding;
         materialProperties->instancing = parameters.instancing;
@@ -701,12 +919,13 @@ struct GLRenderer::Impl {
         auto* scene = _scene->as<Scene>();
         if (!scene) scene = _emptyScene.get();// scene could be a Mesh, Line, Points, ...
 
-        bool isMeshBasicMaterial = material->type() == "MeshBasicMaterial";
-        bool isMeshLambertMaterial = material->type() == "MeshLambertMaterial";
-        bool isMeshToonMaterial = material->type() == "MeshToonMaterial";
-        bool isMeshPhongMaterial = material->type() == "MeshPhongMaterial";
-        bool isMeshStandardMaterial = material->type() == "MeshStandardMaterial";
-        bool isShadowMaterial = material->type() == "ShadowMaterial";
+        const auto materialType = material->type();
+        bool isMeshBasicMaterial = materialType == "MeshBasicMaterial";
+        bool isMeshLambertMaterial = materialType == "MeshLambertMaterial";
+        bool isMeshToonMaterial = materialType == "MeshToonMaterial";
+        bool isMeshPhongMaterial = materialType == "MeshPhongMaterial";
+        bool isMeshStandardMaterial = materialType == "MeshStandardMaterial";
+        bool isShadowMaterial = materialType == "ShadowMaterial";
         bool isShaderMaterial = material->is<ShaderMaterial>();
         bool isEnvMap = material->is<MaterialWithEnvMap>() && material->as<MaterialWithEnvMap>()->envMap;
 
@@ -730,7 +949,7 @@ struct GLRenderer::Impl {
                             object->geometry()->hasAttribute("color") &&
                             object->geometry()->getAttribute<float>("color")->itemSize() == 4;
 
-        auto materialProperties = properties.materialProperties.get(material->uuid());
+        auto materialProperties = properties.materialProperties.get(material->id);
         auto& lights = currentRenderState->getLights();
 
         if (_clippingEnabled) {
@@ -809,7 +1028,18 @@ struct GLRenderer::Impl {
 
         if (needsProgramChange) {
 
-            program = getProgram(material, scene, object);
+            program = getProgram(material, scene, object, scope.asyncShaderCompilation);
+        }
+
+        if (scope.asyncShaderCompilation && !program->isReady()) {
+
+            return nullptr;
+        }
+
+        if (materialProperties->uniformsProgram != program) {
+
+            materialProperties->uniformsList = gl::GLUniforms::seqWithValue(program->getUniforms()->seq, *materialProperties->uniforms);
+            materialProperties->uniformsProgram = program;
         }
 
         bool refreshProgram = false;
@@ -833,6 +1063,11 @@ struct GLRenderer::Impl {
             refreshMaterial = true;
         }
 
+        if (scope.useUniformBuffers && _currentCamera != camera) {
+
+            uniformBuffers.updateCamera(*camera);
+        }
+
         if (refreshProgram || _currentCamera != camera) {
 
             p_uniforms->setValue("projectionMatrix", camera->projectionMatrix);
@@ -1029,7 +1264,7 @@ struct GLRenderer::Impl {
         _currentActiveCubeFace = activeCubeFace;
         _currentActiveMipmapLevel = activeMipmapLevel;
 
-        if (renderTarget && !properties.renderTargetProperties.get(renderTarget->uuid)->glFramebuffer) {
+        if (renderTarget && !properties.renderTargetProperties.get(renderTarget->id)->glFramebuffer) {
 
             textures.setupRenderTarget(renderTarget);
         }
@@ -1040,7 +1275,7 @@ struct GLRenderer::Impl {
 
             const auto& texture = renderTarget->texture;
 
-            framebuffer = *properties.renderTargetProperties.get(renderTarget->uuid)->glFramebuffer;
+            framebuffer = *properties.renderTargetProperties.get(renderTarget->id)->glFramebuffer;
 
             _currentViewport.copy(renderTarget->viewport);
             _currentScissor.copy(renderTarget->scissor);
@@ -1098,6 +1333,8 @@ struct GLRenderer::Impl {
         const auto height = static_cast<int>(texture.image.front().height * levelScale);
 
         textures.setTexture2D(texture, 0);
+        // the copy only exists on the GPU
+        textures.keepResident(texture);
 
         glCopyTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, static_cast<int>(position.x), static_cast<int>(position.y), width, height);
 
@@ -1127,6 +1364,8 @@ struct GLRenderer::Impl {
 
     void dispose() {
 
+        autoInstances.clear();
+        uniformBuffers.dispose();
         renderLists.dispose();
         renderStates.dispose();
         properties.dispose();
@@ -1150,7 +1389,7 @@ struct GLRenderer::Impl {
 GLRenderer::GLRenderer(WindowSize size, const GLRenderer::Parameters& parameters) {
 
 #ifndef EMSCRIPTEN
-    loadGlad();// if Glad has yet to be loaded, do it now
+    ensureGladLoaded();// if Glad has yet to be loaded, do it now
 #endif
 
     pimpl_ = std::make_unique<Impl>(*this, size, parameters);
@@ -1304,11 +1543,21 @@ void GLRenderer::dispose() {
     pimpl_->dispose();
 }
 
+void GLRenderer::compile(Object3D& scene, Camera& camera) {
+
+    pimpl_->compile(&scene, &camera);
+}
+
 void GLRenderer::render(Object3D& scene, Camera& camera) {
 
     pimpl_->render(&scene, &camera);
 }
 
+void GLRenderer::beginFrame() {
+
+    pimpl_->textures.beginFrame();
+}
+
 void GLRenderer::renderBufferDirect(Camera* camera, Scene* scene, BufferGeometry* geometry, Material* material, Object3D* object, std::optional<GeometryGroup> group) {
 
     pimpl_->renderBufferDirect(camera, scene, geometry, material, object, group);
@@ -2,6 +2,8 @@
 #ifndef THREEPP_BUFFER_HPP
 #define THREEPP_BUFFER_HPP
 
+#include <cstddef>
+
 namespace threepp::gl {
 
     struct Buffer {
@@ -9,6 +11,8 @@ namespace threepp::gl {
         int type{};
         int bytesPerElement{};
         unsigned int version{};
+        // bytes allocated for the buffer
+        std::ptrdiff_t size{};
     };
 
 }// namespace threepp::gl
@@ -8,86 +8,132 @@
 #include <GLES3/gl3.h>
 #endif
 
+#include <algorithm>
+
 using namespace threepp;
 using namespace threepp::gl;
 
+namespace {
+
+    struct Data {
+
+        GLint type;
+        GLsizei bytesPerElement;
+        const char* data;
+        GLsizeiptr size;
+    };
+
+    Data dataOf(BufferAttribute* attribute) {
+
+        if (auto attr = attribute->typed<unsigned int>()) {
+
+            const auto& array = attr->array();
+            return {GL_UNSIGNED_INT, sizeof(unsigned int), reinterpret_cast<const char*>(array.data()), static_cast<GLsizeiptr>(array.size() * sizeof(unsigned int))};
+
+        } else if (auto attr = attribute->typed<float>()) {
+
+            const auto& array = attr->array();
+            return {GL_FLOAT, sizeof(float), reinterpret_cast<const char*>(array.data()), static_cast<GLsizeiptr>(array.size() * sizeof(float))};
+        }
+
+        throw std::runtime_error("TODO");
+    }
+
+    // sorts the ranges and merges the ones that overlap or touch, clamped to size elements
+    void mergeRanges(std::vector<UpdateRange>& ranges, int size) {
+
+        for (auto& range : ranges) {
+            range.offset = std::clamp(range.offset, 0, size);
+            range.count = std::clamp(range.count, 0, size - range.offset);
+        }
+
+        std::sort(ranges.begin(), ranges.end(), [](const UpdateRange& a, const UpdateRange& b) {
+            return a.offset < b.offset;
+        });
+
+        size_t merged = 0;
+        for (size_t i = 1; i < ranges.size(); ++i) {
+
+            auto& last = ranges[merged];
+            const auto& range = ranges[i];
+
+            if (range.offset <= last.offset + last.count) {
+
+                last.count = std::max(last.count, range.offset + range.count - last.offset);
+
+            } else {
+
+                ranges[++merged] = range;
+            }
+        }
+
+        if (!ranges.empty()) ranges.resize(merged + 1);
+    }
+
+}// namespace
+
+GLAttributes::GLAttributes(GLState& state)
+    : state_(state) {}
+
 Buffer GLAttributes::createBuffer(BufferAttribute* attribute, GLenum bufferType) {
 
     const auto usage = attribute->getUsage();
+    const auto data = dataOf(attribute);
 
     GLuint buffer;
     glGenBuffers(1, &buffer);
-    glBindBuffer(bufferType, buffer);
-
-    GLint type;
-    GLsizei bytesPerElement;
-    if (attribute->typed<unsigned int>()) {
-        type = GL_UNSIGNED_INT;
-        bytesPerElement = sizeof(unsigned int);
-        auto attr = attribute->typed<unsigned int>();
-        const auto& array = attr->array();
-        glBufferData(bufferType, (GLsizei) (array.size() * bytesPerElement), array.data(), as_integer(usage));
-
-    } else if (attribute->typed<float>()) {
-        type = GL_FLOAT;
-        bytesPerElement = sizeof(float);
-        auto attr = attribute->typed<float>();
-        const auto& array = attr->array();
-        glBufferData(bufferType, (GLsizei) (array.size() * bytesPerElement), array.data(), as_integer(usage));
-    } else {
+    state_.bindBuffer(bufferType, buffer);
+    glBufferData(bufferType, data.size, data.data, as_integer(usage));
 
-        throw std::runtime_error("TODO");
-    }
+    attribute->updateRange.count = -1;
+    attribute->clearUpdateRanges();
 
-    return {buffer, type, bytesPerElement, attribute->version + 1};
+    return {buffer, data.type, data.bytesPerElement, attribute->version + 1, data.size};
 }
 
-void GLAttributes::updateBuffer(GLuint buffer, BufferAttribute* attribute, GLenum bufferType, int bytesPerElement) {
+void GLAttributes::updateBuffer(Buffer& buffer, BufferAttribute* attribute, GLenum bufferType) {
 
+    const auto usage = attribute->getUsage();
+    const auto data = dataOf(attribute);
+
+    auto& ranges = attribute->updateRanges;
     auto& updateRange = attribute->updateRange;
 
-    glBindBuffer(bufferType, buffer);
+    if (updateRange.count != -1) {
 
-    if (updateRange.count == -1) {
+        ranges.emplace_back(updateRange);
+        updateRange.count = -1;
+    }
 
-        if (attribute->typed<unsigned int>()) {
+    state_.bindBuffer(bufferType, buffer.buffer);
 
-            auto attr = attribute->typed<unsigned int>();
-            const auto& array = attr->array();
-            glBufferSubData(bufferType, 0, (GLsizei) (array.size() * bytesPerElement), array.data());
+    if (ranges.empty() || data.size != buffer.size) {
 
-        } else if (attribute->typed<float>()) {
+        if (usage != DrawUsage::Static || data.size != buffer.size) {
+
+            // orphan the storage that may still be in use by the GPU, rather than waiting for it
+            glBufferData(bufferType, data.size, data.data, as_integer(usage));
+            buffer.size = data.size;
 
-            auto attr = attribute->typed<float>();
-            const auto& array = attr->array();
-            glBufferSubData(bufferType, 0, (GLsizei) (array.size() * bytesPerElement), array.data());
         } else {
 
-            throw std::runtime_error("TODO");
+            glBufferSubData(bufferType, 0, data.size, data.data);
         }
 
     } else {
 
-        if (attribute->typed<unsigned int>()) {
+        mergeRanges(ranges, static_cast<int>(data.size / data.bytesPerElement));
 
-            auto attr = attribute->typed<unsigned int>();
-            const auto& array = attr->array();
-            std::vector<unsigned int> sub(array.begin() + updateRange.offset, array.begin() + updateRange.offset + updateRange.count);
-            glBufferSubData(bufferType, updateRange.offset * bytesPerElement, (GLsizei) (sub.size() * bytesPerElement), sub.data());
+        for (const auto& range : ranges) {
 
-        } else if (attribute->typed<float>()) {
+            if (range.count == 0) continue;
 
-            auto attr = attribute->typed<float>();
-            const auto& array = attr->array();
-            std::vector<float> sub(array.begin() + updateRange.offset, array.begin() + updateRange.offset + updateRange.count);
-            glBufferSubData(bufferType, updateRange.offset * bytesPerElement, (GLsizei) (sub.size() * bytesPerElement), sub.data());
-        } else {
-
-            throw std::runtime_error("TODO");
+            const auto offset = static_cast<GLintptr>(range.offset) * data.bytesPerElement;
+            glBufferSubData(bufferType, offset, static_cast<GLsizeiptr>(range.count) * data.bytesPerElement, data.data + offset);
         }
-
-        updateRange.count = -1;
     }
+
+    ranges.clear();
 }
 
 Buffer GLAttributes::get(BufferAttribute* attribute) {
@@ -109,7 +155,7 @@ void GLAttributes::remove(BufferAttribute* attribute) {
 
         auto& data = buffers_.at(attribute);
 
-        glDeleteBuffers(1, &data.buffer);
+        state_.deleteBuffer(data.buffer);
 
         buffers_.erase(attribute);
     }
@@ -130,7 +176,7 @@ void GLAttributes::update(BufferAttribute* attribute, GLenum bufferType) {
         auto& data = buffers_.at(attribute);
 
         if (data.version < attribute->version) {
-            updateBuffer(data.buffer, attribute, bufferType, data.bytesPerElement);
+            updateBuffer(data, attribute, bufferType);
             ++data.version;
         }
     }
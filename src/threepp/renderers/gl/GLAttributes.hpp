@@ -6,6 +6,7 @@
 #include "threepp/core/BufferAttribute.hpp"
 
 #include "threepp/renderers/gl/Buffer.hpp"
+#include "threepp/renderers/gl/GLState.hpp"
 
 #include <unordered_map>
 
@@ -13,9 +14,11 @@ namespace threepp::gl {
 
     struct GLAttributes {
 
+        explicit GLAttributes(GLState& state);
+
         Buffer createBuffer(BufferAttribute* attribute, unsigned int bufferType);
 
-        void updateBuffer(unsigned int buffer, BufferAttribute* attribute, unsigned int bufferType, int bytesPerElement);
+        void updateBuffer(Buffer& buffer, BufferAttribute* attribute, unsigned int bufferType);
 
         Buffer get(BufferAttribute* attribute);
 
@@ -24,6 +27,7 @@ namespace threepp::gl {
         void update(BufferAttribute* attribute, unsigned int bufferType);
 
     private:
+        GLState& state_;
         std::unordered_map<BufferAttribute*, Buffer> buffers_;
     };
 
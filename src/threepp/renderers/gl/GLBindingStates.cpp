@@ -19,6 +19,7 @@ typedef std::unordered_map<int, StateMap> ProgramMap;
 
 struct GLBindingStates::Impl {
 
+    GLState& state_;
     GLAttributes& attributes_;
     unsigned int maxVertexAttributes_;
 
@@ -27,9 +28,10 @@ struct GLBindingStates::Impl {
 
     std::unordered_map<unsigned int, ProgramMap> bindingStates;
 
-    explicit Impl(GLAttributes& attributes)
-        : maxVertexAttributes_(glGetParameteri(GL_MAX_VERTEX_ATTRIBS)),
+    Impl(GLState& state, GLAttributes& attributes)
+        : state_(state),
           attributes_(attributes),
+          maxVertexAttributes_(glGetParameteri(GL_MAX_VERTEX_ATTRIBS)),
           defaultState_(createBindingState(std::nullopt)),
           currentState_(&defaultState_) {}
 
@@ -66,7 +68,7 @@ struct GLBindingStates::Impl {
 
             if (index) {
 
-                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, attributes_.get(index).buffer);
+                state_.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, attributes_.get(index).buffer);
             }
         }
     }
@@ -80,12 +82,12 @@ struct GLBindingStates::Impl {
 
     void bindVertexArrayObject(GLuint vao) const {
 
-        glBindVertexArray(vao);
+        state_.bindVertexArray(vao);
     }
 
     void deleteVertexArrayObject(GLuint vao) {
 
-        glDeleteVertexArrays(1, &vao);
+        state_.deleteVertexArray(vao);
     }
 
     GLBindingState* getBindingState(BufferGeometry* geometry, GLProgram* program, Material* material) {
@@ -280,7 +282,7 @@ struct GLBindingStates::Impl {
                             enableAttribute(programAttribute);
                         }
 
-                        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+                        state_.bindBuffer(GL_ARRAY_BUFFER, buffer);
                         vertexAttribPointer(programAttribute, size, type, normalized, stride * bytesPerElement, offset * bytesPerElement);
 
                     } else {
@@ -294,7 +296,7 @@ struct GLBindingStates::Impl {
                             enableAttribute(programAttribute);
                         }
 
-                        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+                        state_.bindBuffer(GL_ARRAY_BUFFER, buffer);
                         vertexAttribPointer(programAttribute, size, type, normalized, 0, 0);
                     }
 
@@ -310,7 +312,7 @@ struct GLBindingStates::Impl {
                     enableAttributeAndDivisor(programAttribute + 2, 1);
                     enableAttributeAndDivisor(programAttribute + 3, 1);
 
-                    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+                    state_.bindBuffer(GL_ARRAY_BUFFER, buffer);
 
                     glVertexAttribPointer(programAttribute + 0, 4, type, false, 64, (void*) 0);
                     glVertexAttribPointer(programAttribute + 1, 4, type, false, 64, (void*) 16);
@@ -326,7 +328,7 @@ struct GLBindingStates::Impl {
 
                     enableAttributeAndDivisor(programAttribute, 1);
 
-                    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+                    state_.bindBuffer(GL_ARRAY_BUFFER, buffer);
 
                     glVertexAttribPointer(programAttribute, 3, type, false, 12, 0);
 
@@ -424,8 +426,8 @@ struct GLBindingStates::Impl {
     }
 };
 
-GLBindingStates::GLBindingStates(GLAttributes& attributes)
-    : pimpl_(std::make_unique<Impl>(attributes)) {
+GLBindingStates::GLBindingStates(GLState& state, GLAttributes& attributes)
+    : pimpl_(std::make_unique<Impl>(state, attributes)) {
 }
 
 void GLBindingStates::setup(Object3D* object, Material* material, GLProgram* program, BufferGeometry* geometry, BufferAttribute* index) {
@@ -40,7 +40,7 @@ namespace threepp::gl {
 
     struct GLBindingStates {
 
-        explicit GLBindingStates(GLAttributes& attributes);
+        GLBindingStates(GLState& state, GLAttributes& attributes);
 
         void setup(Object3D* object, Material* material, GLProgram* program, BufferGeometry* geometry, BufferAttribute* index);
 
@@ -6,6 +6,8 @@
 #include "threepp/renderers/gl/Buffer.hpp"
 #include "threepp/renderers/gl/GLInfo.hpp"
 
+#include <vector>
+
 namespace threepp::gl {
 
     struct BufferRenderer {
@@ -18,6 +20,9 @@ namespace threepp::gl {
 
         virtual void renderInstances(int start, int count, int primcount) = 0;
 
+        // Draws several ranges of the same buffers with a single call where supported.
+        virtual void renderMultiDraw(const std::vector<int>& starts, const std::vector<int>& counts) = 0;
+
         virtual ~BufferRenderer() = default;
 
     protected:
@@ -33,6 +38,8 @@ namespace threepp::gl {
         void render(int start, int count) override;
 
         void renderInstances(int start, int count, int primcount) override;
+
+        void renderMultiDraw(const std::vector<int>& starts, const std::vector<int>& counts) override;
     };
 
     struct GLIndexedBufferRenderer: BufferRenderer {
@@ -46,10 +53,12 @@ namespace threepp::gl {
 
         void renderInstances(int start, int count, int primcount) override;
 
+        void renderMultiDraw(const std::vector<int>& starts, const std::vector<int>& counts) override;
 
     private:
         int type_{};
         size_t bytesPerElement_{};
+        std::vector<const void*> offsets_;
     };
 
 }// namespace threepp::gl
@@ -5,9 +5,14 @@
 
 #include "threepp/renderers/gl/GLUtils.hpp"
 
+#include <cstring>
 #include <ostream>
 #include <string>
 
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 namespace threepp::gl {
 
     struct GLCapabilities {
@@ -36,6 +41,17 @@ namespace threepp::gl {
 
         const int maxSamples;
 
+        // programs can be polled for completion, rather than blocking until linked
+        const bool parallelShaderCompile;
+
+        // linked programs can be retrieved and loaded with glGetProgramBinary and glProgramBinary
+        const bool programBinary;
+
+        // compressed texture formats besides RGTC, which GL 3 supports
+        const bool s3tc;
+        const bool bptc;
+        const bool etc2;
+
         GLCapabilities(const GLCapabilities&) = delete;
         void operator=(const GLCapabilities&) = delete;
 
@@ -52,6 +68,11 @@ namespace threepp::gl {
                << " maxFragmentUniforms: " << v.maxFragmentUniforms << "\n"
                << " vertexTextures: " << (v.vertexTextures ? "true" : "false") << "\n"
                << " maxSamples: " << v.maxSamples << "\n"
+               << " parallelShaderCompile: " << (v.parallelShaderCompile ? "true" : "false") << "\n"
+               << " programBinary: " << (v.programBinary ? "true" : "false") << "\n"
+               << " s3tc: " << (v.s3tc ? "true" : "false") << "\n"
+               << " bptc: " << (v.bptc ? "true" : "false") << "\n"
+               << " etc2: " << (v.etc2 ? "true" : "false") << "\n"
                << ")";
             return os;
         }
@@ -79,7 +100,44 @@ namespace threepp::gl {
               floatFragmentTextures(GL_ARB_texture_float),
               floatVertexTextures(vertexTextures && floatFragmentTextures),
 
-              maxSamples(glGetParameteri(GL_MAX_SAMPLES)) {}
+              maxSamples(glGetParameteri(GL_MAX_SAMPLES)),
+
+              parallelShaderCompile(hasExtension("GL_KHR_parallel_shader_compile") || hasExtension("GL_ARB_parallel_shader_compile")),
+
+              programBinary(hasProgramBinary()),
+
+              s3tc(hasExtension("GL_EXT_texture_compression_s3tc")),
+              bptc(hasVersion(4, 2) || hasExtension("GL_ARB_texture_compression_bptc")),
+              etc2(hasVersion(4, 3) || hasExtension("GL_ARB_ES3_compatibility")) {}
+
+        static bool hasVersion(int major, int minor) {
+
+            const auto actualMajor = glGetParameteri(GL_MAJOR_VERSION);
+
+            return actualMajor > major || (actualMajor == major && glGetParameteri(GL_MINOR_VERSION) >= minor);
+        }
+
+        static bool hasExtension(const char* name) {
+
+            const auto count = glGetParameteri(GL_NUM_EXTENSIONS);
+            for (int i = 0; i < count; ++i) {
+
+                const auto extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+                if (extension && std::strcmp(extension, name) == 0) return true;
+            }
+
+            return false;
+        }
+
+        static bool hasProgramBinary() {
+
+    #ifndef EMSCRIPTEN
+            // loaded by glad for GL 4.1 contexts and up
+            if (!glGetProgramBinary || !glProgramBinary) return false;
+    #endif
+
+            return glGetParameteri(GL_NUM_PROGRAM_BINARY_FORMATS) > 0;
+        }
     };
 
 }// namespace threepp::gl
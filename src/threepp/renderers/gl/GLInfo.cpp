@@ -50,4 +50,8 @@ void gl::GLInfo::reset() {
     render.triangles = 0;
     render.points = 0;
     render.lines = 0;
+    render.matrices = 0;
+
+    state = {};
+    textures = {};
 }
@@ -3,6 +3,7 @@
 
 #include "threepp/renderers/GLRenderTarget.hpp"
 
+#include "threepp/lights/DirectionalLightShadow.hpp"
 #include "threepp/lights/LightProbe.hpp"
 #include "threepp/lights/LightShadow.hpp"
 
@@ -46,6 +47,8 @@ void GLLights::setup(std::vector<Light*>& lights) {
     int numPointShadows = 0;
     int numSpotShadows = 0;
 
+    bool directionalShadowCascades = false;
+
     std::stable_sort(lights.begin(), lights.end(), shadowCastingLightsFirst);
 
     for (auto light : lights) {
@@ -76,21 +79,29 @@ void GLLights::setup(std::vector<Light*>& lights) {
 
             if (light->castShadow) {
 
-                auto& shadow = directionalLight->shadow;
+                // directional lights are always created with a DirectionalLightShadow
+                auto shadow = static_cast<DirectionalLightShadow*>(directionalLight->shadow.get());
 
                 auto shadowUniforms = shadowCache_.get(*light);
 
                 shadowUniforms->at("shadowBias") = shadow->bias;
                 shadowUniforms->at("shadowNormalBias") = shadow->normalBias;
                 shadowUniforms->at("shadowRadius") = shadow->radius;
-                std::get<Vector2>(shadowUniforms->at("shadowMapSize")).copy(shadow->mapSize);
+                // cascades share one map, so texels are sized by the whole map
+                std::get<Vector2>(shadowUniforms->at("shadowMapSize")).copy(shadow->mapSize).multiply(shadow->getFrameExtents());
+                std::get<Vector3>(shadowUniforms->at("shadowCascadeSplits")).copy(shadow->getCascadeSplits());
+                shadowUniforms->at("shadowCascadeFar") = shadow->getCascadeFar();
 
                 ensureCapacity(state.directionalShadow, directionalLength + 1);
                 ensureCapacity(state.directionalShadowMap, directionalLength + 1);
                 ensureCapacity(state.directionalShadowMatrix, directionalLength + 1);
+                ensureCapacity(state.directionalShadowCascades, directionalLength + 1);
                 state.directionalShadow[directionalLength] = shadowUniforms;
                 state.directionalShadowMap[directionalLength] = shadow->map ? shadow->map->texture.get() : nullptr;
                 state.directionalShadowMatrix[directionalLength] = &shadow->matrix;
+                state.directionalShadowCascades[directionalLength] = &shadow->getCascadeTransforms();
+
+                directionalShadowCascades = directionalShadowCascades || shadow->getCascadeCount() > 1;
 
                 ++numDirectionalShadows;
             }
@@ -197,7 +208,8 @@ void GLLights::setup(std::vector<Light*>& lights) {
         hash.hemiLength != hemiLength ||
         hash.numDirectionalShadows != numDirectionalShadows ||
         hash.numPointShadows != numPointShadows ||
-        hash.numSpotShadows != numSpotShadows) {
+        hash.numSpotShadows != numSpotShadows ||
+        hash.directionalShadowCascades != directionalShadowCascades) {
 
         state.directional.resize(directionalLength);
         state.spot.resize(spotLength);
@@ -211,6 +223,8 @@ void GLLights::setup(std::vector<Light*>& lights) {
         state.spotShadow.resize(numSpotShadows);
         state.spotShadowMap.resize(numSpotShadows);
         state.directionalShadowMatrix.resize(numDirectionalShadows);
+        state.directionalShadowCascades.resize(numDirectionalShadows);
+        state.directionalShadowCascadesEnabled = directionalShadowCascades;
         state.pointShadowMatrix.resize(numPointShadows);
         state.spotShadowMatrix.resize(numSpotShadows);
 
@@ -223,6 +237,8 @@ void GLLights::setup(std::vector<Light*>& lights) {
         hash.numPointShadows = numPointShadows;
         hash.numSpotShadows = numSpotShadows;
 
+        hash.directionalShadowCascades = directionalShadowCascades;
+
         state.version = nextVersion++;
     }
 }
@@ -86,7 +86,9 @@ namespace threepp::gl {
                         {"shadowBias", 0.f},
                         {"shadowNormalBias", 0.f},
                         {"shadowRadius", 1.f},
-                        {"shadowMapSize", Vector2()}};
+                        {"shadowMapSize", Vector2()},
+                        {"shadowCascadeSplits", Vector3()},
+                        {"shadowCascadeFar", 0.f}};
 
             } else if (type == "SpotLight") {
 
@@ -131,6 +133,8 @@ namespace threepp::gl {
                 int numDirectionalShadows = -1;
                 int numPointShadows = -1;
                 int numSpotShadows = -1;
+
+                int directionalShadowCascades = -1;
             };
 
             unsigned int version = 0;
@@ -143,6 +147,9 @@ namespace threepp::gl {
             std::vector<LightUniforms*> directionalShadow;
             std::vector<Texture*> directionalShadowMap;
             std::vector<Matrix4*> directionalShadowMatrix;
+            std::vector<Matrix4*> directionalShadowCascades;
+            // whether any directional light shadow has more than one cascade
+            bool directionalShadowCascadesEnabled = false;
             std::vector<LightUniforms*> spot;
             std::vector<LightUniforms*> spotShadow;
             std::vector<Texture*> spotShadowMap;
@@ -2,17 +2,24 @@
 #include "threepp/renderers/gl/GLProgram.hpp"
 
 #include "threepp/renderers/gl/GLBindingStates.hpp"
+#include "threepp/renderers/gl/GLCapabilities.hpp"
+#include "threepp/renderers/gl/GLProgramBinaryCache.hpp"
 #include "threepp/renderers/gl/GLPrograms.hpp"
+#include "threepp/renderers/gl/GLUniformBuffers.hpp"
 #include "threepp/renderers/gl/GLUniforms.hpp"
 
 #include "threepp/renderers/GLRenderer.hpp"
 #include "threepp/renderers/shaders/ShaderChunk.hpp"
-#include "threepp/utils/RegexUtil.hpp"
+#include "threepp/renderers/shaders/ShaderPreprocessor.hpp"
 #include "threepp/utils/StringUtils.hpp"
+#include "threepp/utils/ThreadPool.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <iostream>
 #include <list>
+#include <sstream>
 #include <vector>
 
 #ifndef EMSCRIPTEN
@@ -62,25 +69,6 @@ namespace {
         }
     }
 
-    std::string loopReplacer(const std::smatch& match) {
-
-        static std::regex reg1(R"(\[\s*i\s*\])");
-        static std::regex reg2("UNROLLED_LOOP_INDEX");
-
-        auto start = utils::parseInt(match[1].str());
-        auto end = utils::parseInt(match[2].str());
-
-        std::stringstream ss;
-        for (int i = start; i < end; ++i) {
-
-            auto str = std::regex_replace(match[3].str(), reg1, "[ " + std::to_string(i) + " ]");
-            utils::replaceAll(str, "UNROLLED_LOOP_INDEX", std::to_string(i));
-            ss << str;
-        }
-
-        return ss.str();
-    }
-
     std::string getTexelDecodingFunction(const std::string& functionName, Encoding encoding) {
 
         const auto components = getEncodingComponents(encoding);
@@ -170,67 +158,19 @@ namespace {
         return str.empty();
     }
 
-    void replaceLightNums(std::string& str, const ProgramParameters* parameters) {
-
-        std::string& result = str;
-        utils::replaceAll(result, "NUM_DIR_LIGHTS", std::to_string(parameters->numDirLights));
-        utils::replaceAll(result, "NUM_SPOT_LIGHTS", std::to_string(parameters->numSpotLights));
-        utils::replaceAll(result, "NUM_RECT_AREA_LIGHTS", std::to_string(parameters->numRectAreaLights));
-        utils::replaceAll(result, "NUM_POINT_LIGHTS", std::to_string(parameters->numPointLights));
-        utils::replaceAll(result, "NUM_HEMI_LIGHTS", std::to_string(parameters->numHemiLights));
-        utils::replaceAll(result, "NUM_DIR_LIGHT_SHADOWS", std::to_string(parameters->numDirLightShadows));
-        utils::replaceAll(result, "NUM_SPOT_LIGHT_SHADOWS", std::to_string(parameters->numSpotLightShadows));
-        utils::replaceAll(result, "NUM_POINT_LIGHT_SHADOWS", std::to_string(parameters->numPointLightShadows));
-    }
-
-    void replaceClippingPlaneNums(std::string& str, const ProgramParameters* parameters) {
-
-        utils::replaceAll(str, "NUM_CLIPPING_PLANES", std::to_string(parameters->numClippingPlanes));
-        utils::replaceAll(str, "UNION_CLIPPING_PLANES", std::to_string(parameters->numClippingPlanes - parameters->numClipIntersection));
-    }
-
-    // Resolve Includes
-
-    std::string resolveIncludes(const std::string& str) {
-
-        static const std::regex rex("#include +<([\\w\\d.]+)>");
-
-        std::string result;
-
-        std::sregex_iterator rex_it(str.begin(), str.end(), rex);
-        std::sregex_iterator rex_end;
-        size_t pos = 0;
-
-        while (rex_it != rex_end) {
-            std::smatch match = *rex_it;
-            result.append(str, pos, match.position(0) - pos);
-            pos = match.position(0) + match.length(0);
-
-            const std::ssub_match& sub = match[1];
-            const std::string& r = shaders::ShaderChunk::instance().get(sub.str());
-            if (r.empty()) {
-                std::stringstream ss;
-                ss << "unable to resolve #include <" << sub.str() << ">";
-                throw std::logic_error(ss.str());
-            }
-            result.append(r);
-            ++rex_it;
-        }
-
-        if (pos == 0) return str;
-        else {
-            result.append(str, pos, str.length());
-            return result;
-        }
-    }
-
-    // Unroll loops
-
-    std::string unrollLoops(const std::string& glsl) {
-
-        static const std::regex rex(R"(#pragma unroll_loop_start\s+for\s*\(\s*int\s+i\s*=\s*(\d+)\s*;\s*i\s*<\s*(\d+)\s*;\s*i\s*\+\+\s*\)\s*\{([\s\S]+?)\}\s+#pragma unroll_loop_end)");
-
-        return regex_replace(glsl, rex, loopReplacer);
+    shaders::ShaderDefines getShaderDefines(const ProgramParameters* parameters) {
+
+        return {
+                {"NUM_DIR_LIGHTS", std::to_string(parameters->numDirLights)},
+                {"NUM_SPOT_LIGHTS", std::to_string(parameters->numSpotLights)},
+                {"NUM_RECT_AREA_LIGHTS", std::to_string(parameters->numRectAreaLights)},
+                {"NUM_POINT_LIGHTS", std::to_string(parameters->numPointLights)},
+                {"NUM_HEMI_LIGHTS", std::to_string(parameters->numHemiLights)},
+                {"NUM_DIR_LIGHT_SHADOWS", std::to_string(parameters->numDirLightShadows)},
+                {"NUM_SPOT_LIGHT_SHADOWS", std::to_string(parameters->numSpotLightShadows)},
+                {"NUM_POINT_LIGHT_SHADOWS", std::to_string(parameters->numPointLightShadows)},
+                {"NUM_CLIPPING_PLANES", std::to_string(parameters->numClippingPlanes)},
+                {"UNION_CLIPPING_PLANES", std::to_string(parameters->numClippingPlanes - parameters->numClipIntersection)}};
     }
 
     inline std::string generatePrecision() {
@@ -326,397 +266,492 @@ namespace {
     }
 
 
-}// namespace
+    // the complete source of both stages. Only touches its arguments and the shader chunks, so it may run on any thread
+    std::pair<std::string, std::string> generateSources(const ProgramParameters* parameters, float gammaFactor) {
 
+        auto& defines = parameters->defines;
 
-GLProgram::GLProgram(const GLRenderer* renderer, std::string cacheKey, const ProgramParameters* parameters, GLBindingStates* bindingStates)
-    : cacheKey(std::move(cacheKey)), bindingStates(bindingStates) {
+        auto vertexShader = parameters->vertexShader;
+        auto fragmentShader = parameters->fragmentShader;
 
-    auto& defines = parameters->defines;
+        auto shadowMapTypeDefine = generateShadowMapTypeDefine(parameters);
+        auto envMapTypeDefine = generateEnvMapTypeDefine(parameters);
+        auto envMapModeDefine = generateEnvMapModeDefine(parameters);
+        auto envMapBlendingDefine = generateEnvMapBlendingDefine(parameters);
 
-    auto vertexShader = parameters->vertexShader;
-    auto fragmentShader = parameters->fragmentShader;
+        auto gammaFactorDefine = (gammaFactor > 0) ? gammaFactor : 1.f;
 
-    auto shadowMapTypeDefine = generateShadowMapTypeDefine(parameters);
-    auto envMapTypeDefine = generateEnvMapTypeDefine(parameters);
-    auto envMapModeDefine = generateEnvMapModeDefine(parameters);
-    auto envMapBlendingDefine = generateEnvMapBlendingDefine(parameters);
+        auto customDefines = generateDefines(defines);
 
-    auto gammaFactorDefine = (renderer->gammaFactor > 0) ? renderer->gammaFactor : 1.f;
+        std::string prefixVertex, prefixFragment;
 
-    auto customDefines = generateDefines(defines);
+        // shared by both stages, as blocks need to be declared identically
+        const auto cameraUniforms = parameters->uniformBuffers
+                                            ? "#define USE_UBO\n"
+                                              "layout(std140) uniform CameraBlock {\n"
+                                              "\tmat4 projectionMatrix;\n"
+                                              "\tmat4 viewMatrix;\n"
+                                              "\tvec3 cameraPosition;\n"
+                                              "\tbool isOrthographic;\n"
+                                              "};"
+                                            : "uniform mat4 projectionMatrix;\n"
+                                              "uniform mat4 viewMatrix;\n"
+                                              "uniform vec3 cameraPosition;\n"
+                                              "uniform bool isOrthographic;";
 
-    this->program = glCreateProgram();
+        if (parameters->isRawShaderMaterial) {
 
-    std::string prefixVertex, prefixFragment;
+            {
+                std::vector<std::string> v{customDefines};
 
-    if (parameters->isRawShaderMaterial) {
+                v.erase(
+                        std::remove_if(
+                                v.begin(),
+                                v.end(),
+                                [](const std::string& s) { return filterEmptyLine(s); }),
+                        v.end());
 
-        {
-            std::vector<std::string> v{customDefines};
+                prefixVertex = utils::join(v);
 
-            v.erase(
-                    std::remove_if(
-                            v.begin(),
-                            v.end(),
-                            [](const std::string& s) { return filterEmptyLine(s); }),
-                    v.end());
+                if (!prefixVertex.empty()) {
 
-            prefixVertex = utils::join(v);
+                    prefixVertex += "\n";
+                }
+            }
+
+            {
+                std::vector<std::string> v{customDefines};
+
+                v.erase(
+                        std::remove_if(
+                                v.begin(),
+                                v.end(),
+                                [](const std::string& s) { return filterEmptyLine(s); }),
+                        v.end());
 
-            if (!prefixVertex.empty()) {
+                prefixFragment = utils::join(v);
 
-                prefixVertex += "\n";
+                if (!prefixFragment.empty()) {
+
+                    prefixFragment += "\n";
+                }
             }
-        }
+        } else {
 
-        {
-            std::vector<std::string> v{customDefines};
+            {
+                std::vector<std::string> v{
 
-            v.erase(
-                    std::remove_if(
-                            v.begin(),
-                            v.end(),
-                            [](const std::string& s) { return filterEmptyLine(s); }),
-                    v.end());
+                        generatePrecision(),
 
-            prefixFragment = utils::join(v);
+                        "#define SHADER_NAME " + parameters->shaderName,
 
-            if (!prefixFragment.empty()) {
+                        customDefines,
 
-                prefixFragment += "\n";
-            }
-        }
-    } else {
+                        parameters->instancing ? "#define USE_INSTANCING" : "",
+                        parameters->instancingColor ? "#define USE_INSTANCING_COLOR" : "",
 
-        {
-            std::vector<std::string> v{
+                        parameters->supportsVertexTextures ? "#define VERTEX_TEXTURES" : "",
 
-                    generatePrecision(),
+                        "#define GAMMA_FACTOR " + std::to_string(gammaFactorDefine),
 
-                    "#define SHADER_NAME " + parameters->shaderName,
+                        "#define MAX_BONES " + std::to_string(parameters->maxBones),
+                        (parameters->useFog && parameters->fog) ? "#define USE_FOG" : "",
+                        (parameters->useFog && parameters->fogExp2) ? "#define FOG_EXP2" : "",
 
-                    customDefines,
+                        parameters->map ? "#define USE_MAP" : "",
+                        parameters->envMap ? "#define USE_ENVMAP" : "",
+                        parameters->envMap ? "#define " + envMapModeDefine : "",
+                        parameters->lightMap ? "#define USE_LIGHTMAP" : "",
+                        parameters->aoMap ? "#define USE_AOMAP" : "",
+                        parameters->emissiveMap ? "#define USE_EMISSIVEMAP" : "",
+                        parameters->bumpMap ? "#define USE_BUMPMAP" : "",
+                        parameters->normalMap ? "#define USE_NORMALMAP" : "",
+                        (parameters->normalMap && parameters->objectSpaceNormalMap) ? "#define OBJECTSPACE_NORMALMAP" : "",
+                        (parameters->normalMap && parameters->tangentSpaceNormalMap) ? "#define TANGENTSPACE_NORMALMAP" : "",
 
-                    parameters->instancing ? "#define USE_INSTANCING" : "",
-                    parameters->instancingColor ? "#define USE_INSTANCING_COLOR" : "",
+                        parameters->clearcoatMap ? "#define USE_CLEARCOATMAP" : "",
+                        parameters->clearcoatRoughnessMap ? "#define USE_CLEARCOAT_ROUGHNESSMAP" : "",
+                        parameters->clearcoatNormalMap ? "#define USE_CLEARCOAT_NORMALMAP" : "",
+                        parameters->displacementMap && parameters->supportsVertexTextures ? "#define USE_DISPLACEMENTMAP" : "",
+                        parameters->specularMap ? "#define USE_SPECULARMAP" : "",
+                        parameters->roughnessMap ? "#define USE_ROUGHNESSMAP" : "",
+                        parameters->metalnessMap ? "#define USE_METALNESSMAP" : "",
+                        parameters->alphaMap ? "#define USE_ALPHAMAP" : "",
+                        parameters->transmission ? "#define USE_TRANSMISSION" : "",
+                        parameters->transmissionMap ? "#define USE_TRANSMISSIONMAP" : "",
+                        parameters->thicknessMap ? "#define USE_THICKNESSMAP" : "",
 
-                    parameters->supportsVertexTextures ? "#define VERTEX_TEXTURES" : "",
+                        parameters->vertexTangents ? "#define USE_TANGENT" : "",
+                        parameters->vertexColors ? "#define USE_COLOR" : "",
+                        parameters->vertexAlphas ? "#define USE_COLOR_ALPHA" : "",
+                        parameters->vertexUvs ? "#define USE_UV" : "",
+                        parameters->uvsVertexOnly ? "#define UVS_VERTEX_ONLY" : "",
 
-                    "#define GAMMA_FACTOR " + std::to_string(gammaFactorDefine),
+                        parameters->flatShading ? "#define FLAT_SHADED" : "",
 
-                    "#define MAX_BONES " + std::to_string(parameters->maxBones),
-                    (parameters->useFog && parameters->fog) ? "#define USE_FOG" : "",
-                    (parameters->useFog && parameters->fogExp2) ? "#define FOG_EXP2" : "",
+                        parameters->skinning ? "#define USE_SKINNING" : "",
+                        parameters->useVertexTexture ? "#define BONE_TEXTURE" : "",
 
-                    parameters->map ? "#define USE_MAP" : "",
-                    parameters->envMap ? "#define USE_ENVMAP" : "",
-                    parameters->envMap ? "#define " + envMapModeDefine : "",
-                    parameters->lightMap ? "#define USE_LIGHTMAP" : "",
-                    parameters->aoMap ? "#define USE_AOMAP" : "",
-                    parameters->emissiveMap ? "#define USE_EMISSIVEMAP" : "",
-                    parameters->bumpMap ? "#define USE_BUMPMAP" : "",
-                    parameters->normalMap ? "#define USE_NORMALMAP" : "",
-                    (parameters->normalMap && parameters->objectSpaceNormalMap) ? "#define OBJECTSPACE_NORMALMAP" : "",
-                    (parameters->normalMap && parameters->tangentSpaceNormalMap) ? "#define TANGENTSPACE_NORMALMAP" : "",
+                        parameters->morphTargets ? "#define USE_MORPHTARGETS" : "",
+                        parameters->morphNormals && !parameters->flatShading ? "#define USE_MORPHNORMALS" : "",
+                        parameters->doubleSided ? "#define DOUBLE_SIDED" : "",
+                        parameters->flipSided ? "#define FLIP_SIDED" : "",
 
-                    parameters->clearcoatMap ? "#define USE_CLEARCOATMAP" : "",
-                    parameters->clearcoatRoughnessMap ? "#define USE_CLEARCOAT_ROUGHNESSMAP" : "",
-                    parameters->clearcoatNormalMap ? "#define USE_CLEARCOAT_NORMALMAP" : "",
-                    parameters->displacementMap && parameters->supportsVertexTextures ? "#define USE_DISPLACEMENTMAP" : "",
-                    parameters->specularMap ? "#define USE_SPECULARMAP" : "",
-                    parameters->roughnessMap ? "#define USE_ROUGHNESSMAP" : "",
-                    parameters->metalnessMap ? "#define USE_METALNESSMAP" : "",
-                    parameters->alphaMap ? "#define USE_ALPHAMAP" : "",
-                    parameters->transmission ? "#define USE_TRANSMISSION" : "",
-                    parameters->transmissionMap ? "#define USE_TRANSMISSIONMAP" : "",
-                    parameters->thicknessMap ? "#define USE_THICKNESSMAP" : "",
+                        parameters->shadowMapEnabled ? "#define USE_SHADOWMAP" : "",
+                        parameters->shadowMapEnabled ? "#define " + shadowMapTypeDefine : "",
+                        parameters->shadowMapEnabled && parameters->dirLightShadowCascades ? "#define DIR_LIGHT_SHADOW_CASCADES" : "",
 
-                    parameters->vertexTangents ? "#define USE_TANGENT" : "",
-                    parameters->vertexColors ? "#define USE_COLOR" : "",
-                    parameters->vertexAlphas ? "#define USE_COLOR_ALPHA" : "",
-                    parameters->vertexUvs ? "#define USE_UV" : "",
-                    parameters->uvsVertexOnly ? "#define UVS_VERTEX_ONLY" : "",
+                        parameters->sizeAttenuation ? "#define USE_SIZEATTENUATION" : "",
 
-                    parameters->flatShading ? "#define FLAT_SHADED" : "",
+                        parameters->logarithmicDepthBuffer ? "#define USE_LOGDEPTHBUF" : "",
 
-                    parameters->skinning ? "#define USE_SKINNING" : "",
-                    parameters->useVertexTexture ? "#define BONE_TEXTURE" : "",
+                        "uniform mat4 modelMatrix;",
+                        "uniform mat4 modelViewMatrix;",
+                        "uniform mat3 normalMatrix;",
 
-                    parameters->morphTargets ? "#define USE_MORPHTARGETS" : "",
-                    parameters->morphNormals && !parameters->flatShading ? "#define USE_MORPHNORMALS" : "",
-                    parameters->doubleSided ? "#define DOUBLE_SIDED" : "",
-                    parameters->flipSided ? "#define FLIP_SIDED" : "",
+                        cameraUniforms,
 
-                    parameters->shadowMapEnabled ? "#define USE_SHADOWMAP" : "",
-                    parameters->shadowMapEnabled ? "#define " + shadowMapTypeDefine : "",
+                        "#ifdef USE_INSTANCING",
 
-                    parameters->sizeAttenuation ? "#define USE_SIZEATTENUATION" : "",
+                        "	attribute mat4 instanceMatrix;",
 
-                    parameters->logarithmicDepthBuffer ? "#define USE_LOGDEPTHBUF" : "",
+                        "#endif",
 
-                    "uniform mat4 modelMatrix;",
-                    "uniform mat4 modelViewMatrix;",
-                    "uniform mat4 projectionMatrix;",
-                    "uniform mat4 viewMatrix;",
-                    "uniform mat3 normalMatrix;",
-                    "uniform vec3 cameraPosition;",
-                    "uniform bool isOrthographic;",
+                        "#ifdef USE_INSTANCING_COLOR",
 
-                    "#ifdef USE_INSTANCING",
+                        "	attribute vec3 instanceColor;",
 
-                    "	attribute mat4 instanceMatrix;",
+                        "#endif",
 
-                    "#endif",
+                        "attribute vec3 position;",
+                        "attribute vec3 normal;",
+                        "attribute vec2 uv;",
 
-                    "#ifdef USE_INSTANCING_COLOR",
+                        "#ifdef USE_TANGENT",
 
-                    "	attribute vec3 instanceColor;",
+                        "	attribute vec4 tangent;",
 
-                    "#endif",
+                        "#endif",
 
-                    "attribute vec3 position;",
-                    "attribute vec3 normal;",
-                    "attribute vec2 uv;",
+                        "#if defined( USE_COLOR_ALPHA )",
 
-                    "#ifdef USE_TANGENT",
+                        "	attribute vec4 color;",
 
-                    "	attribute vec4 tangent;",
+                        "#elif defined( USE_COLOR )",
 
-                    "#endif",
+                        "	attribute vec3 color;",
 
-                    "#if defined( USE_COLOR_ALPHA )",
+                        "#endif",
 
-                    "	attribute vec4 color;",
+                        "#ifdef USE_MORPHTARGETS",
 
-                    "#elif defined( USE_COLOR )",
+                        "	attribute vec3 morphTarget0;",
+                        "	attribute vec3 morphTarget1;",
+                        "	attribute vec3 morphTarget2;",
+                        "	attribute vec3 morphTarget3;",
 
-                    "	attribute vec3 color;",
+                        "	#ifdef USE_MORPHNORMALS",
 
-                    "#endif",
+                        "		attribute vec3 morphNormal0;",
+                        "		attribute vec3 morphNormal1;",
+                        "		attribute vec3 morphNormal2;",
+                        "		attribute vec3 morphNormal3;",
 
-                    "#ifdef USE_MORPHTARGETS",
+                        "	#else",
 
-                    "	attribute vec3 morphTarget0;",
-                    "	attribute vec3 morphTarget1;",
-                    "	attribute vec3 morphTarget2;",
-                    "	attribute vec3 morphTarget3;",
+                        "		attribute vec3 morphTarget4;",
+                        "		attribute vec3 morphTarget5;",
+                        "		attribute vec3 morphTarget6;",
+                        "		attribute vec3 morphTarget7;",
 
-                    "	#ifdef USE_MORPHNORMALS",
+                        "	#endif",
 
-                    "		attribute vec3 morphNormal0;",
-                    "		attribute vec3 morphNormal1;",
-                    "		attribute vec3 morphNormal2;",
-                    "		attribute vec3 morphNormal3;",
+                        "#endif",
 
-                    "	#else",
+                        "#ifdef USE_SKINNING",
 
-                    "		attribute vec3 morphTarget4;",
-                    "		attribute vec3 morphTarget5;",
-                    "		attribute vec3 morphTarget6;",
-                    "		attribute vec3 morphTarget7;",
+                        "	attribute vec4 skinIndex;",
+                        "	attribute vec4 skinWeight;",
 
-                    "	#endif",
+                        "#endif",
 
-                    "#endif",
+                        "\n"
 
-                    "#ifdef USE_SKINNING",
+                };
 
-                    "	attribute vec4 skinIndex;",
-                    "	attribute vec4 skinWeight;",
+                v.erase(std::remove_if(v.begin(), v.end(), [](const std::string& s) {
+                            return s.empty();
+                        }),
+                        v.end());
 
-                    "#endif",
+                prefixVertex = utils::join(v);
+            }
 
-                    "\n"
+            {
+                std::vector<std::string> v{
 
-            };
+                        generatePrecision(),
 
-            v.erase(std::remove_if(v.begin(), v.end(), [](const std::string& s) {
-                        return s.empty();
-                    }),
-                    v.end());
+                        "#define SHADER_NAME " + parameters->shaderName,
 
-            prefixVertex = utils::join(v);
-        }
+                        customDefines,
 
-        {
-            std::vector<std::string> v{
+                        (parameters->alphaTest != 0) ? "#define ALPHATEST " + std::to_string(parameters->alphaTest) + (!(std::isnan(std::fmod(parameters->alphaTest, 1.f))) ? "" : ".0") : "",// add ".0" if integer
 
-                    generatePrecision(),
+                        "#define GAMMA_FACTOR " + std::to_string(gammaFactorDefine),
 
-                    "#define SHADER_NAME " + parameters->shaderName,
+                        (parameters->useFog && parameters->fog) ? "#define USE_FOG" : "",
+                        (parameters->useFog && parameters->fogExp2) ? "#define FOG_EXP2" : "",
 
-                    customDefines,
+                        parameters->map ? "#define USE_MAP" : "",
+                        parameters->matcap ? "#define USE_MATCAP" : "",
+                        parameters->envMap ? "#define USE_ENVMAP" : "",
+                        parameters->envMap ? "#define " + envMapTypeDefine : "",
+                        parameters->envMap ? "#define " + envMapModeDefine : "",
+                        parameters->envMap ? "#define " + envMapBlendingDefine : "",
+                        parameters->lightMap ? "#define USE_LIGHTMAP" : "",
+                        parameters->aoMap ? "#define USE_AOMAP" : "",
+                        parameters->emissiveMap ? "#define USE_EMISSIVEMAP" : "",
+                        parameters->bumpMap ? "#define USE_BUMPMAP" : "",
+                        parameters->normalMap ? "#define USE_NORMALMAP" : "",
+                        (parameters->normalMap && parameters->objectSpaceNormalMap) ? "#define OBJECTSPACE_NORMALMAP" : "",
+                        (parameters->normalMap && parameters->tangentSpaceNormalMap) ? "#define TANGENTSPACE_NORMALMAP" : "",
+                        parameters->clearcoatMap ? "#define USE_CLEARCOATMAP" : "",
+                        parameters->clearcoatRoughnessMap ? "#define USE_CLEARCOAT_ROUGHNESSMAP" : "",
+                        parameters->clearcoatNormalMap ? "#define USE_CLEARCOAT_NORMALMAP" : "",
+                        parameters->specularMap ? "#define USE_SPECULARMAP" : "",
+                        parameters->roughnessMap ? "#define USE_ROUGHNESSMAP" : "",
+                        parameters->metalnessMap ? "#define USE_METALNESSMAP" : "",
+                        parameters->alphaMap ? "#define USE_ALPHAMAP" : "",
 
-                    (parameters->alphaTest != 0) ? "#define ALPHATEST " + std::to_string(parameters->alphaTest) + (!(std::isnan(std::fmod(parameters->alphaTest, 1.f))) ? "" : ".0") : "",// add ".0" if integer
+                        parameters->sheen ? "#define USE_SHEEN" : "",
+                        parameters->transmission ? "#define USE_TRANSMISSION" : "",
+                        parameters->transmissionMap ? "#define USE_TRANSMISSIONMAP" : "",
+                        parameters->thicknessMap ? "#define USE_THICKNESSMAP" : "",
 
-                    "#define GAMMA_FACTOR " + std::to_string(gammaFactorDefine),
+                        parameters->vertexTangents ? "#define USE_TANGENT" : "",
+                        parameters->vertexColors || parameters->instancingColor ? "#define USE_COLOR" : "",
+                        parameters->vertexAlphas ? "#define USE_COLOR_ALPHA" : "",
+                        parameters->vertexUvs ? "#define USE_UV" : "",
+                        parameters->uvsVertexOnly ? "#define UVS_VERTEX_ONLY" : "",
 
-                    (parameters->useFog && parameters->fog) ? "#define USE_FOG" : "",
-                    (parameters->useFog && parameters->fogExp2) ? "#define FOG_EXP2" : "",
+                        parameters->gradientMap ? "#define USE_GRADIENTMAP" : "",
 
-                    parameters->map ? "#define USE_MAP" : "",
-                    parameters->matcap ? "#define USE_MATCAP" : "",
-                    parameters->envMap ? "#define USE_ENVMAP" : "",
-                    parameters->envMap ? "#define " + envMapTypeDefine : "",
-                    parameters->envMap ? "#define " + envMapModeDefine : "",
-                    parameters->envMap ? "#define " + envMapBlendingDefine : "",
-                    parameters->lightMap ? "#define USE_LIGHTMAP" : "",
-                    parameters->aoMap ? "#define USE_AOMAP" : "",
-                    parameters->emissiveMap ? "#define USE_EMISSIVEMAP" : "",
-                    parameters->bumpMap ? "#define USE_BUMPMAP" : "",
-                    parameters->normalMap ? "#define USE_NORMALMAP" : "",
-                    (parameters->normalMap && parameters->objectSpaceNormalMap) ? "#define OBJECTSPACE_NORMALMAP" : "",
-                    (parameters->normalMap && parameters->tangentSpaceNormalMap) ? "#define TANGENTSPACE_NORMALMAP" : "",
-                    parameters->clearcoatMap ? "#define USE_CLEARCOATMAP" : "",
-                    parameters->clearcoatRoughnessMap ? "#define USE_CLEARCOAT_ROUGHNESSMAP" : "",
-                    parameters->clearcoatNormalMap ? "#define USE_CLEARCOAT_NORMALMAP" : "",
-                    parameters->specularMap ? "#define USE_SPECULARMAP" : "",
-                    parameters->roughnessMap ? "#define USE_ROUGHNESSMAP" : "",
-                    parameters->metalnessMap ? "#define USE_METALNESSMAP" : "",
-                    parameters->alphaMap ? "#define USE_ALPHAMAP" : "",
+                        parameters->flatShading ? "#define FLAT_SHADED" : "",
 
-                    parameters->sheen ? "#define USE_SHEEN" : "",
-                    parameters->transmission ? "#define USE_TRANSMISSION" : "",
-                    parameters->transmissionMap ? "#define USE_TRANSMISSIONMAP" : "",
-                    parameters->thicknessMap ? "#define USE_THICKNESSMAP" : "",
+                        parameters->doubleSided ? "#define DOUBLE_SIDED" : "",
+                        parameters->flipSided ? "#define FLIP_SIDED" : "",
 
-                    parameters->vertexTangents ? "#define USE_TANGENT" : "",
-                    parameters->vertexColors || parameters->instancingColor ? "#define USE_COLOR" : "",
-                    parameters->vertexAlphas ? "#define USE_COLOR_ALPHA" : "",
-                    parameters->vertexUvs ? "#define USE_UV" : "",
-                    parameters->uvsVertexOnly ? "#define UVS_VERTEX_ONLY" : "",
+                        parameters->shadowMapEnabled ? "#define USE_SHADOWMAP" : "",
+                        parameters->shadowMapEnabled ? "#define " + shadowMapTypeDefine : "",
+                        parameters->shadowMapEnabled && parameters->dirLightShadowCascades ? "#define DIR_LIGHT_SHADOW_CASCADES" : "",
 
-                    parameters->gradientMap ? "#define USE_GRADIENTMAP" : "",
+                        parameters->premultipliedAlpha ? "#define PREMULTIPLIED_ALPHA" : "",
 
-                    parameters->flatShading ? "#define FLAT_SHADED" : "",
+                        parameters->physicallyCorrectLights ? "#define PHYSICALLY_CORRECT_LIGHTS" : "",
 
-                    parameters->doubleSided ? "#define DOUBLE_SIDED" : "",
-                    parameters->flipSided ? "#define FLIP_SIDED" : "",
+                        parameters->logarithmicDepthBuffer ? "#define USE_LOGDEPTHBUF" : "",
 
-                    parameters->shadowMapEnabled ? "#define USE_SHADOWMAP" : "",
-                    parameters->shadowMapEnabled ? "#define " + shadowMapTypeDefine : "",
+                        cameraUniforms,
 
-                    parameters->premultipliedAlpha ? "#define PREMULTIPLIED_ALPHA" : "",
+                        (parameters->toneMapping != ToneMapping::None) ? "#define TONE_MAPPING" : "",
+                        (parameters->toneMapping != ToneMapping::None) ? shaders::ShaderChunk::instance().tonemapping_pars_fragment() : "",// this code is required here because it is used by the toneMapping() function defined below
+                        (parameters->toneMapping != ToneMapping::None) ? getToneMappingFunction("toneMapping", parameters->toneMapping) : "",
 
-                    parameters->physicallyCorrectLights ? "#define PHYSICALLY_CORRECT_LIGHTS" : "",
+                        parameters->dithering ? "#define DITHERING" : "",
 
-                    parameters->logarithmicDepthBuffer ? "#define USE_LOGDEPTHBUF" : "",
+                        shaders::ShaderChunk::instance().encodings_pars_fragment(),// this code is required here because it is used by the various encoding/decoding function defined below
+                        parameters->map ? getTexelDecodingFunction("mapTexelToLinear", parameters->mapEncoding) : "",
+                        parameters->matcap ? getTexelDecodingFunction("matcapTexelToLinear", parameters->matcapEncoding) : "",
+                        parameters->envMap ? getTexelDecodingFunction("envMapTexelToLinear", parameters->envMapEncoding) : "",
+                        parameters->emissiveMap ? getTexelDecodingFunction("emissiveMapTexelToLinear", parameters->emissiveMapEncoding) : "",
+                        parameters->lightMap ? getTexelDecodingFunction("lightMapTexelToLinear", parameters->lightMapEncoding) : "",
+                        getTexelEncodingFunction("linearToOutputTexel", parameters->outputEncoding),
 
-                    "uniform mat4 viewMatrix;",
-                    "uniform vec3 cameraPosition;",
-                    "uniform bool isOrthographic;",
+                        parameters->depthPacking ? "#define DEPTH_PACKING " + std::to_string(parameters->depthPacking) : "",
 
-                    (parameters->toneMapping != ToneMapping::None) ? "#define TONE_MAPPING" : "",
-                    (parameters->toneMapping != ToneMapping::None) ? shaders::ShaderChunk::instance().tonemapping_pars_fragment() : "",// this code is required here because it is used by the toneMapping() function defined below
-                    (parameters->toneMapping != ToneMapping::None) ? getToneMappingFunction("toneMapping", parameters->toneMapping) : "",
+                        "\n"
 
-                    parameters->dithering ? "#define DITHERING" : "",
+                };
 
-                    shaders::ShaderChunk::instance().encodings_pars_fragment(),// this code is required here because it is used by the various encoding/decoding function defined below
-                    parameters->map ? getTexelDecodingFunction("mapTexelToLinear", parameters->mapEncoding) : "",
-                    parameters->matcap ? getTexelDecodingFunction("matcapTexelToLinear", parameters->matcapEncoding) : "",
-                    parameters->envMap ? getTexelDecodingFunction("envMapTexelToLinear", parameters->envMapEncoding) : "",
-                    parameters->emissiveMap ? getTexelDecodingFunction("emissiveMapTexelToLinear", parameters->emissiveMapEncoding) : "",
-                    parameters->lightMap ? getTexelDecodingFunction("lightMapTexelToLinear", parameters->lightMapEncoding) : "",
-                    getTexelEncodingFunction("linearToOutputTexel", parameters->outputEncoding),
+                v.erase(
+                        std::remove_if(
+                                v.begin(),
+                                v.end(),
+                                [](const std::string& s) { return s.empty(); }),
+                        v.end());
 
-                    parameters->depthPacking ? "#define DEPTH_PACKING " + std::to_string(parameters->depthPacking) : "",
+                prefixFragment = utils::join(v);
+            }
+        }
 
-                    "\n"
+        const auto shaderDefines = getShaderDefines(parameters);
 
-            };
+        vertexShader = shaders::preprocessShader(vertexShader, shaderDefines);
+        fragmentShader = shaders::preprocessShader(fragmentShader, shaderDefines);
 
-            v.erase(
-                    std::remove_if(
-                            v.begin(),
-                            v.end(),
-                            [](const std::string& s) { return s.empty(); }),
-                    v.end());
+        std::string glslVersion{"330 core"};
+    #if EMSCRIPTEN
+        glslVersion = "300 es";
+    #endif
+
+        if (!parameters->isRawShaderMaterial) {
+
+            {
+                std::vector<std::string> v{
+                        "#version " + glslVersion + "\n",
+                        "#define attribute in",
+                        "#define varying out",
+                        "#define texture2D texture"
+
+                };
+
+                prefixVertex = utils::join(v) + "\n" + prefixVertex;
+            }
 
-            prefixFragment = utils::join(v);
+            {
+                std::vector<std::string> v{
+                        "#version " + glslVersion + "\n",
+                        "#define varying in",
+                        "out highp vec4 pc_fragColor;",
+                        "#define gl_FragColor pc_fragColor",
+                        //                    ( parameters->glslVersion == GLSL3 ) ? "" : "out highp vec4 pc_fragColor;",
+                        //                    ( parameters->glslVersion == GLSL3 ) ? "" : "#define gl_FragColor pc_fragColor",
+                        "#define gl_FragDepthEXT gl_FragDepth",
+                        "#define texture2D texture",
+                        "#define textureCube texture",
+                        "#define texture2DProj textureProj",
+                        "#define texture2DLodEXT textureLod",
+                        "#define texture2DProjLodEXT textureProjLod",
+                        "#define textureCubeLodEXT textureLod",
+                        "#define texture2DGradEXT textureGrad",
+                        "#define texture2DProjGradEXT textureProjGrad",
+                        "#define textureCubeGradEXT textureGrad"
+
+                };
+
+                prefixFragment = utils::join(v) + "\n" + prefixFragment;
+            }
         }
+
+        return {prefixVertex + vertexShader, prefixFragment + fragmentShader};
     }
 
-    vertexShader = resolveIncludes(vertexShader);
-    replaceLightNums(vertexShader, parameters);
-    replaceClippingPlaneNums(vertexShader, parameters);
+}// namespace
 
-    fragmentShader = resolveIncludes(fragmentShader);
-    replaceLightNums(fragmentShader, parameters);
-    replaceClippingPlaneNums(fragmentShader, parameters);
 
-    vertexShader = unrollLoops(vertexShader);
-    fragmentShader = unrollLoops(fragmentShader);
+GLProgram::GLProgram(const GLRenderer* renderer, const ProgramCacheKey& cacheKey, const ProgramParameters* parameters, GLBindingStates* bindingStates,
+                     utils::ThreadPool* pool, GLProgramBinaryCache* binaryCache)
+    : cacheKey(cacheKey),
+      bindingStates(bindingStates),
+      index0AttributeName_(parameters->index0AttributeName),
+      morphTargets_(parameters->morphTargets),
+      checkShaderErrors_(renderer->checkShaderErrors),
+      binaryCache_(binaryCache) {
 
-    std::string glslVersion{"330 core"};
-#if EMSCRIPTEN
-    glslVersion = "300 es";
-#endif
+    this->program = glCreateProgram();
 
-    if (!parameters->isRawShaderMaterial) {
+    if (pool) {
 
-        {
-            std::vector<std::string> v{
-                    "#version " + glslVersion + "\n",
-                    "#define attribute in",
-                    "#define varying out",
-                    "#define texture2D texture"
+        auto task = std::make_shared<std::packaged_task<std::pair<std::string, std::string>()>>(
+                [parameters = *parameters, gammaFactor = renderer->gammaFactor] {
+                    return generateSources(&parameters, gammaFactor);
+                });
 
-            };
+        sources_ = task->get_future();
+        pool->submit([task] { (*task)(); });
 
-            prefixVertex = utils::join(v) + "\n" + prefixVertex;
-        }
+    } else {
 
-        {
-            std::vector<std::string> v{
-                    "#version " + glslVersion + "\n",
-                    "#define varying in",
-                    "out highp vec4 pc_fragColor;",
-                    "#define gl_FragColor pc_fragColor",
-                    //                    ( parameters->glslVersion == GLSL3 ) ? "" : "out highp vec4 pc_fragColor;",
-                    //                    ( parameters->glslVersion == GLSL3 ) ? "" : "#define gl_FragColor pc_fragColor",
-                    "#define gl_FragDepthEXT gl_FragDepth",
-                    "#define texture2D texture",
-                    "#define textureCube texture",
-                    "#define texture2DProj textureProj",
-                    "#define texture2DLodEXT textureLod",
-                    "#define texture2DProjLodEXT textureProjLod",
-                    "#define textureCubeLodEXT textureLod",
-                    "#define texture2DGradEXT textureGrad",
-                    "#define texture2DProjGradEXT textureProjGrad",
-                    "#define textureCubeGradEXT textureGrad"
-
-            };
-
-            prefixFragment = utils::join(v) + "\n" + prefixFragment;
-        }
+        const auto [vertexGlsl, fragmentGlsl] = generateSources(parameters, renderer->gammaFactor);
+
+        build(vertexGlsl, fragmentGlsl);
+        onLinked();
+    }
+}
+
+bool GLProgram::isReady() {
+
+    if (linked_) return true;
+
+    if (sources_.valid()) {
+
+        if (sources_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return false;
+
+        const auto [vertexGlsl, fragmentGlsl] = sources_.get();
+        build(vertexGlsl, fragmentGlsl);
+    }
+
+    if (GLCapabilities::instance().parallelShaderCompile) {
+
+        GLint completed;
+        glGetProgramiv(program, GL_COMPLETION_STATUS_KHR, &completed);
+
+        if (!completed) return false;
     }
 
-    std::string vertexGlsl = prefixVertex + vertexShader;
-    std::string fragmentGlsl = prefixFragment + fragmentShader;
+    onLinked();
+
+    return true;
+}
 
+void GLProgram::finish() {
 
+    if (linked_) return;
 
-    const auto glVertexShader = createShader(GL_VERTEX_SHADER, vertexGlsl.c_str());
-    const auto glFragmentShader = createShader(GL_FRAGMENT_SHADER, fragmentGlsl.c_str());
+    if (sources_.valid()) {
 
-    glAttachShader(program, glVertexShader);
-    glAttachShader(program, glFragmentShader);
+        const auto [vertexGlsl, fragmentGlsl] = sources_.get();
+        build(vertexGlsl, fragmentGlsl);
+    }
 
-    if (parameters->index0AttributeName) {
+    onLinked();
+}
 
-        glBindAttribLocation(program, 0, parameters->index0AttributeName.value().c_str());
+void GLProgram::build(const std::string& vertexGlsl, const std::string& fragmentGlsl) {
 
-    } else if (parameters->morphTargets) {
+    if (binaryCache_) {
+
+        binaryKey_ = binaryCache_->key(vertexGlsl, fragmentGlsl, index0AttributeName_, morphTargets_);
+        fromBinary_ = binaryCache_->load(program, binaryKey_);
+
+        if (fromBinary_) return;
+
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
+    link(vertexGlsl, fragmentGlsl);
+}
+
+void GLProgram::link(const std::string& vertexGlsl, const std::string& fragmentGlsl) {
+
+    glVertexShader_ = createShader(GL_VERTEX_SHADER, vertexGlsl.c_str());
+    glFragmentShader_ = createShader(GL_FRAGMENT_SHADER, fragmentGlsl.c_str());
+
+    glAttachShader(program, glVertexShader_);
+    glAttachShader(program, glFragmentShader_);
+
+    if (index0AttributeName_) {
+
+        glBindAttribLocation(program, 0, index0AttributeName_->c_str());
+
+    } else if (morphTargets_) {
 
         // programs with morphTargets displace position out of attribute 0
         glBindAttribLocation(program, 0, "position");
     }
 
     glLinkProgram(program);
+}
+
+// queries the program, which blocks until it has linked
+void GLProgram::onLinked() {
+
+    linked_ = true;
 
-    if (renderer->checkShaderErrors) {
+    GLUniformBuffers::bindBlocks(program);
+
+    if (checkShaderErrors_) {
 
         int length;
         glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
@@ -731,13 +766,20 @@ GLProgram::GLProgram(const GLRenderer* renderer, std::string cacheKey, const Pro
         }
     }
 
-    glDeleteShader(glVertexShader);
-    glDeleteShader(glFragmentShader);
+    glDeleteShader(glVertexShader_);
+    glDeleteShader(glFragmentShader_);
+
+    if (binaryCache_ && !fromBinary_) {
+
+        binaryCache_->store(program, binaryKey_);
+    }
 }
 
 GLUniforms* GLProgram::getUniforms() {
 
     if (!cachedUniforms) {
+        finish();
+
         cachedUniforms = std::make_unique<GLUniforms>(program);
     }
 
@@ -748,6 +790,7 @@ std::unordered_map<std::string, int> GLProgram::getAttributes() {
 
     if (cachedAttributes.empty()) {
 
+        finish();
         cachedAttributes = fetchAttributeLocations(program);
     }
 
@@ -758,6 +801,12 @@ void GLProgram::destroy() {
 
     bindingStates->releaseStatesOfProgram(*this);
 
+    if (!linked_) {
+
+        glDeleteShader(glVertexShader_);
+        glDeleteShader(glFragmentShader_);
+    }
+
     glDeleteProgram(program);
     this->program = -1;
 }
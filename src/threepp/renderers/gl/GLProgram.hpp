@@ -4,34 +4,54 @@
 #define THREEPP_GLPROGRAM_HPP
 
 #include "GLUniforms.hpp"
+#include "ProgramBinaryKey.hpp"
+#include "ProgramCacheKey.hpp"
 #include "ProgramParameters.hpp"
 
+#include <future>
 #include <memory>
+#include <optional>
 #include <utility>
 
 namespace threepp {
 
     class GLRenderer;
 
+    namespace utils {
+        class ThreadPool;
+    }
+
     namespace gl {
 
         struct GLBindingStates;
+        struct GLProgramBinaryCache;
 
         struct GLProgram {
 
             std::string name;
             int id = programIdCount++;
-            std::string cacheKey;
+            ProgramCacheKey cacheKey;
             int usedTimes = 1;
             int program = -1;
 
-            GLProgram(const GLRenderer* renderer, std::string cacheKey, const ProgramParameters* parameters, GLBindingStates* bindingStates);
+            // Given a pool, the shader source is generated on it, and the program compiled once isReady finds it done.
+            // Otherwise the program is compiled and linked right away.
+            // Given a binary cache, the program is loaded from it when possible, and stored in it once compiled.
+            GLProgram(const GLRenderer* renderer, const ProgramCacheKey& cacheKey, const ProgramParameters* parameters, GLBindingStates* bindingStates,
+                      utils::ThreadPool* pool = nullptr, GLProgramBinaryCache* binaryCache = nullptr);
 
             GLProgram(const GLProgram&) = delete;
             GLProgram(GLProgram&&) = delete;
             GLProgram& operator=(const GLProgram&) = delete;
             GLProgram& operator=(GLProgram&&) = delete;
 
+            // Whether the program has linked, without waiting for it.
+            // Linking is polled with GL_COMPLETION_STATUS_KHR where KHR_parallel_shader_compile is available.
+            bool isReady();
+
+            // Waits for the program to link.
+            void finish();
+
             GLUniforms* getUniforms();
 
             std::unordered_map<std::string, int> getAttributes();
@@ -43,6 +63,26 @@ namespace threepp {
             std::unique_ptr<GLUniforms> cachedUniforms;
             std::unordered_map<std::string, int> cachedAttributes;
 
+            std::future<std::pair<std::string, std::string>> sources_;
+            std::optional<std::string> index0AttributeName_;
+            bool morphTargets_ = false;
+            bool checkShaderErrors_ = false;
+
+            unsigned int glVertexShader_ = 0;
+            unsigned int glFragmentShader_ = 0;
+            bool linked_ = false;
+
+            GLProgramBinaryCache* binaryCache_ = nullptr;
+            ProgramBinaryKey binaryKey_{};
+            bool fromBinary_ = false;
+
+            // loads the program from the binary cache, or compiles and links it
+            void build(const std::string& vertexGlsl, const std::string& fragmentGlsl);
+
+            void link(const std::string& vertexGlsl, const std::string& fragmentGlsl);
+
+            void onLinked();
+
             GLProgram() = default;
 
             inline static int programIdCount{0};
@@ -0,0 +1,213 @@
+
+#include "threepp/renderers/gl/GLProgramBinaryCache.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string_view>
+
+#ifndef EMSCRIPTEN
+#include <glad/glad.h>
+#else
+#include <GLES3/gl32.h>
+#endif
+
+using namespace threepp;
+using namespace threepp::gl;
+
+namespace {
+
+    constexpr char magic[4] = {'T', 'P', 'P', 'B'};
+    // 2: the check hash and the length of the inputs
+    constexpr std::uint32_t formatVersion = 2;
+
+    struct Header {
+
+        char magic[4];
+        std::uint32_t version;
+        std::uint64_t key;
+        std::uint64_t check;
+        std::uint64_t length;
+        std::uint32_t format;
+        std::uint32_t size;
+    };
+
+    constexpr std::uint64_t fnvOffset = 14695981039346656037ull;
+    constexpr std::uint64_t fnvPrime = 1099511628211ull;
+
+    // multiplier of the check hash, unrelated to the FNV prime
+    constexpr std::uint64_t checkPrime = 0x9e3779b97f4a7c15ull;
+
+    using Key = GLProgramBinaryCache::Key;
+
+    Key hash(std::string_view str, Key key) {
+
+        for (auto c : str) {
+            key.hash = (key.hash ^ static_cast<unsigned char>(c)) * fnvPrime;
+            key.check = (key.check + static_cast<unsigned char>(c) + 1) * checkPrime;
+        }
+
+        // the length separates consecutive strings
+        key.hash = (key.hash ^ str.size()) * fnvPrime;
+        key.check = (key.check ^ str.size()) * checkPrime;
+        key.length += str.size();
+
+        return key;
+    }
+
+    std::string_view glString(GLenum name) {
+
+        const auto str = reinterpret_cast<const char*>(glGetString(name));
+
+        return str ? str : "";
+    }
+
+}// namespace
+
+GLProgramBinaryCache::GLProgramBinaryCache(ProgramBinaryInfo& info)
+    : info_(info) {
+
+    driverKey_ = hash(glString(GL_VENDOR), {fnvOffset, 0, 0});
+    driverKey_ = hash(glString(GL_RENDERER), driverKey_);
+    driverKey_ = hash(glString(GL_VERSION), driverKey_);
+}
+
+Key GLProgramBinaryCache::key(const std::string& vertexGlsl, const std::string& fragmentGlsl, const std::optional<std::string>& index0AttributeName, bool morphTargets) const {
+
+    auto key = hash(vertexGlsl, driverKey_);
+    key = hash(fragmentGlsl, key);
+    key = hash(index0AttributeName.value_or(""), key);
+    key = hash(morphTargets ? "morphTargets" : "", key);
+
+    return key;
+}
+
+bool GLProgramBinaryCache::load(unsigned int program, const Key& key) {
+
+    unsigned int format;
+    std::vector<char> binary;
+    if (!read(key, format, binary)) {
+
+        ++info_.misses;
+        return false;
+    }
+
+    glProgramBinary(program, format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+    GLint linked;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+
+    if (!linked) {
+
+        // typically after a driver update that kept its version string
+        ++info_.rejected;
+
+        std::error_code ec;
+        std::filesystem::remove(path(key), ec);
+
+        return false;
+    }
+
+    ++info_.hits;
+
+    return true;
+}
+
+void GLProgramBinaryCache::store(unsigned int program, const Key& key) {
+
+    GLint linked;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) return;
+
+    GLint length;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    std::vector<char> binary(length);
+    GLsizei written = 0;
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) return;
+
+    binary.resize(written);
+
+    if (write(key, format, binary)) ++info_.stored;
+}
+
+bool GLProgramBinaryCache::read(const Key& key, unsigned int& format, std::vector<char>& binary) const {
+
+    std::ifstream file(path(key), std::ios::binary);
+    if (!file) return false;
+
+    Header header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(Header));
+
+    if (!file || std::memcmp(header.magic, magic, sizeof(magic)) != 0 ||
+        header.version != formatVersion || Key{header.key, header.check, header.length} != key || header.size == 0) {
+
+        return false;
+    }
+
+    binary.resize(header.size);
+    file.read(binary.data(), header.size);
+    if (!file) return false;
+
+    format = header.format;
+
+    return true;
+}
+
+bool GLProgramBinaryCache::write(const Key& key, unsigned int format, const std::vector<char>& binary) const {
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) return false;
+
+    Header header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = formatVersion;
+    header.key = key.hash;
+    header.check = key.check;
+    header.length = key.length;
+    header.format = format;
+    header.size = static_cast<std::uint32_t>(binary.size());
+
+    // written under a unique name and renamed into place, so that other processes sharing
+    // the directory never read a partial file
+    const auto target = path(key);
+    auto temporary = target;
+    temporary += "." + std::to_string(std::random_device{}()) + ".tmp";
+
+    {
+        std::ofstream file(temporary, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        file.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+
+        if (!file) {
+
+            file.close();
+            std::filesystem::remove(temporary, ec);
+
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporary, target, ec);
+    if (ec) {
+
+        std::filesystem::remove(temporary, ec);
+        return false;
+    }
+
+    return true;
+}
+
+std::filesystem::path GLProgramBinaryCache::path(const Key& key) const {
+
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << key.hash << ".bin";
+
+    return directory / name.str();
+}
@@ -0,0 +1,50 @@
+
+#ifndef THREEPP_GLPROGRAMBINARYCACHE_HPP
+#define THREEPP_GLPROGRAMBINARYCACHE_HPP
+
+#include "threepp/renderers/gl/GLInfo.hpp"
+#include "threepp/renderers/gl/ProgramBinaryKey.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace threepp::gl {
+
+    // Linked program binaries kept in a directory between runs, so that programs are loaded with
+    // glProgramBinary rather than compiled. Binaries are keyed by the generated shader source,
+    // the attribute bindings and the GL vendor, renderer and version, and a binary rejected
+    // by the driver is deleted and the program compiled as usual.
+    struct GLProgramBinaryCache {
+
+        using Key = ProgramBinaryKey;
+
+        std::filesystem::path directory;
+
+        explicit GLProgramBinaryCache(ProgramBinaryInfo& info);
+
+        [[nodiscard]] Key key(const std::string& vertexGlsl, const std::string& fragmentGlsl, const std::optional<std::string>& index0AttributeName, bool morphTargets) const;
+
+        // Loads the binary stored under key into program, and returns whether it linked.
+        bool load(unsigned int program, const Key& key);
+
+        // Stores the binary of a linked program under key.
+        void store(unsigned int program, const Key& key);
+
+        // The binary stored under key, as written by write. Returns false if there is none, or it is invalid.
+        bool read(const Key& key, unsigned int& format, std::vector<char>& binary) const;
+
+        bool write(const Key& key, unsigned int format, const std::vector<char>& binary) const;
+
+    private:
+        ProgramBinaryInfo& info_;
+        Key driverKey_;
+
+        [[nodiscard]] std::filesystem::path path(const Key& key) const;
+    };
+
+}// namespace threepp::gl
+
+#endif//THREEPP_GLPROGRAMBINARYCACHE_HPP
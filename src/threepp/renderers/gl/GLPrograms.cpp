@@ -3,10 +3,12 @@
 
 #include "threepp/materials/RawShaderMaterial.hpp"
 #include "threepp/renderers/GLRenderer.hpp"
-#include "threepp/utils/StringUtils.hpp"
 
 #include "threepp/renderers/shaders/ShaderLib.hpp"
 
+#include <algorithm>
+#include <thread>
+
 using namespace threepp;
 using namespace threepp::gl;
 
@@ -32,13 +34,14 @@ namespace {
 }// namespace
 
 
-GLPrograms::GLPrograms(GLBindingStates& bindingStates, GLClipping& clipping)
+GLPrograms::GLPrograms(GLBindingStates& bindingStates, GLClipping& clipping, GLInfo& info)
     : logarithmicDepthBuffer(GLCapabilities::instance().logarithmicDepthBuffer),
       floatVertexTextures(GLCapabilities::instance().floatVertexTextures),
       maxVertexUniforms(GLCapabilities::instance().maxVertexUniforms),
       vertexTextures(GLCapabilities::instance().vertexTextures),
+      clipping(clipping),
       bindingStates(bindingStates),
-      clipping(clipping) {}
+      info(info) {}
 
 
 ProgramParameters GLPrograms::getParameters(
@@ -53,44 +56,133 @@ ProgramParameters GLPrograms::getParameters(
     return {renderer, clipping, lights, numShadows, object, scene, material, shaderIDs};
 }
 
-std::string GLPrograms::getProgramCacheKey(const GLRenderer& renderer, const ProgramParameters& parameters) {
+ProgramCacheKey GLPrograms::getProgramCacheKey(const GLRenderer& renderer, const ProgramParameters& parameters) {
 
-    std::vector<std::string> array;
+    ProgramCacheKey key;
 
     if (parameters.shaderID) {
 
-        array.emplace_back(*parameters.shaderID);
+        key.addSource(*parameters.shaderID);
 
     } else {
 
-        array.emplace_back(parameters.fragmentShader);
-        array.emplace_back(parameters.vertexShader);
+        key.addSource(parameters.fragmentShader);
+        key.addSource(parameters.vertexShader);
     }
 
-    if (!parameters.defines.empty()) {
-
-        for (const auto& [name, value] : parameters.defines) {
+    for (const auto& [name, value] : parameters.defines) {
 
-            array.emplace_back(name);
-            array.emplace_back(value);
-        }
+        key.addDefine(name, value);
     }
 
-    if (!parameters.isRawShaderMaterial) {
-
-        auto hash = utils::split(parameters.hash(), '\n');
-        for (const auto& value : hash) {
+    key.addFlag(parameters.isRawShaderMaterial);
 
-            array.emplace_back(value);
-        }
+    if (!parameters.isRawShaderMaterial) {
 
-        array.emplace_back(std::to_string(as_integer(renderer.outputEncoding)));
-        array.emplace_back(std::to_string(renderer.gammaFactor));
+        key.addFlag(parameters.instancing);
+        key.addFlag(parameters.instancingColor);
+
+        key.addFlag(parameters.supportsVertexTextures);
+        key.addValue(as_integer(parameters.outputEncoding));
+        key.addFlag(parameters.map);
+        key.addValue(as_integer(parameters.mapEncoding));
+        key.addFlag(parameters.matcap);
+        key.addValue(as_integer(parameters.matcapEncoding));
+        key.addFlag(parameters.envMap);
+        key.addValue(as_integer(parameters.envMapEncoding));
+        key.addValue(parameters.envMapMode);
+        key.addFlag(parameters.envMapCubeUV);
+        key.addFlag(parameters.lightMap);
+        key.addValue(as_integer(parameters.lightMapEncoding));
+        key.addFlag(parameters.aoMap);
+        key.addFlag(parameters.emissiveMap);
+        key.addValue(as_integer(parameters.emissiveMapEncoding));
+        key.addFlag(parameters.bumpMap);
+        key.addFlag(parameters.normalMap);
+        key.addFlag(parameters.objectSpaceNormalMap);
+        key.addFlag(parameters.tangentSpaceNormalMap);
+        key.addFlag(parameters.clearcoatMap);
+        key.addFlag(parameters.clearcoatRoughnessMap);
+        key.addFlag(parameters.clearcoatNormalMap);
+        key.addFlag(parameters.displacementMap);
+        key.addFlag(parameters.roughnessMap);
+        key.addFlag(parameters.metalnessMap);
+        key.addFlag(parameters.specularMap);
+        key.addFlag(parameters.alphaMap);
+
+        key.addFlag(parameters.gradientMap);
+
+        key.addFlag(parameters.sheen.has_value());
+        const auto sheen = parameters.sheen.value_or(Color());
+        key.addValue(sheen.r);
+        key.addValue(sheen.g);
+        key.addValue(sheen.b);
+
+        key.addFlag(parameters.transmission);
+        key.addFlag(parameters.transmissionMap);
+        key.addFlag(parameters.thicknessMap);
+
+        key.addFlag(parameters.combine.has_value());
+        key.addValue(parameters.combine ? as_integer(*parameters.combine) : 0);
+
+        key.addFlag(parameters.vertexTangents);
+        key.addFlag(parameters.vertexColors);
+        key.addFlag(parameters.vertexAlphas);
+        key.addFlag(parameters.vertexUvs);
+        key.addFlag(parameters.uvsVertexOnly);
+
+        key.addFlag(parameters.fog);
+        key.addFlag(parameters.useFog);
+        key.addFlag(parameters.fogExp2);
+
+        key.addFlag(parameters.flatShading);
+
+        key.addFlag(parameters.sizeAttenuation);
+        key.addFlag(parameters.logarithmicDepthBuffer);
+
+        key.addFlag(parameters.morphTargets);
+        key.addFlag(parameters.morphNormals);
+
+        key.addFlag(parameters.skinning);
+        key.addFlag(parameters.useVertexTexture);
+
+        key.addValue(parameters.numDirLights);
+        key.addValue(parameters.numPointLights);
+        key.addValue(parameters.numSpotLights);
+        key.addValue(parameters.numRectAreaLights);
+        key.addValue(parameters.numHemiLights);
+
+        key.addValue(parameters.numDirLightShadows);
+        key.addValue(parameters.numPointLightShadows);
+        key.addValue(parameters.numSpotLightShadows);
+        key.addFlag(parameters.dirLightShadowCascades);
+
+        key.addValue(parameters.numClippingPlanes);
+        key.addValue(parameters.numClipIntersection);
+
+        key.addFlag(parameters.dithering);
+
+        key.addFlag(parameters.shadowMapEnabled);
+        key.addValue(as_integer(parameters.shadowMapType));
+
+        key.addValue(as_integer(parameters.toneMapping));
+        key.addFlag(parameters.physicallyCorrectLights);
+
+        key.addFlag(parameters.uniformBuffers);
+
+        key.addFlag(parameters.premultipliedAlpha);
+
+        key.addValue(parameters.alphaTest);
+        key.addFlag(parameters.doubleSided);
+        key.addFlag(parameters.flipSided);
+
+        key.addValue(parameters.depthPacking);
+
+        key.addValue(as_integer(renderer.outputEncoding));
+        key.addValue(renderer.gammaFactor);
     }
 
-    //    array.emplace_back(parameters.customProgramCacheKey);
-
-    return utils::join(array);
+    return key;
 }
 
 UniformMap* GLPrograms::getUniforms(Material& material) {
@@ -110,7 +202,7 @@ UniformMap* GLPrograms::getUniforms(Material& material) {
     return nullptr;
 }
 
-GLProgram* GLPrograms::acquireProgram(const GLRenderer& renderer, const ProgramParameters& parameters, const std::string& cacheKey) {
+GLProgram* GLPrograms::acquireProgram(const GLRenderer& renderer, const ProgramParameters& parameters, const ProgramCacheKey& cacheKey, bool parallel) {
 
     GLProgram* program = nullptr;
 
@@ -128,7 +220,24 @@ GLProgram* GLPrograms::acquireProgram(const GLRenderer& renderer, const ProgramP
 
     if (!program) {
 
-        programs.emplace_back(std::make_unique<GLProgram>(&renderer, cacheKey, &parameters, &bindingStates));
+        if (parallel && !pool) {
+
+            pool = std::make_unique<utils::ThreadPool>(std::max(1u, std::thread::hardware_concurrency()));
+        }
+
+        GLProgramBinaryCache* binaries = nullptr;
+        if (!renderer.programCacheDirectory.empty() && GLCapabilities::instance().programBinary) {
+
+            if (!binaryCache) {
+
+                binaryCache = std::make_unique<GLProgramBinaryCache>(info.programBinaries);
+            }
+
+            binaryCache->directory = renderer.programCacheDirectory;
+            binaries = binaryCache.get();
+        }
+
+        programs.emplace_back(std::make_unique<GLProgram>(&renderer, cacheKey, &parameters, &bindingStates, parallel ? pool.get() : nullptr, binaries));
         program = programs.back().get();
     }
 
@@ -7,12 +7,15 @@
 #include "GLClipping.hpp"
 #include "GLLights.hpp"
 #include "GLProgram.hpp"
+#include "GLProgramBinaryCache.hpp"
+#include "ProgramCacheKey.hpp"
 #include "ProgramParameters.hpp"
 
 #include "threepp/core/Object3D.hpp"
 #include "threepp/materials/Material.hpp"
 #include "threepp/scenes/Scene.hpp"
 #include "threepp/textures/Texture.hpp"
+#include "threepp/utils/ThreadPool.hpp"
 
 #include <map>
 #include <memory>
@@ -40,9 +43,16 @@ namespace threepp {
         private:
             GLClipping& clipping;
             GLBindingStates& bindingStates;
+            GLInfo& info;
+
+            // generates shader source for programs acquired in parallel, created on first use
+            std::unique_ptr<utils::ThreadPool> pool;
+
+            // created once a renderer sets programCacheDirectory, where program binaries are supported
+            std::unique_ptr<GLProgramBinaryCache> binaryCache;
 
         public:
-            GLPrograms(GLBindingStates& bindingStates, GLClipping& clipping);
+            GLPrograms(GLBindingStates& bindingStates, GLClipping& clipping, GLInfo& info);
 
             static ProgramParameters getParameters(
                     const GLRenderer& renderer,
@@ -53,11 +63,13 @@ namespace threepp {
                     Scene* scene,
                     Object3D* object);
 
-            static std::string getProgramCacheKey(const GLRenderer& renderer, const ProgramParameters& parameters);
+            static ProgramCacheKey getProgramCacheKey(const GLRenderer& renderer, const ProgramParameters& parameters);
 
             static UniformMap* getUniforms(Material& material);
 
-            GLProgram* acquireProgram(const GLRenderer& renderer, const ProgramParameters& parameters, const std::string& cacheKey);
+            // New programs acquired in parallel have their source generated on a worker thread,
+            // and are compiled once GLProgram::isReady finds it done.
+            GLProgram* acquireProgram(const GLRenderer& renderer, const ProgramParameters& parameters, const ProgramCacheKey& cacheKey, bool parallel = false);
 
             void releaseProgram(GLProgram* program);
         };
@@ -0,0 +1,247 @@
+
+#include "threepp/renderers/gl/GLProjection.hpp"
+
+#include "threepp/cameras/Camera.hpp"
+#include "threepp/core/BufferGeometry.hpp"
+#include "threepp/lights/Light.hpp"
+#include "threepp/objects/Group.hpp"
+#include "threepp/objects/LOD.hpp"
+#include "threepp/objects/Line.hpp"
+#include "threepp/objects/Mesh.hpp"
+#include "threepp/objects/Points.hpp"
+#include "threepp/objects/SkinnedMesh.hpp"
+#include "threepp/objects/Sprite.hpp"
+#include "threepp/objects/StaticBatch.hpp"
+
+#include "threepp/utils/ThreadPool.hpp"
+
+using namespace threepp;
+using namespace threepp::gl;
+
+
+void GLProjection::project(Object3D* scene, Camera* camera, const Frustum& frustum, const Matrix4& projScreenMatrix, bool sortObjects, utils::ThreadPool* pool) {
+
+    camera_ = camera;
+    frustum_ = &frustum;
+    projScreenMatrix_ = &projScreenMatrix;
+    sortObjects_ = sortObjects;
+
+    numSegments_ = 0;
+    jobs_.clear();
+
+    currentSegment_ = nextSegment();
+
+    if (!pool) {
+
+        deferCulling_ = false;
+        projectObject(scene, 0, nullptr, segments_[currentSegment_]);
+
+        return;
+    }
+
+    // geometries shared between subtrees may lack a bounding sphere,
+    // computing it concurrently would race, so leave those to the caller
+    deferCulling_ = true;
+
+    subtreeSizes_.clear();
+    countSubtree(scene);
+
+    split(scene, 0, 0, nullptr);
+
+    const auto runJob = [this](const Job& job) {
+        auto& out = segments_[job.segment];
+        for (auto i = job.begin; i < job.end; ++i) {
+            projectObject(job.parent->children[i], job.groupOrder, job.batch, out);
+        }
+    };
+
+    for (size_t i = 1; i < jobs_.size(); ++i) {
+        pool->submit([&, i] { runJob(jobs_[i]); });
+    }
+
+    if (!jobs_.empty()) runJob(jobs_.front());
+
+    pool->wait();
+}
+
+size_t GLProjection::size() const {
+
+    size_t count = 0;
+    for (size_t i = 0; i < numSegments_; ++i) {
+        count += segments_[i].size();
+    }
+
+    return count;
+}
+
+size_t GLProjection::nextSegment() {
+
+    if (numSegments_ == segments_.size()) {
+        segments_.emplace_back();
+    }
+
+    segments_[numSegments_].clear();
+
+    return numSegments_++;
+}
+
+bool GLProjection::visit(Object3D* object, unsigned int& groupOrder, const StaticBatch*& batch, std::vector<ProjectedObject>& out) const {
+
+    if (!object->visible) return false;
+
+    const auto depth = [&] {
+        if (!sortObjects_) return 0.f;
+
+        Vector3 _vector3;
+        _vector3.setFromMatrixPosition(*object->matrixWorld).applyMatrix4(*projScreenMatrix_);
+
+        return _vector3.z;
+    };
+
+    if (auto staticBatch = object->as<StaticBatch>()) {
+
+        // layers are tested per batched object when drawing
+        batch = staticBatch;
+
+        // the bounding spheres of the batches are computed when they are built
+        for (const auto& mesh : staticBatch->batches()) {
+
+            if (!mesh->frustumCulled || frustum_->intersectsObject(*mesh)) {
+
+                out.push_back({mesh.get(), ProjectedObject::Kind::Drawable, ProjectedObject::Cull::Visible, groupOrder, depth()});
+            }
+        }
+
+        return true;
+    }
+
+    bool visible = object->layers.test(camera_->layers);
+
+    if (!visible) return true;
+
+    if (object->is<Group>()) {
+
+        groupOrder = object->renderOrder;
+
+    } else if (batch && batch->isBatched(*object)) {
+
+        // drawn as part of a batch
+
+    } else if (auto lod = object->as<LOD>()) {
+
+        if (lod->autoUpdate) lod->update(*camera_);
+
+    } else if (object->is<Light>()) {
+
+        out.push_back({object, ProjectedObject::Kind::Light, ProjectedObject::Cull::Visible, groupOrder, 0});
+
+    } else if (auto sprite = object->as<Sprite>()) {
+
+        if (!object->frustumCulled || frustum_->intersectsSprite(*sprite)) {
+
+            out.push_back({object, ProjectedObject::Kind::Sprite, ProjectedObject::Cull::Visible, groupOrder, depth()});
+        }
+
+    } else if (object->is<Mesh>() || object->is<Line>() || object->is<Points>()) {
+
+        auto cull = ProjectedObject::Cull::Visible;
+
+        if (object->frustumCulled) {
+
+            if (deferCulling_ && !object->geometry()->boundingSphere) {
+
+                cull = ProjectedObject::Cull::Deferred;
+
+            } else if (!frustum_->intersectsObject(*object)) {
+
+                cull = ProjectedObject::Cull::Culled;
+            }
+        }
+
+        if (cull != ProjectedObject::Cull::Culled) {
+
+            out.push_back({object, ProjectedObject::Kind::Drawable, cull, groupOrder, depth()});
+
+        } else if (object->is<SkinnedMesh>()) {
+
+            // culled skinned meshes still need their skeleton updated
+            out.push_back({object, ProjectedObject::Kind::Drawable, cull, groupOrder, 0});
+        }
+    }
+
+    return true;
+}
+
+void GLProjection::projectObject(Object3D* object, unsigned int groupOrder, const StaticBatch* batch, std::vector<ProjectedObject>& out) const {
+
+    if (!visit(object, groupOrder, batch, out)) return;
+
+    for (const auto& child : object->children) {
+
+        projectObject(child, groupOrder, batch, out);
+    }
+}
+
+size_t GLProjection::countSubtree(const Object3D* object) {
+
+    const auto index = subtreeSizes_.size();
+    subtreeSizes_.emplace_back();
+
+    size_t size = 1;
+    for (const auto child : object->children) {
+
+        size += countSubtree(child);
+    }
+
+    subtreeSizes_[index] = size;
+
+    return size;
+}
+
+void GLProjection::split(Object3D* object, size_t index, unsigned int groupOrder, const StaticBatch* batch) {
+
+    if (!visit(object, groupOrder, batch, segments_[currentSegment_])) return;
+
+    const auto& children = object->children;
+
+    size_t begin = 0;
+    size_t weight = 0;
+
+    // the children follow their parent in pre-order
+    auto childIndex = index + 1;
+
+    const auto flush = [&](size_t end) {
+        if (begin == end) return;
+
+        jobs_.push_back({object, begin, end, groupOrder, batch, nextSegment()});
+        currentSegment_ = nextSegment();
+
+        begin = end;
+        weight = 0;
+    };
+
+    for (size_t i = 0; i < children.size(); ++i) {
+
+        const auto child = children[i];
+        const auto size = subtreeSizes_[childIndex];
+
+        if (size > jobSize && !child->children.empty()) {
+
+            // large subtrees are split further rather than handed to a single job
+            flush(i);
+            split(child, childIndex, groupOrder, batch);
+            begin = i + 1;
+            weight = 0;
+
+        } else {
+
+            weight += size;
+
+            if (weight >= jobSize) flush(i + 1);
+        }
+
+        childIndex += size;
+    }
+
+    flush(children.size());
+}
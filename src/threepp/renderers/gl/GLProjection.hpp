@@ -0,0 +1,113 @@
+
+#ifndef THREEPP_GLPROJECTION_HPP
+#define THREEPP_GLPROJECTION_HPP
+
+#include "threepp/math/Frustum.hpp"
+#include "threepp/math/Matrix4.hpp"
+
+#include <vector>
+
+namespace threepp {
+
+    class Object3D;
+    class Camera;
+    class StaticBatch;
+
+    namespace utils {
+        class ThreadPool;
+    }
+
+    namespace gl {
+
+        // Result of visiting a single object during scene projection.
+        // Everything that touches GL or state shared between objects (geometry upload,
+        // skeleton update, render list insertion) is left to the consumer.
+        struct ProjectedObject {
+
+            enum class Kind {
+                Light,
+                Sprite,
+                Drawable
+            };
+
+            enum class Cull {
+                Visible,
+                Culled,
+                Deferred// frustum test requires a bounding sphere that has yet to be computed
+            };
+
+            Object3D* object;
+            Kind kind;
+            Cull cull;
+            unsigned int groupOrder;
+            float z;
+        };
+
+        // Walks the scene graph, performing layer tests, LOD updates and frustum culling.
+        // When given a thread pool, the graph is split into subtrees that are culled concurrently.
+        // The resulting sequence is identical to the serial walk (scene graph pre-order).
+        class GLProjection {
+
+        public:
+            // Minimum number of objects, counting whole subtrees, handed to a single job.
+            size_t jobSize = 256;
+
+            void project(Object3D* scene, Camera* camera, const Frustum& frustum, const Matrix4& projScreenMatrix, bool sortObjects, utils::ThreadPool* pool = nullptr);
+
+            template<class Func>
+            void forEach(Func&& f) const {
+
+                for (size_t i = 0; i < numSegments_; ++i) {
+                    for (const auto& item : segments_[i]) {
+                        f(item);
+                    }
+                }
+            }
+
+            [[nodiscard]] size_t size() const;
+
+            // The number of jobs the last projection was split into, or 0 if it was not.
+            [[nodiscard]] size_t numJobs() const {
+
+                return jobs_.size();
+            }
+
+        private:
+            struct Job {
+                Object3D* parent;
+                size_t begin;
+                size_t end;
+                unsigned int groupOrder;
+                const StaticBatch* batch;
+                size_t segment;
+            };
+
+            Camera* camera_ = nullptr;
+            const Frustum* frustum_ = nullptr;
+            const Matrix4* projScreenMatrix_ = nullptr;
+            bool sortObjects_ = true;
+            bool deferCulling_ = false;
+
+            size_t numSegments_ = 0;
+            size_t currentSegment_ = 0;
+            std::vector<std::vector<ProjectedObject>> segments_;
+            std::vector<Job> jobs_;
+            // the number of objects in the subtree of each object, in pre-order
+            std::vector<size_t> subtreeSizes_;
+
+            size_t nextSegment();
+
+            bool visit(Object3D* object, unsigned int& groupOrder, const StaticBatch*& batch, std::vector<ProjectedObject>& out) const;
+
+            void projectObject(Object3D* object, unsigned int groupOrder, const StaticBatch* batch, std::vector<ProjectedObject>& out) const;
+
+            size_t countSubtree(const Object3D* object);
+
+            void split(Object3D* object, size_t index, unsigned int groupOrder, const StaticBatch* batch);
+        };
+
+    }// namespace gl
+
+}// namespace threepp
+
+#endif//THREEPP_GLPROJECTION_HPP
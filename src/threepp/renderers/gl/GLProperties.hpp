@@ -6,10 +6,14 @@
 #include "threepp/scenes/Scene.hpp"
 
 #include "GLUniforms.hpp"
+#include "ProgramCacheKey.hpp"
 #include "threepp/core/Uniform.hpp"
 
+#include <algorithm>
+#include <memory>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 namespace threepp::gl {
 
@@ -33,7 +37,7 @@ namespace threepp::gl {
 
         GLProgram* program = nullptr;
         GLProgram* currentProgram = nullptr;
-        std::unordered_map<std::string, GLProgram*> programs{};
+        std::unordered_map<ProgramCacheKey, GLProgram*, ProgramCacheKey::Hash> programs{};
 
         std::optional<FogVariant> fog;
 
@@ -55,31 +59,54 @@ namespace threepp::gl {
         unsigned int lightsStateVersion{};
 
         std::vector<UniformObject*> uniformsList;
+        GLProgram* uniformsProgram = nullptr;// the program uniformsList was made for
         UniformMap* uniforms;
 
         unsigned int version{};
     };
 
+    // Renderer state of materials, textures and render targets, indexed by their id.
+    // Ids are handed out sequentially and never reused, so a lookup is a bounds check and an array access.
+    // Returned pointers stay valid until the entry is removed, after which its storage is recycled.
     template<class T>
     struct GLTypeProperties {
 
-        T* get(const std::string& key) {
+        T* get(unsigned int id) {
 
-            return &properties_[key];
+            if (id >= slots_.size()) {
+                slots_.resize(std::max<size_t>(id + 1, slots_.size() * 2));
+            }
+
+            auto& slot = slots_[id];
+            if (!slot) {
+                if (free_.empty()) {
+                    slot = std::make_unique<T>();
+                } else {
+                    slot = std::move(free_.back());
+                    free_.pop_back();
+                }
+            }
+
+            return slot.get();
         }
 
-        void remove(const std::string& key) {
+        void remove(unsigned int id) {
+
+            if (id >= slots_.size() || !slots_[id]) return;
 
-            properties_.erase(key);
+            *slots_[id] = T{};
+            free_.emplace_back(std::move(slots_[id]));
         }
 
         void dispose() {
 
-            properties_.clear();
+            slots_.clear();
+            free_.clear();
         }
 
     private:
-        std::unordered_map<std::string, T> properties_;
+        std::vector<std::unique_ptr<T>> slots_;
+        std::vector<std::unique_ptr<T>> free_;
     };
 
     struct GLProperties {
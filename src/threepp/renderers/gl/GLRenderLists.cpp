@@ -1,7 +1,12 @@
 
 #include "threepp/renderers/gl/GLRenderLists.hpp"
 
+#include "threepp/core/BufferGeometry.hpp"
+
 #include <algorithm>
+#include <array>
+#include <cstring>
+#include <iterator>
 #include <memory>
 
 using namespace threepp;
@@ -9,24 +14,24 @@ using namespace threepp::gl;
 
 namespace {
 
-    struct {
-
-        bool operator()(const RenderItem* a, const RenderItem* b) {
-            if (a->groupOrder != b->groupOrder) {
-                return a->groupOrder < b->groupOrder;
-            } else if (a->renderOrder != b->renderOrder) {
-                return a->renderOrder < b->renderOrder;
-            } else if (a->program != nullptr && b->program != nullptr && (a->program->id != b->program->id)) {
-                return a->program->id < b->program->id;
-            } else if (a->material->id != b->material->id) {
-                return a->material->id < b->material->id;
-            } else if (a->z != b->z) {
-                return a->z < b->z;
-            } else {
-                return a->id < b->id;
-            }
+    bool painterSortStable(const RenderItem* a, const RenderItem* b, bool groupByGeometry) {
+        if (a->groupOrder != b->groupOrder) {
+            return a->groupOrder < b->groupOrder;
+        } else if (a->renderOrder != b->renderOrder) {
+            return a->renderOrder < b->renderOrder;
+        } else if (a->program != nullptr && b->program != nullptr && (a->program->id != b->program->id)) {
+            return a->program->id < b->program->id;
+        } else if (a->material->id != b->material->id) {
+            return a->material->id < b->material->id;
+        } else if (groupByGeometry && a->geometry->id != b->geometry->id) {
+            // keeps meshes sharing geometry and material together, see GLRenderer::autoInstancing
+            return a->geometry->id < b->geometry->id;
+        } else if (a->z != b->z) {
+            return a->z < b->z;
+        } else {
+            return a->id < b->id;
         }
-    } painterSortStable;
+    }
 
     struct {
         bool operator()(const RenderItem* a, const RenderItem* b) {
@@ -43,13 +48,37 @@ namespace {
         }
     } reversePainterSortStable;
 
+    // below this, comparing keys is cheaper than the counting passes
+    constexpr size_t radixSortThreshold = 64;
+
+    constexpr unsigned int groupOrderBits = 8;
+    constexpr unsigned int renderOrderBits = 16;
+    constexpr unsigned int programBits = 16;
+    constexpr unsigned int materialBits = 24;
+
+    // maps a float to an unsigned integer of the same order
+    std::uint32_t sortableDepth(float z) {
+
+        std::uint32_t bits;
+        std::memcpy(&bits, &z, sizeof(float));
+
+        return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+    }
+
+    bool fits(std::uint64_t value, unsigned int bits) {
+
+        return value < (std::uint64_t{1} << bits);
+    }
+
 }// namespace
 
 gl::GLRenderList::GLRenderList(gl::GLProperties& properties): properties(properties) {}
 
-void gl::GLRenderList::init() {
+void gl::GLRenderList::init(bool groupByGeometry) {
 
     renderItemsIndex = 0;
+    keysFit_ = true;
+    groupByGeometry_ = groupByGeometry;
 
     opaque.clear();
     transparent.clear();
@@ -61,42 +90,66 @@ gl::RenderItem* gl::GLRenderList::getNextRenderItem(
         Material* material,
         unsigned int groupOrder, float z, std::optional<GeometryGroup> group) {
 
-    gl::RenderItem* renderItem = nullptr;
-    auto materialProperties = properties.materialProperties.get(material->uuid());
-
-    if (renderItemsIndex >= renderItems.size()) {
-        auto r = std::make_unique<RenderItem>(RenderItem{object->id,
-                                                         object,
-                                                         geometry,
-                                                         material,
-                                                         materialProperties->program,
-                                                         groupOrder,
-                                                         object->renderOrder,
-                                                         z,
-                                                         group});
-        renderItems.emplace_back(std::move(r));
-        renderItem = renderItems.back().get();
+    if (renderItemsIndex == renderItems.size()) {
+
+        if (renderItems.size() == renderItems.capacity()) grow();
+        renderItems.emplace_back();
+    }
+
+    auto program = properties.materialProperties.get(material->id)->program;
+    auto& renderItem = renderItems[renderItemsIndex++];
+
+    renderItem.id = object->id;
+    renderItem.object = object;
+    renderItem.geometry = geometry;
+    renderItem.material = material;
+    renderItem.program = program;
+    renderItem.groupOrder = groupOrder;
+    renderItem.renderOrder = object->renderOrder;
+    renderItem.z = z;
+    renderItem.group = group;
+
+    const std::uint64_t programId = program ? program->id + 1 : 0;
+
+    keysFit_ = keysFit_ && fits(groupOrder, groupOrderBits) && fits(object->renderOrder, renderOrderBits);
+
+    std::uint64_t key = groupOrder;
+    key = (key << renderOrderBits) | object->renderOrder;
+
+    if (material->transparent) {
+
+        // back to front, then by insertion order
+        renderItem.sortKey = (key << 32 | ~sortableDepth(z)) << (64 - groupOrderBits - renderOrderBits - 32);
+        renderItem.sortKeyMinor = 0;
 
     } else {
 
-        renderItem = renderItems.at(renderItemsIndex).get();
+        keysFit_ = keysFit_ && fits(programId, programBits) && fits(material->id, materialBits);
 
-        renderItem->id = object->id;
-        renderItem->object = object;
-        renderItem->geometry = geometry;
-        renderItem->material = material;
-        if (materialProperties->program) {
-            renderItem->program = materialProperties->program;
-        }
-        renderItem->groupOrder = groupOrder;
-        renderItem->renderOrder = object->renderOrder;
-        renderItem->z = z;
-        renderItem->group = group;
+        key = (key << programBits) | programId;
+        renderItem.sortKey = (key << materialBits) | material->id;
+        // front to back, within runs sharing geometry when grouped by geometry
+        const std::uint64_t geometryId = groupByGeometry_ ? geometry->id : 0;
+        renderItem.sortKeyMinor = geometryId << 32 | sortableDepth(z);
     }
 
-    ++renderItemsIndex;
+    return &renderItem;
+}
+
+void gl::GLRenderList::grow() {
 
-    return renderItem;
+    std::vector<RenderItem> items;
+    items.reserve(std::max(radixSortThreshold, renderItems.capacity() * 2));
+    items.insert(items.end(), std::make_move_iterator(renderItems.begin()), std::make_move_iterator(renderItems.end()));
+
+    // rebase pointers onto the new storage
+    for (auto list : {&opaque, &transparent}) {
+        for (auto& item : *list) {
+            item = items.data() + (item - renderItems.data());
+        }
+    }
+
+    renderItems.swap(items);
 }
 
 void gl::GLRenderList::push(
@@ -137,8 +190,81 @@ void GLRenderList::unshift(
 
 void GLRenderList::sort() {
 
-    if (opaque.size() > 1) std::stable_sort(opaque.begin(), opaque.end(), painterSortStable);
-    if (transparent.size() > 1) std::stable_sort(transparent.begin(), transparent.end(), reversePainterSortStable);
+    if (!keysFit_) {
+
+        if (opaque.size() > 1) {
+            std::stable_sort(opaque.begin(), opaque.end(), [this](const RenderItem* a, const RenderItem* b) {
+                return painterSortStable(a, b, groupByGeometry_);
+            });
+        }
+        if (transparent.size() > 1) std::stable_sort(transparent.begin(), transparent.end(), reversePainterSortStable);
+
+        return;
+    }
+
+    if (opaque.size() > 1) radixSort(opaque);
+    if (transparent.size() > 1) radixSort(transparent);
+}
+
+void GLRenderList::radixSort(std::vector<RenderItem*>& list) {
+
+    const auto n = list.size();
+
+    entries_.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        entries_[i] = {list[i]->sortKey, list[i]->sortKeyMinor, list[i]};
+    }
+
+    if (n < radixSortThreshold) {
+
+        std::stable_sort(entries_.begin(), entries_.end(), [](const SortEntry& a, const SortEntry& b) {
+            return a.key != b.key ? a.key < b.key : a.keyMinor < b.keyMinor;
+        });
+
+    } else {
+
+        // one pass per byte, least significant first: the 8 bytes of keyMinor, then those of key
+        constexpr size_t passes = 16;
+        std::array<std::array<std::uint32_t, 256>, passes> counts{};
+
+        const auto byteAt = [](const SortEntry& entry, size_t pass) {
+            const auto word = pass < 8 ? entry.keyMinor : entry.key;
+            return static_cast<std::uint8_t>(word >> ((pass % 8) * 8));
+        };
+
+        for (const auto& entry : entries_) {
+            for (size_t pass = 0; pass < passes; ++pass) {
+                ++counts[pass][byteAt(entry, pass)];
+            }
+        }
+
+        scratch_.resize(n);
+
+        for (size_t pass = 0; pass < passes; ++pass) {
+
+            auto& count = counts[pass];
+
+            // every key has the same byte here
+            if (count[byteAt(entries_.front(), pass)] == n) continue;
+
+            std::uint32_t offset = 0;
+            for (auto& c : count) {
+                const auto next = offset + c;
+                c = offset;
+                offset = next;
+            }
+
+            for (const auto& entry : entries_) {
+                scratch_[count[byteAt(entry, pass)]++] = entry;
+            }
+
+            entries_.swap(scratch_);
+        }
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        list[i] = entries_[i].item;
+    }
 }
 
 void GLRenderList::finish() {
@@ -147,16 +273,16 @@ void GLRenderList::finish() {
 
     for (auto i = renderItemsIndex, il = renderItems.size(); i < il; ++i) {
 
-        auto& renderItem = renderItems.at(i);
+        auto& renderItem = renderItems[i];
 
-        if (!renderItem->id) break;
+        if (!renderItem.id) break;
 
-        renderItem->id = std::nullopt;
-        renderItem->object = nullptr;
-        renderItem->geometry = nullptr;
-        renderItem->material = nullptr;
-        renderItem->program = nullptr;
-        renderItem->group = std::nullopt;
+        renderItem.id = std::nullopt;
+        renderItem.object = nullptr;
+        renderItem.geometry = nullptr;
+        renderItem.material = nullptr;
+        renderItem.program = nullptr;
+        renderItem.group = std::nullopt;
     }
 }
 
@@ -10,6 +10,9 @@
 #include "GLProgram.hpp"
 #include "GLProperties.hpp"
 
+#include <cstdint>
+#include <vector>
+
 namespace threepp::gl {
 
     struct RenderItem {
@@ -23,6 +26,12 @@ namespace threepp::gl {
         unsigned int renderOrder;
         float z;
         std::optional<GeometryGroup> group;
+
+        // Precomputed by push, and compared as one 128-bit key with sortKey as the most significant half.
+        // Opaque items order by groupOrder, renderOrder, program, material and depth (geometry and depth when grouped by geometry),
+        // transparent items by groupOrder, renderOrder and depth, back to front.
+        std::uint64_t sortKey;
+        std::uint64_t sortKeyMinor;
     };
 
     struct GLRenderList {
@@ -30,12 +39,15 @@ namespace threepp::gl {
         std::vector<RenderItem*> opaque;
         std::vector<RenderItem*> transparent;
 
-        std::vector<std::unique_ptr<RenderItem>> renderItems;
+        // items are reused from frame to frame, and opaque and transparent point into this array
+        std::vector<RenderItem> renderItems;
         size_t renderItemsIndex = 0;
 
         explicit GLRenderList(GLProperties& properties);
 
-        void init();
+        // Starts a new list. Opaque items sharing a material are grouped by geometry before depth when groupByGeometry is set,
+        // see GLRenderer::autoInstancing.
+        void init(bool groupByGeometry = false);
 
         RenderItem* getNextRenderItem(
                 Object3D* object,
@@ -55,12 +67,32 @@ namespace threepp::gl {
                 Material* material,
                 unsigned int groupOrder, float z, std::optional<GeometryGroup> group);
 
+        // Sorts by the precomputed keys with an LSD radix sort, skipping the byte positions all keys share.
+        // Lists with orders or ids too large for their key fields are sorted with a comparator instead.
         void sort();
 
         void finish();
 
     private:
         GLProperties& properties;
+
+        struct SortEntry {
+
+            std::uint64_t key;
+            std::uint64_t keyMinor;
+            RenderItem* item;
+        };
+
+        // false once an item has a value exceeding its field of the sort key
+        bool keysFit_ = true;
+        bool groupByGeometry_ = false;
+
+        std::vector<SortEntry> entries_;
+        std::vector<SortEntry> scratch_;
+
+        void grow();
+
+        void radixSort(std::vector<RenderItem*>& list);
     };
 
     struct GLRenderLists {
@@ -2,15 +2,21 @@
 #include "threepp/renderers/gl/GLShadowMap.hpp"
 
 #include "threepp/math/Frustum.hpp"
+#include "threepp/math/Sphere.hpp"
 
+#include "threepp/objects/InstancedMesh.hpp"
 #include "threepp/objects/Line.hpp"
 #include "threepp/objects/Mesh.hpp"
+#include "threepp/objects/ObjectWithMorphTargetInfluences.hpp"
 #include "threepp/objects/Points.hpp"
+#include "threepp/objects/SkinnedMesh.hpp"
+#include "threepp/objects/StaticBatch.hpp"
 
 #include "threepp/materials/MeshDepthMaterial.hpp"
 #include "threepp/materials/MeshDistanceMaterial.hpp"
 #include "threepp/materials/ShaderMaterial.hpp"
 
+#include "threepp/lights/DirectionalLightShadow.hpp"
 #include "threepp/lights/PointLight.hpp"
 #include "threepp/lights/PointLightShadow.hpp"
 
@@ -20,8 +26,15 @@
 #include "threepp/renderers/shaders/ShaderLib.hpp"
 
 #include "threepp/renderers/gl/GLCapabilities.hpp"
+#include "threepp/renderers/gl/GLInfo.hpp"
 #include "threepp/renderers/gl/GLObjects.hpp"
+#include "threepp/renderers/gl/GLProperties.hpp"
 
+#ifndef EMSCRIPTEN
+#include <glad/glad.h>
+#else
+#include <GLES3/gl32.h>
+#endif
 
 #include <cmath>
 #include <iostream>
@@ -31,6 +44,36 @@ using namespace threepp::gl;
 
 namespace {
 
+    // frames a caster must keep its world transform before it is drawn to the cached static depth
+    constexpr unsigned int staticFrames = 60;
+
+    // Identifies what a caster draws: its geometry and materials, and the versions of their contents.
+    size_t contentHash(Object3D* object) {
+
+        size_t hash = 14695981039346656037ull;
+        const auto add = [&](size_t value) {
+            hash = (hash ^ value) * 1099511628211ull;
+        };
+
+        if (auto geometry = object->geometry()) {
+
+            add(geometry->id);
+            if (auto index = geometry->getIndex()) add(index->version);
+            for (const auto& [name, attribute] : geometry->getAttributes()) {
+
+                add(attribute->version);
+            }
+        }
+
+        for (auto material : object->materials()) {
+
+            add(material->id);
+            add(material->version);
+        }
+
+        return hash;
+    }
+
     inline std::unordered_map<Side, Side> shadowSide{
             {Side::Front, Side::Back},
             {Side::Back, Side::Front},
@@ -70,11 +113,58 @@ namespace {
 
 struct GLShadowMap::Impl {
 
+    // An object that may be drawn to a shadow map, with its bounding sphere in world space.
+    struct ShadowCaster {
+
+        Object3D* object;
+        Sphere sphere;
+        bool frustumCulled;
+        bool isStatic;
+    };
+
+    enum class Casters {
+        All,
+        Static,
+        Dynamic
+    };
+
+    // How long a caster has kept its transform.
+    struct CasterState {
+
+        unsigned int matrixWorldVersion;
+        unsigned int instanceMatrixVersion;
+        size_t contentHash;
+        unsigned int stillFrames;
+        size_t frame;
+    };
+
+    // The static casters of a light drawn on their own, and the views they were drawn with.
+    struct ShadowCache {
+
+        std::unique_ptr<GLRenderTarget> staticMap;
+        std::vector<Matrix4> viewProjections;
+        size_t staticHash{};
+        // whether the shadow map has dynamic casters drawn over the static ones
+        bool hasDynamicCasters{};
+        size_t frame{};
+    };
+
     GLShadowMap* scope;
     GLObjects& _objects;
+    GLProperties& _properties;
+    GLInfo& _info;
 
     const Frustum* _frustum;
 
+    // gathered once per render and culled against the frustum of each light and viewport
+    std::vector<ShadowCaster> _casters;
+
+    size_t _frame{};
+    size_t _staticHash{};
+    std::unordered_map<unsigned int, CasterState> _casterStates;
+    std::unordered_map<unsigned int, ShadowCache> _shadowCaches;
+    std::vector<Matrix4> _viewProjections;
+
     Vector2 _shadowMapSize;
     Vector2 _viewportSize;
 
@@ -89,9 +179,11 @@ struct GLShadowMap::Impl {
 
     std::shared_ptr<Mesh> fullScreenMesh;
 
-    Impl(GLShadowMap* scope, GLObjects& objects)
+    Impl(GLShadowMap* scope, GLObjects& objects, GLProperties& properties, GLInfo& info)
         : scope(scope),
           _objects(objects),
+          _properties(properties),
+          _info(info),
           _maxTextureSize(GLCapabilities::instance().maxTextureSize) {
 
         auto fullScreenTri = BufferGeometry::create();
@@ -106,7 +198,7 @@ struct GLShadowMap::Impl {
         // vertical pass
 
         shadowMaterialVertical->uniforms.at("shadow_pass").setValue(shadow->map->texture.get());
-        shadowMaterialVertical->uniforms.at("resolution").value<Vector2>().copy(shadow->mapSize);
+        shadowMaterialVertical->uniforms.at("resolution").value<Vector2>().copy(_shadowMapSize);
         shadowMaterialVertical->uniforms.at("radius").value<float>() = shadow->radius;
         _renderer.setRenderTarget(shadow->mapPass.get());
         _renderer.clear();
@@ -115,7 +207,7 @@ struct GLShadowMap::Impl {
         // horizontal pass
 
         shadowMaterialHorizontal->uniforms.at("shadow_pass").setValue(shadow->mapPass->texture.get());
-        shadowMaterialHorizontal->uniforms.at("resolution").value<Vector2>().copy(shadow->mapSize);
+        shadowMaterialHorizontal->uniforms.at("resolution").value<Vector2>().copy(_shadowMapSize);
         shadowMaterialHorizontal->uniforms.at("radius").value<float>() = shadow->radius;
         _renderer.setRenderTarget(shadow->map.get());
         _renderer.clear();
@@ -228,61 +320,301 @@ struct GLShadowMap::Impl {
         return result;
     }
 
-    void renderObject(GLRenderer& _renderer, Object3D* object, Camera* camera, Camera* shadowCamera, Light* light) {
+    void renderDrawable(GLRenderer& _renderer, const ShadowCaster& caster, Camera* shadowCamera, Light* light) {
+
+        if (caster.frustumCulled && !_frustum->intersectsSphere(caster.sphere)) return;
+
+        auto object = caster.object;
+
+        object->modelViewMatrix.multiplyMatrices(shadowCamera->matrixWorldInverse, *object->matrixWorld);
+
+        const auto geometry = _objects.update(object);
+        const auto material = object->materials();
+
+        if (material.size() > 1) {
+
+            const auto& groups = geometry->groups;
+
+            for (const auto& group : groups) {
+
+                if (material.size() > group.materialIndex) {
+                    const auto groupMaterial = material[group.materialIndex];
+
+                    if (groupMaterial && groupMaterial->visible) {
+
+                        const auto depthMaterial = getDepthMaterial(_renderer, object, geometry, groupMaterial, light, shadowCamera->near, shadowCamera->far);
+
+                        _renderer.renderBufferDirect(shadowCamera, nullptr, geometry, depthMaterial, object, group);
+                    }
+                }
+            }
+
+        } else if (material.front()->visible) {
+
+            auto depthMaterial = getDepthMaterial(_renderer, object, geometry, material.front(), light, shadowCamera->near, shadowCamera->far);
+
+            _renderer.renderBufferDirect(shadowCamera, nullptr, geometry, depthMaterial, object, std::nullopt);
+        }
+    }
+
+    void addCaster(Object3D* object) {
+
+        if (!object->castShadow && !(object->receiveShadow && scope->type == ShadowMap::VSM)) return;
+
+        auto& caster = _casters.emplace_back();
+        caster.object = object;
+        caster.frustumCulled = object->frustumCulled;
+        caster.isStatic = scope->cacheStaticCasters && isStatic(object);
+
+        if (caster.frustumCulled) {
+
+            auto geometry = object->geometry();
+            if (!geometry->boundingSphere) geometry->computeBoundingSphere();
+
+            caster.sphere.copy(*geometry->boundingSphere).applyMatrix4(*object->matrixWorld);
+        }
+    }
+
+    // Whether object has kept its world transform, geometry and materials for a while. Objects seen for the first time are taken
+    // to be static, so that a scene is cached from its first frame.
+    bool isStatic(Object3D* object) {
+
+        // deformed in the vertex shader
+        if (object->is<SkinnedMesh>()) return false;
+        if (auto morphed = object->as<ObjectWithMorphTargetInfluences>()) {
+            if (!morphed->morphTargetInfluences().empty()) return false;
+        }
+
+        const auto matrixWorldVersion = object->matrixWorldVersion();
+        const auto instanced = object->as<InstancedMesh>();
+        const auto instanceMatrixVersion = instanced ? instanced->instanceMatrix->version : 0;
+        const auto content = contentHash(object);
+
+        auto [it, inserted] = _casterStates.try_emplace(object->id, CasterState{matrixWorldVersion, instanceMatrixVersion, content, staticFrames, _frame});
+        auto& state = it->second;
+
+        if (!inserted && state.frame != _frame) {
+
+            if (state.matrixWorldVersion != matrixWorldVersion || state.instanceMatrixVersion != instanceMatrixVersion || state.contentHash != content) {
+
+                state.matrixWorldVersion = matrixWorldVersion;
+                state.instanceMatrixVersion = instanceMatrixVersion;
+                state.contentHash = content;
+                state.stillFrames = 0;
+
+            } else if (state.stillFrames < staticFrames) {
+
+                ++state.stillFrames;
+            }
+
+            state.frame = _frame;
+        }
+
+        return state.stillFrames >= staticFrames;
+    }
+
+    void gatherCasters(Object3D* object, Camera* camera, const StaticBatch* batch = nullptr) {
 
         if (!object->visible) return;
 
-        bool visible = object->layers.test(camera->layers);
+        if (auto staticBatch = object->as<StaticBatch>()) {
 
-        if (visible && (object->is<Mesh>() || object->is<Line>() || object->is<Points>())) {
+            batch = staticBatch;
 
-            if ((object->castShadow || (object->receiveShadow && scope->type == ShadowMap::VSM)) && (!object->frustumCulled || _frustum->intersectsObject(*object))) {
+            for (const auto& mesh : staticBatch->batches()) {
 
-                object->modelViewMatrix.multiplyMatrices(shadowCamera->matrixWorldInverse, *object->matrixWorld);
+                addCaster(mesh.get());
+            }
 
-                const auto geometry = _objects.update(object);
-                const auto material = object->materials();
+        } else if (!batch || !batch->isBatched(*object)) {
 
-                if (material.size() > 1) {
+            bool visible = object->layers.test(camera->layers);
 
-                    const auto& groups = geometry->groups;
+            if (visible && (object->is<Mesh>() || object->is<Line>() || object->is<Points>())) {
 
-                    for (const auto& group : groups) {
+                addCaster(object);
+            }
+        }
 
-                        if (material.size() > group.materialIndex) {
-                            const auto groupMaterial = material[group.materialIndex];
+        for (auto& child : object->children) {
 
-                            if (groupMaterial && groupMaterial->visible) {
+            gatherCasters(child, camera, batch);
+        }
+    }
 
-                                const auto depthMaterial = getDepthMaterial(_renderer, object, geometry, groupMaterial, light, shadowCamera->near, shadowCamera->far);
+    void gather(Object3D* scene, Camera* camera) {
 
-                                _renderer.renderBufferDirect(shadowCamera, nullptr, geometry, depthMaterial, object, group);
-                            }
-                        }
-                    }
+        ++_frame;
+
+        _casters.clear();
+        gatherCasters(scene, camera);
+
+        // identifies the set of static casters, which are all drawn to the cached maps
+        _staticHash = 14695981039346656037ull;
+        for (const auto& caster : _casters) {
+
+            if (caster.isStatic) {
+
+                _staticHash = (_staticHash ^ caster.object->id) * 1099511628211ull;
+            }
+        }
+    }
 
-                } else if (material.front()->visible) {
+    void pruneCaches() {
 
-                    auto depthMaterial = getDepthMaterial(_renderer, object, geometry, material.front(), light, shadowCamera->near, shadowCamera->far);
+        for (auto it = _casterStates.begin(); it != _casterStates.end();) {
+
+            it = it->second.frame == _frame ? std::next(it) : _casterStates.erase(it);
+        }
+
+        for (auto it = _shadowCaches.begin(); it != _shadowCaches.end();) {
+
+            it = it->second.frame == _frame ? std::next(it) : _shadowCaches.erase(it);
+        }
+    }
+
+    void updateViewport(Light* light, LightShadow* shadow, DirectionalLightShadow* directionalShadow, size_t vp) {
+
+        if (auto pointLightShadow = dynamic_cast<PointLightShadow*>(shadow)) {
+            pointLightShadow->updateMatrices(light->as<PointLight>(), vp);
+        } else if (directionalShadow) {
+            directionalShadow->updateMatrices(light, vp);
+        } else {
+            shadow->updateMatrices(light);
+        }
 
-                    _renderer.renderBufferDirect(shadowCamera, nullptr, geometry, depthMaterial, object, std::nullopt);
+        _frustum = &shadow->getFrustum();
+    }
+
+    void renderViewports(GLRenderer& _renderer, Light* light, LightShadow* shadow, DirectionalLightShadow* directionalShadow, Casters casters) {
+
+        auto& _state = _renderer.state();
+
+        const auto viewportCount = shadow->getViewportCount();
+
+        for (unsigned vp = 0; vp < viewportCount; vp++) {
+
+            const auto& viewport = shadow->getViewport(vp);
+
+            _viewport.set(
+                    _viewportSize.x * viewport.x,
+                    _viewportSize.y * viewport.y,
+                    _viewportSize.x * viewport.z,
+                    _viewportSize.y * viewport.w);
+
+            _state.viewport(_viewport);
+
+            updateViewport(light, shadow, directionalShadow, vp);
+
+            for (const auto& caster : _casters) {
+
+                if (casters == Casters::All || caster.isStatic == (casters == Casters::Static)) {
+
+                    renderDrawable(_renderer, caster, shadow->camera.get(), light);
                 }
             }
         }
+    }
 
-        for (auto& child : object->children) {
+    // Draws the static casters to a map of their own, which is only redrawn when the light, its views or the
+    // set of static casters change, and copied to the shadow map before the dynamic casters are drawn over it.
+    // Returns false if the shadow map is up to date.
+    bool renderCached(GLRenderer& _renderer, Light* light, LightShadow* shadow, DirectionalLightShadow* directionalShadow, bool mapCreated) {
+
+        auto& cache = _shadowCaches[light->id];
+        cache.frame = _frame;
+
+        const auto viewportCount = shadow->getViewportCount();
+
+        _viewProjections.resize(viewportCount);
+
+        bool dynamicCasters = false;
+
+        for (unsigned vp = 0; vp < viewportCount; vp++) {
+
+            updateViewport(light, shadow, directionalShadow, vp);
+
+            _viewProjections[vp].multiplyMatrices(shadow->camera->projectionMatrix, shadow->camera->matrixWorldInverse);
+
+            for (const auto& caster : _casters) {
+
+                if (!dynamicCasters && !caster.isStatic) {
+
+                    dynamicCasters = !caster.frustumCulled || _frustum->intersectsSphere(caster.sphere);
+                }
+            }
+        }
+
+        const auto& map = *shadow->map;
+
+        const bool staticChanged = shadow->needsUpdate || mapCreated || !cache.staticMap ||
+                                   cache.staticMap->width != map.width || cache.staticMap->height != map.height ||
+                                   cache.staticHash != _staticHash || cache.viewProjections != _viewProjections;
+
+        if (!staticChanged && !dynamicCasters && !cache.hasDynamicCasters) return false;
+
+        if (staticChanged) {
+
+            if (!cache.staticMap || cache.staticMap->width != map.width || cache.staticMap->height != map.height) {
+
+                GLRenderTarget::Options pars{};
+                pars.minFilter = Filter::Nearest;
+                pars.magFilter = Filter::Nearest;
+                pars.format = Format::RGBA;
+
+                cache.staticMap = GLRenderTarget::create(map.width, map.height, pars);
+            }
+
+            _renderer.setRenderTarget(cache.staticMap.get());
+            _renderer.clear();
+
+            renderViewports(_renderer, light, shadow, directionalShadow, Casters::Static);
+
+            cache.viewProjections = _viewProjections;
+            cache.staticHash = _staticHash;
+
+            ++_info.shadows.rendered;
+
+        } else {
 
-            renderObject(_renderer, child, camera, shadowCamera, light);
+            ++_info.shadows.composited;
         }
+
+        // copies color and depth, so that dynamic casters behind static ones are hidden
+
+        _renderer.setRenderTarget(shadow->map.get());
+
+        auto& _state = _renderer.state();
+        const auto staticFramebuffer = *_properties.renderTargetProperties.get(cache.staticMap->id)->glFramebuffer;
+        const auto framebuffer = *_properties.renderTargetProperties.get(shadow->map->id)->glFramebuffer;
+
+        _state.bindFramebuffer(GL_READ_FRAMEBUFFER, staticFramebuffer);
+        glBlitFramebuffer(0, 0, static_cast<GLint>(map.width), static_cast<GLint>(map.height),
+                          0, 0, static_cast<GLint>(map.width), static_cast<GLint>(map.height),
+                          GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        _state.bindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+
+        if (dynamicCasters) {
+
+            renderViewports(_renderer, light, shadow, directionalShadow, Casters::Dynamic);
+        }
+
+        cache.hasDynamicCasters = dynamicCasters;
+
+        return true;
     }
 
     void render(GLRenderer& _renderer, const std::vector<Light*>& lights, Object3D* scene, Camera* camera) {
 
+        _info.shadows = {};
+
         if (!scope->enabled) return;
         if (!scope->autoUpdate && !scope->needsUpdate) return;
 
         if (lights.empty()) return;
 
+        const auto calls = _info.render.calls;
+
         auto currentRenderTarget = _renderer.getRenderTarget();
         auto activeCubeFace = _renderer.getActiveCubeFace();
         auto activeMipmapLevel = _renderer.getActiveMipmapLevel();
@@ -297,6 +629,8 @@ struct GLShadowMap::Impl {
 
         // render depth map
 
+        bool castersGathered = false;
+
         for (auto light : lights) {
 
             auto lightWithShadow = dynamic_cast<LightWithShadow*>(light);
@@ -311,6 +645,19 @@ struct GLShadowMap::Impl {
 
             if (!shadow->autoUpdate && !shadow->needsUpdate) continue;
 
+            if (!castersGathered) {
+
+                gather(scene, camera);
+                castersGathered = true;
+            }
+
+            auto directionalShadow = std::dynamic_pointer_cast<DirectionalLightShadow>(shadow);
+
+            if (directionalShadow) {
+
+                directionalShadow->updateCascades(light, *camera);
+            }
+
             _shadowMapSize.copy(shadow->mapSize);
 
             auto shadowFrameExtents = shadow->getFrameExtents();
@@ -336,6 +683,15 @@ struct GLShadowMap::Impl {
                 }
             }
 
+            if (shadow->map && (shadow->map->width != static_cast<unsigned int>(_shadowMapSize.x) || shadow->map->height != static_cast<unsigned int>(_shadowMapSize.y))) {
+
+                // the number of cascades changed
+                shadow->map.reset();
+                shadow->mapPass.reset();
+            }
+
+            const bool mapCreated = !shadow->map;
+
             if (!shadow->map && !std::dynamic_pointer_cast<PointLightShadow>(shadow) && scope->type == ShadowMap::VSM) {
 
                 GLRenderTarget::Options pars{};
@@ -364,32 +720,23 @@ struct GLShadowMap::Impl {
                 shadow->camera->updateProjectionMatrix();
             }
 
-            _renderer.setRenderTarget(shadow->map.get());
-            _renderer.clear();
-
-            const auto viewportCount = shadow->getViewportCount();
-
-            for (unsigned vp = 0; vp < viewportCount; vp++) {
+            if (scope->cacheStaticCasters) {
 
-                const auto& viewport = shadow->getViewport(vp);
+                if (!renderCached(_renderer, light, shadow.get(), directionalShadow.get(), mapCreated)) {
 
-                _viewport.set(
-                        _viewportSize.x * viewport.x,
-                        _viewportSize.y * viewport.y,
-                        _viewportSize.x * viewport.z,
-                        _viewportSize.y * viewport.w);
+                    ++_info.shadows.skipped;
+                    shadow->needsUpdate = false;
+                    continue;
+                }
 
-                _state.viewport(_viewport);
+            } else {
 
-                if (auto pointLightShadow = std::dynamic_pointer_cast<PointLightShadow>(shadow)) {
-                    pointLightShadow->updateMatrices(light->as<PointLight>(), vp);
-                } else {
-                    shadow->updateMatrices(light);
-                }
+                _renderer.setRenderTarget(shadow->map.get());
+                _renderer.clear();
 
-                _frustum = &shadow->getFrustum();
+                renderViewports(_renderer, light, shadow.get(), directionalShadow.get(), Casters::All);
 
-                renderObject(_renderer, scene, camera, shadow->camera.get(), light);
+                ++_info.shadows.rendered;
             }
 
             // do blur pass for VSM
@@ -402,14 +749,24 @@ struct GLShadowMap::Impl {
             shadow->needsUpdate = false;
         }
 
+        // the casters hold raw pointers into the scene
+        _casters.clear();
+
+        if (castersGathered) {
+
+            pruneCaches();
+        }
+
         scope->needsUpdate = false;
 
+        _info.shadows.calls = _info.render.calls - calls;
+
         _renderer.setRenderTarget(currentRenderTarget, activeCubeFace, activeMipmapLevel);
     }
 };
 
-GLShadowMap::GLShadowMap(GLObjects& objects)
-    : type(ShadowMap::PFC), pimpl_(std::make_unique<Impl>(this, objects)) {}
+GLShadowMap::GLShadowMap(GLObjects& objects, GLProperties& properties, GLInfo& info)
+    : type(ShadowMap::PFC), pimpl_(std::make_unique<Impl>(this, objects, properties, info)) {}
 
 
 void GLShadowMap::render(GLRenderer& renderer, const std::vector<Light*>& lights, Object3D* scene, Camera* camera) {
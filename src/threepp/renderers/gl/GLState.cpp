@@ -292,7 +292,8 @@ void gl::StencilBuffer::reset() {
     currentStencilClear = std::nullopt;
 }
 
-gl::GLState::GLState(): maxTextures(glGetParameteri(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS)) {
+gl::GLState::GLState(GLInfo& info)
+    : maxTextures(glGetParameteri(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS)), info(info) {
 
     GLint scissorParam[4];
     GLint viewportParam[4];
@@ -367,6 +368,7 @@ bool gl::GLState::bindFramebuffer(int target, unsigned int framebuffer) {
     if (!currentBoundFramebuffers.count(target) || (currentBoundFramebuffers.count(target) && currentBoundFramebuffers[target] != framebuffer)) {
 
         glBindFramebuffer(target, framebuffer);
+        ++info.state.framebuffers;
 
         currentBoundFramebuffers[target] = framebuffer;
 
@@ -380,11 +382,15 @@ bool gl::GLState::bindFramebuffer(int target, unsigned int framebuffer) {
         if (target == GL_FRAMEBUFFER) {
 
             currentBoundFramebuffers[GL_DRAW_FRAMEBUFFER] = framebuffer;
+            // binds the read framebuffer as well
+            currentBoundFramebuffers[GL_READ_FRAMEBUFFER] = framebuffer;
         }
 
         return true;
     }
 
+    ++info.state.skipped;
+
     return false;
 }
 
@@ -393,15 +399,102 @@ bool gl::GLState::useProgram(unsigned int program) {
     if (currentProgram != program) {
 
         glUseProgram(program);
+        ++info.state.programs;
 
         currentProgram = program;
 
         return true;
     }
 
+    ++info.state.skipped;
+
+    return false;
+}
+
+bool gl::GLState::bindBuffer(int target, unsigned int buffer) {
+
+    if (target == GL_ELEMENT_ARRAY_BUFFER) {
+
+        glBindBuffer(target, buffer);
+        ++info.state.buffers;
+
+        return true;
+    }
+
+    auto it = currentBoundBuffers.find(target);
+    if (it == currentBoundBuffers.end() || it->second != buffer) {
+
+        glBindBuffer(target, buffer);
+        ++info.state.buffers;
+
+        currentBoundBuffers[target] = buffer;
+
+        return true;
+    }
+
+    ++info.state.skipped;
+
+    return false;
+}
+
+bool gl::GLState::bindVertexArray(unsigned int vertexArray) {
+
+    if (currentVertexArray != vertexArray) {
+
+        glBindVertexArray(vertexArray);
+        ++info.state.vertexArrays;
+
+        currentVertexArray = vertexArray;
+
+        return true;
+    }
+
+    ++info.state.skipped;
+
     return false;
 }
 
+void gl::GLState::deleteBuffer(unsigned int buffer) {
+
+    glDeleteBuffers(1, &buffer);
+
+    for (auto& [target, bound] : currentBoundBuffers) {
+
+        if (bound == buffer) bound = 0;
+    }
+}
+
+void gl::GLState::deleteVertexArray(unsigned int vertexArray) {
+
+    glDeleteVertexArrays(1, &vertexArray);
+
+    if (currentVertexArray == vertexArray) currentVertexArray = 0;
+}
+
+void gl::GLState::deleteTexture(unsigned int texture) {
+
+    glDeleteTextures(1, &texture);
+
+    for (auto& [slot, boundTexture] : currentBoundTextures) {
+
+        if (boundTexture.texture == static_cast<int>(texture)) {
+
+            boundTexture.type = std::nullopt;
+            boundTexture.texture = std::nullopt;
+        }
+    }
+}
+
+void gl::GLState::deleteFramebuffer(unsigned int framebuffer) {
+
+    glDeleteFramebuffers(1, &framebuffer);
+
+    for (auto& [target, bound] : currentBoundFramebuffers) {
+
+        if (bound == framebuffer) bound = 0;
+    }
+}
+
 void gl::GLState::setBlending(
         Blending blending,
         std::optional<BlendEquation> blendEquation,
@@ -696,14 +789,19 @@ void gl::GLState::bindTexture(int glType, std::optional<int> glTexture) {
         currentBoundTextures[*currentTextureSlot] = boundTexture;
     }
 
-    auto boundTexture = currentBoundTextures.at(*currentTextureSlot);
+    auto& boundTexture = currentBoundTextures.at(*currentTextureSlot);
 
     if (boundTexture.type != glType || boundTexture.texture != glTexture) {
 
         glBindTexture(glType, glTexture.value_or(emptyTextures[glType]));
+        ++info.state.textures;
 
         boundTexture.type = glType;
         boundTexture.texture = glTexture;
+
+    } else {
+
+        ++info.state.skipped;
     }
 }
 
@@ -733,6 +831,11 @@ void gl::GLState::texImage3D(GLuint target, GLint level, GLint internalFormat, G
     glTexImage3D(target, level, internalFormat, width, height, depth, 0, format, type, pixels);
 }
 
+void gl::GLState::compressedTexImage2D(GLuint target, GLint level, GLuint internalFormat, GLint width, GLint height, GLint imageSize, const void* data) {
+
+    glCompressedTexImage2D(target, level, internalFormat, width, height, 0, imageSize, data);
+}
+
 void gl::GLState::scissor(const Vector4& scissor) {
 
     if (!currentScissor.equals(scissor)) {
@@ -793,6 +896,9 @@ void gl::GLState::reset(int width, int height) {
 
     glUseProgram(0);
 
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
     glLineWidth(1);
 
     glScissor(0, 0, width, height);
@@ -809,6 +915,9 @@ void gl::GLState::reset(int width, int height) {
 
     currentProgram = std::nullopt;
 
+    currentBoundBuffers.clear();
+    currentVertexArray = std::nullopt;
+
     currentBlendingEnabled = false;
     currentBlending = std::nullopt;
     currentBlendEquation = std::nullopt;
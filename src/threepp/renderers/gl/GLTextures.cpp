@@ -39,6 +39,34 @@ namespace {
                texture.minFilter != Filter::Nearest && texture.minFilter != Filter::Linear;
     }
 
+    // read only, so that uploading does not copy pixels shared with other images
+    const void* pixels(const Image& image, GLuint glType) {
+
+        if (glType == GL_FLOAT) return image.data<float>().data();
+
+        return image.data().data();
+    }
+
+    bool compressedFormatSupported(Format format) {
+
+        const auto& capabilities = gl::GLCapabilities::instance();
+
+        switch (format) {
+            case Format::RGB_S3TC_DXT1:
+            case Format::RGBA_S3TC_DXT1:
+            case Format::RGBA_S3TC_DXT3:
+            case Format::RGBA_S3TC_DXT5:
+                return capabilities.s3tc;
+            case Format::RGBA_BPTC:
+                return capabilities.bptc;
+            case Format::RGB_ETC2:
+            case Format::RGBA_ETC2_EAC:
+                return capabilities.etc2;
+            default:
+                return true;
+        }
+    }
+
     GLuint filterFallback(Filter f) {
 
         if (f == Filter::Nearest || f == Filter::NearestMipmapNearest || f == Filter::NearestMipmapLinear) {
@@ -49,6 +77,23 @@ namespace {
         return GL_LINEAR;
     }
 
+    // the memory taken by the levels glGenerateMipmap adds below a first level of the given bytes
+    size_t generatedMipmapBytes(size_t bytes, unsigned int width, unsigned int height) {
+
+        const auto texels = static_cast<size_t>(width) * height;
+        if (texels == 0) return 0;
+
+        size_t total = 0;
+        while (width > 1 || height > 1) {
+
+            width = std::max(1u, width / 2);
+            height = std::max(1u, height / 2);
+            total += bytes * width * height / texels;
+        }
+
+        return total;
+    }
+
     GLint getInternalFormat(GLuint glFormat, GLuint glType) {
 
         GLint internalFormat = glFormat;
@@ -90,11 +135,120 @@ gl::GLTextures::GLTextures(gl::GLState& state, gl::GLProperties& properties, gl:
       onTextureDispose_(this),
       onRenderTargetDispose_(this) {}
 
+void gl::GLTextures::beginUploads() {
+
+    if (!explicitFrames_) ++frame_;
+
+    uploads_ = 0;
+    uploadedBytes_ = 0;
+    uploadTime_ = {};
+}
+
+void gl::GLTextures::beginFrame() {
+
+    // the textures not used in the frame that ended, rather than after each of its renders
+    explicitFrames_ = true;
+    deleteUnused();
+
+    ++frame_;
+}
+
+bool gl::GLTextures::withinUploadBudget(const Texture& texture) const {
+
+    if (uploads_ == 0) return true;
+
+    if (uploadBudgetBytes > 0) {
+
+        size_t bytes = 0;
+        for (const auto& image : texture.image) bytes += image.byteLength();
+        for (const auto& mipmap : texture.mipmaps) bytes += mipmap.byteLength();
+
+        if (uploadedBytes_ + bytes > uploadBudgetBytes) return false;
+    }
+
+    if (uploadBudgetMilliseconds > 0) {
+
+        if (std::chrono::duration<float, std::milli>(uploadTime_).count() >= uploadBudgetMilliseconds) return false;
+    }
+
+    return true;
+}
+
+void gl::GLTextures::evict() {
+
+    if (!explicitFrames_) deleteUnused();
+}
+
+void gl::GLTextures::deleteUnused() {
+
+    if (memoryBudgetBytes == 0) return;
+
+    auto it = residents_.begin();
+
+    while (info->memory.textureBytes > memoryBudgetBytes && it != residents_.end()) {
+
+        // the rest have been used in this frame as well
+        if (it->lastUsed == frame_) break;
+
+        const auto resident = *it++;
+        if (resident.kept) continue;
+
+        auto texture = resident.texture;
+        removeResident(*texture);
+
+        // deleted as when disposed, except that the texture is uploaded again on its next use
+        texture->removeEventListener("dispose", &onTextureDispose_);
+        deallocateTexture(texture);
+        --info->memory.textures;
+
+        ++info->textures.evictions;
+        info->textures.evicted += resident.bytes;
+    }
+}
+
+void gl::GLTextures::makeResident(Texture& texture, size_t bytes) {
+
+    removeResident(texture);
+
+    // textures without pixels can not be uploaded again
+    if (bytes == 0) return;
+
+    residentIndex_[texture.id] = residents_.insert(residents_.end(), {&texture, bytes, frame_, false});
+    info->memory.textureBytes += bytes;
+}
+
+void gl::GLTextures::keepResident(const Texture& texture) {
+
+    const auto it = residentIndex_.find(texture.id);
+    if (it == residentIndex_.end()) return;
+
+    it->second->kept = true;
+}
+
+void gl::GLTextures::markUsed(const Texture& texture) {
+
+    const auto it = residentIndex_.find(texture.id);
+    if (it == residentIndex_.end()) return;
+
+    it->second->lastUsed = frame_;
+    residents_.splice(residents_.end(), residents_, it->second);
+}
+
+void gl::GLTextures::removeResident(const Texture& texture) {
+
+    const auto it = residentIndex_.find(texture.id);
+    if (it == residentIndex_.end()) return;
+
+    info->memory.textureBytes -= it->second->bytes;
+    residents_.erase(it->second);
+    residentIndex_.erase(it);
+}
+
 void gl::GLTextures::generateMipmap(GLuint target, const Texture& texture, GLuint width, GLuint height) {
 
     glGenerateMipmap(target);
 
-    auto textureProperties = properties->textureProperties.get(texture.uuid);
+    auto textureProperties = properties->textureProperties.get(texture.id);
 
     textureProperties->maxMipLevel = static_cast<int>(std::log2(std::max(width, height)));
 }
@@ -131,7 +285,7 @@ void gl::GLTextures::uploadTexture(TextureProperties* textureProperties, Texture
 
     glPixelStorei(GL_UNPACK_ALIGNMENT, texture.unpackAlignment);
 
-    auto& image = texture.image.front();
+    const auto& image = texture.image.front();
 
     GLuint glFormat = toGLFormat(texture.format);
 
@@ -142,13 +296,42 @@ void gl::GLTextures::uploadTexture(TextureProperties* textureProperties, Texture
 
     auto& mipmaps = texture.mipmaps;
 
-    if (dataTexture3D) {
+    size_t bytes = 0;
+
+    const auto glCompressedFormat = toGLCompressedFormat(texture.format);
+
+    if (glCompressedFormat) {
+
+        // the mipmaps can not be generated, so the given ones are used
+        const auto& levels = mipmaps.empty() ? texture.image : mipmaps;
+
+        if (!compressedFormatSupported(texture.format)) {
+
+            std::cerr << "THREE.GLTextures: Attempt to load unsupported compressed texture format in .uploadTexture()" << std::endl;
+
+        } else {
+
+            for (size_t i = 0; i < levels.size(); ++i) {
+
+                const auto& level = levels[i];
+                state->compressedTexImage2D(GL_TEXTURE_2D, static_cast<int>(i), glCompressedFormat,
+                                            static_cast<int>(level.width), static_cast<int>(level.height),
+                                            static_cast<int>(level.byteLength()), level.data().data());
+                bytes += level.byteLength();
+            }
+        }
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<int>(levels.size()) - 1);
+        textureProperties->maxMipLevel = static_cast<int>(levels.size()) - 1;
+
+    } else if (dataTexture3D) {
 
         state->texImage3D(GL_TEXTURE_3D, 0, glInternalFormat,
                          static_cast<int>(image.width),
                          static_cast<int>(image.height),
                          static_cast<int>(image.depth),
                          glFormat, glType, image.data().data());
+        bytes += image.byteLength();
         textureProperties->maxMipLevel = 0;
 
     } else {
@@ -163,12 +346,16 @@ void gl::GLTextures::uploadTexture(TextureProperties* textureProperties, Texture
 
             for (int i = 0; i < mipmaps.size(); ++i) {
 
-                auto& mipmap = mipmaps[i];
+                const auto& mipmap = mipmaps[i];
                 state->texImage2D(GL_TEXTURE_2D, i, glInternalFormat,
                                  static_cast<int>(mipmap.width), static_cast<int>(mipmap.height),
-                                 glFormat, glType, mipmap.data().data());
+                                 glFormat, glType, pixels(mipmap, glType));
+                bytes += mipmap.byteLength();
             }
 
+            // complete without the levels below the smallest given one
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<int>(mipmaps.size()) - 1);
+
             texture.generateMipmaps = false;
             textureProperties->maxMipLevel = static_cast<int>(mipmaps.size()) - 1;
 
@@ -177,26 +364,38 @@ void gl::GLTextures::uploadTexture(TextureProperties* textureProperties, Texture
             if (glType == GL_UNSIGNED_BYTE) {
                 state->texImage2D(GL_TEXTURE_2D, 0, glInternalFormat,
                                  static_cast<int>(image.width), static_cast<int>(image.height),
-                                 glFormat, glType, texture.image.front().data().data());
+                                 glFormat, glType, image.data().data());
             } else if (glType == GL_FLOAT) {
                 state->texImage2D(GL_TEXTURE_2D, 0, glInternalFormat,
                                  static_cast<int>(image.width), static_cast<int>(image.height),
-                                 glFormat, glType, texture.image.front().data<float>().data());
+                                 glFormat, glType, image.data<float>().data());
             } else {
 
                 std::cerr << "Unnsupported gltype=" << glType << std::endl;
             }
+            bytes += image.byteLength();
             textureProperties->maxMipLevel = 0;
         }
     }
 
+    auto residentBytes = bytes;
+
     if (textureNeedsGenerateMipmaps(texture)) {
 
         generateMipmap(textureType, texture, image.width, image.height);
+        residentBytes += generatedMipmapBytes(bytes, image.width, image.height);
     }
 
     textureProperties->version = texture.version();
 
+    ++uploads_;
+    uploadedBytes_ += bytes;
+    ++info->textures.uploads;
+    info->textures.bytes += bytes;
+
+    makeResident(texture, residentBytes);
+    evict();
+
     if (texture.onUpdate) texture.onUpdate.value()(texture);
 }
 
@@ -220,13 +419,15 @@ void gl::GLTextures::deallocateTexture(Texture* texture) {
 
     if (!properties) return;
 
-    auto textureProperties = properties->textureProperties.get(texture->uuid);
+    auto textureProperties = properties->textureProperties.get(texture->id);
 
     if (!textureProperties->glInit) return;
 
-    glDeleteTextures(1, &textureProperties->glTexture.value());
+    removeResident(*texture);
+
+    state->deleteTexture(*textureProperties->glTexture);
 
-    properties->textureProperties.remove(texture->uuid);
+    properties->textureProperties.remove(texture->id);
 }
 
 void gl::GLTextures::deallocateRenderTarget(GLRenderTarget* renderTarget) {
@@ -235,12 +436,12 @@ void gl::GLTextures::deallocateRenderTarget(GLRenderTarget* renderTarget) {
 
     const auto& texture = renderTarget->texture;
 
-    auto renderTargetProperties = properties->renderTargetProperties.get(renderTarget->uuid);
-    const auto& textureProperties = properties->textureProperties.get(texture->uuid);
+    auto renderTargetProperties = properties->renderTargetProperties.get(renderTarget->id);
+    const auto& textureProperties = properties->textureProperties.get(texture->id);
 
     if (textureProperties->glTexture) {
 
-        glDeleteTextures(1, &textureProperties->glTexture.value());
+        state->deleteTexture(*textureProperties->glTexture);
 
         info->memory.textures--;
     }
@@ -250,11 +451,11 @@ void gl::GLTextures::deallocateRenderTarget(GLRenderTarget* renderTarget) {
         renderTarget->depthTexture->dispose();
     }
 
-    glDeleteFramebuffers(1, &renderTargetProperties->glFramebuffer.value());
+    state->deleteFramebuffer(*renderTargetProperties->glFramebuffer);
     if (renderTargetProperties->glDepthbuffer) glDeleteRenderbuffers(1, &renderTargetProperties->glDepthbuffer.value());
 
-    properties->textureProperties.remove(texture->uuid);
-    properties->renderTargetProperties.remove(renderTarget->uuid);
+    properties->textureProperties.remove(texture->id);
+    properties->renderTargetProperties.remove(renderTarget->id);
 }
 
 void gl::GLTextures::resetTextureUnits() {
@@ -278,7 +479,9 @@ int gl::GLTextures::allocateTextureUnit() {
 
 void gl::GLTextures::setTexture2D(Texture& texture, GLuint slot) {
 
-    auto textureProperties = properties->textureProperties.get(texture.uuid);
+    markUsed(texture);
+
+    auto textureProperties = properties->textureProperties.get(texture.id);
 
     if (texture.version() > 0 && textureProperties->version != texture.version()) {
 
@@ -288,9 +491,15 @@ void gl::GLTextures::setTexture2D(Texture& texture, GLuint slot) {
 
             std::cerr << "THREE.GLRenderer: Texture marked for update but image is undefined" << std::endl;
 
+        } else if (!withinUploadBudget(texture)) {
+
+            ++info->textures.deferred;
+
         } else {
 
+            const auto start = std::chrono::steady_clock::now();
             uploadTexture(textureProperties, texture, slot);
+            uploadTime_ += std::chrono::steady_clock::now() - start;
             return;
         }
     }
@@ -301,7 +510,9 @@ void gl::GLTextures::setTexture2D(Texture& texture, GLuint slot) {
 
 void gl::GLTextures::setTexture2DArray(Texture& texture, GLuint slot) {
 
-    auto textureProperties = properties->textureProperties.get(texture.uuid);
+    markUsed(texture);
+
+    auto textureProperties = properties->textureProperties.get(texture.id);
 
     if (texture.version() > 0 && textureProperties->version != texture.version()) {
 
@@ -315,7 +526,9 @@ void gl::GLTextures::setTexture2DArray(Texture& texture, GLuint slot) {
 
 void gl::GLTextures::setTexture3D(Texture& texture, GLuint slot) {
 
-    auto textureProperties = properties->textureProperties.get(texture.uuid);
+    markUsed(texture);
+
+    auto textureProperties = properties->textureProperties.get(texture.id);
 
     if (texture.version() > 0 && textureProperties->version != texture.version()) {
 
@@ -329,7 +542,9 @@ void gl::GLTextures::setTexture3D(Texture& texture, GLuint slot) {
 
 void gl::GLTextures::setTextureCube(Texture& texture, GLuint slot) {
 
-    auto textureProperties = properties->textureProperties.get(texture.uuid);
+    markUsed(texture);
+
+    auto textureProperties = properties->textureProperties.get(texture.id);
 
     if (texture.version() > 0 && textureProperties->version != texture.version()) {
 
@@ -355,24 +570,33 @@ void gl::GLTextures::uploadCubeTexture(TextureProperties* textureProperties, Tex
     auto glInternalFormat = getInternalFormat(glFormat, glType);
     setTextureParameters(GL_TEXTURE_CUBE_MAP, texture);
 
-    auto& images = texture.image;
-    auto& mipmaps = texture.mipmaps;
+    const auto& images = texture.image;
+    const auto& mipmaps = texture.mipmaps;
+    size_t bytes = 0;
     for (int i = 0; i < 6; i++) {
-        auto& image = images[i];
+        const auto& image = images[i];
         state->texImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, glInternalFormat, image.width, image.height, glFormat, glType, image.data().data());
+        bytes += image.byteLength();
 
         for (int j = 0; j < mipmaps.size(); j++) {
             state->texImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, j + i, glInternalFormat, image.width, image.height, glFormat, glType, mipmaps[j].data().data());
+            bytes += mipmaps[j].byteLength();
         }
     }
 
     textureProperties->maxMipLevel = static_cast<int>(mipmaps.size());
 
+    auto residentBytes = bytes;
+
     if (textureNeedsGenerateMipmaps(texture)) {
         generateMipmap(GL_TEXTURE_CUBE_MAP, texture, images.front().width, images.front().height);
+        residentBytes += generatedMipmapBytes(bytes, images.front().width, images.front().height);
     }
 
     textureProperties->version = texture.version();
+
+    makeResident(texture, residentBytes);
+    evict();
     if (texture.onUpdate) {
         texture.onUpdate.value()(texture);
     }
@@ -397,7 +621,7 @@ void gl::GLTextures::setupFrameBufferTexture(
     }
 
     state->bindFramebuffer(GL_FRAMEBUFFER, framebuffer);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, textureTarget, *properties->textureProperties.get(texture.uuid)->glTexture, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, textureTarget, *properties->textureProperties.get(texture.id)->glTexture, 0);
     state->bindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
@@ -447,7 +671,7 @@ void gl::GLTextures::setupDepthTexture(unsigned int framebuffer, GLRenderTarget*
     }
 
     // upload an empty depth texture with framebuffer size
-    if (!properties->textureProperties.get(renderTarget->depthTexture->uuid)->glTexture ||
+    if (!properties->textureProperties.get(renderTarget->depthTexture->id)->glTexture ||
         renderTarget->depthTexture->image.front().width != renderTarget->width ||
         renderTarget->depthTexture->image.front().height != renderTarget->height) {
 
@@ -458,7 +682,7 @@ void gl::GLTextures::setupDepthTexture(unsigned int framebuffer, GLRenderTarget*
 
     setTexture2D(*renderTarget->depthTexture, 0);
 
-    const auto glDepthTexture = properties->textureProperties.get(renderTarget->depthTexture->uuid)->glTexture;
+    const auto glDepthTexture = properties->textureProperties.get(renderTarget->depthTexture->id)->glTexture;
 
     if (renderTarget->depthTexture->format == Format::Depth) {
 
@@ -476,7 +700,7 @@ void gl::GLTextures::setupDepthTexture(unsigned int framebuffer, GLRenderTarget*
 
 void gl::GLTextures::setupDepthRenderbuffer(GLRenderTarget* renderTarget) {
 
-    auto renderTargetProperties = properties->renderTargetProperties.get(renderTarget->uuid);
+    auto renderTargetProperties = properties->renderTargetProperties.get(renderTarget->id);
 
     if (renderTarget->depthTexture) {
 
@@ -498,8 +722,8 @@ void gl::GLTextures::setupRenderTarget(GLRenderTarget* renderTarget) {
 
     const auto& texture = renderTarget->texture;
 
-    auto renderTargetProperties = properties->renderTargetProperties.get(renderTarget->uuid);
-    auto textureProperties = properties->textureProperties.get(texture->uuid);
+    auto renderTargetProperties = properties->renderTargetProperties.get(renderTarget->id);
+    auto textureProperties = properties->textureProperties.get(texture->id);
 
     renderTarget->addEventListener("dispose", &onRenderTargetDispose_);
 
@@ -555,7 +779,7 @@ void gl::GLTextures::updateRenderTargetMipmap(GLRenderTarget* renderTarget) {
     if (textureNeedsGenerateMipmaps(*texture)) {
 
         const auto target = GL_TEXTURE_2D;
-        const auto glTexture = properties->textureProperties.get(texture->uuid)->glTexture;
+        const auto glTexture = properties->textureProperties.get(texture->id)->glTexture;
 
         state->bindTexture(target, *glTexture);
         generateMipmap(target, *texture, renderTarget->width, renderTarget->height);
@@ -565,7 +789,7 @@ void gl::GLTextures::updateRenderTargetMipmap(GLRenderTarget* renderTarget) {
 
 std::optional<unsigned int> gl::GLTextures::getGlTexture(const Texture& texture) const {
 
-    const auto textureProperties = properties->textureProperties.get(texture.uuid);
+    const auto textureProperties = properties->textureProperties.get(texture.id);
 
     return textureProperties->glTexture;
 }
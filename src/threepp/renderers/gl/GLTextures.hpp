@@ -11,6 +11,8 @@
 #include "threepp/renderers/GLRenderTarget.hpp"
 #include "threepp/textures/Texture.hpp"
 
+#include <chrono>
+#include <list>
 #include <memory>
 #include <unordered_map>
 
@@ -23,8 +25,34 @@ namespace threepp::gl {
         const int maxTextureSize;
         const int maxSamples;
 
+        // The texture data setTexture2D may upload between calls to beginUploads, in bytes and milliseconds,
+        // or no limit if 0. Textures over the budget keep their previous contents until a later frame,
+        // or sample as black if they have none. The first upload is always made, however large.
+        size_t uploadBudgetBytes = 0;
+        float uploadBudgetMilliseconds = 0;
+
+        // The estimated memory the textures uploaded from images may take up, in bytes, or no limit if 0.
+        // Over the budget, the least recently used textures are deleted, and uploaded again when next used.
+        // Textures used in the current frame, and textures written to on the GPU, are never deleted.
+        size_t memoryBudgetBytes = 0;
+
         GLTextures(GLState& state, GLProperties& properties, GLInfo& info);
 
+        // Starts a new upload budget. Until beginFrame is first called, this also starts a frame.
+        void beginUploads();
+
+        // Starts a frame, which may span several calls to beginUploads, for the textures last used.
+        // Textures not used in the frame that ended are evicted here, rather than by evict.
+        void beginFrame();
+
+        // Deletes the least recently used textures, not used in this frame, while over the memory budget.
+        // Does nothing once frames are started by beginFrame.
+        void evict();
+
+        // Keeps texture from being deleted over the memory budget, as its contents were written on the GPU
+        // and can not be restored from its image. Until it is next uploaded from its image.
+        void keepResident(const Texture& texture);
+
         void generateMipmap(unsigned int target, const Texture& texture, unsigned int width, unsigned int height);
 
         void setTextureParameters(unsigned int textureType, Texture& texture);
@@ -98,6 +126,35 @@ namespace threepp::gl {
         RenderTargetEventListener onRenderTargetDispose_;
 
         int textureUnits = 0;
+
+        size_t uploads_ = 0;
+        size_t uploadedBytes_ = 0;
+        std::chrono::steady_clock::duration uploadTime_{};
+
+        struct Resident {
+
+            Texture* texture;
+            size_t bytes;
+            size_t lastUsed;
+            bool kept;
+        };
+
+        // the textures that can be uploaded again, least recently used first
+        std::list<Resident> residents_;
+        std::unordered_map<unsigned int, std::list<Resident>::iterator> residentIndex_;
+        size_t frame_ = 0;
+        // whether frames are started by beginFrame rather than beginUploads
+        bool explicitFrames_ = false;
+
+        [[nodiscard]] bool withinUploadBudget(const Texture& texture) const;
+
+        void deleteUnused();
+
+        void makeResident(Texture& texture, size_t bytes);
+
+        void markUsed(const Texture& texture);
+
+        void removeResident(const Texture& texture);
     };
 
 }// namespace threepp::gl
@@ -0,0 +1,200 @@
+
+#include "threepp/renderers/gl/GLUniformBuffers.hpp"
+
+#include "threepp/cameras/OrthographicCamera.hpp"
+#include "threepp/renderers/gl/GLUtils.hpp"
+
+#include <cstring>
+
+using namespace threepp;
+using namespace threepp::gl;
+
+namespace {
+
+    // appends values following the std140 rules, in units of 4 bytes
+    struct Std140Writer {
+
+        std::vector<float>& data;
+
+        void align(size_t alignment) {
+
+            while (data.size() % alignment) data.emplace_back(0.f);
+        }
+
+        void write(float value) {
+
+            data.emplace_back(value);
+        }
+
+        void write(bool value) {
+
+            const uint32_t bits = value ? 1 : 0;
+            float f;
+            std::memcpy(&f, &bits, sizeof(f));
+
+            data.emplace_back(f);
+        }
+
+        void write(const Vector3& v) {
+
+            align(4);
+            data.insert(data.end(), {v.x, v.y, v.z});
+        }
+
+        void write(const Color& c) {
+
+            align(4);
+            data.insert(data.end(), {c.r, c.g, c.b});
+        }
+
+        void write(const Matrix4& m) {
+
+            align(4);
+            data.insert(data.end(), m.elements.begin(), m.elements.end());
+        }
+
+        // structs and array elements start and end at a multiple of 16 bytes
+        void endStruct() {
+
+            align(4);
+        }
+    };
+
+    const Vector3& vector3(const LightUniforms& uniforms, const std::string& name) {
+
+        return std::get<Vector3>(uniforms.at(name));
+    }
+
+    const Color& color(const LightUniforms& uniforms, const std::string& name) {
+
+        return std::get<Color>(uniforms.at(name));
+    }
+
+    float scalar(const LightUniforms& uniforms, const std::string& name) {
+
+        return std::get<float>(uniforms.at(name));
+    }
+
+}// namespace
+
+GLUniformBuffers::GLUniformBuffers(GLState& state)
+    : state_(state) {}
+
+void GLUniformBuffers::updateCamera(const Camera& camera) {
+
+    writeCamera(camera, camera_.data);
+    upload(camera_, cameraBinding);
+}
+
+void GLUniformBuffers::updateLights(const GLLights::LightState& lights) {
+
+    writeLights(lights, lights_.data);
+    upload(lights_, lightsBinding);
+}
+
+void GLUniformBuffers::bindBlocks(unsigned int program) {
+
+    const auto cameraBlock = glGetUniformBlockIndex(program, "CameraBlock");
+    if (cameraBlock != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, cameraBlock, cameraBinding);
+    }
+
+    const auto lightsBlock = glGetUniformBlockIndex(program, "LightsBlock");
+    if (lightsBlock != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, lightsBlock, lightsBinding);
+    }
+}
+
+void GLUniformBuffers::writeCamera(const Camera& camera, std::vector<float>& data) {
+
+    data.clear();
+    Std140Writer writer{data};
+
+    Vector3 cameraPosition;
+    cameraPosition.setFromMatrixPosition(*camera.matrixWorld);
+
+    writer.write(camera.projectionMatrix);
+    writer.write(camera.matrixWorldInverse);
+    writer.write(cameraPosition);
+    writer.write(camera.is<OrthographicCamera>());
+    writer.endStruct();
+}
+
+void GLUniformBuffers::writeLights(const GLLights::LightState& lights, std::vector<float>& data) {
+
+    data.clear();
+    Std140Writer writer{data};
+
+    writer.write(lights.ambient);
+    for (const auto& probe : lights.probe) {
+        writer.write(probe);
+        writer.endStruct();
+    }
+
+    for (const auto uniforms : lights.directional) {
+        writer.write(vector3(*uniforms, "direction"));
+        writer.write(color(*uniforms, "color"));
+        writer.endStruct();
+    }
+
+    for (const auto uniforms : lights.point) {
+        writer.write(vector3(*uniforms, "position"));
+        writer.write(color(*uniforms, "color"));
+        writer.write(scalar(*uniforms, "distance"));
+        writer.write(scalar(*uniforms, "decay"));
+        writer.endStruct();
+    }
+
+    for (const auto uniforms : lights.spot) {
+        writer.write(vector3(*uniforms, "position"));
+        writer.write(vector3(*uniforms, "direction"));
+        writer.write(color(*uniforms, "color"));
+        writer.write(scalar(*uniforms, "distance"));
+        writer.write(scalar(*uniforms, "decay"));
+        writer.write(scalar(*uniforms, "coneCos"));
+        writer.write(scalar(*uniforms, "penumbraCos"));
+        writer.endStruct();
+    }
+
+    for (const auto uniforms : lights.hemi) {
+        writer.write(vector3(*uniforms, "direction"));
+        writer.write(color(*uniforms, "skyColor"));
+        writer.write(color(*uniforms, "groundColor"));
+        writer.endStruct();
+    }
+}
+
+void GLUniformBuffers::dispose() {
+
+    for (auto block : {&camera_, &lights_}) {
+
+        if (block->buffer) state_.deleteBuffer(block->buffer);
+
+        block->buffer = 0;
+        block->uploaded.clear();
+    }
+}
+
+GLUniformBuffers::~GLUniformBuffers() {
+
+    dispose();
+}
+
+void GLUniformBuffers::upload(Block& block, unsigned int binding) {
+
+    if (block.buffer && block.data == block.uploaded) return;
+
+    if (!block.buffer) glGenBuffers(1, &block.buffer);
+
+    const auto size = static_cast<GLsizeiptr>(block.data.size() * sizeof(float));
+
+    state_.bindBuffer(GL_UNIFORM_BUFFER, block.buffer);
+    if (block.data.size() == block.uploaded.size()) {
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, size, block.data.data());
+    } else {
+        glBufferData(GL_UNIFORM_BUFFER, size, block.data.data(), GL_DYNAMIC_DRAW);
+    }
+    glBindBufferBase(GL_UNIFORM_BUFFER, binding, block.buffer);
+
+    block.uploaded = block.data;
+}
@@ -0,0 +1,66 @@
+
+#ifndef THREEPP_GLUNIFORMBUFFERS_HPP
+#define THREEPP_GLUNIFORMBUFFERS_HPP
+
+#include "threepp/renderers/gl/GLLights.hpp"
+#include "threepp/renderers/gl/GLState.hpp"
+
+#include <vector>
+
+namespace threepp {
+
+    class Camera;
+
+    namespace gl {
+
+        // Uniform buffer objects holding the camera and light uniforms shared by all programs.
+        // Programs compiled with USE_UBO read these from the CameraBlock and LightsBlock std140 blocks,
+        // so they are uploaded once per camera and once per frame rather than once per program.
+        struct GLUniformBuffers {
+
+            static constexpr unsigned int cameraBinding = 0;
+            static constexpr unsigned int lightsBinding = 1;
+
+            explicit GLUniformBuffers(GLState& state);
+
+            GLUniformBuffers(const GLUniformBuffers&) = delete;
+            GLUniformBuffers& operator=(const GLUniformBuffers&) = delete;
+
+            void updateCamera(const Camera& camera);
+
+            void updateLights(const GLLights::LightState& lights);
+
+            // Assigns the binding points of the blocks used by program.
+            static void bindBlocks(unsigned int program);
+
+            // std140 layout of the CameraBlock.
+            static void writeCamera(const Camera& camera, std::vector<float>& data);
+
+            // std140 layout of the LightsBlock.
+            static void writeLights(const GLLights::LightState& lights, std::vector<float>& data);
+
+            void dispose();
+
+            ~GLUniformBuffers();
+
+        private:
+            struct Block {
+
+                unsigned int buffer = 0;
+                std::vector<float> data;
+                std::vector<float> uploaded;
+            };
+
+            GLState& state_;
+
+            Block camera_;
+            Block lights_;
+
+            void upload(Block& block, unsigned int binding);
+        };
+
+    }// namespace gl
+
+}// namespace threepp
+
+#endif//THREEPP_GLUNIFORMBUFFERS_HPP
@@ -11,7 +11,6 @@
 #endif
 
 #include <iostream>
-#include <regex>
 
 using namespace threepp;
 using namespace threepp::gl;
@@ -230,7 +229,7 @@ namespace {
             float w = value[3];
 
             ensureCapacity(cache, 4);
-            if (cache[0] != x || cache[1] != y && cache[2] != z || cache[3] != w) {
+            if (cache[0] != x || cache[1] != y || cache[2] != z || cache[3] != w) {
 
                 glUniform4f(addr, x, y, z, w);
 
@@ -418,31 +417,41 @@ namespace {
         container->map[id] = container->seq.back().get();
     }
 
-    void parseUniform(ActiveUniformInfo& activeInfo, int addr, Container* container) {
+    inline bool isWordChar(char c) {
+
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
 
-        static std::regex rex(R"(([\w\d_]+)(\])?(\[|\.)?)");
+    // Splits a uniform name such as "spotLights[0].color" into path parts,
+    // each an identifier or array index optionally followed by a "[" or "." subscript.
+    void parseUniform(ActiveUniformInfo& activeInfo, int addr, Container* container) {
 
-        const auto path = activeInfo.name;
+        const auto& path = activeInfo.name;
         const auto pathLength = path.size();
 
-        std::sregex_iterator rex_it(path.cbegin(), path.cend(), rex);
-        std::sregex_iterator rex_end;
+        size_t pos = 0;
+        while (true) {
 
-        while (rex_it != rex_end) {
-            std::smatch match = *rex_it;
+            while (pos < pathLength && !isWordChar(path[pos])) ++pos;
+            if (pos == pathLength) break;
 
-            const auto matchEnd = match.length();
+            const auto start = pos;
+            while (pos < pathLength && isWordChar(path[pos])) ++pos;
 
-            std::string id = match[1];
-            bool isIndex = match[2] == "]";
-            std::string subscript = match[3];
+            std::string id = path.substr(start, pos - start);
+
+            const bool isIndex = pos < pathLength && path[pos] == ']';
+            if (isIndex) ++pos;
+
+            char subscript = 0;
+            if (pos < pathLength && (path[pos] == '[' || path[pos] == '.')) subscript = path[pos++];
 
             if (isIndex) id = std::to_string(utils::parseInt(id) | 0);
 
-            if (!match[3].matched || subscript == "[" && matchEnd + 2 == pathLength) {
+            if (!subscript || (subscript == '[' && pos + 2 == pathLength)) {
 
                 // bare name or "pure" bottom-level array "[0]" suffix
-                if (!match[3].matched) {
+                if (!subscript) {
                     addUniform(container, std::make_unique<SingleUniform>(id, activeInfo, addr));
                 } else {
                     addUniform(container, std::make_unique<PureArrayUniform>(id, activeInfo, addr));
@@ -457,8 +466,6 @@ namespace {
 
                 container = dynamic_cast<Container*>(container->map.at(id));
             }
-
-            ++rex_it;
         }
     }
 
@@ -476,6 +483,9 @@ GLUniforms::GLUniforms(unsigned int program) {
         ActiveUniformInfo info(program, i);
         GLint addr = glGetUniformLocation(program, info.name.c_str());
 
+        // members of uniform blocks are set through their buffer
+        if (addr < 0) continue;
+
         parseUniform(info, addr, dynamic_cast<Container*>(this));
     }
 }
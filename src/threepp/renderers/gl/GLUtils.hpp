@@ -11,6 +11,26 @@
 
 #include "threepp/constants.hpp"
 
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT3_EXT 0x83F2
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif
+
+#ifndef GL_COMPRESSED_RGB8_ETC2
+#define GL_COMPRESSED_RGB8_ETC2 0x9274
+#define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
+
+#ifndef GL_COMPRESSED_RG_RGTC2
+#define GL_COMPRESSED_RG_RGTC2 0x8DBD
+#endif
+
 namespace threepp::gl {
 
     inline GLint glGetParameteri(GLenum id) {
@@ -59,6 +79,31 @@ namespace threepp::gl {
         }
     }
 
+    // The internal format of a compressed format, or 0 if the format is not compressed.
+    constexpr inline GLuint toGLCompressedFormat(Format p) {
+
+        switch (p) {
+            case Format::RGB_S3TC_DXT1:
+                return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            case Format::RGBA_S3TC_DXT1:
+                return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+            case Format::RGBA_S3TC_DXT3:
+                return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+            case Format::RGBA_S3TC_DXT5:
+                return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case Format::RED_GREEN_RGTC2:
+                return GL_COMPRESSED_RG_RGTC2;
+            case Format::RGBA_BPTC:
+                return GL_COMPRESSED_RGBA_BPTC_UNORM;
+            case Format::RGB_ETC2:
+                return GL_COMPRESSED_RGB8_ETC2;
+            case Format::RGBA_ETC2_EAC:
+                return GL_COMPRESSED_RGBA8_ETC2_EAC;
+            default:
+                return 0;
+        }
+    }
+
     constexpr inline GLuint toGLType(Type p) {
 
         switch (p) {
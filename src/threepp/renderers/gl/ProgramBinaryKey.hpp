@@ -0,0 +1,30 @@
+#ifndef THREEPP_PROGRAMBINARYKEY_HPP
+#define THREEPP_PROGRAMBINARYKEY_HPP
+
+#include <cstdint>
+
+namespace threepp::gl {
+
+    // Key of a program binary stored by GLProgramBinaryCache. The file is named by one hash of the inputs,
+    // while a second, independent hash and the length of the inputs are stored in it,
+    // so that inputs whose names collide are told apart.
+    struct ProgramBinaryKey {
+
+        std::uint64_t hash;
+        std::uint64_t check;
+        std::uint64_t length;
+
+        bool operator==(const ProgramBinaryKey& other) const {
+
+            return hash == other.hash && check == other.check && length == other.length;
+        }
+
+        bool operator!=(const ProgramBinaryKey& other) const {
+
+            return !(*this == other);
+        }
+    };
+
+}// namespace threepp::gl
+
+#endif//THREEPP_PROGRAMBINARYKEY_HPP
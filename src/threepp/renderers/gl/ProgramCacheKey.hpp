@@ -0,0 +1,158 @@
+
+#ifndef THREEPP_PROGRAMCACHEKEY_HPP
+#define THREEPP_PROGRAMCACHEKEY_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace threepp::gl {
+
+    // Key identifying a compiled program.
+    // Boolean parameters are packed into a bitmask and numeric parameters into a small array.
+    // Shader sources and defines are reduced to two independent 64-bit hashes each, so that the key stays
+    // a fixed size without allocations, and a collision would have to happen in both hashes at once to share a program.
+    struct ProgramCacheKey {
+
+        static constexpr size_t maxFlags = 64;
+        static constexpr size_t maxValues = 32;
+
+        std::uint64_t sourceHash{fnvOffset};
+        std::uint64_t sourceCheck{};
+        std::uint64_t definesHash{};
+        std::uint64_t definesCheck{};
+        std::uint64_t flags{};
+        std::array<std::uint32_t, maxValues> values{};
+
+        static_assert(maxFlags <= sizeof(flags) * 8, "Flags are packed into a bitmask");
+
+        void addSource(std::string_view source) {
+
+            sourceHash = hash(source, sourceHash);
+            sourceHash = hash(source.size(), sourceHash);
+
+            sourceCheck = check(source, sourceCheck);
+            sourceCheck = check(source.size(), sourceCheck);
+        }
+
+        // defines are combined independently of the order they are added in
+        void addDefine(std::string_view name, std::string_view value) {
+
+            auto h = hash(name, fnvOffset);
+            h = hash(name.size(), h);
+            h = hash(value, h);
+            definesHash += mix(h);
+
+            auto c = check(name, 0);
+            c = check(name.size(), c);
+            c = check(value, c);
+            definesCheck += mix(c);
+        }
+
+        void addFlag(bool value) {
+
+            if (numFlags_ == maxFlags) throw std::runtime_error("[ProgramCacheKey] too many flags, max is " + std::to_string(maxFlags));
+
+            if (value) flags |= std::uint64_t{1} << numFlags_;
+            ++numFlags_;
+        }
+
+        template<class T, class = std::enable_if_t<std::is_integral_v<T>>>
+        void addValue(T value) {
+
+            nextValue() = static_cast<std::uint32_t>(value);
+        }
+
+        void addValue(float value) {
+
+            std::uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(float));
+            nextValue() = bits;
+        }
+
+        bool operator==(const ProgramCacheKey& other) const {
+
+            return sourceHash == other.sourceHash && sourceCheck == other.sourceCheck &&
+                   definesHash == other.definesHash && definesCheck == other.definesCheck &&
+                   flags == other.flags && values == other.values;
+        }
+
+        bool operator!=(const ProgramCacheKey& other) const {
+
+            return !(*this == other);
+        }
+
+        struct Hash {
+
+            size_t operator()(const ProgramCacheKey& key) const {
+
+                auto h = mix(key.sourceHash ^ key.definesHash) ^ mix(key.flags);
+                for (auto value : key.values) {
+                    h = mix(h ^ value);
+                }
+
+                return static_cast<size_t>(h);
+            }
+        };
+
+    private:
+        static constexpr std::uint64_t fnvOffset = 14695981039346656037ull;
+        static constexpr std::uint64_t fnvPrime = 1099511628211ull;
+
+        // multiplier of the check hashes, unrelated to the FNV prime
+        static constexpr std::uint64_t checkPrime = 0x9e3779b97f4a7c15ull;
+
+        unsigned int numFlags_{};
+        unsigned int numValues_{};
+
+        std::uint32_t& nextValue() {
+
+            if (numValues_ == maxValues) throw std::runtime_error("[ProgramCacheKey] too many values, max is " + std::to_string(maxValues));
+
+            return values[numValues_++];
+        }
+
+        static std::uint64_t hash(std::string_view str, std::uint64_t h) {
+
+            for (auto c : str) {
+                h = (h ^ static_cast<unsigned char>(c)) * fnvPrime;
+            }
+
+            return h;
+        }
+
+        static std::uint64_t hash(size_t value, std::uint64_t h) {
+
+            return (h ^ value) * fnvPrime;
+        }
+
+        static std::uint64_t check(std::string_view str, std::uint64_t c) {
+
+            for (auto ch : str) {
+                c = (c + static_cast<unsigned char>(ch) + 1) * checkPrime;
+            }
+
+            return c;
+        }
+
+        static std::uint64_t check(size_t value, std::uint64_t c) {
+
+            return (c ^ value) * checkPrime;
+        }
+
+        // splitmix64 finalizer
+        static std::uint64_t mix(std::uint64_t h) {
+
+            h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+            h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+            return h ^ (h >> 31);
+        }
+    };
+
+}// namespace threepp::gl
+
+#endif//THREEPP_PROGRAMCACHEKEY_HPP
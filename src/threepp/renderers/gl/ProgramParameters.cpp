@@ -11,8 +11,6 @@
 #include "threepp/objects/SkinnedMesh.hpp"
 #include "threepp/scenes/Scene.hpp"
 
-#include <sstream>
-
 using namespace threepp;
 using namespace threepp::gl;
 
@@ -58,25 +56,22 @@ ProgramParameters::ProgramParameters(
     auto roughnessMaterial = dynamic_cast<MaterialWithRoughness*>(material);
     auto metallnessMaterial = dynamic_cast<MaterialWithMetalness*>(material);
 
-    std::string vShader, fShader;
-    if (shaderIDs.count(material->type())) {
+    shaderName = material->type();
+
+    auto shaderIDIt = shaderIDs.find(shaderName);
+    if (shaderIDIt != shaderIDs.end()) {
 
-        shaderID = shaderIDs.at(material->type());
-        const auto shader = shaders::ShaderLib::instance().get(*shaderID);
-        vShader = shader.vertexShader;
-        fShader = shader.fragmentShader;
+        shaderID = shaderIDIt->second;
+        const auto& shader = shaders::ShaderLib::instance().get(*shaderID);
+        vertexShader = shader.vertexShader;
+        fragmentShader = shader.fragmentShader;
 
     } else {
 
-        vShader = shaderMaterial->vertexShader;
-        fShader = shaderMaterial->fragmentShader;
+        vertexShader = shaderMaterial->vertexShader;
+        fragmentShader = shaderMaterial->fragmentShader;
     }
 
-    shaderName = material->type();
-
-    vertexShader = vShader;
-    fragmentShader = fShader;
-
     if (definesMaterial) {
         defines = definesMaterial->defines;
     }
@@ -175,6 +170,8 @@ ProgramParameters::ProgramParameters(
     numPointLightShadows = lights.pointShadowMap.size();
     numSpotLightShadows = lights.spotShadowMap.size();
 
+    dirLightShadowCascades = lights.directionalShadowCascadesEnabled;
+
     numClippingPlanes = clipping.numPlanes;
     numClipIntersection = clipping.numIntersection;
 
@@ -186,6 +183,8 @@ ProgramParameters::ProgramParameters(
     toneMapping = material->toneMapped ? renderer.toneMapping : ToneMapping::None;
     physicallyCorrectLights = renderer.physicallyCorrectLights;
 
+    uniformBuffers = renderer.useUniformBuffers;
+
     premultipliedAlpha = material->premultipliedAlpha;
 
     alphaTest = material->alphaTest;
@@ -198,106 +197,3 @@ ProgramParameters::ProgramParameters(
         index0AttributeName = shaderMaterial->index0AttributeName;
     }
 }
-
-std::string ProgramParameters::hash() const {
-
-    std::stringstream s;
-
-    s << std::to_string(instancing) << '\n';
-    s << std::to_string(instancingColor) << '\n';
-
-    s << std::to_string(supportsVertexTextures) << '\n';
-    s << std::to_string(as_integer(outputEncoding)) << '\n';
-    s << std::to_string(map) << '\n';
-    s << std::to_string(as_integer(mapEncoding)) << '\n';
-    s << std::to_string(matcap) << '\n';
-    s << std::to_string(as_integer(matcapEncoding)) << '\n';
-    s << std::to_string(envMap) << '\n';
-    s << std::to_string(as_integer(envMapEncoding)) << '\n';
-    s << std::to_string(envMapMode) << '\n';
-    s << std::to_string(as_integer(envMapEncoding)) << '\n';
-    s << std::to_string(envMapCubeUV) << '\n';
-    s << std::to_string(lightMap) << '\n';
-    s << std::to_string(as_integer(lightMapEncoding)) << '\n';
-    s << std::to_string(aoMap) << '\n';
-    s << std::to_string(emissiveMap) << '\n';
-    s << std::to_string(as_integer(emissiveMapEncoding)) << '\n';
-    s << std::to_string(bumpMap) << '\n';
-    s << std::to_string(normalMap) << '\n';
-    s << std::to_string(objectSpaceNormalMap) << '\n';
-    s << std::to_string(tangentSpaceNormalMap) << '\n';
-    s << std::to_string(clearcoatMap) << '\n';
-    s << std::to_string(clearcoatRoughnessMap) << '\n';
-    s << std::to_string(clearcoatNormalMap) << '\n';
-    s << std::to_string(displacementMap) << '\n';
-    s << std::to_string(roughnessMap) << '\n';
-    s << std::to_string(metalnessMap) << '\n';
-    s << std::to_string(specularMap) << '\n';
-    s << std::to_string(alphaMap) << '\n';
-
-    s << std::to_string(gradientMap) << '\n';
-
-    if (sheen.has_value()) {
-        s << *sheen << '\n';
-    } else {
-        s << "undefined \n";
-    }
-
-    s << std::to_string(transmission) << '\n';
-    s << std::to_string(transmissionMap) << '\n';
-    s << std::to_string(thicknessMap) << '\n';
-
-    s << (combine.has_value() ? std::to_string(as_integer(*combine)) : std::string("undefined")) << '\n';
-
-    s << std::to_string(vertexTangents) << '\n';
-    s << std::to_string(vertexColors) << '\n';
-    s << std::to_string(vertexAlphas) << '\n';
-    s << std::to_string(vertexUvs) << '\n';
-    s << std::to_string(uvsVertexOnly) << '\n';
-
-    s << std::to_string(fog) << '\n';
-    s << std::to_string(useFog) << '\n';
-    s << std::to_string(fogExp2) << '\n';
-
-    s << std::to_string(flatShading) << '\n';
-
-    s << std::to_string(sizeAttenuation) << '\n';
-    s << std::to_string(logarithmicDepthBuffer) << '\n';
-
-    s << std::to_string(morphTargets) << '\n';
-    s << std::to_string(morphNormals) << '\n';
-
-    s << std::to_string(skinning) << '\n';
-    s << std::to_string(useVertexTexture) << '\n';
-
-    s << std::to_string(numDirLights) << '\n';
-    s << std::to_string(numPointLights) << '\n';
-    s << std::to_string(numSpotLights) << '\n';
-    s << std::to_string(numRectAreaLights) << '\n';
-    s << std::to_string(numHemiLights) << '\n';
-
-    s << std::to_string(numDirLightShadows) << '\n';
-    s << std::to_string(numPointLightShadows) << '\n';
-    s << std::to_string(numSpotLightShadows) << '\n';
-
-    s << std::to_string(numClippingPlanes) << '\n';
-    s << std::to_string(numClipIntersection) << '\n';
-
-    s << std::to_string(dithering) << '\n';
-
-    s << std::to_string(shadowMapEnabled) << '\n';
-    s << std::to_string(as_integer(shadowMapType)) << '\n';
-
-    s << std::to_string(as_integer(toneMapping)) << '\n';
-    s << std::to_string(physicallyCorrectLights) << '\n';
-
-    s << std::to_string(premultipliedAlpha) << '\n';
-
-    s << std::to_string(alphaTest) << '\n';
-    s << std::to_string(doubleSided) << '\n';
-    s << std::to_string(flipSided) << '\n';
-
-    s << std::to_string(depthPacking) << '\n';
-
-    return s.str();
-}
@@ -104,6 +104,8 @@ namespace threepp {
             size_t numPointLightShadows{};
             size_t numSpotLightShadows{};
 
+            bool dirLightShadowCascades{};
+
             int numClippingPlanes{};
             int numClipIntersection{};
 
@@ -115,6 +117,8 @@ namespace threepp {
             ToneMapping toneMapping{};
             bool physicallyCorrectLights{};
 
+            bool uniformBuffers{};
+
             bool premultipliedAlpha{};
 
             float alphaTest{};
@@ -136,8 +140,6 @@ namespace threepp {
                     Scene* scene,
                     Material* material,
                     const std::unordered_map<std::string, std::string>& shaderIDs);
-
-            [[nodiscard]] std::string hash() const;
         };
 
     }// namespace gl
@@ -0,0 +1,285 @@
+
+#include "threepp/renderers/shaders/ShaderPreprocessor.hpp"
+
+#include "threepp/renderers/shaders/ShaderChunk.hpp"
+
+#include <stdexcept>
+#include <string_view>
+
+using namespace threepp;
+using namespace threepp::shaders;
+
+namespace {
+
+    constexpr std::string_view includeDirective = "#include";
+    constexpr std::string_view loopStart = "#pragma unroll_loop_start";
+    constexpr std::string_view loopEnd = "#pragma unroll_loop_end";
+    constexpr std::string_view loopIndex = "UNROLLED_LOOP_INDEX";
+
+    inline bool isSpace(char c) {
+
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    inline bool isDigit(char c) {
+
+        return c >= '0' && c <= '9';
+    }
+
+    inline bool isIdentifierChar(char c) {
+
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || isDigit(c) || c == '_';
+    }
+
+    inline bool startsWith(std::string_view str, size_t pos, std::string_view prefix) {
+
+        return str.compare(pos, prefix.size(), prefix) == 0;
+    }
+
+    // Matches "#include +<name>" at pos, returning its length, or 0 if there is no directive.
+    size_t matchInclude(std::string_view str, size_t pos, std::string_view& name) {
+
+        if (!startsWith(str, pos, includeDirective)) return 0;
+
+        size_t i = pos + includeDirective.size();
+        const auto spaces = i;
+        while (i < str.size() && str[i] == ' ') ++i;
+        if (i == spaces || i == str.size() || str[i] != '<') return 0;
+
+        const auto nameStart = ++i;
+        while (i < str.size() && (isIdentifierChar(str[i]) || str[i] == '.')) ++i;
+        if (i == nameStart || i == str.size() || str[i] != '>') return 0;
+
+        name = str.substr(nameStart, i - nameStart);
+
+        return i + 1 - pos;
+    }
+
+    // Reads "for ( int i = A; i < B; i ++ ) {", tolerating any whitespace between tokens.
+    struct LoopHeaderParser {
+
+        std::string_view str;
+        size_t pos = 0;
+
+        void skipSpace() {
+
+            while (pos < str.size() && isSpace(str[pos])) ++pos;
+        }
+
+        bool expectSpace() {
+
+            const auto start = pos;
+            skipSpace();
+
+            return pos != start;
+        }
+
+        bool expect(std::string_view token) {
+
+            skipSpace();
+            if (!startsWith(str, pos, token)) return false;
+            pos += token.size();
+
+            return true;
+        }
+
+        bool expectNumber(int& value) {
+
+            skipSpace();
+            if (pos == str.size() || !isDigit(str[pos])) return false;
+
+            value = 0;
+            while (pos < str.size() && isDigit(str[pos])) {
+                value = value * 10 + (str[pos++] - '0');
+            }
+
+            return true;
+        }
+
+        bool parse(int& start, int& end) {
+
+            if (!expect("for") || !expect("(") || !expect("int") || !expectSpace() || !startsWith(str, pos, "i")) return false;
+            ++pos;
+
+            return expect("=") && expectNumber(start) && expect(";") &&
+                   expect("i") && expect("<") && expectNumber(end) && expect(";") &&
+                   expect("i") && expect("++") && expect(")") && expect("{");
+        }
+    };
+
+    // Appends body once per index, with "[ i ]" and UNROLLED_LOOP_INDEX replaced by the index.
+    void appendUnrolled(std::string& out, std::string_view body, int start, int end) {
+
+        for (int i = start; i < end; ++i) {
+
+            const auto index = std::to_string(i);
+
+            size_t copyFrom = 0;
+            size_t pos = 0;
+            while (pos < body.size()) {
+
+                if (body[pos] == '[') {
+
+                    auto j = pos + 1;
+                    while (j < body.size() && isSpace(body[j])) ++j;
+                    if (j < body.size() && body[j] == 'i') {
+                        ++j;
+                        while (j < body.size() && isSpace(body[j])) ++j;
+                        if (j < body.size() && body[j] == ']') {
+                            out.append(body, copyFrom, pos - copyFrom);
+                            out.append("[ ").append(index).append(" ]");
+                            pos = copyFrom = j + 1;
+                            continue;
+                        }
+                    }
+
+                } else if (startsWith(body, pos, loopIndex)) {
+
+                    out.append(body, copyFrom, pos - copyFrom);
+                    out.append(index);
+                    pos = copyFrom = pos + loopIndex.size();
+                    continue;
+                }
+
+                ++pos;
+            }
+
+            out.append(body, copyFrom, body.size() - copyFrom);
+        }
+    }
+
+    class Preprocessor {
+
+    public:
+        Preprocessor(const ShaderDefines* defines, bool unroll)
+            : defines_(defines), unroll_(unroll) {}
+
+        void process(std::string_view src) {
+
+            const auto n = src.size();
+
+            size_t copyFrom = 0;
+            size_t pos = 0;
+
+            const auto flush = [&](size_t to) {
+                out.append(src, copyFrom, to - copyFrom);
+            };
+
+            while (pos < n) {
+
+                const char c = src[pos];
+
+                if (c == '#') {
+
+                    std::string_view name;
+                    if (const auto length = matchInclude(src, pos, name)) {
+
+                        flush(pos);
+                        process(ShaderChunk::instance().resolved(std::string(name)));
+                        pos = copyFrom = pos + length;
+
+                    } else if (unroll_ && startsWith(src, pos, loopStart)) {
+
+                        flush(pos);
+                        if (loopStart_ == std::string::npos) loopStart_ = out.size();
+                        pos += loopStart.size();
+                        copyFrom = pos;
+                        out.append(loopStart);
+
+                    } else if (unroll_ && startsWith(src, pos, loopEnd)) {
+
+                        flush(pos);
+                        pos += loopEnd.size();
+                        copyFrom = pos;
+                        out.append(loopEnd);
+                        unrollLoop();
+
+                    } else {
+
+                        ++pos;
+                    }
+
+                } else if (isIdentifierChar(c)) {
+
+                    auto end = pos + 1;
+                    while (end < n && isIdentifierChar(src[end])) ++end;
+
+                    // numbers are skipped as a whole, so that suffixes are never taken for identifiers
+                    if (defines_ && !isDigit(c)) {
+
+                        const auto identifier = src.substr(pos, end - pos);
+                        for (const auto& [key, value] : *defines_) {
+                            if (identifier == key) {
+                                flush(pos);
+                                out.append(value);
+                                copyFrom = end;
+                                break;
+                            }
+                        }
+                    }
+
+                    pos = end;
+
+                } else {
+
+                    ++pos;
+                }
+            }
+
+            flush(n);
+        }
+
+        std::string out;
+
+    private:
+        const ShaderDefines* defines_;
+        bool unroll_;
+        size_t loopStart_ = std::string::npos;
+
+        // Replaces the text written since the last unroll_loop_start pragma, which ends with unroll_loop_end,
+        // by the unrolled loop body. The text is left untouched if the loop does not have constant bounds.
+        void unrollLoop() {
+
+            if (loopStart_ == std::string::npos) return;
+
+            const std::string_view text = std::string_view(out).substr(loopStart_);
+            loopStart_ = std::string::npos;
+
+            LoopHeaderParser parser{text, loopStart.size()};
+            if (parser.str.size() <= parser.pos || !isSpace(parser.str[parser.pos])) return;
+
+            int start, end;
+            if (!parser.parse(start, end)) return;
+
+            // the body ends at the closing brace, which must be separated from the pragma by whitespace
+            auto bodyEnd = text.size() - loopEnd.size();
+            const auto spaceEnd = bodyEnd;
+            while (bodyEnd > parser.pos && isSpace(text[bodyEnd - 1])) --bodyEnd;
+            if (bodyEnd == spaceEnd || bodyEnd == parser.pos || text[bodyEnd - 1] != '}') return;
+            --bodyEnd;
+
+            const std::string body(text.substr(parser.pos, bodyEnd - parser.pos));
+            if (body.empty()) return;
+
+            out.resize(out.size() - text.size());
+            appendUnrolled(out, body, start, end);
+        }
+    };
+
+}// namespace
+
+std::string shaders::preprocessShader(const std::string& source, const ShaderDefines& defines) {
+
+    Preprocessor preprocessor(&defines, true);
+    preprocessor.process(source);
+
+    return std::move(preprocessor.out);
+}
+
+std::string shaders::resolveIncludes(const std::string& source) {
+
+    Preprocessor preprocessor(nullptr, false);
+    preprocessor.process(source);
+
+    return std::move(preprocessor.out);
+}
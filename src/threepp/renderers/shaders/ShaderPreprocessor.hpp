@@ -0,0 +1,24 @@
+
+#ifndef THREEPP_SHADERPREPROCESSOR_HPP
+#define THREEPP_SHADERPREPROCESSOR_HPP
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace threepp::shaders {
+
+    // Identifiers substituted by a value, such as NUM_DIR_LIGHTS.
+    using ShaderDefines = std::vector<std::pair<std::string, std::string>>;
+
+    // Expands "#include <chunk>" directives, substitutes defines and unrolls
+    // "#pragma unroll_loop_start" loops with constant bounds, in a single pass over the source.
+    // Only whole identifiers are substituted. Included chunks are taken from ShaderChunk::resolved.
+    std::string preprocessShader(const std::string& source, const ShaderDefines& defines = {});
+
+    // Expands the "#include <chunk>" directives of source, recursively.
+    std::string resolveIncludes(const std::string& source);
+
+}// namespace threepp::shaders
+
+#endif//THREEPP_SHADERPREPROCESSOR_HPP
@@ -4,7 +4,7 @@
 using namespace threepp;
 
 
-DataTexture3D::DataTexture3D(const std::vector<unsigned char>& data,
+DataTexture3D::DataTexture3D(std::vector<unsigned char> data,
                              unsigned int width, unsigned int height, unsigned int depth)
     : Texture({}) {
 
@@ -16,7 +16,7 @@ DataTexture3D::DataTexture3D(const std::vector<unsigned char>& data,
     //
     // See #14839
 
-    this->image.emplace_back(Image{data, width, height, depth});
+    this->image.emplace_back(Image{std::move(data), width, height, depth});
 
     this->magFilter = Filter::Nearest;
     this->minFilter = Filter::Nearest;
@@ -30,8 +30,8 @@ DataTexture3D::DataTexture3D(const std::vector<unsigned char>& data,
 }
 
 std::shared_ptr<DataTexture3D> DataTexture3D::create(
-        const std::vector<unsigned char>& data,
+        std::vector<unsigned char> data,
         unsigned int width, unsigned int height, unsigned int depth) {
 
-    return std::shared_ptr<DataTexture3D>(new DataTexture3D(data, width, height, depth));
+    return std::shared_ptr<DataTexture3D>(new DataTexture3D(std::move(data), width, height, depth));
 }
@@ -0,0 +1,44 @@
+
+#ifndef THREEPP_CHARCONV_HPP
+#define THREEPP_CHARCONV_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+namespace threepp::utils {
+
+    // Parses the number at the start of text without allocating or throwing.
+    // Returns false when text does not start with a number, in which case value is left untouched.
+    inline bool fromChars(std::string_view text, float& value) {
+
+        if (!text.empty() && text.front() == '+') text.remove_prefix(1);
+        if (text.empty()) return false;
+
+#if defined(__cpp_lib_to_chars)
+        return std::from_chars(text.data(), text.data() + text.size(), value).ec == std::errc();
+#else
+        char buffer[64]{};
+        std::memcpy(buffer, text.data(), std::min(text.size(), sizeof(buffer) - 1));
+
+        char* end;
+        const auto result = std::strtof(buffer, &end);
+        if (end == buffer) return false;
+
+        value = result;
+        return true;
+#endif
+    }
+
+    inline bool fromChars(std::string_view text, int& value) {
+
+        if (!text.empty() && text.front() == '+') text.remove_prefix(1);
+
+        return std::from_chars(text.data(), text.data() + text.size(), value).ec == std::errc();
+    }
+
+}// namespace threepp::utils
+
+#endif//THREEPP_CHARCONV_HPP
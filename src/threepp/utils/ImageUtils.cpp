@@ -0,0 +1,115 @@
+
+#include "threepp/utils/ImageUtils.hpp"
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+using namespace threepp;
+
+namespace {
+
+    template<class T>
+    std::vector<T> downsample(PixelView<const T> src, unsigned int width, unsigned int height, unsigned int channels) {
+
+        const auto targetWidth = std::max(1u, width / 2);
+        const auto targetHeight = std::max(1u, height / 2);
+
+        std::vector<T> target(static_cast<size_t>(targetWidth) * targetHeight * channels);
+
+        for (unsigned y = 0; y < targetHeight; ++y) {
+
+            const auto row0 = src.data() + static_cast<size_t>(std::min(2 * y, height - 1)) * width * channels;
+            const auto row1 = src.data() + static_cast<size_t>(std::min(2 * y + 1, height - 1)) * width * channels;
+
+            auto out = target.data() + static_cast<size_t>(y) * targetWidth * channels;
+
+            for (unsigned x = 0; x < targetWidth; ++x) {
+
+                const auto x0 = std::min(2 * x, width - 1) * channels;
+                const auto x1 = std::min(2 * x + 1, width - 1) * channels;
+
+                for (unsigned c = 0; c < channels; ++c) {
+
+                    if constexpr (std::is_same_v<T, float>) {
+
+                        *out++ = 0.25f * (row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c]);
+
+                    } else {
+
+                        // rounded to nearest
+                        *out++ = static_cast<T>((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) / 4);
+                    }
+                }
+            }
+        }
+
+        return target;
+    }
+
+    template<class T>
+    std::vector<Image> generateChain(Image& image, unsigned int channels) {
+
+        std::vector<Image> mipmaps;
+        // the first level shares the pixels of image
+        mipmaps.push_back(image);
+
+        auto width = image.width;
+        auto height = image.height;
+
+        while (width > 1 || height > 1) {
+
+            auto data = downsample<T>(std::as_const(mipmaps.back()).template data<T>(), width, height, channels);
+
+            width = std::max(1u, width / 2);
+            height = std::max(1u, height / 2);
+
+            mipmaps.emplace_back(std::move(data), width, height, image.flipped());
+        }
+
+        return mipmaps;
+    }
+
+    unsigned int channelCount(Format format) {
+
+        switch (format) {
+            case Format::Alpha:
+            case Format::Luminance:
+            case Format::Red:
+                return 1;
+            case Format::LuminanceAlpha:
+            case Format::RG:
+                return 2;
+            case Format::RGB:
+                return 3;
+            case Format::RGBA:
+                return 4;
+            default:
+                return 0;
+        }
+    }
+
+}// namespace
+
+std::vector<Image> threepp::generateMipmaps(Image& image, unsigned int channels) {
+
+    if (image.holds<float>()) {
+
+        return generateChain<float>(image, channels);
+    }
+
+    return generateChain<unsigned char>(image, channels);
+}
+
+void threepp::generateMipmaps(Texture& texture) {
+
+    const auto channels = channelCount(texture.format);
+
+    if (texture.image.size() != 1 || channels == 0) return;
+    if (texture.type != Type::UnsignedByte && texture.type != Type::Float) return;
+
+    texture.mipmaps = generateMipmaps(texture.image.front(), channels);
+
+    // rows of the smaller levels are not 4 byte aligned
+    if (channels * (texture.type == Type::Float ? 4 : 1) % 4 != 0) texture.unpackAlignment = 1;
+}
@@ -1,19 +1,260 @@
 
-
 #include "threepp/utils/LoadGlad.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <string_view>
 
+namespace {
 
-void threepp::loadGlad() {
+    enum class Loaded {
+        None,
+        Null,
+        Context
+    };
+
+    Loaded loaded = Loaded::None;
+
+    GLuint nullNames = 0;
+
+    // a stub of the type of a glad entry point, which ignores its arguments and returns 0 if anything
+    template<class F>
+    struct NullFunction;
+
+    template<class R, class... Args>
+    struct NullFunction<R(APIENTRYP)(Args...)> {
+
+        static R APIENTRY call(Args...) {
+
+            return R();
+        }
+    };
+
+    const GLubyte* APIENTRY nullGetString(GLenum name) {
+
+        switch (name) {
+            case GL_VERSION:
+                return reinterpret_cast<const GLubyte*>("4.1 threepp null");
+            case GL_SHADING_LANGUAGE_VERSION:
+                return reinterpret_cast<const GLubyte*>("4.10");
+            default:
+                return reinterpret_cast<const GLubyte*>("threepp null");
+        }
+    }
+
+    // glad requires at least one extension of a GL 3+ context
+    const GLubyte* APIENTRY nullGetStringi(GLenum, GLuint) {
+
+        return reinterpret_cast<const GLubyte*>("GL_THREEPP_null");
+    }
+
+    void APIENTRY nullGetIntegerv(GLenum pname, GLint* data) {
+
+        switch (pname) {
+            case GL_VIEWPORT:
+            case GL_SCISSOR_BOX:
+                std::memset(data, 0, 4 * sizeof(GLint));
+                break;
+            case GL_MAJOR_VERSION:
+                *data = 4;
+                break;
+            case GL_MINOR_VERSION:
+            case GL_NUM_EXTENSIONS:
+                *data = 1;
+                break;
+            case GL_MAX_TEXTURE_SIZE:
+            case GL_MAX_CUBE_MAP_TEXTURE_SIZE:
+                *data = 16384;
+                break;
+            case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+                *data = 32;
+                break;
+            case GL_MAX_TEXTURE_IMAGE_UNITS:
+            case GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS:
+            case GL_MAX_VERTEX_ATTRIBS:
+                *data = 16;
+                break;
+            case GL_MAX_VERTEX_UNIFORM_VECTORS:
+            case GL_MAX_FRAGMENT_UNIFORM_VECTORS:
+                *data = 1024;
+                break;
+            case GL_MAX_VARYING_VECTORS:
+                *data = 30;
+                break;
+            case GL_MAX_SAMPLES:
+                *data = 4;
+                break;
+            case GL_NUM_PROGRAM_BINARY_FORMATS:
+                *data = 1;
+                break;
+            default:
+                *data = 0;
+                break;
+        }
+    }
+
+    void APIENTRY nullGetFloatv(GLenum pname, GLfloat* data) {
+
+        *data = pname == GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT ? 16.f : 0.f;
+    }
+
+    constexpr GLsizei nullProgramBinaryLength = 16;
+
+    void APIENTRY nullGetProgramiv(GLuint, GLenum pname, GLint* params) {
+
+        switch (pname) {
+            case GL_LINK_STATUS:
+            case GL_VALIDATE_STATUS:
+                *params = 1;
+                break;
+            case GL_PROGRAM_BINARY_LENGTH:
+                *params = nullProgramBinaryLength;
+                break;
+            default:
+                *params = 0;
+                break;
+        }
+    }
+
+    void APIENTRY nullGetProgramBinary(GLuint, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary) {
+
+        const auto size = std::min(bufSize, nullProgramBinaryLength);
+        std::memset(binary, 0, size);
+
+        if (length) *length = size;
+        *binaryFormat = 1;
+    }
+
+    void APIENTRY nullGetShaderiv(GLuint, GLenum pname, GLint* params) {
+
+        *params = pname == GL_COMPILE_STATUS ? 1 : 0;
+    }
+
+    void APIENTRY nullGenNames(GLsizei n, GLuint* names) {
+
+        for (GLsizei i = 0; i < n; ++i) {
+            names[i] = ++nullNames;
+        }
+    }
+
+    GLuint APIENTRY nullCreateProgram() {
+
+        return ++nullNames;
+    }
 
-    static bool gladInitialized = false;
+    GLuint APIENTRY nullCreateShader(GLenum) {
 
-    if (!gladInitialized) {
+        return ++nullNames;
+    }
+
+    GLint APIENTRY nullGetLocation(GLuint, const GLchar*) {
+
+        return -1;
+    }
+
+    GLuint APIENTRY nullGetUniformBlockIndex(GLuint, const GLchar*) {
+
+        return GL_INVALID_INDEX;
+    }
+
+    GLenum APIENTRY nullCheckFramebufferStatus(GLenum) {
+
+        return GL_FRAMEBUFFER_COMPLETE;
+    }
+
+    GLenum APIENTRY nullClientWaitSync(GLsync, GLbitfield, GLuint64) {
+
+        return GL_ALREADY_SIGNALED;
+    }
+
+    // the entry points used by threepp that do nothing, and so need no stub of their own
+#define THREEPP_NULL_GL_ENTRY_POINTS(X) \
+    X(glActiveTexture) X(glAttachShader) X(glBindAttribLocation) X(glBindBuffer) X(glBindBufferBase) \
+    X(glBindFramebuffer) X(glBindRenderbuffer) X(glBindTexture) X(glBindVertexArray) X(glBlendEquation) \
+    X(glBlendEquationSeparate) X(glBlendFunc) X(glBlendFuncSeparate) X(glBlitFramebuffer) X(glBufferData) \
+    X(glBufferSubData) X(glClear) X(glClearColor) X(glClearDepth) X(glClearStencil) X(glColorMask) \
+    X(glCompileShader) X(glCompressedTexImage2D) X(glCopyTexSubImage2D) X(glCullFace) X(glDeleteBuffers) \
+    X(glDeleteFramebuffers) X(glDeleteProgram) X(glDeleteRenderbuffers) X(glDeleteShader) X(glDeleteTextures) \
+    X(glDeleteVertexArrays) X(glDepthFunc) X(glDepthMask) X(glDisable) X(glDisableVertexAttribArray) \
+    X(glDrawArrays) X(glDrawArraysInstanced) X(glDrawBuffers) X(glDrawElements) X(glDrawElementsInstanced) \
+    X(glEnable) X(glEnableVertexAttribArray) X(glFramebufferRenderbuffer) X(glFramebufferTexture2D) \
+    X(glFrontFace) X(glGenerateMipmap) X(glGetActiveAttrib) X(glGetActiveUniform) X(glGetProgramInfoLog) \
+    X(glGetShaderInfoLog) X(glLineWidth) X(glLinkProgram) X(glMultiDrawArrays) X(glMultiDrawElements) \
+    X(glPixelStorei) X(glPolygonOffset) X(glProgramBinary) X(glProgramParameteri) X(glReadPixels) \
+    X(glRenderbufferStorage) X(glScissor) X(glShaderSource) X(glStencilFunc) X(glStencilMask) X(glStencilOp) \
+    X(glTexImage2D) X(glTexImage3D) X(glTexParameteri) X(glUniform1f) X(glUniform1fv) X(glUniform1i) \
+    X(glUniform1iv) X(glUniform2f) X(glUniform2fv) X(glUniform3f) X(glUniform3fv) X(glUniform4f) \
+    X(glUniform4fv) X(glUniformBlockBinding) X(glUniformMatrix3fv) X(glUniformMatrix4fv) X(glUseProgram) \
+    X(glVertexAttribDivisor) X(glVertexAttribIPointer) X(glVertexAttribPointer) X(glViewport)
+
+    template<class F>
+    void* entryPoint(F f) {
+
+        return reinterpret_cast<void*>(f);
+    }
+
+    void* nullLoader(const char* name) {
+
+        const std::string_view fn(name);
+
+        if (fn == "glGetString") return entryPoint(&nullGetString);
+        if (fn == "glGetStringi") return entryPoint(&nullGetStringi);
+        if (fn == "glGetIntegerv") return entryPoint(&nullGetIntegerv);
+        if (fn == "glGetFloatv") return entryPoint(&nullGetFloatv);
+        if (fn == "glGetProgramiv") return entryPoint(&nullGetProgramiv);
+        if (fn == "glGetShaderiv") return entryPoint(&nullGetShaderiv);
+        if (fn == "glGetProgramBinary") return entryPoint(&nullGetProgramBinary);
+        if (fn.rfind("glGen", 0) == 0 && fn != "glGenerateMipmap") return entryPoint(&nullGenNames);
+        if (fn == "glCreateProgram") return entryPoint(&nullCreateProgram);
+        if (fn == "glCreateShader") return entryPoint(&nullCreateShader);
+        if (fn == "glGetUniformLocation" || fn == "glGetAttribLocation" || fn == "glGetFragDataLocation") return entryPoint(&nullGetLocation);
+        if (fn == "glGetUniformBlockIndex") return entryPoint(&nullGetUniformBlockIndex);
+        if (fn == "glCheckFramebufferStatus") return entryPoint(&nullCheckFramebufferStatus);
+        if (fn == "glClientWaitSync") return entryPoint(&nullClientWaitSync);
+
+        // left null, so that an entry point without a stub fails where it is called
+        return nullptr;
+    }
+
+    void loadNullFunctions() {
+
+#define THREEPP_NULL_GL_ENTRY_POINT(name) \
+    if (!glad_##name) glad_##name = &NullFunction<decltype(glad_##name)>::call;
+
+        THREEPP_NULL_GL_ENTRY_POINTS(THREEPP_NULL_GL_ENTRY_POINT)
+
+#undef THREEPP_NULL_GL_ENTRY_POINT
+    }
+
+}// namespace
+
+
+void threepp::loadGlad() {
+
+    if (loaded != Loaded::Context) {
         if (!gladLoadGL()) {
             std::cerr << "Failed to initialize GLAD" << std::endl;
             exit(EXIT_FAILURE);
         }
-        gladInitialized = true;
+        loaded = Loaded::Context;
     }
 }
+
+void threepp::ensureGladLoaded() {
+
+    if (loaded == Loaded::None) loadGlad();
+}
+
+bool threepp::loadNullGL() {
+
+    // the entry points of a context loaded before are replaced, so loadGlad loads them again
+    loaded = Loaded::None;
+
+    if (!gladLoadGLLoader(&nullLoader)) return false;
+
+    loadNullFunctions();
+    loaded = Loaded::Null;
+
+    return true;
+}
@@ -7,7 +7,18 @@
 
 namespace threepp {
 
+    // Loads the entry points of the current context, unless they are loaded already.
     void loadGlad();
+
+    // Loads the entry points of the current context, unless these or the null ones are loaded already.
+    void ensureGladLoaded();
+
+    // Loads entry points that do nothing and need no GL context, so that the CPU side of the renderer
+    // can be benchmarked and tested headless. Queries report a GL 4.1 context where every object
+    // is created, every shader compiles and links, every program binary is accepted,
+    // and no program has any active uniforms or attributes.
+    // Only the entry points threepp uses are loaded. A later call to loadGlad loads those of the current context.
+    bool loadNullGL();
 }
 
 #endif//THREEPP_LOAD_GLAD_HPP
@@ -0,0 +1,148 @@
+
+#include "threepp/utils/MemoryMappedFile.hpp"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif !defined(EMSCRIPTEN)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <fstream>
+#include <vector>
+
+using namespace threepp::utils;
+
+#if defined(_WIN32)
+
+struct MemoryMappedFile::Impl {
+
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+    const char* data = nullptr;
+    size_t size = 0;
+    bool valid = false;
+
+    explicit Impl(const std::filesystem::path& path) {
+
+        file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize)) return;
+
+        size = static_cast<size_t>(fileSize.QuadPart);
+        valid = true;
+
+        // empty files cannot be mapped
+        if (size == 0) return;
+
+        mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            valid = false;
+            return;
+        }
+
+        data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        valid = data != nullptr;
+    }
+
+    ~Impl() {
+
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+    }
+};
+
+#elif !defined(EMSCRIPTEN)
+
+struct MemoryMappedFile::Impl {
+
+    int fd = -1;
+    const char* data = nullptr;
+    size_t size = 0;
+    bool valid = false;
+
+    explicit Impl(const std::filesystem::path& path) {
+
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1) return;
+
+        struct stat st {};
+        if (fstat(fd, &st) == -1) return;
+
+        size = static_cast<size_t>(st.st_size);
+        valid = true;
+
+        // empty files cannot be mapped
+        if (size == 0) return;
+
+        auto mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            valid = false;
+            return;
+        }
+
+        data = static_cast<const char*>(mapped);
+        madvise(mapped, size, MADV_SEQUENTIAL);
+    }
+
+    ~Impl() {
+
+        if (data) munmap(const_cast<char*>(data), size);
+        if (fd != -1) ::close(fd);
+    }
+};
+
+#else
+
+struct MemoryMappedFile::Impl {
+
+    std::vector<char> buffer;
+    const char* data = nullptr;
+    size_t size = 0;
+    bool valid = false;
+
+    explicit Impl(const std::filesystem::path& path) {
+
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) return;
+
+        size = static_cast<size_t>(file.tellg());
+        buffer.resize(size);
+
+        file.seekg(0);
+        file.read(buffer.data(), static_cast<std::streamsize>(size));
+
+        data = buffer.data();
+        valid = static_cast<bool>(file);
+    }
+};
+
+#endif
+
+MemoryMappedFile::MemoryMappedFile(const std::filesystem::path& path)
+    : pimpl_(std::make_unique<Impl>(path)) {}
+
+bool MemoryMappedFile::valid() const {
+
+    return pimpl_->valid;
+}
+
+const char* MemoryMappedFile::data() const {
+
+    return pimpl_->data;
+}
+
+size_t MemoryMappedFile::size() const {
+
+    return pimpl_->size;
+}
+
+MemoryMappedFile::~MemoryMappedFile() = default;
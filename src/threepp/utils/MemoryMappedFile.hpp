@@ -0,0 +1,36 @@
+
+#ifndef THREEPP_MEMORYMAPPEDFILE_HPP
+#define THREEPP_MEMORYMAPPEDFILE_HPP
+
+#include <filesystem>
+#include <memory>
+
+namespace threepp::utils {
+
+    // Read-only view of the content of a file.
+    // The file is memory-mapped where supported, and read into memory otherwise.
+    class MemoryMappedFile {
+
+    public:
+        explicit MemoryMappedFile(const std::filesystem::path& path);
+
+        MemoryMappedFile(const MemoryMappedFile&) = delete;
+        MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+        // Whether the file could be opened.
+        [[nodiscard]] bool valid() const;
+
+        [[nodiscard]] const char* data() const;
+
+        [[nodiscard]] size_t size() const;
+
+        ~MemoryMappedFile();
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> pimpl_;
+    };
+
+}// namespace threepp::utils
+
+#endif//THREEPP_MEMORYMAPPEDFILE_HPP
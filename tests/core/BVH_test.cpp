@@ -0,0 +1,217 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "threepp/core/Raycaster.hpp"
+#include "threepp/geometries/PlaneGeometry.hpp"
+#include "threepp/geometries/SphereGeometry.hpp"
+#include "threepp/geometries/TorusKnotGeometry.hpp"
+#include "threepp/materials/MeshBasicMaterial.hpp"
+#include "threepp/math/MathUtils.hpp"
+#include "threepp/objects/Mesh.hpp"
+
+#include <algorithm>
+
+using namespace threepp;
+
+namespace {
+
+    std::vector<Ray> randomRays(size_t count) {
+
+        std::vector<Ray> rays;
+        for (size_t i = 0; i < count; ++i) {
+            Vector3 origin(math::randFloat(-10, 10), math::randFloat(-10, 10), math::randFloat(-10, 10));
+            Vector3 target(math::randFloat(-1, 1), math::randFloat(-1, 1), math::randFloat(-1, 1));
+            rays.emplace_back(origin, (target - origin).normalize());
+        }
+
+        return rays;
+    }
+
+    std::vector<std::pair<int, float>> hits(Raycaster& raycaster, Mesh& mesh, const Ray& ray) {
+
+        raycaster.ray = ray;
+
+        std::vector<std::pair<int, float>> result;
+        for (const auto& intersection : raycaster.intersectObject(mesh)) {
+            result.emplace_back(*intersection.faceIndex, intersection.distance);
+        }
+        std::sort(result.begin(), result.end());
+
+        return result;
+    }
+
+    void checkAgainstBruteForce(Mesh& mesh, size_t numRays) {
+
+        auto geometry = mesh.geometry();
+
+        Raycaster raycaster;
+        size_t numHits = 0;
+
+        for (const auto& ray : randomRays(numRays)) {
+
+            geometry->disposeBoundsTree();
+            const auto expected = hits(raycaster, mesh, ray);
+
+            geometry->computeBoundsTree();
+            const auto actual = hits(raycaster, mesh, ray);
+
+            REQUIRE(expected == actual);
+            numHits += actual.size();
+        }
+
+        CHECK(numHits > 0);
+    }
+
+}// namespace
+
+TEST_CASE("BVH structure") {
+
+    auto geometry = TorusKnotGeometry::create(1, 0.4f, 64, 8);
+    geometry->computeBoundsTree();
+
+    const auto bvh = geometry->boundsTree();
+    REQUIRE(bvh);
+
+    const auto numTriangles = geometry->getIndex()->count() / 3;
+    auto triangles = bvh->triangles();
+    REQUIRE(triangles.size() == numTriangles);
+
+    std::sort(triangles.begin(), triangles.end());
+    for (unsigned i = 0; i < numTriangles; ++i) {
+        REQUIRE(triangles[i] == i);
+    }
+
+    size_t leafTriangles = 0;
+    for (const auto& node : bvh->nodes()) {
+        if (node.isLeaf()) {
+            CHECK(node.count <= bvh->maxLeafSize());
+            leafTriangles += node.count;
+        }
+    }
+    CHECK(leafTriangles == numTriangles);
+}
+
+TEST_CASE("BVH raycast matches brute force") {
+
+    SECTION("indexed") {
+
+        Mesh mesh(TorusKnotGeometry::create(1, 0.4f, 64, 8));
+        mesh.position.set(0.5f, 0, 0);
+        mesh.scale.set(2, 1, 1);
+        mesh.updateMatrixWorld();
+
+        checkAgainstBruteForce(mesh, 200);
+    }
+
+    SECTION("non-indexed") {
+
+        Mesh mesh(SphereGeometry::create(2, 32, 16)->toNonIndexed());
+        mesh.updateMatrixWorld();
+
+        checkAgainstBruteForce(mesh, 200);
+    }
+
+    SECTION("groups") {
+
+        auto geometry = SphereGeometry::create(2, 32, 16);
+        const auto count = geometry->getIndex()->count();
+        geometry->addGroup(0, count / 2, 0);
+        geometry->addGroup(count / 2, count - count / 2, 1);
+
+        Mesh mesh(geometry, std::vector<std::shared_ptr<Material>>{MeshBasicMaterial::create(), MeshBasicMaterial::create()});
+        mesh.updateMatrixWorld();
+
+        checkAgainstBruteForce(mesh, 200);
+    }
+}
+
+TEST_CASE("BVH is refitted when positions change") {
+
+    auto geometry = SphereGeometry::create(1, 16, 8);
+    Mesh mesh(geometry);
+    mesh.updateMatrixWorld();
+
+    geometry->computeBoundsTree();
+    const auto bvh = geometry->boundsTree();
+
+    geometry->scale(3, 3, 3);
+    geometry->computeBoundingSphere();
+
+    // the ray misses the unit sphere but hits the scaled one
+    Raycaster raycaster({2, 0, -10}, {0, 0, 1});
+    CHECK(raycaster.intersectObject(mesh).size() == 1);
+    CHECK(geometry->boundsTree() == bvh);
+}
+
+TEST_CASE("BVH raycast with axis aligned rays") {
+
+    // node bounds meet at x = 0 and y = 0, and are flat in z
+    Mesh mesh(PlaneGeometry::create(2, 2, 4, 4));
+    mesh.updateMatrixWorld();
+
+    auto geometry = mesh.geometry();
+    geometry->computeBoundsTree();
+
+    Raycaster raycaster;
+    for (const auto& origin : {Vector3(0, 0, 5), Vector3(0, 0.25f, 5), Vector3(0.5f, 0, 5), Vector3(-0.5f, 0.5f, 5)}) {
+
+        const Ray ray(origin, {0, 0, -1});
+
+        geometry->disposeBoundsTree();
+        const auto expected = hits(raycaster, mesh, ray);
+
+        geometry->computeBoundsTree();
+        const auto actual = hits(raycaster, mesh, ray);
+
+        CHECK(!expected.empty());
+        CHECK(expected == actual);
+    }
+
+    // parallel to the plane, from within its bounds
+    raycaster.ray.set({-5, 0, 0}, {1, 0, 0});
+    CHECK(raycaster.intersectObject(mesh).empty());
+}
+
+TEST_CASE("BVH is rebuilt when attributes are replaced") {
+
+    auto geometry = SphereGeometry::create(1, 16, 8);
+    Mesh mesh(geometry);
+    mesh.updateMatrixWorld();
+
+    geometry->computeBoundsTree(8);
+    const auto bvh = geometry->boundsTree();
+    const auto version = geometry->attributesVersion();
+
+    auto position = geometry->getAttribute<float>("position")->clone();
+    for (auto& value : position->array()) value *= 3;
+    geometry->setAttribute("position", std::move(position));
+    geometry->computeBoundingSphere();
+
+    CHECK(geometry->attributesVersion() != version);
+
+    Raycaster raycaster({2, 0, -10}, {0, 0, 1});
+    CHECK(raycaster.intersectObject(mesh).size() == 1);
+
+    // rebuilt with the same settings
+    CHECK(geometry->boundsTree() != bvh);
+    CHECK(geometry->boundsTree()->maxLeafSize() == 8);
+}
+
+TEST_CASE("BVH raycast benchmark", "[.benchmark]") {
+
+    Mesh mesh(SphereGeometry::create(1, 256, 128));
+    mesh.updateMatrixWorld();
+
+    auto geometry = mesh.geometry();
+    Raycaster raycaster({0.1f, 0.2f, -10}, {0, 0, 1});
+
+    BENCHMARK("brute force") {
+        geometry->disposeBoundsTree();
+        return raycaster.intersectObject(mesh);
+    };
+
+    geometry->computeBoundsTree();
+    BENCHMARK("bvh") {
+        return raycaster.intersectObject(mesh);
+    };
+}
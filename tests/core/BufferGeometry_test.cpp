@@ -0,0 +1,189 @@
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "threepp/geometries/BoxGeometry.hpp"
+#include "threepp/geometries/PlaneGeometry.hpp"
+#include "threepp/geometries/SphereGeometry.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+using namespace threepp;
+
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+    // threads may add up the values of a vertex in another order
+    void checkClose(const std::vector<float>& actual, const std::vector<float>& expected) {
+
+        REQUIRE(actual.size() == expected.size());
+        for (size_t i = 0; i < actual.size(); ++i) {
+
+            CHECK_THAT(actual[i], WithinAbs(expected[i], 1e-5));
+        }
+    }
+
+    // computeVertexNormals before it worked on the arrays, through the attribute accessors
+    void accessorNormals(BufferGeometry& geometry) {
+
+        const auto index = geometry.getIndex();
+        const auto position = geometry.getAttribute<float>("position");
+        const auto normal = geometry.getAttribute<float>("normal");
+
+        for (int i = 0; i < normal->count(); i++) normal->setXYZ(i, 0, 0, 0);
+
+        Vector3 pA, pB, pC, nA, nB, nC, cb, ab;
+        for (int i = 0; i < index->count(); i += 3) {
+
+            const auto vA = index->getX(i), vB = index->getX(i + 1), vC = index->getX(i + 2);
+
+            position->setFromBufferAttribute(pA, vA);
+            position->setFromBufferAttribute(pB, vB);
+            position->setFromBufferAttribute(pC, vC);
+
+            cb.subVectors(pC, pB);
+            ab.subVectors(pA, pB);
+            cb.cross(ab);
+
+            normal->setFromBufferAttribute(nA, vA);
+            normal->setFromBufferAttribute(nB, vB);
+            normal->setFromBufferAttribute(nC, vC);
+
+            nA.add(cb);
+            nB.add(cb);
+            nC.add(cb);
+
+            normal->setXYZ(vA, nA.x, nA.y, nA.z);
+            normal->setXYZ(vB, nB.x, nB.y, nB.z);
+            normal->setXYZ(vC, nC.x, nC.y, nC.z);
+        }
+
+        geometry.normalizeNormals();
+    }
+
+}// namespace
+
+TEST_CASE("Smooth normals of indexed geometries") {
+
+    auto geometry = SphereGeometry::create(1, 64, 32);
+    const auto expected = geometry->getAttribute<float>("normal")->array();
+
+    geometry->computeVertexNormals(1);
+    const auto normals = geometry->getAttribute<float>("normal")->array();
+
+    // the vertices away from the poles and the seam are shared by their triangles
+    const auto positions = geometry->getAttribute<float>("position");
+    for (unsigned i = 0; i < positions->count(); ++i) {
+
+        const auto y = positions->getY(i);
+        if (std::abs(y) > 0.9f || positions->getX(i) == 0 && positions->getZ(i) <= 0) continue;
+
+        const auto dot = normals[i * 3] * expected[i * 3] + normals[i * 3 + 1] * expected[i * 3 + 1] + normals[i * 3 + 2] * expected[i * 3 + 2];
+        CHECK_THAT(dot, WithinAbs(1, 1e-2));
+    }
+
+    for (auto threadCount : {2u, 3u, 8u}) {
+
+        geometry->computeVertexNormals(threadCount);
+        checkClose(geometry->getAttribute<float>("normal")->array(), normals);
+    }
+}
+
+TEST_CASE("Flat normals of non-indexed geometries") {
+
+    auto geometry = BoxGeometry::create()->toNonIndexed();
+    const auto expected = geometry->getAttribute<float>("normal")->array();
+
+    for (auto threadCount : {1u, 4u}) {
+
+        geometry->computeVertexNormals(threadCount);
+        CHECK(geometry->getAttribute<float>("normal")->array() == expected);
+    }
+}
+
+TEST_CASE("Degenerate triangles leave zero normals") {
+
+    auto geometry = BufferGeometry::create();
+    geometry->setAttribute("position", FloatBufferAttribute::create(std::vector<float>{0, 0, 0, 1, 0, 0, 2, 0, 0}, 3));
+    geometry->setIndex(std::vector<unsigned int>{0, 1, 2});
+
+    geometry->computeVertexNormals();
+    CHECK(geometry->getAttribute<float>("normal")->array() == std::vector<float>(9));
+}
+
+TEST_CASE("Tangents follow the uvs") {
+
+    auto geometry = PlaneGeometry::create(2, 2, 4, 4);
+    geometry->computeTangents();
+
+    const auto tangents = geometry->getAttribute<float>("tangent");
+    REQUIRE(tangents);
+    REQUIRE(tangents->count() == geometry->getAttribute<float>("position")->count());
+
+    for (unsigned i = 0; i < tangents->count(); ++i) {
+
+        CHECK_THAT(tangents->getX(i), WithinAbs(1, 1e-6));
+        CHECK_THAT(tangents->getY(i), WithinAbs(0, 1e-6));
+        CHECK_THAT(tangents->getZ(i), WithinAbs(0, 1e-6));
+        CHECK(tangents->getW(i) == 1);
+    }
+
+    // mirrored uvs flip the handedness
+    auto uvs = geometry->getAttribute<float>("uv");
+    for (unsigned i = 0; i < uvs->count(); ++i) uvs->setX(i, 1 - uvs->getX(i));
+
+    geometry->computeTangents();
+    CHECK_THAT(tangents->getX(0), WithinAbs(-1, 1e-6));
+    CHECK(tangents->getW(0) == -1);
+}
+
+TEST_CASE("Tangents do not depend on the number of threads") {
+
+    auto geometry = SphereGeometry::create(1, 64, 32);
+
+    geometry->computeTangents(1);
+    const auto tangents = geometry->getAttribute<float>("tangent")->array();
+
+    for (auto threadCount : {2u, 5u}) {
+
+        geometry->computeTangents(threadCount);
+        checkClose(geometry->getAttribute<float>("tangent")->array(), tangents);
+    }
+}
+
+TEST_CASE("Normals and tangents benchmark", "[.benchmark]") {
+
+    const auto threads = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "hardware threads: " << threads << std::endl;
+
+    // about 5.2M and 130k triangles, the smaller one is left to a single thread by default
+    for (const auto& [widthSegments, heightSegments] : {std::pair{2048u, 1280u}, std::pair{256u, 256u}}) {
+
+        auto geometry = SphereGeometry::create(1, widthSegments, heightSegments);
+        std::cout << geometry->getIndex()->count() / 3 << " triangles" << std::endl;
+
+        BENCHMARK("normals, accessors") {
+            accessorNormals(*geometry);
+        };
+
+        BENCHMARK("normals, 1 thread") {
+            geometry->computeVertexNormals(1);
+        };
+
+        BENCHMARK("normals, hardware threads") {
+            geometry->computeVertexNormals(threads);
+        };
+
+        BENCHMARK("tangents, 1 thread") {
+            geometry->computeTangents(1);
+        };
+
+        BENCHMARK("tangents, hardware threads") {
+            geometry->computeTangents(threads);
+        };
+    }
+}
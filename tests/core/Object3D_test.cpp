@@ -3,6 +3,8 @@
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
 #include "threepp/core/Object3D.hpp"
+#include "threepp/helpers/PointLightHelper.hpp"
+#include "threepp/lights/PointLight.hpp"
 #include "threepp/math/Euler.hpp"
 #include "threepp/math/MathUtils.hpp"
 #include "threepp/math/Matrix3.hpp"
@@ -425,3 +427,66 @@ TEST_CASE("updateWorldMatrix") {
 
     REQUIRE(object->matrixWorld->elements == m.setPosition(parent->position).elements);
 }
+
+TEST_CASE("updateMatrixWorld only updates changed subtrees") {
+
+    auto root = Object3D::create();
+    auto a = Object3D::create();
+    auto b = Object3D::create();
+    auto c = Object3D::create();
+    root->add(a);
+    root->add(b);
+    b->add(c);
+
+    root->updateMatrixWorld();
+
+    auto count = Object3D::matrixWorldUpdateCount();
+    root->updateMatrixWorld();
+    CHECK(Object3D::matrixWorldUpdateCount() - count == 0);
+
+    b->position.x = 2;
+    c->position.y = 1;
+
+    count = Object3D::matrixWorldUpdateCount();
+    root->updateMatrixWorld();
+    CHECK(Object3D::matrixWorldUpdateCount() - count == 2);
+    CHECK(Vector3().setFromMatrixPosition(*c->matrixWorld).distanceTo({2, 1, 0}) < eps);
+
+    b->rotation.z = math::PI / 2;
+
+    count = Object3D::matrixWorldUpdateCount();
+    root->updateMatrixWorld();
+    CHECK(Object3D::matrixWorldUpdateCount() - count == 2);
+    CHECK(Vector3().setFromMatrixPosition(*c->matrixWorld).distanceTo({1, 0, 0}) < eps);
+
+    // reparenting picks up the new parent transform
+    a->position.x = 5;
+    root->updateMatrixWorld();
+    a->add(c);
+
+    count = Object3D::matrixWorldUpdateCount();
+    root->updateMatrixWorld();
+    CHECK(Object3D::matrixWorldUpdateCount() - count == 1);
+    CHECK(Vector3().setFromMatrixPosition(*c->matrixWorld).distanceTo({5, 1, 0}) < eps);
+
+    // force updates everything
+    count = Object3D::matrixWorldUpdateCount();
+    root->updateMatrixWorld(true);
+    CHECK(Object3D::matrixWorldUpdateCount() - count == 4);
+}
+
+TEST_CASE("updateMatrixWorld follows the matrix source of helpers") {
+
+    auto scene = Object3D::create();
+    auto light = PointLight::create();
+    auto helper = PointLightHelper::create(*light, 1);
+    scene->add(light);
+    scene->add(helper);
+
+    scene->updateMatrixWorld();
+
+    light->position.x = 5;
+    scene->updateMatrixWorld();
+
+    CHECK(Vector3().setFromMatrixPosition(*helper->matrixWorld).distanceTo({5, 0, 0}) < eps);
+}
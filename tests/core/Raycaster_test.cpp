@@ -0,0 +1,226 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "threepp/core/Raycaster.hpp"
+#include "threepp/geometries/BoxGeometry.hpp"
+#include "threepp/geometries/SphereGeometry.hpp"
+#include "threepp/geometries/TorusKnotGeometry.hpp"
+#include "threepp/materials/MeshBasicMaterial.hpp"
+#include "threepp/math/MathUtils.hpp"
+#include "threepp/objects/Group.hpp"
+#include "threepp/objects/InstancedMesh.hpp"
+#include "threepp/objects/Line.hpp"
+#include "threepp/objects/Mesh.hpp"
+#include "threepp/objects/Points.hpp"
+#include "threepp/utils/ThreadPool.hpp"
+
+#include <thread>
+
+using namespace threepp;
+
+namespace {
+
+    std::vector<Ray> randomRays(size_t count) {
+
+        std::vector<Ray> rays;
+        for (size_t i = 0; i < count; ++i) {
+            Vector3 origin(math::randFloat(-10, 10), math::randFloat(-10, 10), math::randFloat(-10, 10));
+            Vector3 target(math::randFloat(-2, 2), math::randFloat(-2, 2), math::randFloat(-2, 2));
+            rays.emplace_back(origin, (target - origin).normalize());
+        }
+
+        return rays;
+    }
+
+    std::shared_ptr<Group> createScene() {
+
+        auto group = Group::create();
+
+        auto knot = Mesh::create(TorusKnotGeometry::create(1, 0.4f, 64, 8));
+        knot->geometry()->computeBoundsTree();
+        group->add(knot);
+
+        auto sphere = Mesh::create(SphereGeometry::create(1, 32, 16));
+        sphere->position.set(2, 1, 0);
+        group->add(sphere);
+
+        auto instanced = InstancedMesh::create(BoxGeometry::create(0.5f, 0.5f, 0.5f), MeshBasicMaterial::create(), 8);
+        for (unsigned i = 0; i < instanced->count; ++i) {
+            Matrix4 m;
+            m.makeTranslation(math::randFloat(-2, 2), math::randFloat(-2, 2), math::randFloat(-2, 2));
+            instanced->setMatrixAt(i, m);
+        }
+        group->add(instanced);
+
+        auto points = Points::create(SphereGeometry::create(1.5f, 8, 4));
+        group->add(points);
+
+        auto line = Line::create(TorusKnotGeometry::create(1.5f, 0.1f, 32, 3));
+        group->add(line);
+
+        group->updateMatrixWorld();
+
+        return group;
+    }
+
+    bool sameIntersections(const std::vector<Intersection>& a, const std::vector<Intersection>& b) {
+
+        if (a.size() != b.size()) return false;
+
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i].object != b[i].object || a[i].distance != b[i].distance ||
+                a[i].faceIndex != b[i].faceIndex || a[i].index != b[i].index || a[i].instanceId != b[i].instanceId) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+}// namespace
+
+TEST_CASE("batched raycast matches per-ray raycast") {
+
+    auto scene = createScene();
+    const std::vector<Object3D*> objects{scene.get()};
+
+    const auto rays = randomRays(500);
+
+    Raycaster raycaster;
+    raycaster.params.pointsThreshold = 0.1f;
+    raycaster.params.lineThreshold = 0.1f;
+
+    std::vector<std::vector<Intersection>> expected;
+    for (const auto& ray : rays) {
+        raycaster.ray = ray;
+        expected.emplace_back(raycaster.intersectObjects(objects, true));
+    }
+
+    size_t numHits = 0;
+    for (const auto& intersects : expected) numHits += intersects.size();
+    REQUIRE(numHits > 0);
+
+    SECTION("temporary pool") {
+
+        const auto actual = raycaster.intersectObjects(rays, objects, true);
+
+        REQUIRE(actual.size() == rays.size());
+        for (size_t i = 0; i < rays.size(); ++i) {
+            CHECK(sameIntersections(expected[i], actual[i]));
+        }
+    }
+
+    SECTION("external pool") {
+
+        utils::ThreadPool pool(4);
+        raycaster.batchSize = 7;
+        const auto actual = raycaster.intersectObjects(rays, objects, true, &pool);
+
+        REQUIRE(actual.size() == rays.size());
+        for (size_t i = 0; i < rays.size(); ++i) {
+            CHECK(sameIntersections(expected[i], actual[i]));
+        }
+    }
+
+    SECTION("not recursive") {
+
+        const auto actual = raycaster.intersectObjects(rays, objects, false);
+
+        for (const auto& intersects : actual) {
+            CHECK(intersects.empty());
+        }
+    }
+}
+
+TEST_CASE("raycast through a bounds tree matches raycast without one") {
+
+    const auto doubleSided = [] {
+        // triangles drawn from an offset in between may be wound either way
+        auto material = MeshBasicMaterial::create();
+        material->side = Side::Double;
+        return material;
+    };
+
+    auto geometry = TorusKnotGeometry::create(1, 0.4f, 64, 8);
+    auto mesh = Mesh::create(geometry, doubleSided());
+    mesh->updateMatrixWorld();
+
+    const auto rays = randomRays(300);
+
+    Raycaster raycaster;
+
+    const auto intersect = [&](bool boundsTree) {
+        if (boundsTree) {
+            geometry->computeBoundsTree();
+        } else {
+            geometry->disposeBoundsTree();
+        }
+
+        std::vector<std::vector<Intersection>> result;
+        for (const auto& ray : rays) {
+            raycaster.ray = ray;
+            result.emplace_back(raycaster.intersectObject(*mesh));
+        }
+
+        return result;
+    };
+
+    const auto check = [&](int start) {
+        INFO("start " << start);
+
+        const auto expected = intersect(false);
+        const auto actual = intersect(true);
+
+        size_t numHits = 0;
+        for (size_t i = 0; i < rays.size(); ++i) {
+            numHits += expected[i].size();
+            CHECK(sameIntersections(expected[i], actual[i]));
+        }
+        CHECK(numHits > 0);
+    };
+
+    const auto count = geometry->getIndex()->count();
+
+    for (int start : {0, 2, 300, 302}) {
+
+        geometry->setDrawRange(start, count / 2 + 1);
+        check(start);
+    }
+
+    geometry->setDrawRange(0, count);
+    mesh->setMaterials({doubleSided(), doubleSided()});
+
+    for (int start : {0, 3, 4}) {
+
+        geometry->clearGroups();
+        geometry->addGroup(start, count / 3, 0);
+        geometry->addGroup(count / 2, count, 1);
+        check(start);
+    }
+}
+
+TEST_CASE("batched raycast benchmark", "[.benchmark]") {
+
+    auto mesh = Mesh::create(SphereGeometry::create(1, 256, 128));
+    mesh->updateMatrixWorld();
+    mesh->geometry()->computeBoundsTree();
+
+    const std::vector<Object3D*> objects{mesh.get()};
+    const auto rays = randomRays(100000);
+
+    Raycaster raycaster;
+    utils::ThreadPool pool(std::thread::hardware_concurrency());
+
+    BENCHMARK("serial") {
+        size_t numHits = 0;
+        for (const auto& ray : rays) {
+            raycaster.ray = ray;
+            numHits += raycaster.intersectObjects(objects).size();
+        }
+        return numHits;
+    };
+
+    BENCHMARK("batched") {
+        return raycaster.intersectObjects(rays, objects, false, &pool);
+    };
+}
@@ -0,0 +1,314 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "threepp/cameras/PerspectiveCamera.hpp"
+#include "threepp/geometries/BoxGeometry.hpp"
+#include "threepp/materials/MeshBasicMaterial.hpp"
+#include "threepp/objects/StaticBatch.hpp"
+
+using namespace threepp;
+
+namespace {
+
+    std::shared_ptr<Mesh> addMesh(Object3D& parent, const std::shared_ptr<BufferGeometry>& geometry, const std::shared_ptr<Material>& material, float x) {
+
+        auto mesh = Mesh::create(geometry, material);
+        mesh->position.x = x;
+        parent.add(mesh);
+
+        return mesh;
+    }
+
+    Frustum frustumOf(Camera& camera) {
+
+        camera.updateMatrixWorld();
+
+        Matrix4 projScreenMatrix;
+        projScreenMatrix.multiplyMatrices(camera.projectionMatrix, camera.matrixWorldInverse);
+
+        Frustum frustum;
+        frustum.setFromProjectionMatrix(projScreenMatrix);
+
+        return frustum;
+    }
+
+}// namespace
+
+TEST_CASE("StaticBatch groups meshes by material") {
+
+    auto geometry = BoxGeometry::create();
+    auto red = MeshBasicMaterial::create();
+    auto blue = MeshBasicMaterial::create();
+
+    auto batch = StaticBatch::create();
+    auto a = addMesh(*batch, geometry, red, 0);
+    auto b = addMesh(*batch, geometry, red, 2);
+    auto c = addMesh(*batch, geometry, blue, 4);
+    auto d = addMesh(*b, geometry, blue, 2);
+
+    batch->updateMatrixWorld();
+
+    REQUIRE(batch->batches().size() == 2);
+    CHECK(batch->isBatched(*a));
+    CHECK(batch->isBatched(*b));
+    CHECK(batch->isBatched(*c));
+    CHECK(batch->isBatched(*d));
+
+    for (const auto& mesh : batch->batches()) {
+        CHECK(mesh->ranges().size() == 2);
+        CHECK(mesh->geometry()->getIndex()->count() == 2 * geometry->getIndex()->count());
+    }
+
+    // the geometry of d is baked relative to the batch
+    const auto& blueBatch = batch->batches().front()->material() == blue.get() ? batch->batches().front() : batch->batches().back();
+    CHECK(blueBatch->ranges().back().boundingSphere.center.x == 4);
+}
+
+TEST_CASE("StaticBatch excludes dynamic and unbatchable meshes") {
+
+    auto geometry = BoxGeometry::create();
+    auto material = MeshBasicMaterial::create();
+    auto transparent = MeshBasicMaterial::create();
+    transparent->transparent = true;
+
+    auto batch = StaticBatch::create();
+    auto a = addMesh(*batch, geometry, material, 0);
+    auto b = addMesh(*batch, geometry, material, 2);
+    auto c = addMesh(*batch, geometry, material, 4);
+    auto d = addMesh(*batch, geometry, transparent, 6);
+    auto e = addMesh(*batch, geometry, transparent, 8);
+
+    batch->setDynamic(*c);
+    batch->updateMatrixWorld();
+
+    REQUIRE(batch->batches().size() == 1);
+    CHECK(batch->isBatched(*a));
+    CHECK(batch->isBatched(*b));
+    CHECK_FALSE(batch->isBatched(*c));
+    CHECK_FALSE(batch->isBatched(*d));
+    CHECK_FALSE(batch->isBatched(*e));
+
+    // a lone mesh is not batched
+    batch->setDynamic(*b);
+    batch->updateMatrixWorld();
+
+    CHECK(batch->batches().empty());
+    CHECK_FALSE(batch->isBatched(*a));
+}
+
+TEST_CASE("StaticBatch only rebuilds changed batches") {
+
+    auto geometry = BoxGeometry::create();
+    auto red = MeshBasicMaterial::create();
+    auto blue = MeshBasicMaterial::create();
+
+    auto batch = StaticBatch::create();
+    addMesh(*batch, geometry, red, 0);
+    addMesh(*batch, geometry, red, 2);
+    addMesh(*batch, geometry, blue, 4);
+    addMesh(*batch, geometry, blue, 6);
+
+    batch->updateMatrixWorld();
+    REQUIRE(batch->batches().size() == 2);
+
+    auto before = batch->batches();
+
+    batch->updateMatrixWorld();
+    CHECK(batch->batches() == before);
+
+    auto added = addMesh(*batch, geometry, blue, 8);
+    batch->updateMatrixWorld();
+
+    REQUIRE(batch->batches().size() == 2);
+    CHECK(batch->isBatched(*added));
+
+    int unchanged = 0;
+    for (const auto& mesh : batch->batches()) {
+        if (std::find(before.begin(), before.end(), mesh) != before.end()) ++unchanged;
+    }
+    CHECK(unchanged == 1);
+
+    batch->invalidate();
+    batch->updateMatrixWorld();
+
+    for (const auto& mesh : batch->batches()) {
+        CHECK(std::find(before.begin(), before.end(), mesh) == before.end());
+    }
+}
+
+TEST_CASE("BatchedMesh draw ranges") {
+
+    auto geometry = BoxGeometry::create();
+    auto material = MeshBasicMaterial::create();
+
+    auto batch = StaticBatch::create();
+    auto a = addMesh(*batch, geometry, material, 0);
+    auto b = addMesh(*batch, geometry, material, 2);
+    auto c = addMesh(*batch, geometry, material, 100);
+
+    batch->updateMatrixWorld();
+    REQUIRE(batch->batches().size() == 1);
+
+    const auto& mesh = batch->batches().front();
+    const auto count = geometry->getIndex()->count();
+
+    auto camera = PerspectiveCamera::create(60, 1, 0.1f, 1000);
+    camera->position.z = 1000;
+    auto frustum = frustumOf(*camera);
+
+    std::vector<int> starts;
+    std::vector<int> counts;
+
+    mesh->computeDrawRanges(frustum, camera->layers, starts, counts);
+    CHECK(starts == std::vector<int>{0});
+    CHECK(counts == std::vector<int>{3 * count});
+
+    b->visible = false;
+    mesh->computeDrawRanges(frustum, camera->layers, starts, counts);
+    CHECK(starts == std::vector<int>{0, 2 * count});
+    CHECK(counts == std::vector<int>{count, count});
+
+    b->visible = true;
+    c->layers.set(1);
+    mesh->computeDrawRanges(frustum, camera->layers, starts, counts);
+    CHECK(starts == std::vector<int>{0});
+    CHECK(counts == std::vector<int>{2 * count});
+
+    c->layers.set(0);
+    camera->position.z = 10;
+    frustum = frustumOf(*camera);
+    mesh->computeDrawRanges(frustum, camera->layers, starts, counts);
+    CHECK(starts == std::vector<int>{0});
+    CHECK(counts == std::vector<int>{2 * count});
+
+    a->frustumCulled = true;
+    c->frustumCulled = false;
+    mesh->computeDrawRanges(frustum, camera->layers, starts, counts);
+    CHECK(starts == std::vector<int>{0});
+    CHECK(counts == std::vector<int>{3 * count});
+}
+
+TEST_CASE("StaticBatch drops removed meshes right away") {
+
+    auto geometry = BoxGeometry::create();
+    auto material = MeshBasicMaterial::create();
+
+    auto batch = StaticBatch::create();
+    auto group = Object3D::create();
+    batch->add(group);
+
+    auto a = addMesh(*batch, geometry, material, 0);
+    auto b = addMesh(*group, geometry, material, 2);
+    auto c = addMesh(*group, geometry, material, 4);
+
+    batch->updateMatrixWorld();
+    REQUIRE(batch->batches().size() == 1);
+
+    const auto mesh = batch->batches().front();
+    CHECK(mesh->ranges().size() == 3);
+
+    // removing an ancestor of batched meshes, which may then be destroyed before the next update
+    batch->remove(*group);
+    CHECK(mesh->ranges().size() == 1);
+    CHECK(batch->isBatched(*a));
+    CHECK(!batch->isBatched(*b));
+    CHECK(!batch->isBatched(*c));
+
+    group.reset();
+    b.reset();
+    c.reset();
+
+    auto camera = PerspectiveCamera::create(60, 1, 0.1f, 1000);
+    camera->position.z = 100;
+
+    std::vector<int> starts;
+    std::vector<int> counts;
+    mesh->computeDrawRanges(frustumOf(*camera), camera->layers, starts, counts);
+    CHECK(counts == std::vector<int>{geometry->getIndex()->count()});
+
+    // a single mesh is left, which is drawn on its own
+    batch->updateMatrixWorld();
+    CHECK(batch->batches().empty());
+}
+
+TEST_CASE("StaticBatch batches follow the batch") {
+
+    auto geometry = BoxGeometry::create();
+    auto material = MeshBasicMaterial::create();
+
+    auto batch = StaticBatch::create();
+    addMesh(*batch, geometry, material, 0);
+    addMesh(*batch, geometry, material, 2);
+
+    batch->updateMatrixWorld();
+    REQUIRE(batch->batches().size() == 1);
+
+    const auto& mesh = batch->batches().front();
+    const auto version = mesh->matrixWorldVersion();
+
+    batch->position.x = 5;
+    batch->updateMatrixWorld();
+
+    CHECK(mesh->matrixWorldVersion() != version);
+    CHECK(Vector3().setFromMatrixPosition(*mesh->matrixWorld).x == 5);
+
+    // without being rebuilt
+    CHECK(batch->batches().front() == mesh);
+}
+
+TEST_CASE("StaticBatch rebuilds batches whose meshes move or change") {
+
+    auto geometry = BoxGeometry::create();
+    auto red = MeshBasicMaterial::create();
+    auto blue = MeshBasicMaterial::create();
+
+    auto batch = StaticBatch::create();
+    auto group = Object3D::create();
+    batch->add(group);
+
+    auto a = addMesh(*group, geometry, red, 0);
+    addMesh(*group, geometry, red, 2);
+    auto c = addMesh(*batch, geometry, blue, 4);
+    addMesh(*batch, geometry, blue, 6);
+
+    batch->updateMatrixWorld();
+    REQUIRE(batch->batches().size() == 2);
+
+    const auto batchOf = [&](const std::shared_ptr<Material>& material) {
+        for (const auto& mesh : batch->batches()) {
+            if (mesh->material() == material.get()) return mesh;
+        }
+        return std::shared_ptr<BatchedMesh>();
+    };
+
+    auto redBatch = batchOf(red);
+    auto blueBatch = batchOf(blue);
+
+    // moving an ancestor of batched meshes
+    group->position.y = 1;
+    batch->updateMatrixWorld();
+
+    CHECK(batchOf(red) != redBatch);
+    CHECK(batchOf(blue) == blueBatch);
+    CHECK(batchOf(red)->ranges().front().boundingSphere.center.y == 1);
+
+    redBatch = batchOf(red);
+
+    c->castShadow = true;
+    batch->updateMatrixWorld();
+
+    CHECK(batchOf(red) == redBatch);
+    CHECK(batchOf(blue) != blueBatch);
+
+    // added below a batched mesh
+    auto added = addMesh(*a, geometry, red, 2);
+    batch->updateMatrixWorld();
+
+    CHECK(batch->isBatched(*added));
+    CHECK(batchOf(red)->ranges().size() == 3);
+
+    batch->setDynamic(*added);
+    batch->updateMatrixWorld();
+
+    CHECK(!batch->isBatched(*added));
+    CHECK(batchOf(red)->ranges().size() == 2);
+}
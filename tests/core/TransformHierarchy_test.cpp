@@ -0,0 +1,222 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "threepp/cameras/PerspectiveCamera.hpp"
+#include "threepp/core/TransformHierarchy.hpp"
+#include "threepp/helpers/PointLightHelper.hpp"
+#include "threepp/lights/DirectionalLight.hpp"
+#include "threepp/lights/PointLight.hpp"
+#include "threepp/math/MathUtils.hpp"
+
+#include "../equals_util.hpp"
+
+using namespace threepp;
+
+namespace {
+
+    // a tree of n objects where every object has up to 4 children
+    std::vector<std::shared_ptr<Object3D>> createTree(size_t n) {
+
+        std::vector<std::shared_ptr<Object3D>> objects{Object3D::create()};
+
+        for (size_t i = 1; i < n; ++i) {
+
+            auto object = Object3D::create();
+            object->position.set(math::randFloat(-10, 10), math::randFloat(-10, 10), math::randFloat(-10, 10));
+            object->rotation.set(math::randFloat(0, 2), math::randFloat(0, 2), math::randFloat(0, 2));
+            object->scale.setScalar(math::randFloat(0.5f, 1.5f));
+
+            objects[(i - 1) / 4]->add(object);
+            objects.emplace_back(object);
+        }
+
+        return objects;
+    }
+
+    // world matrices as computed by Object3D::updateMatrixWorld
+    std::vector<Matrix4> expectedMatrices(const std::vector<std::shared_ptr<Object3D>>& objects) {
+
+        std::vector<Matrix4> matrices;
+
+        for (const auto& object : objects) {
+
+            Matrix4 m;
+            m.compose(object->position, object->quaternion, object->scale);
+            if (object->parent) m.premultiply(*object->parent->matrixWorld);
+
+            object->matrixWorld->copy(m);
+            matrices.emplace_back(m);
+        }
+
+        return matrices;
+    }
+
+    bool matchesExpected(const std::vector<std::shared_ptr<Object3D>>& objects) {
+
+        std::vector<Matrix4> actual;
+        for (const auto& object : objects) actual.emplace_back(*object->matrixWorld);
+
+        const auto expected = expectedMatrices(objects);
+
+        for (size_t i = 0; i < objects.size(); ++i) {
+
+            if (!matrixEquals4(actual[i], expected[i]) || !matrixEquals4(expected[i], actual[i])) return false;
+            objects[i]->matrixWorld->copy(actual[i]);
+        }
+
+        return true;
+    }
+
+}// namespace
+
+TEST_CASE("TransformHierarchy matches updateMatrixWorld") {
+
+    auto objects = createTree(200);
+    auto& root = *objects.front();
+
+    TransformHierarchy hierarchy(root);
+    CHECK(hierarchy.size() == 200);
+
+    hierarchy.update();
+    CHECK(matchesExpected(objects));
+
+    objects[1]->position.x += 1;
+    objects[57]->rotation.y += 1;
+    objects[199]->scale.x = 3;
+
+    hierarchy.update();
+    CHECK(matchesExpected(objects));
+
+    // objects refer to the flattened storage
+    objects[10]->matrixAutoUpdate = false;
+    objects[10]->matrix->makeTranslation(1, 2, 3);
+    objects[10]->matrixWorldNeedsUpdate = true;
+
+    hierarchy.update();
+    CHECK(objects[10]->matrixWorld->elements[12] != 0);
+}
+
+TEST_CASE("TransformHierarchy rebuild and special objects") {
+
+    auto root = Object3D::create();
+    auto group = Object3D::create();
+    auto camera = PerspectiveCamera::create();
+    auto light = DirectionalLight::create();
+    light->position.set(0, 0, 0);
+    auto child = Object3D::create();
+
+    root->add(group);
+    group->add(camera);
+    group->add(light);
+    light->add(child);
+
+    TransformHierarchy hierarchy(*root);
+    // the light is updated through its own updateMatrixWorld, along with its child
+    CHECK(hierarchy.size() == 4);
+
+    group->position.set(1, 2, 3);
+    child->position.x = 1;
+    hierarchy.update();
+
+    CHECK(Vector3().setFromMatrixPosition(*camera->matrixWorld).distanceTo({1, 2, 3}) < eps);
+    CHECK(Vector3().setFromMatrixPosition(camera->matrixWorldInverse).distanceTo({-1, -2, -3}) < eps);
+    CHECK(Vector3().setFromMatrixPosition(*child->matrixWorld).distanceTo({2, 2, 3}) < eps);
+
+    auto added = Object3D::create();
+    added->position.z = 1;
+    camera->add(added);
+
+    hierarchy.rebuild();
+    CHECK(hierarchy.size() == 5);
+
+    hierarchy.update();
+    CHECK(Vector3().setFromMatrixPosition(*added->matrixWorld).distanceTo({1, 2, 4}) < eps);
+}
+
+TEST_CASE("TransformHierarchy follows structural changes") {
+
+    auto root = Object3D::create();
+    auto group = Object3D::create();
+    group->position.x = 1;
+    root->add(group);
+
+    TransformHierarchy hierarchy(*root);
+    hierarchy.update();
+    CHECK(hierarchy.size() == 2);
+
+    auto added = Object3D::create();
+    added->position.y = 1;
+    group->add(added);
+
+    hierarchy.update();
+    CHECK(hierarchy.size() == 3);
+    CHECK(Vector3().setFromMatrixPosition(*added->matrixWorld).distanceTo({1, 1, 0}) < eps);
+
+    // removed, and destroyed before the next update
+    group->remove(*added);
+    added.reset();
+    root->clear();
+    group.reset();
+
+    hierarchy.update();
+    CHECK(hierarchy.size() == 1);
+}
+
+TEST_CASE("TransformHierarchy keeps shared matrices") {
+
+    auto scene = Object3D::create();
+    auto light = PointLight::create();
+    auto helper = PointLightHelper::create(*light, 1);
+    scene->add(light);
+    scene->add(helper);
+
+    const auto helperPosition = [&] {
+        return Vector3().setFromMatrixPosition(*helper->matrixWorld);
+    };
+
+    TransformHierarchy hierarchy(*scene);
+    hierarchy.update(true);
+
+    light->position.x = 5;
+    hierarchy.update();
+    CHECK(helperPosition().distanceTo({5, 0, 0}) < eps);
+
+    // a helper added once its light is in the flat storage
+    auto other = PointLightHelper::create(*light, 1);
+    scene->add(other);
+
+    hierarchy.rebuild();
+    light->position.x = 2;
+    hierarchy.update();
+    CHECK(helperPosition().distanceTo({2, 0, 0}) < eps);
+    CHECK(Vector3().setFromMatrixPosition(*other->matrixWorld).distanceTo({2, 0, 0}) < eps);
+}
+
+TEST_CASE("TransformHierarchy benchmark", "[.benchmark]") {
+
+    auto objects = createTree(100000);
+    auto& root = *objects.front();
+
+    root.updateMatrixWorld();
+
+    BENCHMARK("Object3D::updateMatrixWorld(true)") {
+        root.updateMatrixWorld(true);
+    };
+
+    BENCHMARK("Object3D::updateMatrixWorld, 1% moving") {
+        for (size_t i = 1; i < objects.size(); i += 100) objects[objects.size() - i]->position.x += 0.01f;
+        root.updateMatrixWorld();
+    };
+
+    TransformHierarchy hierarchy(root);
+    hierarchy.update();
+
+    BENCHMARK("TransformHierarchy::update(true)") {
+        hierarchy.update(true);
+    };
+
+    BENCHMARK("TransformHierarchy::update, 1% moving") {
+        for (size_t i = 1; i < objects.size(); i += 100) objects[objects.size() - i]->position.x += 0.01f;
+        hierarchy.update();
+    };
+}
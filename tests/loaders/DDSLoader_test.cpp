@@ -0,0 +1,148 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "threepp/loaders/DDSLoader.hpp"
+
+#include <cstring>
+#include <fstream>
+
+using namespace threepp;
+
+namespace {
+
+    void write32(std::vector<unsigned char>& data, size_t offset, uint32_t value) {
+
+        std::memcpy(data.data() + offset, &value, sizeof(value));
+    }
+
+    // A DDS file with the given four-character code, and mipmaps of 8 or 16 bytes per 4x4 block.
+    std::vector<unsigned char> createDDS(const char* fourCC, unsigned int width, unsigned int height, unsigned int mipmapCount, size_t blockBytes, uint32_t dxgiFormat = 0) {
+
+        const bool dx10 = std::strcmp(fourCC, "DX10") == 0;
+
+        std::vector<unsigned char> data(dx10 ? 148 : 128);
+        std::memcpy(data.data(), "DDS ", 4);
+        write32(data, 4, 124);
+        write32(data, 8, 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000);
+        write32(data, 12, height);
+        write32(data, 16, width);
+        write32(data, 28, mipmapCount);
+        write32(data, 76, 32);
+        write32(data, 80, 0x4);
+        std::memcpy(data.data() + 84, fourCC, 4);
+
+        if (dx10) {
+            write32(data, 128, dxgiFormat);
+            write32(data, 140, 1);
+        }
+
+        for (unsigned i = 0; i < mipmapCount; ++i) {
+
+            const auto blocks = std::max(1u, ((width >> i) + 3) / 4) * std::max(1u, ((height >> i) + 3) / 4);
+            data.resize(data.size() + blocks * blockBytes, static_cast<unsigned char>(i));
+        }
+
+        return data;
+    }
+
+}// namespace
+
+TEST_CASE("DDS mipmaps are read as stored") {
+
+    DDSLoader loader;
+
+    auto texture = loader.parse(createDDS("DXT5", 16, 8, 5, 16));
+    REQUIRE(texture);
+
+    CHECK(texture->format == Format::RGBA_S3TC_DXT5);
+    CHECK(texture->image.front().width == 16);
+    CHECK(texture->image.front().height == 8);
+    CHECK(!texture->generateMipmaps);
+
+    const std::vector<std::pair<unsigned int, unsigned int>> sizes{{16, 8}, {8, 4}, {4, 2}, {2, 1}, {1, 1}};
+    const std::vector<size_t> bytes{8 * 16, 2 * 16, 16, 16, 16};
+
+    REQUIRE(texture->mipmaps.size() == 5);
+    for (size_t i = 0; i < 5; ++i) {
+
+        auto& mipmap = texture->mipmaps[i];
+        CHECK(mipmap.width == sizes[i].first);
+        CHECK(mipmap.height == sizes[i].second);
+        CHECK(mipmap.byteLength() == bytes[i]);
+        CHECK(mipmap.data().front() == i);
+    }
+}
+
+TEST_CASE("DDS mipmap counts past 1x1 are rejected") {
+
+    DDSLoader loader;
+
+    auto data = createDDS("DXT5", 16, 8, 5, 16);
+    data.resize(data.size() + 1024);
+    CHECK(loader.parse(data));
+
+    write32(data, 28, 6);
+    CHECK(!loader.parse(data));
+
+    write32(data, 28, 40);
+    CHECK(!loader.parse(data));
+}
+
+TEST_CASE("DDS sizes past any file are rejected") {
+
+    DDSLoader loader;
+
+    auto data = createDDS("DXT5", 16, 8, 1, 16);
+    CHECK(loader.parse(data));
+
+    // (width + 3) / 4 wraps around to a single block in 32 bits
+    write32(data, 12, 0xFFFFFFFF);
+    write32(data, 16, 0xFFFFFFFF);
+    CHECK(!loader.parse(data));
+
+    // the number of blocks times the block size wraps around in 64 bits
+    write32(data, 12, 0xFFFFFFFC);
+    write32(data, 16, 0xFFFFFFFC);
+    CHECK(!loader.parse(data));
+}
+
+TEST_CASE("DDS formats") {
+
+    DDSLoader loader;
+
+    CHECK(loader.parse(createDDS("DXT1", 8, 8, 1, 8))->format == Format::RGB_S3TC_DXT1);
+    CHECK(loader.parse(createDDS("DXT3", 8, 8, 1, 16))->format == Format::RGBA_S3TC_DXT3);
+    CHECK(loader.parse(createDDS("ATI2", 8, 8, 1, 16))->format == Format::RED_GREEN_RGTC2);
+
+    auto bc7 = loader.parse(createDDS("DX10", 8, 8, 1, 16, 99));
+    REQUIRE(bc7);
+    CHECK(bc7->format == Format::RGBA_BPTC);
+    CHECK(bc7->encoding == Encoding::sRGB);
+    CHECK(bc7->minFilter == Filter::Linear);
+
+    CHECK(!loader.parse(createDDS("DX10", 8, 8, 1, 16, 28)));
+    CHECK(!loader.parse(createDDS("ABCD", 8, 8, 1, 16)));
+
+    auto truncated = createDDS("DXT5", 8, 8, 4, 16);
+    truncated.pop_back();
+    CHECK(!loader.parse(truncated));
+}
+
+TEST_CASE("DDS files are loaded") {
+
+    const auto path = std::filesystem::temp_directory_path() / "threepp_dds_test.dds";
+    const auto data = createDDS("DXT1", 32, 32, 6, 8);
+
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    }
+
+    auto texture = DDSLoader().load(path);
+    REQUIRE(texture);
+    CHECK(texture->name == "threepp_dds_test");
+    CHECK(texture->mipmaps.size() == 6);
+
+    std::filesystem::remove(path);
+
+    CHECK(!DDSLoader().load(path));
+}
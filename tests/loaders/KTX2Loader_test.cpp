@@ -0,0 +1,119 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "threepp/loaders/KTX2Loader.hpp"
+
+#include <cstring>
+#include <limits>
+
+using namespace threepp;
+
+namespace {
+
+    template<class T>
+    void write(std::vector<unsigned char>& data, size_t offset, T value) {
+
+        std::memcpy(data.data() + offset, &value, sizeof(value));
+    }
+
+    // A KTX2 file with mipmaps of 8 or 16 bytes per 4x4 block, stored smallest first.
+    std::vector<unsigned char> createKTX2(uint32_t vkFormat, unsigned int width, unsigned int height, unsigned int levelCount, size_t blockBytes, uint32_t supercompressionScheme = 0) {
+
+        const unsigned char identifier[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+        std::vector<unsigned char> data(80 + levelCount * 24);
+        std::memcpy(data.data(), identifier, sizeof(identifier));
+        write<uint32_t>(data, 12, vkFormat);
+        write<uint32_t>(data, 16, 1);
+        write<uint32_t>(data, 20, width);
+        write<uint32_t>(data, 24, height);
+        write<uint32_t>(data, 36, 1);
+        write<uint32_t>(data, 40, levelCount);
+        write<uint32_t>(data, 44, supercompressionScheme);
+
+        for (int i = static_cast<int>(levelCount) - 1; i >= 0; --i) {
+
+            const auto blocks = std::max(1u, ((width >> i) + 3) / 4) * std::max(1u, ((height >> i) + 3) / 4);
+            const auto byteLength = blocks * blockBytes;
+
+            write<uint64_t>(data, 80 + i * 24, data.size());
+            write<uint64_t>(data, 80 + i * 24 + 8, byteLength);
+            write<uint64_t>(data, 80 + i * 24 + 16, byteLength);
+
+            data.resize(data.size() + byteLength, static_cast<unsigned char>(i));
+        }
+
+        return data;
+    }
+
+}// namespace
+
+TEST_CASE("KTX2 mipmaps are read through the level index") {
+
+    KTX2Loader loader;
+
+    auto texture = loader.parse(createKTX2(145, 32, 16, 6, 16));
+    REQUIRE(texture);
+
+    CHECK(texture->format == Format::RGBA_BPTC);
+    CHECK(texture->encoding == Encoding::Linear);
+    CHECK(texture->image.front().width == 32);
+    CHECK(texture->image.front().height == 16);
+
+    REQUIRE(texture->mipmaps.size() == 6);
+    for (size_t i = 0; i < 6; ++i) {
+
+        auto& mipmap = texture->mipmaps[i];
+        CHECK(mipmap.width == std::max(1u, 32u >> i));
+        CHECK(mipmap.height == std::max(1u, 16u >> i));
+        CHECK(mipmap.data().front() == i);
+    }
+}
+
+TEST_CASE("KTX2 level counts past 1x1 are rejected") {
+
+    KTX2Loader loader;
+
+    auto data = createKTX2(145, 32, 16, 6, 16);
+    CHECK(loader.parse(data));
+
+    write<uint32_t>(data, 40, 7);
+    CHECK(!loader.parse(data));
+
+    write<uint32_t>(data, 40, 40);
+    CHECK(!loader.parse(data));
+}
+
+TEST_CASE("KTX2 level offsets past the file are rejected") {
+
+    KTX2Loader loader;
+
+    auto data = createKTX2(145, 32, 16, 6, 16);
+    CHECK(loader.parse(data));
+
+    write<uint64_t>(data, 80, data.size());
+    CHECK(!loader.parse(data));
+
+    // byteOffset + byteLength wraps around to within the file
+    write<uint64_t>(data, 80, std::numeric_limits<uint64_t>::max() - 100);
+    CHECK(!loader.parse(data));
+}
+
+TEST_CASE("KTX2 formats") {
+
+    KTX2Loader loader;
+
+    CHECK(loader.parse(createKTX2(131, 8, 8, 1, 8))->format == Format::RGB_S3TC_DXT1);
+    CHECK(loader.parse(createKTX2(137, 8, 8, 1, 16))->format == Format::RGBA_S3TC_DXT5);
+    CHECK(loader.parse(createKTX2(141, 8, 8, 1, 16))->format == Format::RED_GREEN_RGTC2);
+    CHECK(loader.parse(createKTX2(147, 8, 8, 1, 8))->format == Format::RGB_ETC2);
+
+    auto etc2 = loader.parse(createKTX2(152, 8, 8, 1, 16));
+    REQUIRE(etc2);
+    CHECK(etc2->format == Format::RGBA_ETC2_EAC);
+    CHECK(etc2->encoding == Encoding::sRGB);
+
+    // uncompressed, supercompressed and mismatched level sizes
+    CHECK(!loader.parse(createKTX2(37, 8, 8, 1, 64)));
+    CHECK(!loader.parse(createKTX2(145, 8, 8, 1, 16, 2)));
+    CHECK(!loader.parse(createKTX2(145, 8, 8, 1, 8)));
+}
@@ -0,0 +1,197 @@
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "threepp/loaders/OBJLoader.hpp"
+#include "threepp/math/MathUtils.hpp"
+#include "threepp/objects/Mesh.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+using namespace threepp;
+
+namespace {
+
+    const std::filesystem::path femaleFile = std::string(DATA_FOLDER) + "/models/obj/female02/female02.obj";
+    const std::filesystem::path waltFile = std::string(DATA_FOLDER) + "/models/obj/walt/WaltHead.obj";
+
+    std::filesystem::path tempFile(const std::string& name) {
+
+        return std::filesystem::temp_directory_path() / name;
+    }
+
+    // a grid of quads, split over several materials, using both absolute and relative indices
+    void writeGrid(const std::filesystem::path& path, int size) {
+
+        std::ofstream out(path);
+        out << "# generated\n";
+        out << "o grid\n";
+
+        for (int y = 0; y <= size; ++y) {
+            for (int x = 0; x <= size; ++x) {
+                out << "v " << x << " " << y << " " << math::randFloat(-1, 1) << "\n";
+                out << "vt " << static_cast<float>(x) / size << " " << static_cast<float>(y) / size << "\n";
+            }
+        }
+        out << "vn 0 0 1\n";
+
+        const auto row = size + 1;
+        const auto total = row * row;
+
+        for (int y = 0; y < size; ++y) {
+
+            if (y % 50 == 0) out << "usemtl material" << (y / 50) % 3 << "\n";
+            if (y % 70 == 0) out << "s " << (y % 140 == 0 ? "off" : "1") << "\n";
+
+            for (int x = 0; x < size; ++x) {
+
+                const auto a = y * row + x + 1;
+                const auto b = a + 1, c = a + row + 1, d = a + row;
+
+                if (x % 2 == 0) {
+                    out << "f " << a << "/" << a << "/1 " << b << "/" << b << "/1 " << c << "/" << c << "/1 " << d << "/" << d << "/1\n";
+                } else {
+                    // relative to the number of vertices declared so far
+                    out << "f " << a - total - 1 << "//-1 " << b - total - 1 << "//-1 " << c - total - 1 << "//-1\n";
+                }
+            }
+        }
+    }
+
+    std::vector<float> arrayOf(const BufferGeometry& geometry, const std::string& name) {
+
+        if (!geometry.hasAttribute(name)) return {};
+
+        return geometry.getAttribute<float>(name)->array();
+    }
+
+}// namespace
+
+TEST_CASE("Load OBJ") {
+
+    OBJLoader loader;
+    loader.useCache = false;
+
+    auto female = loader.load(femaleFile);
+    REQUIRE(female);
+    REQUIRE(female->children.size() == 1);
+
+    auto geometry = female->children.front()->geometry();
+    CHECK(geometry->getAttribute<float>("position")->array().size() == 56097);
+    CHECK(geometry->getAttribute<float>("normal")->array().size() == 56097);
+    CHECK(geometry->getAttribute<float>("uv")->array().size() == 37398);
+    CHECK(geometry->groups.size() == 15);
+    CHECK(female->children.front()->as<Mesh>()->materials().size() == 15);
+
+    auto walt = loader.load(waltFile);
+    REQUIRE(walt);
+    REQUIRE(walt->children.size() == 1);
+
+    geometry = walt->children.front()->geometry();
+    CHECK(walt->children.front()->name == "Mesh_Mesh_head_geo.001_lambert2SG.001");
+    CHECK(geometry->getAttribute<float>("position")->array().size() == 145440);
+    REQUIRE(geometry->groups.size() == 1);
+    CHECK(geometry->groups.front().start == 0);
+    CHECK(geometry->groups.front().count == 48480);
+
+    CHECK(loader.load("missing.obj") == nullptr);
+}
+
+TEST_CASE("Vertices without colors are white") {
+
+    const auto path = tempFile("threepp_colors_test.obj");
+    {
+        std::ofstream out(path);
+        out << "v 0 0 0 1 0 0\n";
+        out << "v 1 0 0\n";
+        out << "v 1 1 0 0 0 1\n";
+        out << "v 0 1 0\n";
+        out << "f 1 2 3\n";
+        out << "f 1 3 4\n";
+    }
+
+    OBJLoader loader;
+    loader.useCache = false;
+
+    auto obj = loader.load(path, false);
+    REQUIRE(obj);
+    REQUIRE(obj->children.size() == 1);
+
+    const auto colors = arrayOf(*obj->children.front()->geometry(), "color");
+    CHECK(colors == std::vector<float>{1, 0, 0, 1, 1, 1, 0, 0, 1,
+                                       1, 0, 0, 0, 0, 1, 1, 1, 1});
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Parallel OBJ parsing matches serial parsing") {
+
+    const auto path = tempFile("threepp_parallel_test.obj");
+    writeGrid(path, 300);
+
+    REQUIRE(std::filesystem::file_size(path) > 1024 * 1024);
+
+    OBJLoader serial;
+    serial.useCache = false;
+    serial.threadCount = 1;
+    OBJLoader parallel;
+    parallel.useCache = false;
+    parallel.threadCount = 4;
+
+    for (const auto& file : {path, waltFile}) {
+
+        auto a = serial.load(file, false);
+        auto b = parallel.load(file, false);
+
+        REQUIRE(a->children.size() == b->children.size());
+
+        for (size_t i = 0; i < a->children.size(); ++i) {
+
+            const auto& ga = *a->children[i]->geometry();
+            const auto& gb = *b->children[i]->geometry();
+
+            CHECK(a->children[i]->name == b->children[i]->name);
+            for (const auto& name : {"position", "normal", "uv", "color"}) {
+                CHECK(arrayOf(ga, name) == arrayOf(gb, name));
+            }
+
+            REQUIRE(ga.groups.size() == gb.groups.size());
+            for (size_t j = 0; j < ga.groups.size(); ++j) {
+                CHECK(ga.groups[j].start == gb.groups[j].start);
+                CHECK(ga.groups[j].count == gb.groups[j].count);
+                CHECK(ga.groups[j].materialIndex == gb.groups[j].materialIndex);
+            }
+        }
+    }
+
+    // 300 rows of 150 quads and 150 triangles
+    auto grid = serial.load(path, false);
+    const auto& geometry = *grid->children.front()->geometry();
+    CHECK(grid->children.front()->name == "grid");
+    CHECK(geometry.getAttribute<float>("position")->count() == 300 * 150 * 9);
+    CHECK(geometry.groups.size() == 6);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("OBJLoader benchmark", "[.benchmark]") {
+
+    const auto path = tempFile("threepp_benchmark.obj");
+    writeGrid(path, 1500);
+
+    OBJLoader loader;
+    loader.useCache = false;
+
+    const auto size = static_cast<double>(std::filesystem::file_size(path)) / (1024 * 1024);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 5; ++i) {
+        loader.load(path, false);
+    }
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / 5;
+
+    std::cout << path.filename().string() << ": " << size << " MB in " << seconds * 1000 << " ms, " << size / seconds << " MB/s" << std::endl;
+
+    std::filesystem::remove(path);
+}
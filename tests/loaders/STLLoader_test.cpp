@@ -0,0 +1,201 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "threepp/loaders/STLLoader.hpp"
+#include "threepp/math/MathUtils.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+using namespace threepp;
+
+namespace {
+
+    const std::filesystem::path stlFile = std::string(DATA_FOLDER) + "/models/stl/pr2_head_pan.stl";
+
+    std::filesystem::path tempFile(const std::string& name) {
+
+        return std::filesystem::temp_directory_path() / name;
+    }
+
+    void writeAscii(const std::filesystem::path& path, const BufferGeometry& geometry) {
+
+        const auto& positions = geometry.getAttribute<float>("position")->array();
+        const auto& normals = geometry.getAttribute<float>("normal")->array();
+
+        std::ofstream out(path);
+        out << "solid test\n";
+        for (size_t i = 0; i < positions.size(); i += 9) {
+
+            out << "  facet normal " << normals[i] << " " << normals[i + 1] << " " << normals[i + 2] << "\n";
+            out << "    outer loop\n";
+            for (size_t j = i; j < i + 9; j += 3) {
+                out << "      vertex " << positions[j] << " " << positions[j + 1] << " " << positions[j + 2] << "\n";
+            }
+            out << "    endloop\n";
+            out << "  endfacet\n";
+        }
+        out << "endsolid test\n";
+    }
+
+    void writeBinary(const std::filesystem::path& path, uint32_t faces) {
+
+        std::vector<char> data(84 + static_cast<size_t>(faces) * 50);
+        std::memcpy(data.data() + 80, &faces, 4);
+
+        for (size_t face = 0; face < faces; ++face) {
+
+            float values[12];
+            for (float& value : values) value = math::randFloat(-1, 1);
+            std::memcpy(data.data() + 84 + face * 50, values, sizeof(values));
+        }
+
+        std::ofstream out(path, std::ios::binary);
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+
+    bool sameArrays(const std::vector<float>& a, const std::vector<float>& b, float tolerance) {
+
+        if (a.size() != b.size()) return false;
+
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (std::abs(a[i] - b[i]) > tolerance) return false;
+        }
+
+        return true;
+    }
+
+}// namespace
+
+TEST_CASE("Load binary STL") {
+
+    STLLoader loader;
+    auto geometry = loader.load(stlFile);
+
+    REQUIRE(geometry);
+
+    const auto& positions = geometry->getAttribute<float>("position")->array();
+    const auto& normals = geometry->getAttribute<float>("normal")->array();
+
+    REQUIRE(positions.size() == 1000 * 9);
+    REQUIRE(normals.size() == 1000 * 9);
+
+    // compare against the raw file content
+    std::ifstream in(stlFile, std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    for (size_t face = 0; face < 1000; ++face) {
+
+        float values[12];
+        std::memcpy(values, data.data() + 84 + face * 50, sizeof(values));
+
+        for (int i = 0; i < 9; ++i) {
+            REQUIRE(positions[face * 9 + i] == values[3 + i]);
+            REQUIRE(normals[face * 9 + i] == values[i % 3]);
+        }
+    }
+
+    CHECK(loader.load("missing.stl") == nullptr);
+}
+
+TEST_CASE("Load ASCII STL") {
+
+    STLLoader loader;
+    auto binary = loader.load(stlFile);
+
+    const auto path = tempFile("threepp_ascii_test.stl");
+    writeAscii(path, *binary);
+
+    auto ascii = loader.load(path);
+    REQUIRE(ascii);
+
+    CHECK(sameArrays(ascii->getAttribute<float>("position")->array(), binary->getAttribute<float>("position")->array(), 1e-4f));
+    CHECK(sameArrays(ascii->getAttribute<float>("normal")->array(), binary->getAttribute<float>("normal")->array(), 1e-4f));
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Parallel STL parsing matches serial parsing") {
+
+    const auto binaryPath = tempFile("threepp_parallel_test.stl");
+    writeBinary(binaryPath, 50000);
+
+    STLLoader serial;
+    serial.threadCount = 1;
+    STLLoader parallel;
+    parallel.threadCount = 4;
+
+    auto a = serial.load(binaryPath);
+    auto b = parallel.load(binaryPath);
+    CHECK(a->getAttribute<float>("position")->array() == b->getAttribute<float>("position")->array());
+    CHECK(a->getAttribute<float>("normal")->array() == b->getAttribute<float>("normal")->array());
+
+    const auto asciiPath = tempFile("threepp_parallel_test_ascii.stl");
+    writeAscii(asciiPath, *a);
+
+    auto c = serial.load(asciiPath);
+    auto d = parallel.load(asciiPath);
+    CHECK(c->getAttribute<float>("position")->count() == 150000);
+    CHECK(c->getAttribute<float>("position")->array() == d->getAttribute<float>("position")->array());
+    CHECK(c->getAttribute<float>("normal")->array() == d->getAttribute<float>("normal")->array());
+
+    std::filesystem::remove(binaryPath);
+    std::filesystem::remove(asciiPath);
+}
+
+TEST_CASE("Merge STL vertices") {
+
+    STLLoader loader;
+    loader.mergeVertices = true;
+
+    auto geometry = loader.load(stlFile);
+    REQUIRE(geometry);
+    REQUIRE(geometry->hasIndex());
+
+    const auto index = geometry->getIndex();
+    const auto positions = geometry->getAttribute<float>("position");
+
+    CHECK(index->count() == 3000);
+    CHECK(positions->count() < 3000);
+    CHECK(geometry->getAttribute<float>("normal")->count() == positions->count());
+
+    // every triangle still refers to the same positions
+    auto unmerged = STLLoader().load(stlFile);
+    const auto& expected = unmerged->getAttribute<float>("position")->array();
+
+    for (int i = 0; i < index->count(); ++i) {
+        const auto vertex = index->array()[i];
+        for (int j = 0; j < 3; ++j) {
+            REQUIRE(positions->array()[vertex * 3 + j] == expected[i * 3 + j]);
+        }
+    }
+}
+
+TEST_CASE("STLLoader benchmark", "[.benchmark]") {
+
+    const auto binaryPath = tempFile("threepp_benchmark.stl");
+    writeBinary(binaryPath, 2000000);
+
+    STLLoader loader;
+    auto geometry = loader.load(binaryPath);
+
+    const auto asciiPath = tempFile("threepp_benchmark_ascii.stl");
+    writeAscii(asciiPath, *geometry);
+
+    for (const auto& path : {binaryPath, asciiPath}) {
+
+        const auto size = static_cast<double>(std::filesystem::file_size(path)) / (1024 * 1024);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < 5; ++i) {
+            geometry = loader.load(path);
+        }
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / 5;
+
+        std::cout << path.filename().string() << ": " << size << " MB in " << seconds * 1000 << " ms, " << size / seconds << " MB/s" << std::endl;
+    }
+
+    std::filesystem::remove(binaryPath);
+    std::filesystem::remove(asciiPath);
+}
@@ -0,0 +1,67 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "threepp/loaders/TextureLoader.hpp"
+
+using namespace threepp;
+
+namespace {
+
+    const std::filesystem::path pngFile = std::string(DATA_FOLDER) + "/textures/checker.png";
+    const std::filesystem::path jpgFile = std::string(DATA_FOLDER) + "/textures/brick_bump.jpg";
+
+}// namespace
+
+TEST_CASE("Textures are loaded asynchronously") {
+
+    TextureLoader loader(false);
+
+    std::vector<std::string> loaded;
+    const auto onLoad = [&](Texture& texture) { loaded.emplace_back(texture.name); };
+
+    auto png = loader.loadAsync(pngFile, true, onLoad);
+    auto jpg = loader.loadAsync(jpgFile, true, onLoad);
+    REQUIRE(png);
+    REQUIRE(jpg);
+
+    // a single texel until the image is decoded
+    CHECK(png->image.front().width == 1);
+    CHECK(png->image.front().height == 1);
+    CHECK(png->version() == 1);
+
+    CHECK(loader.wait() == 2);
+    CHECK(loader.pending() == 0);
+    CHECK(loaded.size() == 2);
+
+    for (const auto& [texture, file] : {std::make_pair(png, pngFile), std::make_pair(jpg, jpgFile)}) {
+
+        const auto expected = TextureLoader(false).load(file);
+
+        CHECK(texture->format == expected->format);
+        CHECK(texture->version() == 2);
+
+        auto& image = texture->image.front();
+        auto& expectedImage = expected->image.front();
+        CHECK(image.width == expectedImage.width);
+        CHECK(image.height == expectedImage.height);
+        CHECK(image.data() == expectedImage.data());
+    }
+
+    CHECK(loader.update() == 0);
+}
+
+TEST_CASE("Textures being loaded are cached") {
+
+    TextureLoader loader;
+
+    auto texture = loader.loadAsync(pngFile);
+    CHECK(loader.loadAsync(pngFile) == texture);
+    CHECK(loader.load(pngFile) == texture);
+    CHECK(loader.pending() == 1);
+
+    CHECK(!loader.loadAsync("missing.png"));
+
+    // the texture is gone before its image is decoded
+    texture.reset();
+    CHECK(loader.wait() == 0);
+    CHECK(loader.pending() == 0);
+}
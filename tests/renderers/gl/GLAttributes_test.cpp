@@ -0,0 +1,142 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "threepp/renderers/gl/GLAttributes.hpp"
+#include "threepp/utils/LoadGlad.hpp"
+
+using namespace threepp;
+using namespace threepp::gl;
+
+namespace {
+
+    struct Upload {
+
+        bool orphaned;
+        GLintptr offset;
+        GLsizeiptr size;
+
+        bool operator==(const Upload& other) const {
+
+            return orphaned == other.orphaned && offset == other.offset && size == other.size;
+        }
+    };
+
+    std::vector<Upload> uploads;
+
+    void APIENTRY recordBufferData(GLenum, GLsizeiptr size, const void*, GLenum) {
+
+        uploads.push_back({true, 0, size});
+    }
+
+    void APIENTRY recordBufferSubData(GLenum, GLintptr offset, GLsizeiptr size, const void*) {
+
+        uploads.push_back({false, offset, size});
+    }
+
+    constexpr GLsizeiptr element = sizeof(float);
+
+    // records the buffer uploads of null GL, for an attribute of 100 floats already uploaded once
+    struct AttributesFixture {
+
+        GLInfo info;
+        GLState state{info};
+        GLAttributes attributes{state};
+        std::unique_ptr<FloatBufferAttribute> attribute = FloatBufferAttribute::create(std::vector<float>(100), 1);
+
+        AttributesFixture() {
+
+            glad_glBufferData = &recordBufferData;
+            glad_glBufferSubData = &recordBufferSubData;
+
+            attributes.update(attribute.get(), GL_ARRAY_BUFFER);
+            uploads.clear();
+
+            // the buffer is created as of the next version
+            attribute->needsUpdate();
+        }
+
+        std::vector<Upload> update(const std::vector<UpdateRange>& ranges) {
+
+            for (const auto& range : ranges) attribute->addUpdateRange(range.offset, range.count);
+            attribute->needsUpdate();
+
+            uploads.clear();
+            attributes.update(attribute.get(), GL_ARRAY_BUFFER);
+
+            return uploads;
+        }
+    };
+
+}// namespace
+
+TEST_CASE("Update ranges are merged") {
+
+    REQUIRE(loadNullGL());
+
+    AttributesFixture f;
+
+    SECTION("overlapping") {
+
+        const auto result = f.update({{5, 10}, {0, 10}, {12, 2}});
+        CHECK(result == std::vector<Upload>{{false, 0, 15 * element}});
+    }
+
+    SECTION("adjacent") {
+
+        const auto result = f.update({{4, 4}, {0, 4}});
+        CHECK(result == std::vector<Upload>{{false, 0, 8 * element}});
+    }
+
+    SECTION("disjoint") {
+
+        const auto result = f.update({{10, 2}, {0, 2}, {20, 5}});
+        CHECK(result == std::vector<Upload>{{false, 0, 2 * element}, {false, 10 * element, 2 * element}, {false, 20 * element, 5 * element}});
+    }
+
+    SECTION("past the end") {
+
+        const auto result = f.update({{90, 50}, {200, 10}});
+        CHECK(result == std::vector<Upload>{{false, 90 * element, 10 * element}});
+    }
+
+    SECTION("with the single update range") {
+
+        f.attribute->updateRange = {30, 5};
+        const auto result = f.update({{35, 5}});
+        CHECK(result == std::vector<Upload>{{false, 30 * element, 10 * element}});
+    }
+
+    // the ranges are consumed by the update
+    CHECK(f.attribute->updateRanges.empty());
+    CHECK(f.attribute->updateRange.count == -1);
+}
+
+TEST_CASE("Whole buffer updates orphan the storage unless static") {
+
+    REQUIRE(loadNullGL());
+
+    AttributesFixture f;
+
+    SECTION("static") {
+
+        const auto result = f.update({});
+        CHECK(result == std::vector<Upload>{{false, 0, 100 * element}});
+    }
+
+    SECTION("dynamic") {
+
+        f.attribute->setUsage(DrawUsage::Dynamic);
+        const auto result = f.update({});
+        CHECK(result == std::vector<Upload>{{true, 0, 100 * element}});
+    }
+
+    SECTION("resized") {
+
+        f.attribute->array().resize(150);
+        const auto result = f.update({{0, 10}});
+        CHECK(result == std::vector<Upload>{{true, 0, 150 * element}});
+
+        // sized to match from then on
+        const auto next = f.update({{0, 10}});
+        CHECK(next == std::vector<Upload>{{false, 0, 10 * element}});
+    }
+}
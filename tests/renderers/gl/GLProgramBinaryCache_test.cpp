@@ -0,0 +1,103 @@
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "threepp/cameras/PerspectiveCamera.hpp"
+#include "threepp/geometries/BoxGeometry.hpp"
+#include "threepp/materials/materials.hpp"
+#include "threepp/objects/Mesh.hpp"
+#include "threepp/renderers/GLRenderer.hpp"
+#include "threepp/renderers/gl/GLProgramBinaryCache.hpp"
+#include "threepp/scenes/Scene.hpp"
+#include "threepp/utils/LoadGlad.hpp"
+
+#include <fstream>
+
+using namespace threepp;
+using namespace threepp::gl;
+
+namespace {
+
+    std::filesystem::path emptyDirectory(const std::string& name) {
+
+        const auto directory = std::filesystem::temp_directory_path() / name;
+        std::filesystem::remove_all(directory);
+
+        return directory;
+    }
+
+}// namespace
+
+TEST_CASE("Binaries are written and read back") {
+
+    REQUIRE(loadNullGL());
+
+    ProgramBinaryInfo info;
+    GLProgramBinaryCache cache(info);
+    cache.directory = emptyDirectory("threepp_binary_cache_test");
+
+    const auto key = cache.key("void main() {}", "void main() {}", std::nullopt, false);
+    CHECK(key != cache.key("void main() {}", "void main() {}", "position", false));
+    CHECK(key != cache.key("void main() {}", "void main() {}", std::nullopt, true));
+
+    unsigned int format;
+    std::vector<char> binary;
+    CHECK(!cache.read(key, format, binary));
+
+    REQUIRE(cache.write(key, 42, {'a', 'b', 'c'}));
+    REQUIRE(cache.read(key, format, binary));
+    CHECK(format == 42);
+    CHECK(binary == std::vector<char>{'a', 'b', 'c'});
+
+    CHECK(!cache.read({key.hash + 1, key.check, key.length}, format, binary));
+
+    // stored under the same name, as if the hashes collided
+    CHECK(!cache.read({key.hash, key.check + 1, key.length}, format, binary));
+    CHECK(!cache.read({key.hash, key.check, key.length + 1}, format, binary));
+    CHECK(cache.read(key, format, binary));
+
+    // truncated files are ignored
+    for (const auto& entry : std::filesystem::directory_iterator(cache.directory)) {
+        std::filesystem::resize_file(entry.path(), 8);
+    }
+    CHECK(!cache.read(key, format, binary));
+
+    std::filesystem::remove_all(cache.directory);
+}
+
+TEST_CASE("Programs are loaded from the cache on later runs") {
+
+    REQUIRE(loadNullGL());
+
+    const auto directory = emptyDirectory("threepp_program_cache_test");
+
+    PerspectiveCamera camera;
+
+    const auto run = [&] {
+        GLRenderer renderer({64, 64});
+        renderer.programCacheDirectory = directory;
+
+        auto scene = Scene::create();
+        for (const auto& material : std::vector<std::shared_ptr<Material>>{MeshBasicMaterial::create(), MeshNormalMaterial::create()}) {
+            auto mesh = Mesh::create(BoxGeometry::create(), material);
+            mesh->position.z = -10;
+            scene->add(mesh);
+        }
+
+        renderer.render(*scene, camera);
+        CHECK(renderer.info().render.calls == 2);
+
+        return renderer.info().programBinaries;
+    };
+
+    const auto first = run();
+    CHECK(first.hits == 0);
+    CHECK(first.misses == 2);
+    CHECK(first.stored == 2);
+
+    const auto second = run();
+    CHECK(second.hits == 2);
+    CHECK(second.misses == 0);
+    CHECK(second.stored == 0);
+
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,144 @@
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "threepp/cameras/PerspectiveCamera.hpp"
+#include "threepp/geometries/BoxGeometry.hpp"
+#include "threepp/lights/DirectionalLight.hpp"
+#include "threepp/materials/MeshToonMaterial.hpp"
+#include "threepp/materials/materials.hpp"
+#include "threepp/objects/Mesh.hpp"
+#include "threepp/renderers/GLRenderer.hpp"
+#include "threepp/scenes/Scene.hpp"
+#include "threepp/utils/LoadGlad.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+using namespace threepp;
+
+namespace {
+
+    // one mesh per program
+    std::shared_ptr<Scene> createScene() {
+
+        auto scene = Scene::create();
+        scene->add(DirectionalLight::create());
+
+        std::vector<std::function<std::shared_ptr<Material>()>> factories{
+                [] { return MeshBasicMaterial::create(); },
+                [] { return MeshLambertMaterial::create(); },
+                [] { return MeshPhongMaterial::create(); },
+                [] { return MeshStandardMaterial::create(); },
+                [] { return MeshToonMaterial::create(); },
+                [] { return MeshNormalMaterial::create(); }};
+
+        for (const auto& factory : factories) {
+            for (auto vertexColors : {false, true}) {
+
+                auto material = factory();
+                material->vertexColors = vertexColors;
+
+                auto mesh = Mesh::create(BoxGeometry::create(), material);
+                mesh->position.z = -10;
+                scene->add(mesh);
+            }
+        }
+
+        return scene;
+    }
+
+    size_t renderUntilDrawn(GLRenderer& renderer, Scene& scene, Camera& camera, size_t calls) {
+
+        size_t frames = 0;
+        do {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            renderer.render(scene, camera);
+            ++frames;
+
+            REQUIRE(renderer.info().render.calls <= calls);
+        } while (renderer.info().render.calls < calls && frames < 10000);
+
+        return frames;
+    }
+
+}// namespace
+
+TEST_CASE("Objects are drawn once their programs are ready") {
+
+    REQUIRE(loadNullGL());
+
+    GLRenderer renderer({64, 64});
+    renderer.asyncShaderCompilation = true;
+    renderer.autoInstancing = false;
+
+    PerspectiveCamera camera;
+    auto scene = createScene();
+
+    renderUntilDrawn(renderer, *scene, camera, 12);
+    CHECK(renderer.info().render.calls == 12);
+}
+
+TEST_CASE("compile prepares the programs of a scene") {
+
+    REQUIRE(loadNullGL());
+
+    GLRenderer renderer({64, 64});
+    PerspectiveCamera camera;
+    auto scene = createScene();
+
+    SECTION("blocking") {
+
+        renderer.compile(*scene, camera);
+
+        renderer.render(*scene, camera);
+        CHECK(renderer.info().render.calls == 12);
+    }
+
+    SECTION("async") {
+
+        renderer.asyncShaderCompilation = true;
+        renderer.compile(*scene, camera);
+
+        renderUntilDrawn(renderer, *scene, camera, 12);
+        CHECK(renderer.info().render.calls == 12);
+    }
+}
+
+TEST_CASE("Shader compilation benchmark", "[.benchmark]") {
+
+    REQUIRE(loadNullGL());
+
+    PerspectiveCamera camera;
+
+    const auto measure = [&](const std::string& name, const auto& f) {
+        GLRenderer renderer({64, 64});
+        auto scene = createScene();
+
+        const auto start = std::chrono::steady_clock::now();
+        f(renderer, *scene);
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << name << ": " << seconds * 1000 << " ms" << std::endl;
+    };
+
+    measure("first frame", [&](GLRenderer& renderer, Scene& scene) {
+        renderer.render(scene, camera);
+    });
+    measure("compile, then first frame", [&](GLRenderer& renderer, Scene& scene) {
+        renderer.compile(scene, camera);
+        renderer.render(scene, camera);
+    });
+    measure("async, until drawn", [&](GLRenderer& renderer, Scene& scene) {
+        renderer.asyncShaderCompilation = true;
+
+        double longest = 0;
+        do {
+            const auto start = std::chrono::steady_clock::now();
+            renderer.render(scene, camera);
+            longest = std::max(longest, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        } while (renderer.info().render.calls < 12);
+
+        std::cout << "longest async frame: " << longest * 1000 << " ms" << std::endl;
+    });
+}
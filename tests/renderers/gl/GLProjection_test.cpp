@@ -0,0 +1,264 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "threepp/renderers/gl/GLProjection.hpp"
+#include "threepp/renderers/gl/GLRenderLists.hpp"
+
+#include "threepp/cameras/PerspectiveCamera.hpp"
+#include "threepp/geometries/BoxGeometry.hpp"
+#include "threepp/lights/PointLight.hpp"
+#include "threepp/materials/MeshBasicMaterial.hpp"
+#include "threepp/math/MathUtils.hpp"
+#include "threepp/objects/Group.hpp"
+#include "threepp/objects/LOD.hpp"
+#include "threepp/objects/Mesh.hpp"
+#include "threepp/objects/Sprite.hpp"
+#include "threepp/scenes/Scene.hpp"
+#include "threepp/utils/ThreadPool.hpp"
+
+using namespace threepp;
+using namespace threepp::gl;
+
+namespace {
+
+    void addMeshes(Object3D& parent, size_t count, const std::vector<std::shared_ptr<BufferGeometry>>& geometries, const std::vector<std::shared_ptr<Material>>& materials) {
+
+        for (size_t i = 0; i < count; ++i) {
+            auto mesh = Mesh::create(geometries[i % geometries.size()], materials[i % materials.size()]);
+            mesh->position.set(math::randFloat(-60, 60), math::randFloat(-60, 60), math::randFloat(-60, 60));
+            mesh->renderOrder = i % 3;
+            parent.add(mesh);
+        }
+    }
+
+    std::shared_ptr<Scene> createScene() {
+
+        auto scene = Scene::create();
+
+        std::vector<std::shared_ptr<BufferGeometry>> geometries{BoxGeometry::create(), BoxGeometry::create(2, 1, 1)};
+        std::vector<std::shared_ptr<Material>> materials;
+        for (int i = 0; i < 4; ++i) {
+            auto material = MeshBasicMaterial::create();
+            material->transparent = i % 2 == 0;
+            materials.emplace_back(material);
+        }
+
+        auto light = PointLight::create();
+        light->castShadow = true;
+        scene->add(light);
+
+        // flat part of the scene, split into several jobs
+        addMeshes(*scene, 2000, geometries, materials);
+
+        // large group, split further
+        auto group = Group::create();
+        group->renderOrder = 2;
+        addMeshes(*group, 1000, geometries, materials);
+        scene->add(group);
+
+        // nested groups with small children
+        for (int i = 0; i < 50; ++i) {
+            auto g = Group::create();
+            g->renderOrder = i % 4;
+            g->visible = i % 7 != 0;
+            g->layers.set(i % 5 == 0 ? 1 : 0);
+            addMeshes(*g, 20, geometries, materials);
+            scene->add(g);
+        }
+
+        auto lod = LOD::create();
+        for (int i = 0; i < 3; ++i) {
+            auto level = Mesh::create(geometries.front(), materials.front());
+            lod->addLevel(level, static_cast<float>(i) * 20);
+        }
+        scene->add(lod);
+
+        auto sprite = Sprite::create();
+        scene->add(sprite);
+
+        scene->updateMatrixWorld();
+
+        return scene;
+    }
+
+    struct Projected {
+
+        Object3D* object;
+        ProjectedObject::Kind kind;
+        unsigned int groupOrder;
+        float z;
+
+        bool operator==(const Projected& other) const {
+            return object == other.object && kind == other.kind && groupOrder == other.groupOrder && z == other.z;
+        }
+    };
+
+    std::vector<Projected> resolve(const GLProjection& projection, const Frustum& frustum) {
+
+        std::vector<Projected> result;
+        projection.forEach([&](const ProjectedObject& item) {
+            if (item.cull == ProjectedObject::Cull::Culled) return;
+            if (item.cull == ProjectedObject::Cull::Deferred && !frustum.intersectsObject(*item.object)) return;
+
+            result.push_back({item.object, item.kind, item.groupOrder, item.z});
+        });
+
+        return result;
+    }
+
+    void fill(GLRenderList& list, const std::vector<Projected>& items) {
+
+        list.init();
+        for (const auto& item : items) {
+            if (item.kind == ProjectedObject::Kind::Light) continue;
+
+            Material* material = item.kind == ProjectedObject::Kind::Sprite
+                                         ? item.object->as<Sprite>()->material.get()
+                                         : item.object->material();
+            list.push(item.object, item.object->geometry(), material, item.groupOrder, item.z, std::nullopt);
+        }
+        list.finish();
+        list.sort();
+    }
+
+    bool sameItems(const std::vector<RenderItem*>& a, const std::vector<RenderItem*>& b) {
+
+        if (a.size() != b.size()) return false;
+
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i]->object != b[i]->object || a[i]->material != b[i]->material || a[i]->z != b[i]->z) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+}// namespace
+
+TEST_CASE("parallel projection matches serial projection") {
+
+    auto scene = createScene();
+
+    PerspectiveCamera camera(60, 1, 0.1f, 200);
+    camera.position.z = 80;
+    camera.updateMatrixWorld();
+
+    Matrix4 projScreenMatrix;
+    projScreenMatrix.multiplyMatrices(camera.projectionMatrix, camera.matrixWorldInverse);
+    Frustum frustum;
+    frustum.setFromProjectionMatrix(projScreenMatrix);
+
+    utils::ThreadPool pool(4);
+
+    // parallel first, so that bounding spheres are yet to be computed
+    GLProjection parallel;
+    parallel.jobSize = 64;
+    parallel.project(scene.get(), &camera, frustum, projScreenMatrix, true, &pool);
+    auto parallelItems = resolve(parallel, frustum);
+
+    GLProjection serial;
+    serial.project(scene.get(), &camera, frustum, projScreenMatrix, true);
+    auto serialItems = resolve(serial, frustum);
+
+    REQUIRE(!serialItems.empty());
+    REQUIRE(serialItems.size() < 2000 + 1000 + 50 * 20);
+    CHECK(serialItems == parallelItems);
+
+    GLProperties properties;
+    GLRenderList serialList(properties);
+    GLRenderList parallelList(properties);
+
+    fill(serialList, serialItems);
+    fill(parallelList, parallelItems);
+
+    CHECK(!serialList.opaque.empty());
+    CHECK(!serialList.transparent.empty());
+    CHECK(sameItems(serialList.opaque, parallelList.opaque));
+    CHECK(sameItems(serialList.transparent, parallelList.transparent));
+
+    // second frame, no deferred culling left
+    parallel.project(scene.get(), &camera, frustum, projScreenMatrix, true, &pool);
+    size_t numDeferred = 0;
+    parallel.forEach([&](const ProjectedObject& item) {
+        if (item.cull == ProjectedObject::Cull::Deferred) ++numDeferred;
+    });
+    CHECK(numDeferred == 0);
+    CHECK(resolve(parallel, frustum) == serialItems);
+}
+
+TEST_CASE("parallel projection splits deep subtrees") {
+
+    std::vector<std::shared_ptr<BufferGeometry>> geometries{BoxGeometry::create()};
+    std::vector<std::shared_ptr<Material>> materials{MeshBasicMaterial::create()};
+
+    // few direct children, each holding many objects further down
+    auto scene = Scene::create();
+    for (int i = 0; i < 4; ++i) {
+        auto group = Group::create();
+        for (int j = 0; j < 4; ++j) {
+            auto inner = Group::create();
+            addMeshes(*inner, 100, geometries, materials);
+            group->add(inner);
+        }
+        scene->add(group);
+    }
+    scene->updateMatrixWorld();
+
+    PerspectiveCamera camera(60, 1, 0.1f, 200);
+    camera.position.z = 80;
+    camera.updateMatrixWorld();
+
+    Matrix4 projScreenMatrix;
+    projScreenMatrix.multiplyMatrices(camera.projectionMatrix, camera.matrixWorldInverse);
+    Frustum frustum;
+    frustum.setFromProjectionMatrix(projScreenMatrix);
+
+    utils::ThreadPool pool(4);
+
+    GLProjection parallel;
+    parallel.jobSize = 64;
+    parallel.project(scene.get(), &camera, frustum, projScreenMatrix, true, &pool);
+
+    CHECK(parallel.numJobs() >= 16);
+
+    GLProjection serial;
+    serial.project(scene.get(), &camera, frustum, projScreenMatrix, true);
+    CHECK(resolve(parallel, frustum) == resolve(serial, frustum));
+}
+
+TEST_CASE("parallel projection splits around a large child") {
+
+    std::vector<std::shared_ptr<BufferGeometry>> geometries{BoxGeometry::create()};
+    std::vector<std::shared_ptr<Material>> materials{MeshBasicMaterial::create()};
+
+    // a large group in between small siblings
+    auto scene = Scene::create();
+    addMeshes(*scene, 10, geometries, materials);
+    auto group = Group::create();
+    addMeshes(*group, 100, geometries, materials);
+    scene->add(group);
+    addMeshes(*scene, 10, geometries, materials);
+    scene->updateMatrixWorld();
+
+    PerspectiveCamera camera(60, 1, 0.1f, 200);
+    camera.position.z = 80;
+    camera.updateMatrixWorld();
+
+    Matrix4 projScreenMatrix;
+    projScreenMatrix.multiplyMatrices(camera.projectionMatrix, camera.matrixWorldInverse);
+    Frustum frustum;
+    frustum.setFromProjectionMatrix(projScreenMatrix);
+
+    utils::ThreadPool pool(4);
+
+    GLProjection parallel;
+    parallel.jobSize = 8;
+    parallel.project(scene.get(), &camera, frustum, projScreenMatrix, true, &pool);
+
+    // 8 and 2 meshes before the group, 12 jobs of 8 and one of 4 in it, then 8 and 2 meshes after it
+    CHECK(parallel.numJobs() == 17);
+
+    GLProjection serial;
+    serial.project(scene.get(), &camera, frustum, projScreenMatrix, true);
+    CHECK(resolve(parallel, frustum) == resolve(serial, frustum));
+}
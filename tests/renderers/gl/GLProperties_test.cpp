@@ -0,0 +1,87 @@
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "threepp/materials/MeshBasicMaterial.hpp"
+#include "threepp/renderers/gl/GLProperties.hpp"
+
+#include <chrono>
+#include <iostream>
+
+using namespace threepp;
+using namespace threepp::gl;
+
+TEST_CASE("Properties are created on first access") {
+
+    GLProperties properties;
+
+    auto m1 = MeshBasicMaterial::create();
+    auto m2 = MeshBasicMaterial::create();
+
+    auto p1 = properties.materialProperties.get(m1->id);
+    auto p2 = properties.materialProperties.get(m2->id);
+
+    REQUIRE(p1 != p2);
+    CHECK(p1->version == 0);
+
+    p1->version = 3;
+    CHECK(properties.materialProperties.get(m1->id) == p1);
+
+    // references stay valid as the table grows
+    for (unsigned i = 0; i < 1000; ++i) {
+        properties.materialProperties.get(m2->id + i);
+    }
+    CHECK(properties.materialProperties.get(m1->id) == p1);
+    CHECK(p1->version == 3);
+}
+
+TEST_CASE("Removed properties are reset and recycled") {
+
+    GLProperties properties;
+
+    auto p1 = properties.textureProperties.get(7);
+    p1->glInit = true;
+    p1->version = 2;
+
+    properties.textureProperties.remove(7);
+    properties.textureProperties.remove(8);
+
+    // the storage is reused, but not the state
+    auto p2 = properties.textureProperties.get(9);
+    CHECK(p2 == p1);
+    CHECK(!p2->glInit);
+    CHECK(p2->version == 0);
+
+    auto p3 = properties.textureProperties.get(7);
+    CHECK(p3 != p2);
+    CHECK(!p3->glInit);
+}
+
+TEST_CASE("GLProperties benchmark", "[.benchmark]") {
+
+    constexpr int materialCount = 1000;
+    constexpr int draws = 1000000;
+
+    std::vector<std::shared_ptr<Material>> materials;
+    for (int i = 0; i < materialCount; ++i) {
+        materials.emplace_back(MeshBasicMaterial::create());
+    }
+
+    GLProperties properties;
+    std::unordered_map<std::string, MaterialProperties> byUuid;
+
+    const auto measure = [&](const std::string& name, const auto& lookup) {
+        unsigned int sum = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < draws; ++i) {
+            sum += lookup(*materials[i % materialCount])->version;
+        }
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << name << ": " << seconds * 1e9 / draws << " ns per lookup (" << sum << ")" << std::endl;
+    };
+
+    // the previous implementation, hashing a copy of the uuid on every lookup
+    measure("uuid", [&](const Material& material) { return &byUuid[material.uuid()]; });
+    measure("id", [&](const Material& material) { return properties.materialProperties.get(material.id); });
+}
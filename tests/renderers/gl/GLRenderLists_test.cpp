@@ -9,6 +9,11 @@
 #include "threepp/renderers/gl/GLProperties.hpp"
 #include "threepp/renderers/gl/GLRenderLists.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+
 using namespace threepp;
 using namespace threepp::gl;
 
@@ -87,16 +92,16 @@ TEST_CASE("push") {
     GLProgram proD;
     BufferGeometry geoD;
 
-    auto materialProperties = properties.materialProperties.get(matA.uuid());
+    auto materialProperties = properties.materialProperties.get(matA.id);
     materialProperties->program = &proA;
 
-    materialProperties = properties.materialProperties.get(matB.uuid());
+    materialProperties = properties.materialProperties.get(matB.id);
     materialProperties->program = &proB;
 
-    materialProperties = properties.materialProperties.get(matC.uuid());
+    materialProperties = properties.materialProperties.get(matC.id);
     materialProperties->program = &proC;
 
-    materialProperties = properties.materialProperties.get(matD.uuid());
+    materialProperties = properties.materialProperties.get(matD.id);
     materialProperties->program = &proD;
 
     // A
@@ -171,3 +176,176 @@ TEST_CASE("push") {
         CHECK(!o->group.has_value());
     }
 }
+
+TEST_CASE("sort groups opaque items by geometry when asked to") {
+
+    GLProperties properties;
+    GLRenderList list(properties);
+
+    BufferGeometry geoA;
+    BufferGeometry geoB;
+    DummyMaterial material;
+
+    std::vector<std::unique_ptr<Object3D>> objects;
+    for (int i = 0; i < 6; ++i) {
+
+        objects.emplace_back(std::make_unique<Object3D>());
+    }
+
+    const auto push = [&] {
+        for (int i = 0; i < 6; ++i) {
+            list.push(objects[i].get(), i % 2 == 0 ? &geoA : &geoB, &material, 0, static_cast<float>(i), std::nullopt);
+        }
+    };
+
+    list.init();
+    push();
+    list.sort();
+
+    // front to back only
+    REQUIRE(list.opaque.size() == 6);
+    for (int i = 0; i < 6; ++i) {
+        CHECK(list.opaque[i]->z == static_cast<float>(i));
+    }
+
+    list.init(true);
+    push();
+    list.sort();
+
+    REQUIRE(list.opaque.size() == 6);
+    for (int i = 0; i < 3; ++i) {
+        CHECK(list.opaque[i]->geometry == &geoA);
+        CHECK(list.opaque[i + 3]->geometry == &geoB);
+    }
+
+    // front to back within a geometry
+    CHECK(list.opaque[0]->z < list.opaque[1]->z);
+    CHECK(list.opaque[1]->z < list.opaque[2]->z);
+}
+
+namespace {
+
+    // one list of objects, materials, geometries and programs to sort
+    struct SortFixture {
+
+        GLProperties properties;
+
+        std::vector<std::unique_ptr<Object3D>> objects;
+        std::vector<std::unique_ptr<DummyMaterial>> materials;
+        std::vector<std::unique_ptr<BufferGeometry>> geometries;
+        std::vector<std::unique_ptr<GLProgram>> programs;
+
+        explicit SortFixture(size_t count, unsigned int maxRenderOrder = 4) {
+
+            for (int i = 0; i < 16; ++i) {
+
+                auto& material = materials.emplace_back(std::make_unique<DummyMaterial>());
+                material->transparent = i % 4 == 0;
+
+                auto& program = programs.emplace_back(std::make_unique<GLProgram>());
+                properties.materialProperties.get(material->id)->program = program.get();
+
+                geometries.emplace_back(std::make_unique<BufferGeometry>());
+            }
+
+            std::mt19937 rng(42);
+            for (size_t i = 0; i < count; ++i) {
+
+                auto& object = objects.emplace_back(std::make_unique<Object3D>());
+                object->renderOrder = rng() % maxRenderOrder;
+            }
+        }
+
+        void push(GLRenderList& list) {
+
+            std::mt19937 rng(7);
+            std::uniform_real_distribution<float> depth(-1, 1);
+
+            for (auto& object : objects) {
+                list.push(object.get(), geometries[rng() % geometries.size()].get(), materials[rng() % materials.size()].get(), rng() % 3, depth(rng), std::nullopt);
+            }
+        }
+    };
+
+    // the comparators sorting the lists before keys were precomputed
+    bool painterSortStable(const RenderItem* a, const RenderItem* b, bool groupByGeometry) {
+
+        if (a->groupOrder != b->groupOrder) return a->groupOrder < b->groupOrder;
+        if (a->renderOrder != b->renderOrder) return a->renderOrder < b->renderOrder;
+        if (a->program->id != b->program->id) return a->program->id < b->program->id;
+        if (a->material->id != b->material->id) return a->material->id < b->material->id;
+        if (groupByGeometry && a->geometry->id != b->geometry->id) return a->geometry->id < b->geometry->id;
+        return a->z < b->z;
+    }
+
+    bool reversePainterSortStable(const RenderItem* a, const RenderItem* b) {
+
+        if (a->groupOrder != b->groupOrder) return a->groupOrder < b->groupOrder;
+        if (a->renderOrder != b->renderOrder) return a->renderOrder < b->renderOrder;
+        return a->z > b->z;
+    }
+
+}// namespace
+
+TEST_CASE("sort orders as the painter comparators") {
+
+    for (auto count : {50, 5000}) {
+        for (unsigned int maxRenderOrder : {4u, 1u << 20}) {
+
+            SortFixture fixture(count, maxRenderOrder);
+            GLRenderList list(fixture.properties);
+
+            // the second frame reuses the items of the first
+            for (int frame = 0; frame < 2; ++frame) {
+
+                const bool groupByGeometry = frame == 1;
+
+                list.init(groupByGeometry);
+                fixture.push(list);
+
+                auto opaque = list.opaque;
+                auto transparent = list.transparent;
+                std::stable_sort(opaque.begin(), opaque.end(), [&](auto a, auto b) {
+                    return painterSortStable(a, b, groupByGeometry);
+                });
+                std::stable_sort(transparent.begin(), transparent.end(), reversePainterSortStable);
+
+                list.sort();
+                list.finish();
+
+                CHECK(list.opaque.size() + list.transparent.size() == static_cast<size_t>(count));
+                CHECK(list.opaque == opaque);
+                CHECK(list.transparent == transparent);
+            }
+        }
+    }
+}
+
+TEST_CASE("GLRenderList benchmark", "[.benchmark]") {
+
+    constexpr size_t count = 100000;
+    constexpr int frames = 20;
+
+    SortFixture fixture(count);
+    GLRenderList list(fixture.properties);
+
+    const auto measure = [&](const std::string& name, const auto& sort) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < frames; ++i) {
+            list.init();
+            fixture.push(list);
+            sort();
+            list.finish();
+        }
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << name << ": " << seconds * 1e3 / frames << " ms to push and sort " << count << " items" << std::endl;
+    };
+
+    measure("no sort", [] {});
+    measure("comparators", [&] {
+        std::stable_sort(list.opaque.begin(), list.opaque.end(), [](auto a, auto b) { return painterSortStable(a, b, false); });
+        std::stable_sort(list.transparent.begin(), list.transparent.end(), reversePainterSortStable);
+    });
+    measure("radix", [&] { list.sort(); });
+}
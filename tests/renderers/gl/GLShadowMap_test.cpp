@@ -0,0 +1,309 @@
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "threepp/cameras/PerspectiveCamera.hpp"
+#include "threepp/geometries/BoxGeometry.hpp"
+#include "threepp/lights/DirectionalLight.hpp"
+#include "threepp/lights/DirectionalLightShadow.hpp"
+#include "threepp/materials/MeshLambertMaterial.hpp"
+#include "threepp/objects/Mesh.hpp"
+#include "threepp/renderers/GLRenderTarget.hpp"
+#include "threepp/renderers/GLRenderer.hpp"
+#include "threepp/scenes/Scene.hpp"
+#include "threepp/utils/LoadGlad.hpp"
+
+#include <cmath>
+
+using namespace threepp;
+
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+    struct CascadeFixture {
+
+        std::shared_ptr<DirectionalLight> light = DirectionalLight::create();
+        std::shared_ptr<DirectionalLightShadow> shadow = std::dynamic_pointer_cast<DirectionalLightShadow>(light->shadow);
+        PerspectiveCamera camera{60, 1, 0.5f, 100};
+
+        CascadeFixture() {
+
+            light->position.set(10, 30, 20);
+            light->updateMatrixWorld();
+            light->target->updateMatrixWorld();
+
+            shadow->cascades = 4;
+            shadow->camera->near = 1;
+            shadow->camera->far = 200;
+
+            camera.position.set(0, 2, 10);
+            camera.lookAt({0, 0, 0});
+            camera.updateMatrixWorld();
+        }
+
+        // the position in the shadow map of a world position, using the cascade's own camera
+        Vector2 cascadeCoord(size_t cascade, const Vector3& position) {
+
+            shadow->updateMatrices(light.get(), cascade);
+
+            auto coord = Vector3(position).applyMatrix4(shadow->camera->matrixWorldInverse).applyMatrix4(shadow->camera->projectionMatrix);
+            const auto& viewport = shadow->getViewport(cascade);
+            const auto& extents = shadow->getFrameExtents();
+
+            return {(0.5f * coord.x + 0.5f + viewport.x) / extents.x, (0.5f * coord.y + 0.5f + viewport.y) / extents.y};
+        }
+
+        // the position in the shadow map as computed by the shaders
+        Vector2 shaderCoord(size_t cascade, const Vector3& position) {
+
+            const auto coord = Vector3(position).applyMatrix4(shadow->matrix);
+            const auto column = shadow->getCascadeTransforms().elements.data() + cascade * 4;
+
+            return {coord.x * column[0] + column[2], coord.y * column[1] + column[3]};
+        }
+
+        Vector3 pointAtDepth(float depth, float x, float y) {
+
+            return Vector3(x, y, -depth).applyMatrix4(*camera.matrixWorld);
+        }
+    };
+
+}// namespace
+
+TEST_CASE("A single cascade keeps the shadow camera") {
+
+    CascadeFixture f;
+    f.shadow->cascades = 1;
+    f.shadow->updateCascades(f.light.get(), f.camera);
+
+    CHECK(f.shadow->getViewportCount() == 1);
+    CHECK(f.shadow->getFrameExtents() == Vector2(1, 1));
+
+    auto shadowCamera = f.shadow->camera->as<OrthographicCamera>();
+    CHECK(shadowCamera->left == -5);
+    CHECK(shadowCamera->right == 5);
+}
+
+TEST_CASE("Cascades split the view frustum") {
+
+    CascadeFixture f;
+    f.shadow->cascadeDistance = 50;
+    f.shadow->updateCascades(f.light.get(), f.camera);
+
+    CHECK(f.shadow->getViewportCount() == 4);
+    CHECK(f.shadow->getFrameExtents() == Vector2(2, 2));
+
+    const auto& splits = f.shadow->getCascadeSplits();
+    CHECK(f.camera.near < splits.x);
+    CHECK(splits.x < splits.y);
+    CHECK(splits.y < splits.z);
+    CHECK(splits.z < f.shadow->getCascadeFar());
+    CHECK(f.shadow->getCascadeFar() == 50);
+
+    // the nearest cascade covers the smallest area
+    float previousWidth = 0;
+    for (size_t i = 0; i < 4; ++i) {
+
+        f.shadow->updateMatrices(f.light.get(), i);
+        auto shadowCamera = f.shadow->camera->as<OrthographicCamera>();
+
+        const auto width = shadowCamera->right - shadowCamera->left;
+        CHECK(width > previousWidth);
+        previousWidth = width;
+    }
+}
+
+TEST_CASE("Shadow coordinates are mapped to each cascade") {
+
+    CascadeFixture f;
+    f.shadow->updateCascades(f.light.get(), f.camera);
+
+    const auto& splits = f.shadow->getCascadeSplits();
+    const float depths[4] = {0.5f * (f.camera.near + splits.x), 0.5f * (splits.x + splits.y), 0.5f * (splits.y + splits.z), 0.5f * (splits.z + f.shadow->getCascadeFar())};
+
+    for (size_t i = 0; i < 4; ++i) {
+
+        const auto position = f.pointAtDepth(depths[i], 0.3f * depths[i], -0.2f * depths[i]);
+
+        const auto expected = f.cascadeCoord(i, position);
+        const auto actual = f.shaderCoord(i, position);
+
+        CHECK_THAT(actual.x, WithinAbs(expected.x, 1e-4));
+        CHECK_THAT(actual.y, WithinAbs(expected.y, 1e-4));
+
+        // and within the part of the map the cascade is rendered to
+        const auto& viewport = f.shadow->getViewport(i);
+        CHECK(actual.x >= viewport.x / 2);
+        CHECK(actual.x <= (viewport.x + 1) / 2);
+        CHECK(actual.y >= viewport.y / 2);
+        CHECK(actual.y <= (viewport.y + 1) / 2);
+    }
+}
+
+TEST_CASE("Cascades move in whole texels") {
+
+    CascadeFixture f;
+    f.shadow->updateCascades(f.light.get(), f.camera);
+
+    std::vector<std::pair<float, float>> before;
+    for (size_t i = 0; i < 4; ++i) {
+
+        f.shadow->updateMatrices(f.light.get(), i);
+        auto shadowCamera = f.shadow->camera->as<OrthographicCamera>();
+        before.emplace_back(shadowCamera->left, shadowCamera->right);
+    }
+
+    f.camera.position.x += 0.123f;
+    f.camera.rotation.y += 0.05f;
+    f.camera.updateMatrixWorld();
+    f.shadow->updateCascades(f.light.get(), f.camera);
+
+    for (size_t i = 0; i < 4; ++i) {
+
+        f.shadow->updateMatrices(f.light.get(), i);
+        const auto& after = *f.shadow->camera->as<OrthographicCamera>();
+
+        const auto [left, right] = before[i];
+        const auto width = right - left;
+        CHECK_THAT(after.right - after.left, WithinAbs(width, 1e-4));
+
+        const auto texels = (after.left - left) / (width / f.shadow->mapSize.x);
+        CHECK_THAT(texels, WithinAbs(std::round(texels), 1e-2));
+    }
+}
+
+TEST_CASE("Cascades are rendered side by side in one map") {
+
+    REQUIRE(loadNullGL());
+
+    GLRenderer renderer({64, 64});
+    renderer.shadowMap().enabled = true;
+
+    CascadeFixture f;
+    f.light->castShadow = true;
+    f.shadow->mapSize.set(256, 256);
+
+    auto scene = Scene::create();
+    scene->add(f.light);
+
+    auto mesh = Mesh::create(BoxGeometry::create(), MeshLambertMaterial::create());
+    mesh->castShadow = true;
+    mesh->receiveShadow = true;
+    scene->add(mesh);
+
+    renderer.render(*scene, f.camera);
+    REQUIRE(f.shadow->map);
+    CHECK(f.shadow->map->width == 512);
+    CHECK(f.shadow->map->height == 512);
+
+    f.shadow->cascades = 2;
+    renderer.render(*scene, f.camera);
+    CHECK(f.shadow->map->width == 512);
+    CHECK(f.shadow->map->height == 256);
+
+    f.shadow->cascades = 1;
+    renderer.render(*scene, f.camera);
+    CHECK(f.shadow->map->width == 256);
+    CHECK(f.shadow->map->height == 256);
+}
+
+TEST_CASE("Shadow maps of unchanged lights are not redrawn") {
+
+    REQUIRE(loadNullGL());
+
+    GLRenderer renderer({64, 64});
+    renderer.shadowMap().enabled = true;
+    CHECK(!renderer.shadowMap().cacheStaticCasters);
+    renderer.shadowMap().cacheStaticCasters = true;
+
+    PerspectiveCamera camera{60, 1, 0.5f, 100};
+    camera.position.set(0, 2, 10);
+
+    auto scene = Scene::create();
+
+    auto light = DirectionalLight::create();
+    light->position.set(10, 30, 20);
+    light->castShadow = true;
+    scene->add(light);
+
+    std::vector<std::shared_ptr<Mesh>> meshes;
+    for (int i = 0; i < 3; ++i) {
+
+        // distinct geometries, so that the meshes are drawn one by one
+        auto mesh = Mesh::create(BoxGeometry::create(1, 1, 1, i + 1), MeshLambertMaterial::create());
+        mesh->position.x = static_cast<float>(i * 2 - 2);
+        mesh->castShadow = true;
+        scene->add(mesh);
+        meshes.push_back(mesh);
+    }
+
+    const auto render = [&] {
+        renderer.render(*scene, camera);
+        return renderer.info().shadows;
+    };
+
+    auto shadows = render();
+    CHECK(shadows.rendered == 1);
+    CHECK(shadows.calls == 3);
+
+    shadows = render();
+    CHECK(shadows.rendered == 0);
+    CHECK(shadows.skipped == 1);
+    CHECK(shadows.calls == 0);
+
+    SECTION("moving the light") {
+
+        light->position.x += 1;
+        shadows = render();
+        CHECK(shadows.rendered == 1);
+        CHECK(shadows.calls == 3);
+
+        CHECK(render().skipped == 1);
+    }
+
+    SECTION("setting needsUpdate") {
+
+        light->shadow->needsUpdate = true;
+        CHECK(render().rendered == 1);
+        CHECK(render().skipped == 1);
+    }
+
+    SECTION("moving a caster") {
+
+        // the static casters are drawn again without the moving one, which is then drawn on its own
+        meshes[0]->position.y += 1;
+        shadows = render();
+        CHECK(shadows.rendered == 1);
+        CHECK(shadows.calls == 3);
+
+        for (int i = 0; i < 3; ++i) {
+
+            meshes[0]->position.y += 1;
+            shadows = render();
+            CHECK(shadows.composited == 1);
+            CHECK(shadows.calls == 1);
+        }
+    }
+
+    SECTION("editing a caster") {
+
+        // the edited caster is drawn on its own until it settles again
+        meshes[1]->geometry()->getAttribute<float>("position")->needsUpdate();
+        shadows = render();
+        CHECK(shadows.rendered == 1);
+        CHECK(shadows.calls == 3);
+        CHECK(render().calls == 1);
+
+        meshes[2]->material()->needsUpdate();
+        CHECK(render().rendered == 1);
+        CHECK(render().calls == 2);
+    }
+
+    SECTION("without caching") {
+
+        renderer.shadowMap().cacheStaticCasters = false;
+        CHECK(render().calls == 3);
+        CHECK(render().calls == 3);
+    }
+}
@@ -0,0 +1,124 @@
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "threepp/geometries/BoxGeometry.hpp"
+#include "threepp/materials/MeshBasicMaterial.hpp"
+#include "threepp/materials/MeshPhongMaterial.hpp"
+#include "threepp/cameras/PerspectiveCamera.hpp"
+#include "threepp/objects/Mesh.hpp"
+#include "threepp/renderers/GLRenderer.hpp"
+#include "threepp/scenes/Scene.hpp"
+#include "threepp/utils/LoadGlad.hpp"
+
+#include <chrono>
+#include <iostream>
+
+using namespace threepp;
+using namespace threepp::gl;
+
+namespace {
+
+    std::shared_ptr<Scene> createScene(int meshCount) {
+
+        auto scene = Scene::create();
+
+        std::vector<std::shared_ptr<Material>> materials{MeshBasicMaterial::create(), MeshPhongMaterial::create()};
+        for (int i = 0; i < meshCount; ++i) {
+
+            // distinct geometries, so that the meshes are not instanced
+            auto mesh = Mesh::create(BoxGeometry::create(), materials[i % materials.size()]);
+            mesh->position.set(static_cast<float>(i % 50 - 25), static_cast<float>(i / 50 - 20), -60);
+            scene->add(mesh);
+        }
+
+        return scene;
+    }
+
+}// namespace
+
+TEST_CASE("Redundant binds are skipped") {
+
+    REQUIRE(loadNullGL());
+
+    GLInfo info;
+    GLState state(info);
+
+    CHECK(state.useProgram(1));
+    CHECK(!state.useProgram(1));
+    CHECK(info.state.programs == 1);
+
+    state.activeTexture(GL_TEXTURE0);
+    state.bindTexture(GL_TEXTURE_2D, 5);
+    state.bindTexture(GL_TEXTURE_2D, 5);
+    CHECK(info.state.textures == 1);
+
+    // the name may be reused by a new texture, which then needs binding
+    state.deleteTexture(5);
+    state.bindTexture(GL_TEXTURE_2D, 5);
+    CHECK(info.state.textures == 2);
+
+    CHECK(state.bindBuffer(GL_ARRAY_BUFFER, 3));
+    CHECK(!state.bindBuffer(GL_ARRAY_BUFFER, 3));
+    state.deleteBuffer(3);
+    CHECK(state.bindBuffer(GL_ARRAY_BUFFER, 3));
+
+    // part of the vertex array state
+    CHECK(state.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 4));
+    CHECK(state.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 4));
+    CHECK(info.state.buffers == 4);
+
+    CHECK(state.bindVertexArray(2));
+    CHECK(!state.bindVertexArray(2));
+    CHECK(info.state.vertexArrays == 1);
+
+    CHECK(info.state.skipped == 4);
+
+    info.reset();
+    CHECK(info.state.programs == 0);
+    CHECK(info.state.skipped == 0);
+}
+
+TEST_CASE("Renderer binds counted per frame") {
+
+    REQUIRE(loadNullGL());
+
+    GLRenderer renderer({64, 64});
+    PerspectiveCamera camera;
+
+    auto scene = createScene(100);
+
+    renderer.render(*scene, camera);
+    const auto first = renderer.info().state;
+    CHECK(first.buffers > 0);
+
+    renderer.render(*scene, camera);
+    const auto& second = renderer.info();
+
+    CHECK(second.render.calls == 100);
+    // sorted by program, and nothing left to upload
+    CHECK(second.state.programs <= 2);
+    CHECK(second.state.vertexArrays == 100);
+    CHECK(second.state.buffers == 0);
+}
+
+TEST_CASE("GLRenderer benchmark", "[.benchmark]") {
+
+    REQUIRE(loadNullGL());
+
+    constexpr int frames = 100;
+
+    GLRenderer renderer({1024, 1024});
+    PerspectiveCamera camera;
+
+    auto scene = createScene(2000);
+    renderer.render(*scene, camera);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) {
+        renderer.render(*scene, camera);
+    }
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "2000 meshes: " << seconds * 1000 / frames << " ms per frame" << std::endl;
+    std::cout << renderer.info() << std::endl;
+}
@@ -0,0 +1,214 @@
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "threepp/renderers/gl/GLTextures.hpp"
+#include "threepp/utils/LoadGlad.hpp"
+
+using namespace threepp;
+using namespace threepp::gl;
+
+namespace {
+
+    constexpr unsigned int size = 64;
+    constexpr size_t textureBytes = size * size * 4;
+
+    std::vector<std::shared_ptr<Texture>> createTextures(int count) {
+
+        std::vector<std::shared_ptr<Texture>> textures;
+        for (int i = 0; i < count; ++i) {
+
+            auto texture = Texture::create(Image{std::vector<unsigned char>(textureBytes, 255), size, size});
+            texture->needsUpdate();
+            textures.emplace_back(texture);
+        }
+
+        return textures;
+    }
+
+    struct TexturesFixture {
+
+        GLInfo info;
+        GLState state{info};
+        GLProperties properties;
+        GLTextures textures{state, properties, info};
+
+        // binds every texture, as when rendering a frame
+        void frame(const std::vector<std::shared_ptr<Texture>>& list) {
+
+            info.reset();
+            textures.beginUploads();
+
+            for (const auto& texture : list) textures.setTexture2D(*texture, 0);
+            textures.evict();
+        }
+    };
+
+}// namespace
+
+TEST_CASE("Texture uploads are spread over frames") {
+
+    REQUIRE(loadNullGL());
+
+    TexturesFixture f;
+    const auto textures = createTextures(5);
+
+    SECTION("without a budget") {
+
+        f.frame(textures);
+        CHECK(f.info.textures.uploads == 5);
+        CHECK(f.info.textures.bytes == 5 * textureBytes);
+        CHECK(f.info.textures.deferred == 0);
+    }
+
+    SECTION("with a byte budget") {
+
+        f.textures.uploadBudgetBytes = 2 * textureBytes;
+
+        f.frame(textures);
+        CHECK(f.info.textures.uploads == 2);
+        CHECK(f.info.textures.deferred == 3);
+
+        f.frame(textures);
+        CHECK(f.info.textures.uploads == 2);
+        CHECK(f.info.textures.deferred == 1);
+
+        f.frame(textures);
+        CHECK(f.info.textures.uploads == 1);
+        CHECK(f.info.textures.deferred == 0);
+
+        f.frame(textures);
+        CHECK(f.info.textures.uploads == 0);
+
+        // updated textures are uploaded again
+        textures.front()->needsUpdate();
+        f.frame(textures);
+        CHECK(f.info.textures.uploads == 1);
+    }
+
+    SECTION("one texture is uploaded each frame however large") {
+
+        f.textures.uploadBudgetBytes = 1;
+
+        for (int i = 0; i < 5; ++i) {
+
+            f.frame(textures);
+            CHECK(f.info.textures.uploads == 1);
+        }
+
+        f.frame(textures);
+        CHECK(f.info.textures.uploads == 0);
+    }
+}
+
+TEST_CASE("Least recently used textures are evicted over the memory budget") {
+
+    REQUIRE(loadNullGL());
+
+    TexturesFixture f;
+    const auto textures = createTextures(4);
+    for (const auto& texture : textures) texture->minFilter = Filter::Linear;
+
+    f.textures.memoryBudgetBytes = 2 * textureBytes;
+
+    // the textures used in a frame are kept, whatever the budget
+    f.frame(textures);
+    CHECK(f.info.textures.uploads == 4);
+    CHECK(f.info.textures.evictions == 0);
+    CHECK(f.info.memory.textures == 4);
+    CHECK(f.info.memory.textureBytes == 4 * textureBytes);
+
+    f.frame({textures[2], textures[3]});
+    CHECK(f.info.textures.uploads == 0);
+    CHECK(f.info.textures.evictions == 2);
+    CHECK(f.info.textures.evicted == 2 * textureBytes);
+    CHECK(f.info.memory.textures == 2);
+    CHECK(f.info.memory.textureBytes == 2 * textureBytes);
+    CHECK(!f.textures.getGlTexture(*textures[0]));
+    CHECK(f.textures.getGlTexture(*textures[2]));
+
+    // evicted textures are uploaded again when used
+    f.frame({textures[3], textures[0]});
+    CHECK(f.info.textures.uploads == 1);
+    CHECK(f.info.textures.evictions == 1);
+    CHECK(f.info.memory.textures == 2);
+    CHECK(f.textures.getGlTexture(*textures[0]));
+    CHECK(!f.textures.getGlTexture(*textures[2]));
+
+    textures[3]->dispose();
+    CHECK(f.info.memory.textures == 1);
+    CHECK(f.info.memory.textureBytes == textureBytes);
+
+    f.frame({textures[1]});
+    CHECK(f.info.textures.uploads == 1);
+    CHECK(f.info.textures.evictions == 0);
+    CHECK(f.info.memory.textureBytes == 2 * textureBytes);
+}
+
+TEST_CASE("Eviction spans frames of several passes") {
+
+    REQUIRE(loadNullGL());
+
+    TexturesFixture f;
+    const auto textures = createTextures(3);
+    for (const auto& texture : textures) texture->minFilter = Filter::Linear;
+
+    f.textures.memoryBudgetBytes = 2 * textureBytes;
+
+    // a scene and a HUD drawn over it, each frame
+    for (int i = 0; i < 3; ++i) {
+
+        f.textures.beginFrame();
+        f.frame({textures[0], textures[1]});
+        f.frame({textures[2]});
+    }
+
+    CHECK(f.info.textures.uploads == 0);
+    CHECK(f.info.memory.textures == 3);
+
+    // a frame without the HUD, after which its texture is evicted
+    f.textures.beginFrame();
+    f.frame({textures[0], textures[1]});
+    CHECK(f.info.memory.textures == 3);
+
+    f.textures.beginFrame();
+    CHECK(f.info.textures.evictions == 1);
+    CHECK(f.info.memory.textures == 2);
+    CHECK(!f.textures.getGlTexture(*textures[2]));
+}
+
+TEST_CASE("Textures written on the GPU are not evicted") {
+
+    REQUIRE(loadNullGL());
+
+    TexturesFixture f;
+    const auto textures = createTextures(3);
+    for (const auto& texture : textures) texture->minFilter = Filter::Linear;
+
+    f.textures.memoryBudgetBytes = textureBytes;
+
+    f.frame(textures);
+    f.textures.keepResident(*textures[0]);
+
+    f.frame({textures[2]});
+    CHECK(f.info.textures.evictions == 1);
+    CHECK(f.textures.getGlTexture(*textures[0]));
+    CHECK(!f.textures.getGlTexture(*textures[1]));
+
+    // uploading from the image again makes it evictable
+    textures[0]->needsUpdate();
+    f.frame({textures[0]});
+    f.frame({textures[2]});
+    CHECK(!f.textures.getGlTexture(*textures[0]));
+}
+
+TEST_CASE("Generated mipmaps count towards the texture memory") {
+
+    REQUIRE(loadNullGL());
+
+    TexturesFixture f;
+    const auto textures = createTextures(1);
+
+    f.frame(textures);
+    // 64x64 down to 1x1
+    CHECK(f.info.memory.textureBytes == 4 * (4096 + 1024 + 256 + 64 + 16 + 4 + 1));
+}
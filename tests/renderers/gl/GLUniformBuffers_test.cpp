@@ -0,0 +1,90 @@
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "threepp/cameras/OrthographicCamera.hpp"
+#include "threepp/cameras/PerspectiveCamera.hpp"
+#include "threepp/renderers/gl/GLUniformBuffers.hpp"
+
+#include <cstring>
+
+using namespace threepp;
+using namespace threepp::gl;
+
+namespace {
+
+    uint32_t bitsAt(const std::vector<float>& data, size_t index) {
+
+        uint32_t bits;
+        std::memcpy(&bits, &data[index], sizeof(bits));
+
+        return bits;
+    }
+
+}// namespace
+
+TEST_CASE("CameraBlock layout") {
+
+    PerspectiveCamera camera;
+    camera.position.set(1, 2, 3);
+    camera.updateMatrixWorld();
+
+    std::vector<float> data;
+    GLUniformBuffers::writeCamera(camera, data);
+
+    // mat4, mat4, vec3 and bool, padded to 16 bytes
+    REQUIRE(data.size() * 4 == 144);
+
+    CHECK(std::equal(data.begin(), data.begin() + 16, camera.projectionMatrix.elements.begin()));
+    CHECK(std::equal(data.begin() + 16, data.begin() + 32, camera.matrixWorldInverse.elements.begin()));
+    CHECK(data[32] == 1);
+    CHECK(data[33] == 2);
+    CHECK(data[34] == 3);
+    CHECK(bitsAt(data, 35) == 0);
+
+    OrthographicCamera ortho;
+    GLUniformBuffers::writeCamera(ortho, data);
+    CHECK(bitsAt(data, 35) == 1);
+}
+
+TEST_CASE("LightsBlock layout") {
+
+    GLLights lights;
+
+    auto ambient = AmbientLight::create(Color(0.5f, 0.25f, 0.125f));
+    auto directional = DirectionalLight::create(Color(1, 0, 0));
+    auto point = PointLight::create(Color(0, 1, 0), 1, 10, 2);
+    auto spot = SpotLight::create(Color(0, 0, 1), 1, 20);
+    auto hemi = HemisphereLight::create(Color(1, 1, 0), Color(0, 1, 1));
+
+    std::vector<Light*> array{ambient.get(), directional.get(), point.get(), spot.get(), hemi.get()};
+    lights.setup(array);
+
+    PerspectiveCamera camera;
+    lights.setupView(array, &camera);
+
+    std::vector<float> data;
+    GLUniformBuffers::writeLights(lights.state, data);
+
+    // ambient (16 bytes), 9 probes (16 each), then one light of each type: 32, 48, 64 and 48 bytes
+    REQUIRE(data.size() * 4 == 16 + 9 * 16 + 32 + 48 + 64 + 48);
+
+    CHECK(data[0] == 0.5f);
+    CHECK(data[1] == 0.25f);
+    CHECK(data[2] == 0.125f);
+
+    const size_t directionalOffset = (16 + 9 * 16) / 4;
+    CHECK(data[directionalOffset + 4] == 1);// color.r
+
+    const size_t pointOffset = directionalOffset + 32 / 4;
+    CHECK(data[pointOffset + 5] == 1);// color.g
+    CHECK(data[pointOffset + 7] == 10);// distance
+    CHECK(data[pointOffset + 8] == 2); // decay
+
+    const size_t spotOffset = pointOffset + 48 / 4;
+    CHECK(data[spotOffset + 10] == 1);// color.b
+    CHECK(data[spotOffset + 11] == 20);// distance
+
+    const size_t hemiOffset = spotOffset + 64 / 4;
+    CHECK(data[hemiOffset + 4] == 1);// skyColor.r
+    CHECK(data[hemiOffset + 10] == 1);// groundColor.b
+}
@@ -0,0 +1,119 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "threepp/renderers/gl/ProgramCacheKey.hpp"
+
+#include <unordered_map>
+
+using namespace threepp::gl;
+
+namespace {
+
+    ProgramCacheKey createKey(bool flag, int value, float alphaTest) {
+
+        ProgramCacheKey key;
+        key.addSource("basic");
+        key.addFlag(false);
+        key.addFlag(flag);
+        key.addValue(value);
+        key.addValue(alphaTest);
+
+        return key;
+    }
+
+}// namespace
+
+TEST_CASE("ProgramCacheKey equality") {
+
+    const auto key = createKey(true, 2, 0.5f);
+
+    CHECK(key == createKey(true, 2, 0.5f));
+    CHECK(ProgramCacheKey::Hash()(key) == ProgramCacheKey::Hash()(createKey(true, 2, 0.5f)));
+
+    CHECK(key != createKey(false, 2, 0.5f));
+    CHECK(key != createKey(true, 3, 0.5f));
+    CHECK(key != createKey(true, 2, 0.6f));
+
+    ProgramCacheKey other;
+    other.addSource("phong");
+    CHECK(other != ProgramCacheKey());
+}
+
+TEST_CASE("ProgramCacheKey sources") {
+
+    ProgramCacheKey a;
+    a.addSource("ab");
+    a.addSource("c");
+
+    ProgramCacheKey b;
+    b.addSource("a");
+    b.addSource("bc");
+
+    CHECK(a != b);
+}
+
+TEST_CASE("ProgramCacheKey defines") {
+
+    ProgramCacheKey a;
+    a.addDefine("USE_A", "1");
+    a.addDefine("USE_B", "");
+
+    ProgramCacheKey b;
+    b.addDefine("USE_B", "");
+    b.addDefine("USE_A", "1");
+
+    CHECK(a == b);
+
+    ProgramCacheKey c;
+    c.addDefine("USE_A", "");
+    c.addDefine("USE_B", "1");
+
+    CHECK(a != c);
+}
+
+TEST_CASE("ProgramCacheKey as map key") {
+
+    std::unordered_map<ProgramCacheKey, int, ProgramCacheKey::Hash> programs;
+
+    for (int i = 0; i < 100; ++i) {
+        programs[createKey(i % 2 == 0, i, 0)] = i;
+    }
+
+    CHECK(programs.size() == 100);
+    CHECK(programs.at(createKey(true, 42, 0)) == 42);
+    CHECK(programs.count(createKey(false, 42, 0)) == 0);
+}
+
+TEST_CASE("ProgramCacheKey hash collisions") {
+
+    ProgramCacheKey a;
+    a.addSource("basic");
+    a.addDefine("USE_A", "1");
+
+    ProgramCacheKey b;
+    b.addSource("phong");
+    b.addDefine("USE_A", "1");
+
+    // as if the sources hashed the same
+    b.sourceHash = a.sourceHash;
+    CHECK(a != b);
+    CHECK(ProgramCacheKey::Hash()(a) == ProgramCacheKey::Hash()(b));
+
+    ProgramCacheKey c;
+    c.addSource("basic");
+    c.addDefine("USE_B", "1");
+
+    c.definesHash = a.definesHash;
+    CHECK(a != c);
+}
+
+TEST_CASE("ProgramCacheKey bounds") {
+
+    ProgramCacheKey key;
+
+    for (size_t i = 0; i < ProgramCacheKey::maxFlags; ++i) key.addFlag(true);
+    CHECK_THROWS(key.addFlag(true));
+
+    for (size_t i = 0; i < ProgramCacheKey::maxValues; ++i) key.addValue(1);
+    CHECK_THROWS(key.addValue(1));
+    CHECK_THROWS(key.addValue(1.f));
+}
@@ -0,0 +1,156 @@
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "threepp/renderers/shaders/ShaderChunk.hpp"
+#include "threepp/renderers/shaders/ShaderLib.hpp"
+#include "threepp/renderers/shaders/ShaderPreprocessor.hpp"
+#include "threepp/utils/RegexUtil.hpp"
+#include "threepp/utils/StringUtils.hpp"
+
+#include <chrono>
+#include <iostream>
+
+using namespace threepp;
+using namespace threepp::shaders;
+
+namespace {
+
+    // the previous, regex based implementation
+
+    std::string regexResolveIncludes(const std::string& str) {
+
+        static const std::regex rex("#include +<([\\w\\d.]+)>");
+
+        return regex_replace(str, rex, [](const std::smatch& match) {
+            return ShaderChunk::instance().get(match[1].str());
+        });
+    }
+
+    std::string regexUnrollLoops(const std::string& glsl) {
+
+        static const std::regex rex(R"(#pragma unroll_loop_start\s+for\s*\(\s*int\s+i\s*=\s*(\d+)\s*;\s*i\s*<\s*(\d+)\s*;\s*i\s*\+\+\s*\)\s*\{([\s\S]+?)\}\s+#pragma unroll_loop_end)");
+        static const std::regex index(R"(\[\s*i\s*\])");
+
+        return regex_replace(glsl, rex, [](const std::smatch& match) {
+            std::string result;
+            for (int i = utils::parseInt(match[1].str()); i < utils::parseInt(match[2].str()); ++i) {
+                auto str = std::regex_replace(match[3].str(), index, "[ " + std::to_string(i) + " ]");
+                utils::replaceAll(str, "UNROLLED_LOOP_INDEX", std::to_string(i));
+                result += str;
+            }
+            return result;
+        });
+    }
+
+    std::string regexPreprocess(const std::string& source, const ShaderDefines& defines) {
+
+        auto result = regexResolveIncludes(source);
+        for (const auto& [key, value] : defines) {
+            utils::replaceAll(result, key, value);
+        }
+
+        return regexUnrollLoops(result);
+    }
+
+    ShaderDefines makeDefines(int lights, int shadows, int clippingPlanes) {
+
+        return {
+                {"NUM_DIR_LIGHTS", std::to_string(lights)},
+                {"NUM_SPOT_LIGHTS", std::to_string(lights)},
+                {"NUM_RECT_AREA_LIGHTS", std::to_string(lights)},
+                {"NUM_POINT_LIGHTS", std::to_string(lights)},
+                {"NUM_HEMI_LIGHTS", std::to_string(lights)},
+                {"NUM_DIR_LIGHT_SHADOWS", std::to_string(shadows)},
+                {"NUM_SPOT_LIGHT_SHADOWS", std::to_string(shadows)},
+                {"NUM_POINT_LIGHT_SHADOWS", std::to_string(shadows)},
+                {"NUM_CLIPPING_PLANES", std::to_string(clippingPlanes)},
+                {"UNION_CLIPPING_PLANES", std::to_string(clippingPlanes)}};
+    }
+
+    std::vector<const Shader*> allShaders() {
+
+        auto& lib = ShaderLib::instance();
+
+        return {&lib.basic, &lib.lambert, &lib.phong, &lib.standard, &lib.toon, &lib.matcap,
+                &lib.points, &lib.dashed, &lib.depth, &lib.normal, &lib.sprite, &lib.background,
+                &lib.cube, &lib.equirect, &lib.distanceRGBA, &lib.shadow, &lib.physical};
+    }
+
+}// namespace
+
+TEST_CASE("Includes, defines and loops are expanded") {
+
+    const std::string source =
+            "#include <alphamap_pars_fragment>\n"
+            "float x = NUM_LIGHTS + NUM_LIGHTS_2;\n"
+            "#pragma unroll_loop_start\n"
+            "for ( int i = 0; i < NUM_LIGHTS; i ++ ) {\n"
+            "\tlight = lights[ i ]; index = UNROLLED_LOOP_INDEX;\n"
+            "}\n"
+            "#pragma unroll_loop_end\n";
+
+    const auto result = preprocessShader(source, {{"NUM_LIGHTS", "2"}});
+
+    const std::string expected =
+            "float x = 2 + NUM_LIGHTS_2;\n"
+            "\n"
+            "\tlight = lights[ 0 ]; index = 0;\n"
+            "\n"
+            "\tlight = lights[ 1 ]; index = 1;\n"
+            "\n";
+
+    CHECK(result == ShaderChunk::instance().alphamap_pars_fragment() + "\n" + expected);
+}
+
+TEST_CASE("Loops without constant bounds are kept") {
+
+    const std::string source =
+            "#pragma unroll_loop_start\n"
+            "for ( int i = 0; i < count; i ++ ) {\n"
+            "}\n"
+            "#pragma unroll_loop_end\n";
+
+    CHECK(preprocessShader(source) == source);
+}
+
+TEST_CASE("Unknown includes throw") {
+
+    CHECK_THROWS_AS(preprocessShader("#include <no_such_chunk>"), std::logic_error);
+}
+
+TEST_CASE("Matches the regex preprocessor for all ShaderLib programs") {
+
+    for (const auto& defines : {makeDefines(0, 0, 0), makeDefines(1, 0, 2), makeDefines(3, 2, 1)}) {
+        for (const auto shader : allShaders()) {
+
+            CHECK(preprocessShader(shader->vertexShader, defines) == regexPreprocess(shader->vertexShader, defines));
+            CHECK(preprocessShader(shader->fragmentShader, defines) == regexPreprocess(shader->fragmentShader, defines));
+        }
+    }
+}
+
+TEST_CASE("ShaderPreprocessor benchmark", "[.benchmark]") {
+
+    constexpr int iterations = 20;
+
+    const auto shaders = allShaders();
+    const auto defines = makeDefines(2, 1, 0);
+
+    const auto measure = [&](const std::string& name, const auto& preprocess) {
+        size_t size = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            for (const auto shader : shaders) {
+                size += preprocess(shader->vertexShader, defines).size();
+                size += preprocess(shader->fragmentShader, defines).size();
+            }
+        }
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << name << ": " << seconds * 1e3 / iterations << " ms for all ShaderLib programs (" << size << ")" << std::endl;
+    };
+
+    measure("regex", regexPreprocess);
+    measure("single pass", preprocessShader);
+}
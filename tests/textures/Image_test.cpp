@@ -0,0 +1,99 @@
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "threepp/loaders/ImageLoader.hpp"
+#include "threepp/textures/DataTexture.hpp"
+
+#include <fstream>
+
+using namespace threepp;
+
+TEST_CASE("Copies of an image share its pixels") {
+
+    Image image{std::vector<unsigned char>{1, 2, 3, 4}, 2, 2};
+    CHECK(!image.shared());
+
+    auto copy = image;
+    CHECK(image.shared());
+    CHECK(std::as_const(copy).data().data() == std::as_const(image).data().data());
+
+    // writing to one copies its pixels first
+    copy.data()[0] = 42;
+    CHECK(!image.shared());
+    CHECK(!copy.shared());
+    CHECK(image.data() == std::vector<unsigned char>{1, 2, 3, 4});
+    CHECK(copy.data() == std::vector<unsigned char>{42, 2, 3, 4});
+
+    // pixels no longer shared are written in place
+    const auto pixels = image.data().data();
+    image.data()[1] = 7;
+    CHECK(image.data().data() == pixels);
+
+    // setting the data of one leaves the others untouched
+    auto other = image;
+    other.setData(std::vector<unsigned char>{5, 6, 7, 8});
+    CHECK(!image.shared());
+    CHECK(image.data() == std::vector<unsigned char>{1, 7, 3, 4});
+    CHECK(other.data() == std::vector<unsigned char>{5, 6, 7, 8});
+}
+
+TEST_CASE("Cloned textures share their images") {
+
+    auto texture = DataTexture::create(std::vector<float>(16), 2, 2);
+    auto clone = texture->clone();
+
+    const auto& image = texture->image.front();
+    const auto& cloneImage = clone->image.front();
+    CHECK(cloneImage.data<float>().data() == image.data<float>().data());
+}
+
+TEST_CASE("Borrowed pixels are viewed in place") {
+
+    std::vector<float> pixels(16);
+
+    auto texture = DataTexture::create(Image::borrow(pixels.data(), pixels.size(), 2, 2));
+    auto& image = texture->image.front();
+
+    CHECK(image.holds<float>());
+    CHECK(!image.holds<unsigned char>());
+    CHECK(image.byteLength() == 16 * sizeof(float));
+    CHECK_THROWS(image.data<unsigned char>());
+
+    pixels[3] = 1;
+    CHECK(image.data<float>()[3] == 1);
+    CHECK(image.data<float>().data() == pixels.data());
+
+    // copies view the same pixels
+    auto copy = image;
+    copy.data<float>()[4] = 2;
+    CHECK(pixels[4] == 2);
+}
+
+TEST_CASE("Raw files are memory-mapped") {
+
+    const auto path = std::filesystem::temp_directory_path() / "threepp_image_test.raw";
+    {
+        std::ofstream file(path, std::ios::binary);
+        for (char i = 0; i < 12; ++i) file.put(i);
+    }
+
+    ImageLoader loader;
+    CHECK(!loader.loadRaw(path, 2, 2, 4));
+    CHECK(!loader.loadRaw<float>(path, 2, 2, 3));
+    CHECK(!loader.loadRaw(std::filesystem::temp_directory_path() / "threepp_no_such_file.raw", 1, 1));
+
+    {
+        auto image = loader.loadRaw(path, 2, 2, 3);
+        REQUIRE(image);
+        CHECK(image->width == 2);
+        CHECK(image->height == 2);
+        CHECK(std::as_const(*image).data() == std::vector<unsigned char>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11});
+
+        // the mapping is read-only, so writing copies the pixels
+        image->data()[0] = 42;
+        CHECK(image->data() == std::vector<unsigned char>{42, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11});
+        CHECK(loader.loadRaw(path, 2, 2, 3)->data().front() == 0);
+    }
+
+    std::filesystem::remove(path);
+}
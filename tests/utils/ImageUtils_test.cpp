@@ -0,0 +1,63 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "threepp/utils/ImageUtils.hpp"
+
+using namespace threepp;
+
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("Mipmaps average 2x2 texels") {
+
+    // 4x2, two channels
+    Image image{std::vector<unsigned char>{0, 10, 4, 20, 100, 0, 200, 0,
+                                           8, 30, 12, 40, 100, 255, 200, 255},
+                4, 2};
+
+    auto mipmaps = generateMipmaps(image, 2);
+    REQUIRE(mipmaps.size() == 3);
+
+    CHECK(mipmaps[0].data() == image.data());
+
+    CHECK(mipmaps[1].width == 2);
+    CHECK(mipmaps[1].height == 1);
+    CHECK(mipmaps[1].data() == std::vector<unsigned char>{6, 25, 150, 128});
+
+    CHECK(mipmaps[2].width == 1);
+    CHECK(mipmaps[2].height == 1);
+    CHECK(mipmaps[2].data() == std::vector<unsigned char>{78, 77});
+}
+
+TEST_CASE("Mipmaps of odd sizes repeat the edge") {
+
+    Image image{std::vector<float>{1, 2, 3,
+                                   4, 5, 6,
+                                   7, 8, 9},
+                3, 3};
+
+    auto mipmaps = generateMipmaps(image, 1);
+    REQUIRE(mipmaps.size() == 2);
+
+    CHECK(mipmaps[1].width == 1);
+    CHECK(mipmaps[1].height == 1);
+    CHECK_THAT(mipmaps[1].data<float>().front(), WithinAbs(3, 1e-6));
+}
+
+TEST_CASE("Texture mipmaps") {
+
+    auto texture = Texture::create(Image{std::vector<unsigned char>(64 * 32 * 3, 255), 64, 32});
+    texture->format = Format::RGB;
+
+    generateMipmaps(*texture);
+
+    REQUIRE(texture->mipmaps.size() == 7);
+    CHECK(texture->mipmaps.back().width == 1);
+    CHECK(texture->mipmaps.back().height == 1);
+    CHECK(texture->mipmaps.back().data() == std::vector<unsigned char>{255, 255, 255});
+    CHECK(texture->unpackAlignment == 1);
+
+    auto unsupported = Texture::create(Image{std::vector<unsigned char>(16), 2, 2});
+    unsupported->format = Format::RGBA_S3TC_DXT5;
+    generateMipmaps(*unsupported);
+    CHECK(unsupported->mipmaps.empty());
+}